@@ -0,0 +1,229 @@
+#include "AnalysisCache.h"
+#include "AndAcceptor.h"
+#include "TemplateAcceptor.h"
+#include "ValueAcceptor.h"
+#include <calculator/DefaultAcceptor.h>
+#include <calculator/RangeAcceptor.h>
+#include <calculator/WeatherArea.h>
+#include <calculator/WeatherResult.h>
+#include <regression/tframe.h>
+
+#include <newbase/NFmiGlobals.h>
+#include <newbase/NFmiSettings.h>
+#include <newbase/NFmiStringTools.h>
+
+#include <iostream>
+#include <limits>
+#include <string>
+
+using namespace std;
+using namespace TextGen;
+
+namespace AnalysisCacheTest
+{
+struct Positive
+{
+  bool operator()(float theValue) const { return theValue > 0; }
+};
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Test AnalysisCache::key for acceptors
+ */
+// ----------------------------------------------------------------------
+
+void acceptor_keys()
+{
+  RangeAcceptor r1;
+  r1.lowerLimit(0.5);
+  r1.upperLimit(1.5);
+
+  RangeAcceptor r2;
+  r2.lowerLimit(0.5);
+  r2.upperLimit(1.5);
+
+  RangeAcceptor r3;
+  r3.lowerLimit(0.5);
+  r3.upperLimit(2.5);
+
+  string k1, k2, k3;
+  if (!AnalysisCache::key(r1, k1) || !AnalysisCache::key(r2, k2) || !AnalysisCache::key(r3, k3))
+    TEST_FAILED("RangeAcceptor should have a key");
+  if (k1 != k2)
+    TEST_FAILED("Identical RangeAcceptors should have identical keys");
+  if (k1 == k3)
+    TEST_FAILED("Different RangeAcceptors should have different keys");
+
+  RangeAcceptor r4;
+  r4.lowerLimit(0.5);
+  string k4;
+  AnalysisCache::key(r4, k4);
+  const float limits[2] = {0.5, std::numeric_limits<float>::infinity()};
+  if (k4 != "R" + string(reinterpret_cast<const char*>(limits), sizeof(limits)))
+    TEST_FAILED("RangeAcceptor key should consist of its limits");
+
+  ValueAcceptor v1;
+  v1.value(1);
+  ValueAcceptor v2;
+  v2.value(2);
+  string kv1, kv2;
+  AnalysisCache::key(v1, kv1);
+  AnalysisCache::key(v2, kv2);
+  if (kv1 == kv2)
+    TEST_FAILED("Different ValueAcceptors should have different keys");
+
+  string ka1, ka2;
+  if (!AnalysisCache::key(AndAcceptor(r1, v1), ka1) ||
+      !AnalysisCache::key(AndAcceptor(r1, v2), ka2))
+    TEST_FAILED("AndAcceptor of known acceptors should have a key");
+  if (ka1 == ka2)
+    TEST_FAILED("Different AndAcceptors should have different keys");
+
+  string kd1, kd2;
+  AnalysisCache::key(DefaultAcceptor(), kd1);
+  AnalysisCache::key(r1, kd2);
+  if (kd1 == kd2)
+    TEST_FAILED("DefaultAcceptor and RangeAcceptor should have different keys");
+
+  string kt;
+  if (AnalysisCache::key(TemplateAcceptor<Positive>(Positive()), kt))
+    TEST_FAILED("Arbitrary TemplateAcceptors should not have a key");
+
+  TEST_PASSED();
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Test AnalysisCache::key for areas
+ */
+// ----------------------------------------------------------------------
+
+void area_keys()
+{
+  WeatherArea a1("25,60", "helsinki");
+  WeatherArea a2("25,60", "helsinki");
+  WeatherArea a3("25,61", "helsinki");
+
+  string k1, k2, k3;
+  AnalysisCache::key(a1, k1);
+  AnalysisCache::key(a2, k2);
+  AnalysisCache::key(a3, k3);
+
+  if (k1 != k2)
+    TEST_FAILED("Identical areas should have identical keys");
+  if (k1 == k3)
+    TEST_FAILED("Different points should have different keys");
+
+  a2.type(WeatherArea::Coast);
+  k2.clear();
+  AnalysisCache::key(a2, k2);
+  if (k1 == k2)
+    TEST_FAILED("Different area types should have different keys");
+
+  WeatherArea u1("maps/uusimaa.svg", "uusimaa");
+  WeatherArea u2("maps/uusimaa.svg:10", "uusimaa");
+  string ku1, ku2;
+  AnalysisCache::key(u1, ku1);
+  AnalysisCache::key(u2, ku2);
+  if (ku1 == ku2)
+    TEST_FAILED("Areas with different expansions should have different keys");
+  if (ku1.size() > 100)
+    TEST_FAILED("Area key should not contain the path, size = " +
+                NFmiStringTools::Convert(ku1.size()));
+
+  TEST_PASSED();
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Test AnalysisCache lookups and counters
+ */
+// ----------------------------------------------------------------------
+
+void lookups()
+{
+  AnalysisCache cache;
+  WeatherResult result(kFloatMissing, 0);
+
+  if (cache.find("a", result))
+    TEST_FAILED("Empty cache should not find anything");
+
+  cache.insert("a", WeatherResult(1, 2));
+  if (!cache.find("a", result))
+    TEST_FAILED("Failed to find inserted result");
+  if (result.value() != 1 || result.error() != 2)
+    TEST_FAILED("Found incorrect result");
+
+  if (cache.hits() != 1 || cache.misses() != 1)
+    TEST_FAILED("Incorrect hit and miss counts");
+
+  cache.clear();
+  if (cache.size() != 0 || cache.hits() != 0 || cache.misses() != 0)
+    TEST_FAILED("Failed to clear the cache");
+
+  TEST_PASSED();
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Test AnalysisCache::Scope
+ */
+// ----------------------------------------------------------------------
+
+void scopes()
+{
+  if (AnalysisCache::current() != nullptr)
+    TEST_FAILED("No cache should be active by default");
+
+  AnalysisCache outer;
+  AnalysisCache inner;
+  {
+    AnalysisCache::Scope scope1(&outer);
+    if (AnalysisCache::current() != &outer)
+      TEST_FAILED("Failed to activate the outer cache");
+    {
+      AnalysisCache::Scope scope2(&inner);
+      if (AnalysisCache::current() != &inner)
+        TEST_FAILED("Failed to activate the inner cache");
+    }
+    if (AnalysisCache::current() != &outer)
+      TEST_FAILED("Failed to restore the outer cache");
+  }
+  if (AnalysisCache::current() != nullptr)
+    TEST_FAILED("Failed to deactivate the cache");
+
+  TEST_PASSED();
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief The actual test driver
+ */
+// ----------------------------------------------------------------------
+
+class tests : public tframe::tests
+{
+  //! Overridden message separator
+  virtual const char* error_message_prefix() const { return "\n\t"; }
+  //! Main test suite
+  void test(void)
+  {
+    TEST(acceptor_keys);
+    TEST(area_keys);
+    TEST(lookups);
+    TEST(scopes);
+  }
+
+};  // class tests
+
+}  // namespace AnalysisCacheTest
+
+int main(void)
+{
+  NFmiSettings::Init();
+
+  cout << endl << "AnalysisCache tests" << endl << "===================" << endl;
+
+  AnalysisCacheTest::tests t;
+  return t.run();
+}
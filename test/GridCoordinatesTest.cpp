@@ -0,0 +1,140 @@
+#include <regression/tframe.h>
+
+#include "GridCoordinates.h"
+
+#include <newbase/NFmiGrid.h>
+#include <newbase/NFmiSettings.h>
+#include <newbase/NFmiStereographicArea.h>
+#include <newbase/NFmiStringTools.h>
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace TextGen;
+
+namespace GridCoordinatesTest
+{
+using NFmiStringTools::Convert;
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Test that the table matches NFmiGrid::LatLon
+ */
+// ----------------------------------------------------------------------
+
+void coordinates()
+{
+  NFmiStereographicArea area(NFmiPoint(19, 59), NFmiPoint(33, 71), 25);
+  NFmiGrid grid(&area, 30, 52);
+
+  const GridCoordinates table(grid);
+
+  if (table.size() != 30 * 52)
+    TEST_FAILED("Table size should be " + Convert(30 * 52) + ", not " + Convert(table.size()));
+
+  for (unsigned long idx = 0; idx < table.size(); idx++)
+  {
+    const NFmiPoint expected = grid.LatLon(idx);
+    if (table.lon(idx) != expected.X() || table.lat(idx) != expected.Y())
+      TEST_FAILED("Coordinates of grid point " + Convert(idx) + " differ from NFmiGrid::LatLon");
+    if (table.latlon(idx).X() != expected.X() || table.latlon(idx).Y() != expected.Y())
+      TEST_FAILED("latlon of grid point " + Convert(idx) + " differs from NFmiGrid::LatLon");
+  }
+
+  TEST_PASSED();
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Test that equal grids share one table
+ */
+// ----------------------------------------------------------------------
+
+void get()
+{
+  NFmiStereographicArea area1(NFmiPoint(19, 59), NFmiPoint(33, 71), 25);
+  NFmiStereographicArea area2(NFmiPoint(19, 59), NFmiPoint(33, 70), 25);
+  NFmiGrid grid1(&area1, 30, 52);
+  NFmiGrid grid2(&area1, 30, 52);
+  NFmiGrid grid3(&area2, 30, 52);
+
+  auto table1 = GridCoordinates::get(grid1);
+
+  if (GridCoordinates::get(grid2) != table1)
+    TEST_FAILED("Equal grids should share the coordinate table");
+  if (GridCoordinates::get(grid3) == table1)
+    TEST_FAILED("Different grids should not share the coordinate table");
+
+  TEST_PASSED();
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Test that only the most recently used tables are kept
+ */
+// ----------------------------------------------------------------------
+
+void capacity()
+{
+  vector<NFmiStereographicArea> areas;
+  for (unsigned int i = 0; i <= GridCoordinates::capacity(); i++)
+    areas.emplace_back(NFmiPoint(19, 59), NFmiPoint(33, 60 + i), 25);
+
+  vector<NFmiGrid> grids;
+  for (auto& area : areas)
+    grids.emplace_back(&area, 10, 12);
+
+  auto first = GridCoordinates::get(grids[0]);
+  auto second = GridCoordinates::get(grids[1]);
+
+  // Using the first table keeps it cached while the second one is dropped
+
+  for (unsigned int i = 2; i < grids.size(); i++)
+  {
+    GridCoordinates::get(grids[i]);
+    if (GridCoordinates::get(grids[0]) != first)
+      TEST_FAILED("A recently used table should stay in the cache");
+  }
+
+  auto again = GridCoordinates::get(grids[1]);
+  if (again == second)
+    TEST_FAILED("The least recently used table should be dropped from the cache");
+  if (second->size() != 10 * 12 || second->lon(5) != again->lon(5))
+    TEST_FAILED("A dropped table should remain valid");
+
+  TEST_PASSED();
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief The actual test driver
+ */
+// ----------------------------------------------------------------------
+
+class tests : public tframe::tests
+{
+  //! Overridden message separator
+  virtual const char* error_message_prefix() const { return "\n\t"; }
+  //! Main test suite
+  void test(void)
+  {
+    TEST(coordinates);
+    TEST(get);
+    TEST(capacity);
+  }
+
+};  // class tests
+
+}  // namespace GridCoordinatesTest
+
+int main(void)
+{
+  NFmiSettings::Init();
+
+  cout << endl << "GridCoordinates tests" << endl << "=====================" << endl;
+
+  GridCoordinatesTest::tests t;
+  return t.run();
+}
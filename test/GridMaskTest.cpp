@@ -0,0 +1,237 @@
+#include <regression/tframe.h>
+
+#include "GridMask.h"
+#include <calculator/Settings.h>
+#include <macgyver/Exception.h>
+
+#include <newbase/NFmiIndexMask.h>
+#include <newbase/NFmiSettings.h>
+#include <newbase/NFmiStringTools.h>
+
+#include <algorithm>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace TextGen;
+
+namespace GridMaskTest
+{
+using NFmiStringTools::Convert;
+
+// A grid whose rows do not end at word boundaries
+const unsigned long width = 37;
+const unsigned long height = 11;
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Random mask with both scattered points and long runs
+ */
+// ----------------------------------------------------------------------
+
+set<unsigned long> make_mask(unsigned int theSeed)
+{
+  std::mt19937 gen(theSeed);
+  std::uniform_int_distribution<unsigned long> point(0, width * height - 1);
+  std::uniform_int_distribution<unsigned long> length(1, 2 * width);
+
+  set<unsigned long> ret;
+  for (int i = 0; i < 20; i++)
+  {
+    const unsigned long start = point(gen);
+    const unsigned long end = std::min(width * height, start + (i % 2 == 0 ? 1 : length(gen)));
+    for (unsigned long idx = start; idx < end; idx++)
+      ret.insert(idx);
+  }
+  return ret;
+}
+
+NFmiIndexMask make_index_mask(const set<unsigned long>& theIndexes)
+{
+  NFmiIndexMask ret;
+  for (unsigned long idx : theIndexes)
+    ret.insert(idx);
+  return ret;
+}
+
+bool same(const GridMask& theMask, const set<unsigned long>& theIndexes)
+{
+  const vector<unsigned long> indexes = theMask.indexes();
+  return (theMask.count() == theIndexes.size() &&
+          std::equal(indexes.begin(), indexes.end(), theIndexes.begin(), theIndexes.end()));
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Test conversions to and from NFmiIndexMask
+ */
+// ----------------------------------------------------------------------
+
+void conversions()
+{
+  GridMask empty(width, height);
+  if (!empty.empty() || empty.count() != 0)
+    TEST_FAILED("A new mask should be empty");
+
+  for (unsigned int seed = 1; seed <= 10; seed++)
+  {
+    const set<unsigned long> indexes = make_mask(seed);
+    const GridMask mask(make_index_mask(indexes), width, height);
+
+    if (!same(mask, indexes))
+      TEST_FAILED("Mask " + Convert(seed) + " differs from the index mask");
+
+    const NFmiIndexMask result = mask.indexMask();
+    if (!std::equal(result.begin(), result.end(), indexes.begin(), indexes.end()))
+      TEST_FAILED("Mask " + Convert(seed) + " converted back differs from the original");
+
+    for (unsigned long idx = 0; idx < mask.size(); idx++)
+      if (mask.test(idx) != (indexes.find(idx) != indexes.end()))
+        TEST_FAILED("Mask " + Convert(seed) + " differs at " + Convert(idx));
+  }
+
+  NFmiIndexMask outside;
+  outside.insert(width * height);
+  try
+  {
+    GridMask mask(outside, width, height);
+    TEST_FAILED("Index outside the grid should throw");
+  }
+  catch (const Fmi::Exception&)
+  {
+  }
+
+  TEST_PASSED();
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Test intersection, union and difference
+ */
+// ----------------------------------------------------------------------
+
+void algebra()
+{
+  for (unsigned int seed = 1; seed <= 10; seed++)
+  {
+    const set<unsigned long> a = make_mask(seed);
+    const set<unsigned long> b = make_mask(seed + 100);
+    const GridMask amask(make_index_mask(a), width, height);
+    const GridMask bmask(make_index_mask(b), width, height);
+
+    set<unsigned long> expected;
+    std::set_intersection(
+        a.begin(), a.end(), b.begin(), b.end(), std::inserter(expected, expected.end()));
+    GridMask result = amask;
+    result &= bmask;
+    if (!same(result, expected))
+      TEST_FAILED("Intersection " + Convert(seed) + " failed");
+
+    expected.clear();
+    std::set_union(a.begin(), a.end(), b.begin(), b.end(), std::inserter(expected, expected.end()));
+    result = amask;
+    result |= bmask;
+    if (!same(result, expected))
+      TEST_FAILED("Union " + Convert(seed) + " failed");
+
+    expected.clear();
+    std::set_difference(
+        a.begin(), a.end(), b.begin(), b.end(), std::inserter(expected, expected.end()));
+    result = amask;
+    result -= bmask;
+    if (!same(result, expected))
+      TEST_FAILED("Difference " + Convert(seed) + " failed");
+  }
+
+  GridMask mask(width, height);
+  try
+  {
+    mask &= GridMask(height, width);
+    TEST_FAILED("Combining masks over different grids should throw");
+  }
+  catch (const Fmi::Exception&)
+  {
+  }
+
+  TEST_PASSED();
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Test the runs of consecutive points
+ */
+// ----------------------------------------------------------------------
+
+void spans()
+{
+  for (unsigned int seed = 1; seed <= 10; seed++)
+  {
+    const set<unsigned long> indexes = make_mask(seed);
+    const GridMask mask(make_index_mask(indexes), width, height);
+
+    set<unsigned long> result;
+    unsigned long previous = 0;
+    for (const auto& span : mask.spans())
+    {
+      if (span.begin >= span.end)
+        TEST_FAILED("Span " + Convert(span.begin) + " is empty");
+      if (span.begin / width != (span.end - 1) / width)
+        TEST_FAILED("Span " + Convert(span.begin) + " continues to the next row");
+      if (span.begin < previous)
+        TEST_FAILED("Span " + Convert(span.begin) + " is out of order");
+      if (span.begin == previous && previous % width != 0)
+        TEST_FAILED("Span " + Convert(span.begin) + " should be joined to the previous one");
+      for (unsigned long idx = span.begin; idx < span.end; idx++)
+        result.insert(idx);
+      previous = span.end;
+    }
+
+    if (result != indexes)
+      TEST_FAILED("Spans of mask " + Convert(seed) + " differ from the mask");
+  }
+
+  GridMask full(width, height);
+  for (unsigned long idx = 0; idx < full.size(); idx++)
+    full.set(idx);
+  if (full.spans().size() != height)
+    TEST_FAILED("A full mask should have one span per row, not " + Convert(full.spans().size()));
+
+  TEST_PASSED();
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief The actual test driver
+ */
+// ----------------------------------------------------------------------
+
+class tests : public tframe::tests
+{
+  //! Overridden message separator
+  virtual const char* error_message_prefix() const { return "\n\t"; }
+  //! Main test suite
+  void test(void)
+  {
+    TEST(conversions);
+    TEST(algebra);
+    TEST(spans);
+  }
+
+};  // class tests
+
+}  // namespace GridMaskTest
+
+int main(void)
+{
+  NFmiSettings::Init();
+  Settings::set(NFmiSettings::ToString());
+
+  cout << endl << "GridMask tests" << endl << "==============" << endl;
+
+  GridMaskTest::tests t;
+  return t.run();
+}
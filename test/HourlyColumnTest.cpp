@@ -0,0 +1,183 @@
+#include <regression/tframe.h>
+
+#include "WeatherForecast.h"
+#include <calculator/WeatherPeriod.h>
+#include <calculator/WeatherResult.h>
+
+#include <newbase/NFmiSettings.h>
+#include <newbase/NFmiStringTools.h>
+
+#include <iostream>
+#include <string>
+
+using namespace std;
+using namespace TextGen;
+
+namespace HourlyColumnTest
+{
+using NFmiStringTools::Convert;
+
+// 24 hourly periods starting from 1.7.2010 01:00, start and end times are equal
+
+void make_axis(HourlyTimeAxis& theAxis)
+{
+  TextGenPosixTime time(2010, 7, 1, 0, 0, 0);
+  for (unsigned int i = 0; i < 24; i++)
+  {
+    time.ChangeByHours(1);
+    theAxis.push_back(WeatherPeriod(time, time), i < 12 ? AAMUPAIVA : ILTAPAIVA);
+  }
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Test HourlyTimeAxis
+ */
+// ----------------------------------------------------------------------
+
+void axis()
+{
+  HourlyTimeAxis axis;
+  make_axis(axis);
+
+  if (axis.size() != 24)
+    TEST_FAILED("Axis size should be 24, not " + Convert(axis.size()));
+
+  for (unsigned int i = 0; i < axis.size(); i++)
+  {
+    if (axis.startTime(i) != axis.period(i).localStartTime().EpochTime())
+      TEST_FAILED("Wrong start time at hour " + Convert(i));
+    if (axis.endTime(i) != axis.period(i).localEndTime().EpochTime())
+      TEST_FAILED("Wrong end time at hour " + Convert(i));
+    if (i > 0 && axis.startTime(i) - axis.startTime(i - 1) != 3600)
+      TEST_FAILED("Hours should be 3600 seconds apart at hour " + Convert(i));
+  }
+
+  if (axis.partOfTheDay(11) != AAMUPAIVA || axis.partOfTheDay(12) != ILTAPAIVA)
+    TEST_FAILED("Wrong part of the day");
+
+  TEST_PASSED();
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Test reading and writing a HourlyColumn through the data items
+ */
+// ----------------------------------------------------------------------
+
+void items()
+{
+  HourlyTimeAxis axis;
+  make_axis(axis);
+  HourlyColumn column(axis);
+
+  weather_result_data_item_vector data;
+  for (std::size_t i = 0; i < column.size(); i++)
+    data.emplace_back(column, i);
+
+  if (data[5]->theResult.value() != kFloatMissing)
+    TEST_FAILED("A new column should contain missing values");
+
+  for (unsigned int i = 0; i < data.size(); i++)
+    data[i]->theResult = WeatherResult(i, 0.5 * i);
+
+  if (column.values()[7] != 7 || column.errors()[7] != 3.5)
+    TEST_FAILED("Writing through the data item should change the column");
+
+  const WeatherResult result = data[9]->theResult;
+  if (result.value() != 9 || result.error() != 4.5)
+    TEST_FAILED("Wrong result at hour 9: " + as_string(result));
+
+  if (data[3]->thePeriod.localStartTime() != axis.period(3).localStartTime())
+    TEST_FAILED("Wrong period at hour 3");
+  if (data[15]->thePartOfTheDay != ILTAPAIVA)
+    TEST_FAILED("Wrong part of the day at hour 15");
+
+  data[0]->theResult = data[23]->theResult;
+  if (column.values()[0] != 23 || column.values()[23] != 23)
+    TEST_FAILED("Assigning one data item to another should copy the value");
+
+  // The items are stored in the column, so references to them stay valid
+  WeatherResultRef& ref = data[2]->theResult;
+  const WeatherResultDataItem& item = *data[2];
+  ref = WeatherResult(42, 1);
+  if (column.values()[2] != 42 || item.theResult.value() != 42 || &item != &*data[2])
+    TEST_FAILED("A reference to a data item should refer to the column");
+
+  if (!(data[4] == weather_result_data_item_vector::value_type(column, 4)) || data[4] == data[5])
+    TEST_FAILED("Data items should be equal only for the same hour of the same column");
+
+  TEST_PASSED();
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Test get_sub_time_series and get_mean with a column
+ */
+// ----------------------------------------------------------------------
+
+void sub_time_series()
+{
+  HourlyTimeAxis axis;
+  make_axis(axis);
+  HourlyColumn column(axis);
+
+  weather_result_data_item_vector data;
+  for (std::size_t i = 0; i < column.size(); i++)
+  {
+    data.emplace_back(column, i);
+    data.back()->theResult = WeatherResult(i, 0);
+  }
+
+  const WeatherPeriod period(TextGenPosixTime(2010, 7, 1, 6, 0, 0),
+                             TextGenPosixTime(2010, 7, 1, 9, 0, 0));
+
+  weather_result_data_item_vector subseries;
+  get_sub_time_series(period, data, subseries);
+
+  if (subseries.size() != 4)
+    TEST_FAILED("Period 06-09 should contain 4 hours, not " + Convert(subseries.size()));
+  if (subseries.front().index() != 5 || subseries.back().index() != 8)
+    TEST_FAILED("Period 06-09 should contain the hours 5...8");
+  if (get_mean(subseries) != 6.5)
+    TEST_FAILED("The mean of hours 5...8 should be 6.5, not " + Convert(get_mean(subseries)));
+
+  weather_result_data_item_vector afternoon;
+  get_sub_time_series(ILTAPAIVA, data, afternoon);
+  if (afternoon.size() != 12)
+    TEST_FAILED("The afternoon should contain 12 hours, not " + Convert(afternoon.size()));
+
+  TEST_PASSED();
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief The actual test driver
+ */
+// ----------------------------------------------------------------------
+
+class tests : public tframe::tests
+{
+  //! Overridden message separator
+  virtual const char* error_message_prefix() const { return "\n\t"; }
+  //! Main test suite
+  void test(void)
+  {
+    TEST(axis);
+    TEST(items);
+    TEST(sub_time_series);
+  }
+
+};  // class tests
+
+}  // namespace HourlyColumnTest
+
+int main(void)
+{
+  NFmiSettings::Init();
+
+  cout << endl << "HourlyColumn tests" << endl << "==================" << endl;
+
+  HourlyColumnTest::tests t;
+  return t.run();
+}
@@ -0,0 +1,218 @@
+#include "LabelMask.h"
+#include <calculator/Settings.h>
+#include <macgyver/Exception.h>
+#include <regression/tframe.h>
+
+#include <newbase/NFmiIndexMask.h>
+#include <newbase/NFmiSettings.h>
+
+#include <iostream>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace TextGen;
+
+namespace LabelMaskTest
+{
+// ----------------------------------------------------------------------
+/*!
+ * \brief Make a mask of the given grid points
+ */
+// ----------------------------------------------------------------------
+
+MaskSource::mask_type make_mask(const vector<unsigned long>& theIndexes)
+{
+  auto mask = std::make_shared<NFmiIndexMask>();
+  for (auto idx : theIndexes)
+    mask->insert(idx);
+  return mask;
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Test that the union and the labels are correct
+ */
+// ----------------------------------------------------------------------
+
+void labels()
+{
+  // Full area and its overlapping coastal and inland parts
+
+  const vector<MaskSource::mask_type> masks{make_mask({1, 2, 3, 4, 5, 6}),
+                                            make_mask({5, 6, 7}),
+                                            make_mask({1, 2, 3}),
+                                            make_mask({})};
+
+  LabelMask mask(masks);
+
+  if (mask.labels() != 4)
+    TEST_FAILED("Expected 4 labels, got " + to_string(mask.labels()));
+
+  const vector<unsigned long> indexes{1, 2, 3, 4, 5, 6, 7};
+  if (mask.indexes() != indexes)
+    TEST_FAILED("The union of the masks is incorrect");
+
+  if (mask.size() != indexes.size())
+    TEST_FAILED("Expected 7 grid points, got " + to_string(mask.size()));
+
+  const vector<string> expected{
+      "0101", "0101", "0101", "0001", "0011", "0011", "0010"};  // label 0 is the last bit
+
+  for (unsigned int i = 0; i < mask.size(); i++)
+  {
+    const string labels = mask.memberships()[i].to_string().substr(LabelMask::max_labels - 4);
+    if (labels != expected[i])
+      TEST_FAILED("Point " + to_string(mask.indexes()[i]) + " has labels " + labels +
+                  " instead of " + expected[i]);
+  }
+
+  const vector<size_t> sizes{6, 3, 3, 0};
+  for (unsigned int label = 0; label < sizes.size(); label++)
+    if (mask.size(label) != sizes[label])
+      TEST_FAILED("Label " + to_string(label) + " has " + to_string(mask.size(label)) +
+                  " points instead of " + to_string(sizes[label]));
+
+  TEST_PASSED();
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Test that each mask is recovered in its original order
+ */
+// ----------------------------------------------------------------------
+
+void order()
+{
+  const vector<MaskSource::mask_type> masks{make_mask({100, 7, 42, 3}), make_mask({42, 8, 1000})};
+
+  LabelMask mask(masks);
+
+  for (unsigned int label = 0; label < masks.size(); label++)
+  {
+    vector<unsigned long> original(masks[label]->begin(), masks[label]->end());
+    vector<unsigned long> recovered;
+    for (unsigned int i = 0; i < mask.size(); i++)
+      if (mask.memberships()[i].test(label))
+        recovered.push_back(mask.indexes()[i]);
+
+    if (recovered != original)
+      TEST_FAILED("Label " + to_string(label) + " does not reproduce its mask");
+  }
+
+  TEST_PASSED();
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Test the merge against a union built with a map
+ */
+// ----------------------------------------------------------------------
+
+void merge()
+{
+  std::mt19937 generator(12345);
+
+  for (unsigned int n = 0; n <= LabelMask::max_labels; n++)
+  {
+    vector<MaskSource::mask_type> masks;
+    map<unsigned long, LabelMask::label_set> expected;
+    for (unsigned int label = 0; label < n; label++)
+    {
+      // Masks of different densities, including empty ones
+      const unsigned int modulo = 1 + label % 4;
+      vector<unsigned long> indexes;
+      for (unsigned long idx = 0; idx < 500; idx++)
+        if (label != 3 && generator() % modulo == 0)
+        {
+          indexes.push_back(idx);
+          expected[idx].set(label);
+        }
+      masks.push_back(make_mask(indexes));
+    }
+
+    LabelMask mask(masks);
+
+    vector<unsigned long> indexes;
+    vector<LabelMask::label_set> memberships;
+    for (const auto& point : expected)
+    {
+      indexes.push_back(point.first);
+      memberships.push_back(point.second);
+    }
+
+    if (mask.indexes() != indexes || mask.memberships() != memberships)
+      TEST_FAILED("The merge of " + to_string(n) + " masks differs from their union");
+
+    for (unsigned int label = 0; label < n; label++)
+      if (mask.size(label) != masks[label]->size())
+        TEST_FAILED("Label " + to_string(label) + " of " + to_string(n) + " masks has " +
+                    to_string(mask.size(label)) + " points instead of " +
+                    to_string(masks[label]->size()));
+  }
+
+  TEST_PASSED();
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Test that too many masks are rejected
+ */
+// ----------------------------------------------------------------------
+
+void limits()
+{
+  LabelMask empty;
+  if (!empty.empty() || empty.labels() != 0)
+    TEST_FAILED("Default constructed mask should be empty");
+
+  const vector<MaskSource::mask_type> masks(LabelMask::max_labels + 1, make_mask({1}));
+
+  try
+  {
+    LabelMask mask(masks);
+    TEST_FAILED("Should have failed with " + to_string(masks.size()) + " masks");
+  }
+  catch (const Fmi::Exception&)
+  {
+  }
+
+  TEST_PASSED();
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief The actual test driver
+ */
+// ----------------------------------------------------------------------
+
+class tests : public tframe::tests
+{
+  //! Overridden message separator
+  virtual const char* error_message_prefix() const { return "\n\t"; }
+  //! Main test suite
+  void test(void)
+  {
+    TEST(labels);
+    TEST(order);
+    TEST(merge);
+    TEST(limits);
+  }
+
+};  // class tests
+
+}  // namespace LabelMaskTest
+
+int main(void)
+{
+  NFmiSettings::Init();
+  Settings::set(NFmiSettings::ToString());
+
+  cout << endl << "LabelMask tests" << endl << "===============" << endl;
+
+  LabelMaskTest::tests t;
+  return t.run();
+}
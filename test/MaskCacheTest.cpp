@@ -0,0 +1,238 @@
+#include <regression/tframe.h>
+
+#include "MaskCache.h"
+#include <calculator/Settings.h>
+
+#include <newbase/NFmiGrid.h>
+#include <newbase/NFmiSettings.h>
+#include <newbase/NFmiStereographicArea.h>
+#include <newbase/NFmiStringTools.h>
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace TextGen;
+
+namespace MaskCacheTest
+{
+using NFmiStringTools::Convert;
+
+const string cachedir = "/tmp";
+
+GridMask make_mask(const NFmiGrid& theGrid)
+{
+  GridMask mask(theGrid);
+  for (unsigned long idx = 0; idx < mask.size(); idx += 3)
+    mask.set(idx);
+  mask.set(GridMask::Span{100, 250});
+  return mask;
+}
+
+bool same(const GridMask& theMask1, const GridMask& theMask2)
+{
+  return (theMask1.width() == theMask2.width() && theMask1.height() == theMask2.height() &&
+          theMask1.indexes() == theMask2.indexes());
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Test that the key depends on all its parts
+ */
+// ----------------------------------------------------------------------
+
+void key()
+{
+  NFmiStereographicArea area1(NFmiPoint(19, 59), NFmiPoint(33, 71), 25);
+  NFmiStereographicArea area2(NFmiPoint(19, 59), NFmiPoint(33, 70), 25);
+  NFmiGrid grid1(&area1, 30, 52);
+  NFmiGrid grid2(&area2, 30, 52);
+  NFmiGrid grid3(&area1, 30, 53);
+
+  const string name = MaskCache::Key("coast").add(grid1).add(5.0).name();
+
+  if (name != MaskCache::Key("coast").add(grid1).add(5.0).name())
+    TEST_FAILED("Equal keys should have equal names");
+  if (name == MaskCache::Key("inland").add(grid1).add(5.0).name())
+    TEST_FAILED("The kind of the mask should change the key");
+  if (name == MaskCache::Key("coast").add(grid2).add(5.0).name())
+    TEST_FAILED("The area of the grid should change the key");
+  if (name == MaskCache::Key("coast").add(grid3).add(5.0).name())
+    TEST_FAILED("The size of the grid should change the key");
+  if (name == MaskCache::Key("coast").add(grid1).add(6.0).name())
+    TEST_FAILED("The distance should change the key");
+
+  TEST_PASSED();
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Test writing and reading a mask
+ */
+// ----------------------------------------------------------------------
+
+void readwrite()
+{
+  NFmiStereographicArea area(NFmiPoint(19, 59), NFmiPoint(33, 71), 25);
+  NFmiGrid grid(&area, 30, 52);
+
+  const MaskCache::Key key = MaskCache::Key("test").add(grid);
+  const string filename = cachedir + "/" + key.name();
+
+  const GridMask mask = make_mask(grid);
+  MaskCache::write(filename, key, mask);
+
+  GridMask result(grid);
+  if (!MaskCache::read(filename, key, result))
+    TEST_FAILED("Failed to read back " + filename);
+  if (!same(result, mask))
+    TEST_FAILED("Mask read from " + filename + " differs from the one written");
+
+  if (MaskCache::read(filename, MaskCache::Key("other").add(grid), result))
+    TEST_FAILED("Mask with a different key should not be accepted");
+
+  GridMask wrongsize(31, 52);
+  if (MaskCache::read(filename, key, wrongsize))
+    TEST_FAILED("Mask for a different grid size should not be accepted");
+
+  // A file with the same hash but a different key, as in a hash collision
+  {
+    std::fstream io(filename.c_str(), std::ios::in | std::ios::out | std::ios::binary);
+    io.seekp(32);
+    io.put('?');
+  }
+  if (MaskCache::read(filename, key, result))
+    TEST_FAILED("Mask with a different full key should not be accepted");
+
+  {
+    std::ofstream out(filename.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+    out << "TGMASK02 truncated";
+  }
+  if (MaskCache::read(filename, key, result))
+    TEST_FAILED("Truncated mask file should not be accepted");
+
+  std::remove(filename.c_str());
+
+  if (MaskCache::read(filename, key, result))
+    TEST_FAILED("Missing mask file should not be accepted");
+
+  TEST_PASSED();
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Test that a cached mask is not created again
+ */
+// ----------------------------------------------------------------------
+
+void find_or_create()
+{
+  NFmiStereographicArea area(NFmiPoint(19, 59), NFmiPoint(33, 71), 25);
+  NFmiGrid grid(&area, 30, 52);
+
+  const MaskCache::Key key = MaskCache::Key("test").add(grid).add(1.0);
+  const string filename = cachedir + "/" + key.name();
+  std::remove(filename.c_str());
+
+  int calls = 0;
+  auto create = [&]()
+  {
+    ++calls;
+    return make_mask(grid);
+  };
+
+  Settings::set("textgen::mask::cachedir", "");
+  MaskCache::find_or_create(key, grid, create);
+  MaskCache::find_or_create(key, grid, create);
+  if (calls != 2)
+    TEST_FAILED("Masks should not be cached when textgen::mask::cachedir is not set");
+
+  calls = 0;
+  Settings::set("textgen::mask::cachedir", cachedir);
+  const GridMask mask1 = MaskCache::find_or_create(key, grid, create);
+  const GridMask mask2 = MaskCache::find_or_create(key, grid, create);
+  if (calls != 1)
+    TEST_FAILED("Mask should be created once, not " + Convert(calls) + " times");
+  if (!same(mask1, make_mask(grid)) || !same(mask2, mask1))
+    TEST_FAILED("Cached mask differs from the created one");
+
+  Settings::set("textgen::mask::cachedir", "");
+  std::remove(filename.c_str());
+
+  TEST_PASSED();
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Test that threads writing the same mask do not corrupt it
+ */
+// ----------------------------------------------------------------------
+
+void concurrent_write()
+{
+  NFmiStereographicArea area(NFmiPoint(19, 59), NFmiPoint(33, 71), 25);
+  NFmiGrid grid(&area, 30, 52);
+
+  const MaskCache::Key key = MaskCache::Key("test").add(grid).add(2.0);
+  const string filename = cachedir + "/" + key.name();
+  const GridMask mask = make_mask(grid);
+
+  vector<std::thread> threads;
+  for (int i = 0; i < 8; i++)
+    threads.emplace_back(
+        [&]()
+        {
+          for (int j = 0; j < 20; j++)
+            MaskCache::write(filename, key, mask);
+        });
+  for (auto& thread : threads)
+    thread.join();
+
+  GridMask result(grid);
+  if (!MaskCache::read(filename, key, result))
+    TEST_FAILED("Failed to read back " + filename);
+  if (!same(result, mask))
+    TEST_FAILED("Mask written by several threads differs from the one written");
+
+  std::remove(filename.c_str());
+
+  TEST_PASSED();
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief The actual test driver
+ */
+// ----------------------------------------------------------------------
+
+class tests : public tframe::tests
+{
+  //! Overridden message separator
+  virtual const char* error_message_prefix() const { return "\n\t"; }
+  //! Main test suite
+  void test(void)
+  {
+    TEST(key);
+    TEST(readwrite);
+    TEST(find_or_create);
+    TEST(concurrent_write);
+  }
+
+};  // class tests
+
+}  // namespace MaskCacheTest
+
+int main(void)
+{
+  NFmiSettings::Init();
+  Settings::set(NFmiSettings::ToString());
+
+  cout << endl << "MaskCache tests" << endl << "===============" << endl;
+
+  MaskCacheTest::tests t;
+  return t.run();
+}
@@ -0,0 +1,154 @@
+#include "SubMaskExtractor.h"
+#include <calculator/WeatherArea.h>
+#include <regression/tframe.h>
+
+#include <newbase/NFmiGrid.h>
+#include <newbase/NFmiIndexMask.h>
+#include <newbase/NFmiSettings.h>
+#include <newbase/NFmiStereographicArea.h>
+#include <newbase/NFmiStringTools.h>
+#include <newbase/NFmiSvgTools.h>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace TextGen;
+
+namespace MaskDirectionTest
+{
+// ----------------------------------------------------------------------
+/*!
+ * \brief Reference implementation testing every grid point
+ */
+// ----------------------------------------------------------------------
+
+NFmiIndexMask reference_mask(const NFmiGrid& theGrid,
+                             const WeatherArea& theArea,
+                             AreaTools::direction_id theDirectionId)
+{
+  NFmiIndexMask mask;
+
+  const NFmiSvgPath& svgPath = theArea.path();
+
+  double xmin, ymin, xmax, ymax;
+  NFmiSvgTools::BoundingBox(svgPath, xmin, ymin, xmax, ymax);
+  const double lat = ymin + (ymax - ymin) / 2.0;
+  const double lon = xmin + (xmax - xmin) / 2.0;
+
+  const unsigned long n = theGrid.XNumber() * theGrid.YNumber();
+
+  for (unsigned long idx = 0; idx < n; idx++)
+  {
+    const NFmiPoint p = theGrid.LatLon(idx);
+    if (!NFmiSvgTools::IsInside(svgPath, p))
+      continue;
+
+    bool ok = false;
+    switch (theDirectionId)
+    {
+      case AreaTools::NORTH:
+        ok = (p.Y() >= lat);
+        break;
+      case AreaTools::SOUTH:
+        ok = (p.Y() < lat);
+        break;
+      case AreaTools::EAST:
+        ok = (p.X() >= lon);
+        break;
+      case AreaTools::WEST:
+        ok = (p.X() < lon);
+        break;
+      default:
+        break;
+    }
+    if (ok)
+      mask.insert(idx);
+  }
+  return mask;
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Test MaskDirection against the reference implementation
+ *
+ * The timings of both implementations are printed for each map.
+ */
+// ----------------------------------------------------------------------
+
+void mask_direction()
+{
+  using NFmiStringTools::Convert;
+  using Clock = std::chrono::steady_clock;
+
+  // Roughly 2.5 km resolution over Finland
+
+  NFmiStereographicArea area(NFmiPoint(19, 59), NFmiPoint(33, 71), 25);
+  NFmiGrid grid(&area, 300, 520);
+
+  const vector<string> maps{"maps/uusimaa.svg", "maps/ahvenanmaa.svg", "maps/pohjois-lappi.svg"};
+  const vector<AreaTools::direction_id> directions{
+      AreaTools::NORTH, AreaTools::SOUTH, AreaTools::EAST, AreaTools::WEST};
+
+  for (const auto& mapfile : maps)
+  {
+    const WeatherArea weatherArea(mapfile);
+
+    std::chrono::duration<double> reference_time(0);
+    std::chrono::duration<double> scanline_time(0);
+
+    for (const auto direction : directions)
+    {
+      auto t1 = Clock::now();
+      const NFmiIndexMask expected = reference_mask(grid, weatherArea, direction);
+      auto t2 = Clock::now();
+      const NFmiIndexMask result = MaskDirection(grid, weatherArea, direction);
+      auto t3 = Clock::now();
+
+      reference_time += t2 - t1;
+      scanline_time += t3 - t2;
+
+      if (result.size() != expected.size())
+        TEST_FAILED("Mask size for " + mapfile + " should be " + Convert(expected.size()) +
+                    ", not " + Convert(result.size()));
+
+      if (!std::equal(result.begin(), result.end(), expected.begin()))
+        TEST_FAILED("Mask for " + mapfile + " differs from the reference mask");
+    }
+
+    cout << "\t" << mapfile << ": reference " << reference_time.count() << " s, scanline "
+         << scanline_time.count() << " s" << endl;
+  }
+
+  TEST_PASSED();
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief The actual test driver
+ */
+// ----------------------------------------------------------------------
+
+class tests : public tframe::tests
+{
+  //! Overridden message separator
+  virtual const char* error_message_prefix() const { return "\n\t"; }
+  //! Main test suite
+  void test(void) { TEST(mask_direction); }
+
+};  // class tests
+
+}  // namespace MaskDirectionTest
+
+int main(void)
+{
+  NFmiSettings::Init();
+
+  cout << endl << "MaskDirection tests" << endl << "===================" << endl;
+
+  MaskDirectionTest::tests t;
+  return t.run();
+}
@@ -0,0 +1,159 @@
+#include <regression/tframe.h>
+
+#include "MaskStorage.h"
+#include <calculator/WeatherArea.h>
+
+#include <newbase/NFmiIndexMask.h>
+#include <newbase/NFmiSettings.h>
+#include <newbase/NFmiStringTools.h>
+
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace TextGen;
+
+namespace MaskStorageTest
+{
+using NFmiStringTools::Convert;
+using mask_type = MaskStorage::mask_type;
+
+mask_type make_mask(unsigned long theSize)
+{
+  auto mask = std::make_shared<NFmiIndexMask>();
+  for (unsigned long i = 0; i < theSize; i++)
+    mask->insert(i);
+  return mask;
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Test that the fingerprint depends on the area geometry
+ */
+// ----------------------------------------------------------------------
+
+void fingerprint()
+{
+  const WeatherArea uusimaa("data/uusimaa.svg");
+  const WeatherArea uusimaa2("data/uusimaa.svg");
+  const WeatherArea uusimaa15("data/uusimaa.svg:15");
+  const WeatherArea ahvenanmaa("data/ahvenanmaa.svg");
+  WeatherArea inland("data/uusimaa.svg");
+  inland.type(WeatherArea::Inland);
+
+  const auto hash = MaskStorage::fingerprint(uusimaa);
+
+  if (hash != MaskStorage::fingerprint(uusimaa2))
+    TEST_FAILED("Identical areas should have equal fingerprints");
+  if (hash == MaskStorage::fingerprint(uusimaa15))
+    TEST_FAILED("The radius should change the fingerprint");
+  if (hash == MaskStorage::fingerprint(ahvenanmaa))
+    TEST_FAILED("The path should change the fingerprint");
+  if (hash == MaskStorage::fingerprint(inland))
+    TEST_FAILED("The type should change the fingerprint");
+
+  TEST_PASSED();
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Test finding and inserting masks
+ */
+// ----------------------------------------------------------------------
+
+void find_insert()
+{
+  const WeatherArea uusimaa("data/uusimaa.svg");
+  const WeatherArea uusimaa15("data/uusimaa.svg:15");
+
+  MaskStorage storage;
+
+  const MaskStorage::Key key(1, uusimaa);
+  if (storage.find(key))
+    TEST_FAILED("Empty storage should not contain any masks");
+
+  const mask_type mask1 = make_mask(5);
+  if (storage.insert(key, mask1) != mask1)
+    TEST_FAILED("Inserting a new mask should return the mask itself");
+
+  if (storage.find(MaskStorage::Key(1, WeatherArea("data/uusimaa.svg"))) != mask1)
+    TEST_FAILED("Mask should be found with a key for an identical area");
+  if (storage.find(MaskStorage::Key(2, uusimaa)))
+    TEST_FAILED("Mask should not be found for a different data ID");
+  if (storage.find(MaskStorage::Key(1, uusimaa15)))
+    TEST_FAILED("Mask should not be found for a different radius");
+
+  if (storage.insert(key, make_mask(6)) != mask1)
+    TEST_FAILED("Inserting the same key again should return the first mask");
+  if (storage.size() != 1)
+    TEST_FAILED("Storage size should be 1, not " + Convert(storage.size()));
+
+  TEST_PASSED();
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Test a storage with many areas
+ */
+// ----------------------------------------------------------------------
+
+void many_areas()
+{
+  const unsigned int n = 1000;
+
+  MaskStorage storage;
+  vector<mask_type> masks;
+
+  for (unsigned int i = 0; i < n; i++)
+  {
+    const WeatherArea area(NFmiPoint(20 + i * 0.01, 60), Convert(i), 10);
+    masks.push_back(make_mask(i % 10));
+    storage.insert(MaskStorage::Key(1, area), masks.back());
+  }
+
+  if (storage.size() != n)
+    TEST_FAILED("Storage size should be " + Convert(n) + ", not " + Convert(storage.size()));
+
+  for (unsigned int i = 0; i < n; i++)
+  {
+    const WeatherArea area(NFmiPoint(20 + i * 0.01, 60), Convert(i), 10);
+    if (storage.find(MaskStorage::Key(1, area)) != masks[i])
+      TEST_FAILED("Wrong mask found for area " + Convert(i));
+  }
+
+  TEST_PASSED();
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief The actual test driver
+ */
+// ----------------------------------------------------------------------
+
+class tests : public tframe::tests
+{
+  //! Overridden message separator
+  virtual const char* error_message_prefix() const { return "\n\t"; }
+  //! Main test suite
+  void test(void)
+  {
+    TEST(fingerprint);
+    TEST(find_insert);
+    TEST(many_areas);
+  }
+
+};  // class tests
+
+}  // namespace MaskStorageTest
+
+int main(void)
+{
+  NFmiSettings::Init();
+
+  cout << endl << "MaskStorage tests" << endl << "=================" << endl;
+
+  MaskStorageTest::tests t;
+  return t.run();
+}
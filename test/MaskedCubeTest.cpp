@@ -0,0 +1,143 @@
+#include <regression/tframe.h>
+
+#include "MaskedCube.h"
+#include <calculator/Settings.h>
+
+#include <newbase/NFmiFastQueryInfo.h>
+#include <newbase/NFmiIndexMask.h>
+#include <newbase/NFmiQueryData.h>
+#include <newbase/NFmiSettings.h>
+#include <newbase/NFmiStringTools.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+
+using namespace std;
+using namespace TextGen;
+
+namespace MaskedCubeTest
+{
+const string datafile = "data/skandinavia_pinta.sqd";
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Test that the cube holds the same values as the query data
+ */
+// ----------------------------------------------------------------------
+
+void values()
+{
+  using NFmiStringTools::Convert;
+
+  std::shared_ptr<NFmiQueryData> qd(new NFmiQueryData(datafile));
+  NFmiFastQueryInfo qi(qd.get());
+
+  if (!qi.Param(kFmiTemperature))
+    TEST_FAILED("Temperature is not available in " + datafile);
+
+  NFmiIndexMask mask;
+  for (unsigned long idx = 0; idx < qi.SizeLocations(); idx += 7)
+    mask.insert(idx);
+
+  const unsigned long startindex = 1;
+  const unsigned long endindex = std::min(6UL, qi.SizeTimes());
+
+  MaskedCube cube(qi, mask, startindex, endindex);
+
+  if (cube.points() != mask.size())
+    TEST_FAILED("Cube should have " + Convert(mask.size()) + " points, not " +
+                Convert(cube.points()));
+  if (cube.times() != endindex - startindex)
+    TEST_FAILED("Cube should have " + Convert(endindex - startindex) + " times, not " +
+                Convert(cube.times()));
+
+  unsigned long i = 0;
+  for (unsigned long idx : mask)
+  {
+    if (cube.indexes()[i] != idx)
+      TEST_FAILED("Point " + Convert(i) + " should be grid point " + Convert(idx));
+
+    for (unsigned long t = 0; t < cube.times(); t++)
+    {
+      const float expected =
+          qi.GetFloatValue(qi.Index(qi.ParamIndex(), idx, qi.LevelIndex(), startindex + t));
+      if (cube.value(t, i) != expected)
+        TEST_FAILED("Value at point " + Convert(idx) + " time " + Convert(t) + " should be " +
+                    Convert(expected) + ", not " + Convert(cube.value(t, i)));
+    }
+    ++i;
+  }
+
+  TEST_PASSED();
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Test the layout of the cube
+ */
+// ----------------------------------------------------------------------
+
+void layout()
+{
+  using NFmiStringTools::Convert;
+
+  std::shared_ptr<NFmiQueryData> qd(new NFmiQueryData(datafile));
+  NFmiFastQueryInfo qi(qd.get());
+  qi.Param(kFmiTemperature);
+
+  const vector<unsigned long> indexes{3, 4, 5};
+  MaskedCube cube(qi, indexes, 0, 2);
+
+  if (cube.stride() != MaskedCube::alignment / sizeof(float))
+    TEST_FAILED("Stride of 3 points should be one alignment unit, not " + Convert(cube.stride()));
+
+  for (unsigned long t = 0; t < cube.times(); t++)
+  {
+    if (reinterpret_cast<std::uintptr_t>(cube.row(t)) % MaskedCube::alignment != 0)
+      TEST_FAILED("Time step " + Convert(t) + " is not aligned");
+    for (unsigned long i = cube.points(); i < cube.stride(); i++)
+      if (cube.row(t)[i] != kFloatMissing)
+        TEST_FAILED("Padding after the last point should be missing");
+  }
+
+  MaskedCube empty(qi, indexes, 2, 2);
+  if (!empty.empty() || empty.times() != 0)
+    TEST_FAILED("Cube of an empty period should be empty");
+
+  TEST_PASSED();
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief The actual test driver
+ */
+// ----------------------------------------------------------------------
+
+class tests : public tframe::tests
+{
+  //! Overridden message separator
+  virtual const char* error_message_prefix() const { return "\n\t"; }
+  //! Main test suite
+  void test(void)
+  {
+    TEST(values);
+    TEST(layout);
+  }
+
+};  // class tests
+
+}  // namespace MaskedCubeTest
+
+int main(void)
+{
+  NFmiSettings::Init();
+  Settings::set(NFmiSettings::ToString());
+
+  cout << endl << "MaskedCube tests" << endl << "================" << endl;
+
+  MaskedCubeTest::tests t;
+  return t.run();
+}
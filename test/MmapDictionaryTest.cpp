@@ -0,0 +1,224 @@
+#include "MmapDictionary.h"
+#include "PoDictionary.h"
+#include <calculator/Settings.h>
+#include <macgyver/Exception.h>
+#include <newbase/NFmiSettings.h>
+#include <regression/tframe.h>
+
+#include <boost/locale.hpp>
+
+#include <cstdio>
+#include <iostream>
+#include <map>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace std;
+
+namespace MmapDictionaryTest
+{
+// Compiled dictionaries are written here, see main()
+const string dictdir = "/tmp/textgen-mmapdictionary-test-" + to_string(getpid());
+const string podir = "../po";
+
+//! Compile the given language into the test directory
+void compile_language(const string& theLanguage)
+{
+  map<string, string> data;
+  TextGen::PoDictionary::read(podir + "/" + theLanguage + ".po", data);
+  TextGen::MmapDictionary::compile(data, dictdir + "/" + theLanguage + ".dict");
+}
+
+//! Test init() method
+void init(void)
+{
+  using namespace TextGen;
+  MmapDictionary dict;
+
+  dict.init("fi");
+  dict.init("en");
+
+  try
+  {
+    dict.init("xx_nonexistent");
+    TEST_FAILED("init('xx_nonexistent') should have failed");
+  }
+  catch (const Fmi::Exception&)
+  {
+  }
+
+  if (!dict.empty())
+    TEST_FAILED("Failed init() should leave the dictionary empty");
+
+  TEST_PASSED();
+}
+
+//! Test size(), empty() and language()
+void size(void)
+{
+  using namespace TextGen;
+  MmapDictionary dict;
+
+  if (!dict.empty() || dict.size() != 0 || !dict.language().empty())
+    TEST_FAILED("Dictionary should be empty before init()");
+
+  map<string, string> data;
+  PoDictionary::read(podir + "/fi.po", data);
+
+  dict.init("fi");
+  if (dict.size() != data.size())
+    TEST_FAILED("size() should be " + to_string(data.size()) + ", not " + to_string(dict.size()));
+  if (dict.language() != "fi")
+    TEST_FAILED("language should match init argument");
+
+  TEST_PASSED();
+}
+
+//! Test contains() and find() methods
+void find(void)
+{
+  using namespace TextGen;
+  MmapDictionary dict;
+
+  try
+  {
+    dict.find("sama");
+    TEST_FAILED("find() should throw before init()");
+  }
+  catch (const Fmi::Exception&)
+  {
+  }
+
+  dict.init("fi");
+  if (dict.contains("foobar"))
+    TEST_FAILED("contains(foobar) should have failed");
+  if (!dict.contains("sama"))
+    TEST_FAILED("contains(sama) should have succeeded");
+  if (dict.find("sama") != "sama")
+    TEST_FAILED("find(sama) should have returned sama");
+
+  try
+  {
+    dict.find("foobar");
+    TEST_FAILED("find(foobar) should have thrown");
+  }
+  catch (const Fmi::Exception&)
+  {
+  }
+
+  dict.init("en");
+  if (dict.find("sama") != "the same")
+    TEST_FAILED("find(sama) should have returned 'the same'");
+
+  dict.changeLanguage("fi");
+  if (dict.find("sama") != "sama")
+    TEST_FAILED("find(sama) should have returned sama after changeLanguage(fi)");
+
+  TEST_PASSED();
+}
+
+//! Test insert
+void insert(void)
+{
+  using namespace TextGen;
+  MmapDictionary dict;
+  dict.init("fi");
+
+  try
+  {
+    dict.insert("foo", "bar");
+    TEST_FAILED("insert(foo,bar) should have thrown");
+  }
+  catch (const Fmi::Exception&)
+  {
+  }
+
+  TEST_PASSED();
+}
+
+//! Verify every entry against PoDictionary
+void parity_with_po(void)
+{
+  using namespace TextGen;
+
+  for (const string language : {"fi", "en"})
+  {
+    map<string, string> data;
+    PoDictionary::read(podir + "/" + language + ".po", data);
+
+    MmapDictionary dict;
+    dict.init(language);
+
+    for (const auto& item : data)
+      if (dict.find(item.first) != item.second)
+        TEST_FAILED(language + ": " + item.first + " should map to '" + item.second + "'");
+  }
+
+  TEST_PASSED();
+}
+
+//! Test that corrupted images are rejected
+void corrupted(void)
+{
+  using namespace TextGen;
+
+  FILE* fp = fopen((dictdir + "/xx.dict").c_str(), "w");
+  fputs("TGDICT01 but not really", fp);
+  fclose(fp);
+
+  MmapDictionary dict;
+  try
+  {
+    dict.init("xx");
+    TEST_FAILED("init(xx) should fail for a corrupted image");
+  }
+  catch (const Fmi::Exception&)
+  {
+  }
+
+  TEST_PASSED();
+}
+
+//! The actual test driver
+class tests : public tframe::tests
+{
+  virtual const char* error_message_prefix() const { return "\n\t"; }
+  void test(void)
+  {
+    TEST(init);
+    TEST(size);
+    TEST(find);
+    TEST(insert);
+    TEST(parity_with_po);
+    TEST(corrupted);
+  }
+
+};  // class tests
+
+}  // namespace MmapDictionaryTest
+
+int main(void)
+{
+  boost::locale::generator generator;
+  std::locale::global(generator(""));
+
+  NFmiSettings::Init();
+  Settings::set(NFmiSettings::ToString());
+
+  using MmapDictionaryTest::dictdir;
+  mkdir(dictdir.c_str(), 0755);
+  MmapDictionaryTest::compile_language("fi");
+  MmapDictionaryTest::compile_language("en");
+  Settings::set("textgen::mmapdictionaries", dictdir);
+
+  cout << endl << "MmapDictionary tester" << endl << "=====================" << endl;
+  MmapDictionaryTest::tests t;
+  const int errors = t.run();
+
+  for (const string name : {"fi.dict", "en.dict", "xx.dict"})
+    remove((dictdir + "/" + name).c_str());
+  rmdir(dictdir.c_str());
+
+  return errors;
+}
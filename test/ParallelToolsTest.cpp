@@ -0,0 +1,292 @@
+#include "AnalysisCache.h"
+#include "MessageLogger.h"
+#include "ParallelTools.h"
+#include <calculator/Settings.h>
+#include <regression/tframe.h>
+
+#include <newbase/NFmiSettings.h>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace TextGen;
+
+namespace ParallelToolsTest
+{
+// ----------------------------------------------------------------------
+/*!
+ * \brief Test ParallelTools::threads
+ */
+// ----------------------------------------------------------------------
+
+void threads()
+{
+  if (ParallelTools::threads("parallel::undefined") != 1)
+    TEST_FAILED("Default number of threads should be 1");
+
+  Settings::set("parallel::threads", "4");
+  if (ParallelTools::threads("parallel::threads") != 4)
+    TEST_FAILED("Failed to read the number of threads");
+
+  Settings::set("parallel::threads", "0");
+  if (ParallelTools::threads("parallel::threads") < 1)
+    TEST_FAILED("Value 0 should give at least one thread");
+
+  TEST_PASSED();
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Test ParallelTools::run
+ */
+// ----------------------------------------------------------------------
+
+void run()
+{
+  for (unsigned int nthreads : {1, 4})
+  {
+    AnalysisCache cache;
+    AnalysisCache::Scope scope(&cache);
+
+    const unsigned int ntasks = 100;
+    vector<unsigned int> results(ntasks, 0);
+    vector<char> cached(ntasks, 0);
+    vector<char> nested(ntasks, 0);
+
+    vector<ParallelTools::task_type> tasks;
+    for (unsigned int i = 0; i < ntasks; i++)
+      tasks.push_back(
+          [i, &results, &cached, &nested, &cache]()
+          {
+            results[i] = i * i;
+            cached[i] = (AnalysisCache::current() == &cache);
+
+            // nested tasks are run in the calling thread
+            vector<ParallelTools::task_type> subtasks{[i, &nested]() { nested[i] = true; }};
+            ParallelTools::run(subtasks, 4);
+          });
+
+    ParallelTools::run(tasks, nthreads);
+
+    for (unsigned int i = 0; i < ntasks; i++)
+    {
+      if (results[i] != i * i)
+        TEST_FAILED("Task " + to_string(i) + " was not run");
+      if (!cached[i])
+        TEST_FAILED("The analysis cache was not active in task " + to_string(i));
+      if (!nested[i])
+        TEST_FAILED("Nested task " + to_string(i) + " was not run");
+    }
+  }
+
+  TEST_PASSED();
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Test ParallelTools::run error handling
+ */
+// ----------------------------------------------------------------------
+
+void errors()
+{
+  vector<ParallelTools::task_type> tasks;
+  for (unsigned int i = 0; i < 10; i++)
+    tasks.push_back(
+        [i]()
+        {
+          if (i == 5)
+            throw runtime_error("task failed");
+        });
+
+  try
+  {
+    ParallelTools::run(tasks, 4);
+    TEST_FAILED("Failure in a task should be rethrown");
+  }
+  catch (...)
+  {
+  }
+
+  if (ParallelTools::inWorker())
+    TEST_FAILED("Calling thread should not remain a worker after a failure");
+
+  TEST_PASSED();
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Test that messages are logged in task order
+ */
+// ----------------------------------------------------------------------
+
+void logs()
+{
+  MessageLogger::open();
+
+  vector<ParallelTools::task_type> tasks;
+  for (unsigned int i = 0; i < 20; i++)
+    tasks.push_back(
+        [i]()
+        {
+          MessageLogger log("task");
+          log << to_string(i) << '\n';
+        });
+
+  ParallelTools::run(tasks, 4);
+
+  string expected;
+  for (unsigned int i = 0; i < 20; i++)
+    expected += "[Entering task]\n  " + to_string(i) + "\n[Leaving task]\n";
+
+  const string result = MessageLogger::str();
+  MessageLogger::open("");
+
+  if (result != expected)
+    TEST_FAILED("Messages were not logged in task order:\n" + result);
+
+  TEST_PASSED();
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Test that the tasks see the settings of the calling thread
+ */
+// ----------------------------------------------------------------------
+
+void settings()
+{
+  const unsigned int ntasks = 20;
+  vector<int> values(ntasks, 0);
+  vector<std::thread::id> ids(ntasks);
+
+  vector<ParallelTools::task_type> tasks;
+  for (unsigned int i = 0; i < ntasks; i++)
+    tasks.push_back(
+        [i, &values, &ids]()
+        {
+          // give the other threads time to take some of the tasks
+          std::this_thread::sleep_for(std::chrono::milliseconds(1));
+          values[i] = Settings::optional_int("parallel::value", 0);
+          ids[i] = std::this_thread::get_id();
+        });
+
+  {
+    ParallelTools::SettingsScope scope(NFmiSettings::ToString() + "parallel::value = 42\n");
+    ParallelTools::run(tasks, 4);
+  }
+
+  for (unsigned int i = 0; i < ntasks; i++)
+    if (values[i] != 42)
+      TEST_FAILED("Task " + to_string(i) + " did not see the settings of the calling thread");
+
+  // debugging outputs modify the settings, hence the tasks must be run in the calling thread
+
+  Settings::set("qdtext::append_graph", "true");
+  ParallelTools::run(tasks, 4);
+  Settings::set("qdtext::append_graph", "false");
+
+  for (unsigned int i = 0; i < ntasks; i++)
+    if (ids[i] != std::this_thread::get_id())
+      TEST_FAILED("Task " + to_string(i) + " was not run serially with qdtext::append_graph");
+
+  TEST_PASSED();
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Test that repeated calls reuse the same worker threads
+ */
+// ----------------------------------------------------------------------
+
+thread_local bool tVisited = false;
+
+void pool()
+{
+  const unsigned int ntasks = 20;
+  vector<std::thread::id> first(ntasks);
+  vector<std::thread::id> second(ntasks);
+  vector<bool> visited(ntasks, false);
+
+  vector<ParallelTools::task_type> tasks1;
+  vector<ParallelTools::task_type> tasks2;
+  for (unsigned int i = 0; i < ntasks; i++)
+  {
+    tasks1.push_back(
+        [i, &first]()
+        {
+          std::this_thread::sleep_for(std::chrono::milliseconds(1));
+          first[i] = std::this_thread::get_id();
+          tVisited = true;
+        });
+    tasks2.push_back(
+        [i, &second, &visited]()
+        {
+          std::this_thread::sleep_for(std::chrono::milliseconds(1));
+          second[i] = std::this_thread::get_id();
+          visited[i] = tVisited;
+        });
+  }
+
+  ParallelTools::run(tasks1, 4);
+  ParallelTools::run(tasks2, 4);
+
+  unsigned int reused = 0;
+  for (unsigned int i = 0; i < ntasks; i++)
+  {
+    if (second[i] == std::this_thread::get_id())
+      continue;
+    if (std::find(first.begin(), first.end(), second[i]) == first.end())
+      continue;
+    if (!visited[i])
+      TEST_FAILED("Task " + to_string(i) + " ran in a new thread with a reused id");
+    ++reused;
+  }
+
+  if (reused == 0)
+    TEST_FAILED("The second call did not reuse any worker thread");
+
+  TEST_PASSED();
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief The actual test driver
+ */
+// ----------------------------------------------------------------------
+
+class tests : public tframe::tests
+{
+  //! Overridden message separator
+  virtual const char* error_message_prefix() const { return "\n\t"; }
+  //! Main test suite
+  void test(void)
+  {
+    TEST(threads);
+    TEST(run);
+    TEST(errors);
+    TEST(logs);
+    TEST(settings);
+    TEST(pool);
+  }
+
+};  // class tests
+
+}  // namespace ParallelToolsTest
+
+int main(void)
+{
+  NFmiSettings::Init();
+  ParallelTools::SettingsScope settings(NFmiSettings::ToString());
+
+  cout << endl << "ParallelTools tests" << endl << "===================" << endl;
+
+  ParallelToolsTest::tests t;
+  return t.run();
+}
@@ -1,11 +1,13 @@
 #include "DictionaryFactory.h"
 #include "Phrase.h"
 #include <calculator/Settings.h>
+#include <macgyver/Exception.h>
 #include <regression/tframe.h>
 
 #include <newbase/NFmiSettings.h>
 
 #include <iostream>
+#include <memory>
 #include <stdexcept>
 #include <string>
 
@@ -56,6 +58,75 @@ void realize(void)
   TEST_PASSED();
 }
 
+//! Test phrase interning
+void interning(void)
+{
+  using namespace TextGen;
+
+  Phrase s1("lampotila");
+  Phrase s2(std::string("lampotila"));
+  Phrase s3("sama");
+
+  if (s1.id() != s2.id())
+    TEST_FAILED("Identical words should have the same id");
+  if (s1.id() == s3.id())
+    TEST_FAILED("Different words should have different ids");
+  if (PhraseTable::word(s3.id()) != "sama")
+    TEST_FAILED("PhraseTable::word() should return the interned word");
+
+  // Dictionaries without a phrase index resolve the id via the word
+  std::shared_ptr<Dictionary> basic(DictionaryFactory::create("basic"));
+  basic->insert("sama", "the same");
+  if (s3.realize(*basic) != "the same")
+    TEST_FAILED("realization of sama with a basic dictionary failed");
+
+  std::shared_ptr<Dictionary> english(DictionaryFactory::create("multipo"));
+  english->init("en");
+  try
+  {
+    Phrase("xyzzy not a key").realize(*english);
+    TEST_FAILED("realization of an unknown key should fail");
+  }
+  catch (const Fmi::Exception&)
+  {
+  }
+
+  TEST_PASSED();
+}
+
+//! Test that the phrase table stops growing at its capacity
+void capacity(void)
+{
+  using namespace TextGen;
+
+  Phrase known("lampotila");
+  std::shared_ptr<Dictionary> english(DictionaryFactory::create("multipo"));
+  english->init("en");
+
+  // Enough distinct words to fill every shard of the table
+  for (std::size_t i = 0; i < 2 * PhraseTable::capacity(); i++)
+    Phrase("capacity test " + std::to_string(i));
+
+  if (PhraseTable::size() > PhraseTable::capacity())
+    TEST_FAILED("The phrase table should not grow beyond its capacity");
+
+  Phrase overflow("capacity test overflow");
+  if (overflow.id() != PhraseTable::noId)
+    TEST_FAILED("A new word should not be interned into a full table");
+
+  std::shared_ptr<Dictionary> basic(DictionaryFactory::create("basic"));
+  basic->insert("capacity test overflow", "overflow");
+  if (overflow.realize(*basic) != "overflow")
+    TEST_FAILED("realization of a word not interned failed");
+
+  if (Phrase("lampotila").id() != known.id())
+    TEST_FAILED("Interned words should keep their ids when the table is full");
+  if (known.realize(*english) != "temperature")
+    TEST_FAILED("realization of lampotila in English failed with a full table");
+
+  TEST_PASSED();
+}
+
 //! The actual test driver
 class tests : public tframe::tests
 {
@@ -66,6 +137,8 @@ class tests : public tframe::tests
   {
     TEST(structors);
     TEST(realize);
+    TEST(interning);
+    TEST(capacity);
   }
 
 };  // class tests
@@ -0,0 +1,135 @@
+#include "RasterMaskTools.h"
+#include <calculator/WeatherArea.h>
+#include <regression/tframe.h>
+
+#include <newbase/NFmiGrid.h>
+#include <newbase/NFmiIndexMask.h>
+#include <newbase/NFmiIndexMaskTools.h>
+#include <newbase/NFmiSettings.h>
+#include <newbase/NFmiStereographicArea.h>
+#include <newbase/NFmiStringTools.h>
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace TextGen;
+
+namespace RasterMaskToolsTest
+{
+using MaskFunction = std::function<NFmiIndexMask(const NFmiGrid&, const NFmiSvgPath&, double)>;
+using RasterFunction = std::function<GridMask(const NFmiGrid&, const NFmiSvgPath&, double)>;
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Compare a raster mask function with NFmiIndexMaskTools
+ *
+ * The timings of both implementations are printed for each map.
+ */
+// ----------------------------------------------------------------------
+
+void compare(const string& theName, MaskFunction theReference, RasterFunction theRaster)
+{
+  using NFmiStringTools::Convert;
+  using Clock = std::chrono::steady_clock;
+
+  // Roughly 2.5 km resolution over Finland
+
+  NFmiStereographicArea area(NFmiPoint(19, 59), NFmiPoint(33, 71), 25);
+  NFmiGrid grid(&area, 300, 520);
+
+  const vector<string> maps{"maps/uusimaa.svg", "maps/ahvenanmaa.svg", "maps/pohjois-lappi.svg"};
+  const vector<double> distances{0, 2, 5, 15, 30};
+
+  for (const auto& mapfile : maps)
+  {
+    const WeatherArea weatherArea(mapfile);
+    const NFmiSvgPath& path = weatherArea.path();
+
+    std::chrono::duration<double> reference_time(0);
+    std::chrono::duration<double> raster_time(0);
+
+    for (const auto distance : distances)
+    {
+      auto t1 = Clock::now();
+      const NFmiIndexMask expected = theReference(grid, path, distance);
+      auto t2 = Clock::now();
+      const NFmiIndexMask result = theRaster(grid, path, distance).indexMask();
+      auto t3 = Clock::now();
+
+      reference_time += t2 - t1;
+      raster_time += t3 - t2;
+
+      const string where = mapfile + " at distance " + Convert(distance);
+
+      if (result.size() != expected.size())
+        TEST_FAILED(theName + " size for " + where + " should be " + Convert(expected.size()) +
+                    ", not " + Convert(result.size()));
+
+      if (!std::equal(result.begin(), result.end(), expected.begin()))
+        TEST_FAILED(theName + " for " + where + " differs from NFmiIndexMaskTools");
+    }
+
+    cout << "\t" << theName << " " << mapfile << ": reference " << reference_time.count()
+         << " s, raster " << raster_time.count() << " s" << endl;
+  }
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Test MaskDistance against NFmiIndexMaskTools
+ */
+// ----------------------------------------------------------------------
+
+void mask_distance()
+{
+  compare("MaskDistance", NFmiIndexMaskTools::MaskDistance, RasterMaskTools::MaskDistance);
+  TEST_PASSED();
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Test MaskExpand against NFmiIndexMaskTools
+ */
+// ----------------------------------------------------------------------
+
+void mask_expand()
+{
+  compare("MaskExpand", NFmiIndexMaskTools::MaskExpand, RasterMaskTools::MaskExpand);
+  TEST_PASSED();
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief The actual test driver
+ */
+// ----------------------------------------------------------------------
+
+class tests : public tframe::tests
+{
+  //! Overridden message separator
+  virtual const char* error_message_prefix() const { return "\n\t"; }
+  //! Main test suite
+  void test(void)
+  {
+    TEST(mask_distance);
+    TEST(mask_expand);
+  }
+
+};  // class tests
+
+}  // namespace RasterMaskToolsTest
+
+int main(void)
+{
+  NFmiSettings::Init();
+
+  cout << endl << "RasterMaskTools tests" << endl << "=====================" << endl;
+
+  RasterMaskToolsTest::tests t;
+  return t.run();
+}
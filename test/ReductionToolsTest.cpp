@@ -0,0 +1,293 @@
+#include <regression/tframe.h>
+
+#include "ReductionTools.h"
+#include "ValueAcceptor.h"
+#include <calculator/MaximumCalculator.h>
+#include <calculator/MeanCalculator.h>
+#include <calculator/MinimumCalculator.h>
+#include <calculator/PercentageCalculator.h>
+#include <calculator/RangeAcceptor.h>
+#include <calculator/Settings.h>
+#include <calculator/SumCalculator.h>
+
+#include <newbase/NFmiGlobals.h>
+#include <newbase/NFmiSettings.h>
+#include <newbase/NFmiStringTools.h>
+
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace TextGen;
+
+namespace ReductionToolsTest
+{
+using NFmiStringTools::Convert;
+
+const vector<ReductionTools::InstructionSet> sets{ReductionTools::InstructionSet::Scalar,
+                                                  ReductionTools::InstructionSet::SSE4,
+                                                  ReductionTools::InstructionSet::AVX2};
+
+const vector<string> setnames{"scalar", "sse4", "avx2"};
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Random precipitation-like data with some missing values
+ */
+// ----------------------------------------------------------------------
+
+vector<float> make_data(size_t theSize, unsigned int theSeed)
+{
+  std::mt19937 gen(theSeed);
+  std::uniform_real_distribution<float> amount(0, 10);
+  std::uniform_int_distribution<int> kind(0, 9);
+
+  vector<float> values(theSize);
+  for (auto& value : values)
+  {
+    const int k = kind(gen);
+    if (k == 0)
+      value = kFloatMissing;
+    else if (k < 4)
+      value = 0;
+    else
+      value = amount(gen);
+  }
+  return values;
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Feed the values to a calculator
+ */
+// ----------------------------------------------------------------------
+
+float calculate(Calculator& theCalculator, const vector<float>& theValues, size_t theSize)
+{
+  theCalculator.reset();
+  for (size_t i = 0; i < theSize; i++)
+    theCalculator(theValues[i]);
+  return theCalculator();
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Test for equality within the precision of float sums
+ */
+// ----------------------------------------------------------------------
+
+bool close(float theResult, float theExpected)
+{
+  if (theResult == theExpected)
+    return true;
+  if (theResult == kFloatMissing || theExpected == kFloatMissing)
+    return false;
+  return std::abs(theResult - theExpected) <= 1e-6 * std::max(1.0f, std::abs(theExpected));
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Test the kernels against the calculators
+ *
+ * Minimum, maximum and percentages must be identical, sums and means
+ * equal to float precision. All lengths up to a few vector widths are
+ * tested to cover the tails of the vector kernels.
+ */
+// ----------------------------------------------------------------------
+
+void calculators()
+{
+  const vector<float> values = make_data(1000, 1234);
+
+  MeanCalculator meancalc;
+  MinimumCalculator mincalc;
+  MaximumCalculator maxcalc;
+  SumCalculator sumcalc;
+
+  RangeAcceptor rainlimits;
+  rainlimits.lowerLimit(0.1);
+  PercentageCalculator raincalc;
+  raincalc.condition(rainlimits);
+
+  ValueAcceptor dryfilter;
+  dryfilter.value(0);
+  PercentageCalculator drycalc;
+  drycalc.condition(dryfilter);
+
+  const float maxfloat = std::numeric_limits<float>::max();
+  const ReductionTools::InstructionSet original = ReductionTools::instructionSet();
+
+  for (unsigned int s = 0; s < sets.size(); s++)
+  {
+    if (!ReductionTools::supported(sets[s]))
+      continue;
+    ReductionTools::instructionSet(sets[s]);
+
+    for (size_t n = 0; n <= values.size(); n += (n < 40 ? 1 : 97))
+    {
+      const string where = setnames[s] + " with " + Convert(n) + " values";
+
+      if (!close(ReductionTools::mean(values.data(), n), calculate(meancalc, values, n)))
+        TEST_FAILED("Mean differs for " + where);
+      if (!close(ReductionTools::sum(values.data(), n), calculate(sumcalc, values, n)))
+        TEST_FAILED("Sum differs for " + where);
+      if (ReductionTools::minimum(values.data(), n) != calculate(mincalc, values, n))
+        TEST_FAILED("Minimum differs for " + where);
+      if (ReductionTools::maximum(values.data(), n) != calculate(maxcalc, values, n))
+        TEST_FAILED("Maximum differs for " + where);
+      if (ReductionTools::percentage(values.data(), n, 0.1f, maxfloat) !=
+          calculate(raincalc, values, n))
+        TEST_FAILED("Range percentage differs for " + where);
+      if (ReductionTools::percentage(values.data(), n, 0.0f) != calculate(drycalc, values, n))
+        TEST_FAILED("Value percentage differs for " + where);
+    }
+  }
+
+  ReductionTools::instructionSet(original);
+
+  TEST_PASSED();
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Test that missing values are handled
+ */
+// ----------------------------------------------------------------------
+
+void missing()
+{
+  const vector<float> values(37, kFloatMissing);
+  const ReductionTools::InstructionSet original = ReductionTools::instructionSet();
+
+  for (unsigned int s = 0; s < sets.size(); s++)
+  {
+    if (!ReductionTools::supported(sets[s]))
+      continue;
+    ReductionTools::instructionSet(sets[s]);
+
+    if (ReductionTools::mean(values.data(), values.size()) != kFloatMissing)
+      TEST_FAILED("Mean of missing values should be missing with " + setnames[s]);
+    if (ReductionTools::sum(values.data(), values.size()) != kFloatMissing)
+      TEST_FAILED("Sum of missing values should be missing with " + setnames[s]);
+    if (ReductionTools::minimum(values.data(), values.size()) != kFloatMissing)
+      TEST_FAILED("Minimum of missing values should be missing with " + setnames[s]);
+    if (ReductionTools::maximum(values.data(), values.size()) != kFloatMissing)
+      TEST_FAILED("Maximum of missing values should be missing with " + setnames[s]);
+    if (ReductionTools::percentage(values.data(), values.size(), kFloatMissing) != kFloatMissing)
+      TEST_FAILED("Percentage of missing values should be missing with " + setnames[s]);
+  }
+
+  ReductionTools::instructionSet(original);
+
+  TEST_PASSED();
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Print the timings of each kernel with each instruction set
+ */
+// ----------------------------------------------------------------------
+
+void timings()
+{
+  using Clock = std::chrono::steady_clock;
+
+  // Roughly the mask of a large area over a day
+
+  const vector<float> values = make_data(1 << 16, 4321);
+  const int rounds = 500;
+  const float maxfloat = std::numeric_limits<float>::max();
+
+  const vector<pair<string, std::function<float()> > > kernels{
+      {"sum", [&]() { return ReductionTools::sum(values.data(), values.size()); }},
+      {"mean", [&]() { return ReductionTools::mean(values.data(), values.size()); }},
+      {"minimum", [&]() { return ReductionTools::minimum(values.data(), values.size()); }},
+      {"maximum", [&]() { return ReductionTools::maximum(values.data(), values.size()); }},
+      {"range percentage",
+       [&]() { return ReductionTools::percentage(values.data(), values.size(), 0.1f, maxfloat); }},
+      {"value percentage",
+       [&]() { return ReductionTools::percentage(values.data(), values.size(), 0.0f); }}};
+
+  MeanCalculator meancalc;
+
+  const ReductionTools::InstructionSet original = ReductionTools::instructionSet();
+
+  for (const auto& kernel : kernels)
+  {
+    cout << "\t" << kernel.first << ":";
+
+    for (unsigned int s = 0; s < sets.size(); s++)
+    {
+      if (!ReductionTools::supported(sets[s]))
+        continue;
+      ReductionTools::instructionSet(sets[s]);
+
+      float result = 0;
+      auto t1 = Clock::now();
+      for (int r = 0; r < rounds; r++)
+        result += kernel.second();
+      auto t2 = Clock::now();
+
+      if (std::isnan(result))
+        TEST_FAILED("Kernel " + kernel.first + " returned NaN");
+
+      const std::chrono::duration<double, std::micro> elapsed = t2 - t1;
+      cout << " " << setnames[s] << " " << elapsed.count() / rounds << " us";
+    }
+    cout << endl;
+  }
+
+  auto t1 = Clock::now();
+  float result = 0;
+  for (int r = 0; r < rounds; r++)
+    result += calculate(meancalc, values, values.size());
+  auto t2 = Clock::now();
+  const std::chrono::duration<double, std::micro> elapsed = t2 - t1;
+  cout << "\tMeanCalculator: " << elapsed.count() / rounds << " us" << endl;
+
+  ReductionTools::instructionSet(original);
+
+  if (std::isnan(result))
+    TEST_FAILED("MeanCalculator returned NaN");
+
+  TEST_PASSED();
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief The actual test driver
+ */
+// ----------------------------------------------------------------------
+
+class tests : public tframe::tests
+{
+  //! Overridden message separator
+  virtual const char* error_message_prefix() const { return "\n\t"; }
+  //! Main test suite
+  void test(void)
+  {
+    TEST(calculators);
+    TEST(missing);
+    TEST(timings);
+  }
+
+};  // class tests
+
+}  // namespace ReductionToolsTest
+
+int main(void)
+{
+  NFmiSettings::Init();
+  Settings::set(NFmiSettings::ToString());
+
+  cout << endl << "ReductionTools tests" << endl << "====================" << endl;
+
+  ReductionToolsTest::tests t;
+  return t.run();
+}
@@ -0,0 +1,305 @@
+#include "ShareTools.h"
+#include "ValueAcceptor.h"
+#include <calculator/AnalysisSources.h>
+#include <calculator/GridForecaster.h>
+#include <calculator/RangeAcceptor.h>
+#include <calculator/RegularMaskSource.h>
+#include <calculator/Settings.h>
+#include <calculator/UserWeatherSource.h>
+#include <calculator/WeatherArea.h>
+#include <calculator/WeatherPeriod.h>
+#include <calculator/WeatherResult.h>
+#include <regression/tframe.h>
+
+#include <newbase/NFmiFastQueryInfo.h>
+#include <newbase/NFmiGlobals.h>
+#include <newbase/NFmiQueryData.h>
+#include <newbase/NFmiSettings.h>
+#include <newbase/NFmiStringTools.h>
+
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace TextGen;
+
+namespace ShareToolsTest
+{
+using NFmiStringTools::Convert;
+
+std::shared_ptr<NFmiQueryData> theQD;
+AnalysisSources theSources;
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Analysis sources for the querydata
+ */
+// ----------------------------------------------------------------------
+
+void make_sources()
+{
+  std::shared_ptr<UserWeatherSource> weathersource(new UserWeatherSource());
+  weathersource->insert("data", theQD);
+  theSources.setWeatherSource(weathersource);
+
+  std::shared_ptr<MaskSource> masksource(new RegularMaskSource());
+  theSources.setMaskSource(masksource);
+  theSources.setLandMaskSource(masksource);
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief The period of the given hours counted from the first time of the data
+ */
+// ----------------------------------------------------------------------
+
+WeatherPeriod hours(int theStart, int theEnd)
+{
+  NFmiFastQueryInfo q = NFmiFastQueryInfo(theQD.get());
+  q.First();
+
+  TextGenPosixTime starttime = q.Time();
+  TextGenPosixTime endtime = q.Time();
+  starttime.ChangeByHours(theStart);
+  endtime.ChangeByHours(theEnd);
+  return WeatherPeriod(starttime, endtime);
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief The share of accepted values analyzed separately with GridForecaster
+ */
+// ----------------------------------------------------------------------
+
+WeatherResult grid_share(const WeatherParameter& theParameter,
+                         const WeatherArea& theArea,
+                         const WeatherPeriod& thePeriod,
+                         const Acceptor& theTester)
+{
+  GridForecaster forecaster;
+  return forecaster.analyze("share",
+                            theSources,
+                            theParameter,
+                            Mean,
+                            Percentage,
+                            theArea,
+                            thePeriod,
+                            DefaultAcceptor(),
+                            DefaultAcceptor(),
+                            theTester);
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Require a single pass share to equal the separate analysis
+ *
+ * The single pass sums in double precision, hence the shares may differ
+ * in the last bits.
+ */
+// ----------------------------------------------------------------------
+
+void require_equal(const string& theName,
+                   const WeatherResult& theResult,
+                   const WeatherResult& theExpected)
+{
+  const bool missing = (theResult.value() == kFloatMissing);
+  if (missing != (theExpected.value() == kFloatMissing) ||
+      (!missing && std::abs(theResult.value() - theExpected.value()) > 1e-3))
+    TEST_FAILED(theName + " is " + Convert(theResult.value()) + " instead of " +
+                Convert(theExpected.value()));
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Test ShareTools::distributions against GridForecaster
+ *
+ * The periods before the data give missing shares.
+ */
+// ----------------------------------------------------------------------
+
+void distributions()
+{
+  ShareTools::value_class_vector classes;
+  for (float lo = 0; lo < 20; lo += 2.5)
+    classes.push_back(make_pair(lo, lo + 2.4999f));
+
+  const vector<WeatherParameter> parameters{WindSpeed, MaximumWind, Temperature};
+
+  const WeatherArea uusimaa("maps/uusimaa.svg", "uusimaa");
+  const WeatherArea lappi("maps/pohjois-lappi.svg", "pohjois-lappi");
+  const WeatherArea helsinki("25,60", "helsinki");
+  const TextGenPosixTime start = hours(0, 0).localStartTime();
+
+  for (const WeatherArea* area : {&uusimaa, &lappi, &helsinki})
+    for (const WeatherPeriod& period : {hours(0, 12), hours(3, 3), hours(-6, -1)})
+    {
+      const string when = " of " + Convert(period.localStartTime().DifferenceInHours(start)) + "h";
+      vector<ShareTools::share_distribution> results;
+      ShareTools::distributions(
+          "a::share", theSources, parameters, *area, period, classes, results);
+
+      if (results.size() != parameters.size())
+        TEST_FAILED("Expected " + Convert(parameters.size()) + " distributions, got " +
+                    Convert(results.size()));
+
+      for (unsigned int i = 0; i < parameters.size(); i++)
+      {
+        if (results[i].size() != classes.size())
+          TEST_FAILED("Expected " + Convert(classes.size()) + " classes, got " +
+                      Convert(results[i].size()));
+
+        for (unsigned int c = 0; c < classes.size(); c++)
+        {
+          RangeAcceptor acceptor;
+          acceptor.lowerLimit(classes[c].first);
+          acceptor.upperLimit(classes[c].second);
+
+          const string name = area->name() + " parameter " + Convert(i) + " class " +
+                              Convert(classes[c].first) + when;
+
+          if (results[i][c].first != classes[c].first)
+            TEST_FAILED(name + " has the wrong class limit");
+          require_equal(
+              name, results[i][c].second, grid_share(parameters[i], *area, period, acceptor));
+        }
+      }
+    }
+
+  TEST_PASSED();
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Test ShareTools::categories against GridForecaster
+ *
+ * The categories are given out of order to test that the shares are
+ * returned in the order of the categories.
+ */
+// ----------------------------------------------------------------------
+
+void categories()
+{
+  const vector<float> forms{3, 0, 5, 1, 4, 2};
+  const vector<string> fakes(forms.size(), "a::form");
+
+  const WeatherArea uusimaa("maps/uusimaa.svg", "uusimaa");
+  const WeatherArea lappi("maps/pohjois-lappi.svg", "pohjois-lappi");
+  const WeatherArea helsinki("25,60", "helsinki");
+  const TextGenPosixTime start = hours(0, 0).localStartTime();
+
+  for (const WeatherArea* area : {&uusimaa, &lappi, &helsinki})
+    for (const WeatherPeriod& period : {hours(0, 24), hours(5, 5), hours(-6, -1)})
+    {
+      const string when = " of " + Convert(period.localStartTime().DifferenceInHours(start)) + "h";
+      vector<WeatherResult> results;
+      ShareTools::categories(
+          fakes, theSources, PrecipitationForm, *area, period, forms, results);
+
+      if (results.size() != forms.size())
+        TEST_FAILED("Expected " + Convert(forms.size()) + " categories, got " +
+                    Convert(results.size()));
+
+      for (unsigned int i = 0; i < forms.size(); i++)
+      {
+        ValueAcceptor acceptor;
+        acceptor.value(forms[i]);
+
+        require_equal(area->name() + " form " + Convert(forms[i]) + when,
+                      results[i],
+                      grid_share(PrecipitationForm, *area, period, acceptor));
+      }
+    }
+
+  vector<WeatherResult> results;
+  try
+  {
+    ShareTools::categories(vector<string>{"a::form"},
+                           theSources,
+                           PrecipitationForm,
+                           uusimaa,
+                           hours(0, 1),
+                           forms,
+                           results);
+    TEST_FAILED("Categories without fake variables should throw");
+  }
+  catch (...)
+  {
+  }
+
+  TEST_PASSED();
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Test ShareTools::classIndex
+ */
+// ----------------------------------------------------------------------
+
+void classIndex()
+{
+  ShareTools::value_class_vector classes;
+  classes.push_back(make_pair(0.0f, 0.4999f));
+  classes.push_back(make_pair(0.5f, 1.4999f));
+  classes.push_back(make_pair(1.5f, 2.4999f));
+
+  if (ShareTools::classIndex(classes, -1) != -1)
+    TEST_FAILED("Value below the first class should not be classified");
+  if (ShareTools::classIndex(classes, 0) != 0)
+    TEST_FAILED("Value 0 should be in class 0");
+  if (ShareTools::classIndex(classes, 0.4999f) != 0)
+    TEST_FAILED("Value 0.4999 should be in class 0");
+  if (ShareTools::classIndex(classes, 0.49995f) != -1)
+    TEST_FAILED("Value 0.49995 should not be classified");
+  if (ShareTools::classIndex(classes, 0.5) != 1)
+    TEST_FAILED("Value 0.5 should be in class 1");
+  if (ShareTools::classIndex(classes, 2) != 2)
+    TEST_FAILED("Value 2 should be in class 2");
+  if (ShareTools::classIndex(classes, 2.5) != -1)
+    TEST_FAILED("Value above the last class should not be classified");
+
+  ShareTools::value_class_vector empty;
+  if (ShareTools::classIndex(empty, 1) != -1)
+    TEST_FAILED("Nothing should be classified without classes");
+
+  TEST_PASSED();
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief The actual test driver
+ */
+// ----------------------------------------------------------------------
+
+class tests : public tframe::tests
+{
+  //! Overridden message separator
+  virtual const char* error_message_prefix() const { return "\n\t"; }
+  //! Main test suite
+  void test(void)
+  {
+    TEST(classIndex);
+    TEST(distributions);
+    TEST(categories);
+  }
+
+};  // class tests
+
+}  // namespace ShareToolsTest
+
+int main(void)
+{
+  NFmiSettings::Init();
+  NFmiSettings::Set("textgen::default_forecast", "data");
+  Settings::set(NFmiSettings::ToString());
+
+  cout << endl << "ShareTools tests" << endl << "================" << endl;
+
+  ShareToolsTest::theQD.reset(new NFmiQueryData("data/skandinavia_pinta.sqd"));
+  ShareToolsTest::make_sources();
+
+  ShareToolsTest::tests t;
+  return t.run();
+}
@@ -0,0 +1,320 @@
+#include "CoastMaskSource.h"
+#include "InlandMaskSource.h"
+#include "StatisticsTools.h"
+#include "ValueAcceptor.h"
+#include <calculator/AnalysisSources.h>
+#include <calculator/GridForecaster.h>
+#include <calculator/RangeAcceptor.h>
+#include <calculator/RegularMaskSource.h>
+#include <calculator/Settings.h>
+#include <calculator/UserWeatherSource.h>
+#include <calculator/WeatherArea.h>
+#include <calculator/WeatherPeriod.h>
+#include <calculator/WeatherResult.h>
+#include <regression/tframe.h>
+
+#include <newbase/NFmiFastQueryInfo.h>
+#include <newbase/NFmiQueryData.h>
+#include <newbase/NFmiSettings.h>
+#include <newbase/NFmiStringTools.h>
+
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace TextGen;
+
+namespace StatisticsToolsTest
+{
+using NFmiStringTools::Convert;
+
+std::shared_ptr<NFmiQueryData> theQD;
+AnalysisSources theSources;
+
+const vector<string> fakevars{"a::min", "a::max", "a::mean", "a::median", "a::percentage"};
+const vector<WeatherFunction> functions{Minimum, Maximum, Mean, Median, Percentage};
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Analysis sources for the querydata with a coast
+ */
+// ----------------------------------------------------------------------
+
+void make_sources()
+{
+  std::shared_ptr<UserWeatherSource> weathersource(new UserWeatherSource());
+  weathersource->insert("data", theQD);
+  theSources.setWeatherSource(weathersource);
+
+  std::shared_ptr<MaskSource> masksource(new RegularMaskSource());
+  theSources.setMaskSource(masksource);
+  theSources.setLandMaskSource(masksource);
+
+  const WeatherArea coast("data/rannikko.svg:15");
+  theSources.setCoastMaskSource(std::shared_ptr<MaskSource>(new CoastMaskSource(coast)));
+  theSources.setInlandMaskSource(std::shared_ptr<MaskSource>(new InlandMaskSource(coast)));
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief The given number of hours starting from the first time of the data
+ */
+// ----------------------------------------------------------------------
+
+vector<WeatherPeriod> hours(int theOffset, unsigned int theCount)
+{
+  NFmiFastQueryInfo q = NFmiFastQueryInfo(theQD.get());
+  q.First();
+
+  TextGenPosixTime time = q.Time();
+  time.ChangeByHours(theOffset);
+
+  vector<WeatherPeriod> periods;
+  for (unsigned int i = 0; i < theCount; i++)
+  {
+    periods.emplace_back(time, time);
+    time.ChangeByHours(1);
+  }
+  return periods;
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief The result of a separate GridForecaster analysis
+ */
+// ----------------------------------------------------------------------
+
+WeatherResult grid_analysis(unsigned int theFunction,
+                            const WeatherParameter& theParameter,
+                            const WeatherFunction& theTimeFunction,
+                            const WeatherArea& theArea,
+                            const WeatherPeriod& thePeriod,
+                            const Acceptor& theTester)
+{
+  GridForecaster forecaster;
+  return forecaster.analyze(fakevars[theFunction],
+                            theSources,
+                            theParameter,
+                            functions[theFunction],
+                            theTimeFunction,
+                            theArea,
+                            thePeriod,
+                            DefaultAcceptor(),
+                            DefaultAcceptor(),
+                            theTester);
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Require the single pass results to equal the separate analyses
+ *
+ * \param theResults For each area function the results of the periods
+ */
+// ----------------------------------------------------------------------
+
+void require_equal(const string& theName,
+                   const vector<vector<WeatherResult> >& theResults,
+                   const WeatherParameter& theParameter,
+                   const WeatherFunction& theTimeFunction,
+                   const WeatherArea& theArea,
+                   const vector<WeatherPeriod>& thePeriods,
+                   const Acceptor& theTester)
+{
+  if (theResults.size() != functions.size())
+    TEST_FAILED(theName + ": expected " + Convert(functions.size()) + " functions, got " +
+                Convert(theResults.size()));
+
+  for (unsigned int f = 0; f < functions.size(); f++)
+  {
+    if (theResults[f].size() != thePeriods.size())
+      TEST_FAILED(theName + ": expected " + Convert(thePeriods.size()) + " periods, got " +
+                  Convert(theResults[f].size()));
+
+    for (unsigned int i = 0; i < thePeriods.size(); i++)
+    {
+      const WeatherResult expected =
+          grid_analysis(f, theParameter, theTimeFunction, theArea, thePeriods[i], theTester);
+      if (theResults[f][i].value() != expected.value())
+        TEST_FAILED(theName + ": " + fakevars[f] + " of period " + Convert(i) + " is " +
+                    Convert(theResults[f][i].value()) + " instead of " +
+                    Convert(expected.value()));
+    }
+  }
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Test StatisticsTools::analyze against GridForecaster
+ */
+// ----------------------------------------------------------------------
+
+void analyze()
+{
+  RangeAcceptor tester;
+  tester.lowerLimit(0);
+
+  const WeatherArea uusimaa("maps/uusimaa.svg", "uusimaa");
+  const WeatherArea lappi("maps/pohjois-lappi.svg", "pohjois-lappi");
+  const WeatherArea helsinki("25,60", "helsinki");
+
+  const vector<WeatherPeriod> periods = hours(0, 24);
+  const WeatherPeriod day(periods.front().localStartTime(), periods.back().localEndTime());
+
+  for (const WeatherArea* area : {&uusimaa, &lappi, &helsinki})
+    for (const WeatherFunction timefunction : {Mean, Maximum})
+    {
+      const string name = area->name() + " " + Convert(static_cast<int>(timefunction));
+
+      vector<WeatherResult> results;
+      StatisticsTools::analyze(fakevars,
+                               theSources,
+                               Temperature,
+                               functions,
+                               timefunction,
+                               *area,
+                               day,
+                               results,
+                               DefaultAcceptor(),
+                               DefaultAcceptor(),
+                               tester);
+
+      vector<vector<WeatherResult> > series;
+      for (const auto& result : results)
+        series.push_back(vector<WeatherResult>{result});
+
+      require_equal(name, series, Temperature, timefunction, *area, {day}, tester);
+    }
+
+  TEST_PASSED();
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Test StatisticsTools::timeSeries against GridForecaster
+ *
+ * The periods start before the data, so that some of them are
+ * analyzed separately. The percentage of a single value is
+ * calculated with ReductionTools.
+ */
+// ----------------------------------------------------------------------
+
+void timeseries()
+{
+  RangeAcceptor tester;
+  tester.lowerLimit(0.1);
+
+  ValueAcceptor valuetester;
+  valuetester.value(0);
+
+  const WeatherArea uusimaa("maps/uusimaa.svg", "uusimaa");
+  const WeatherArea helsinki("25,60", "helsinki");
+  const vector<WeatherPeriod> periods = hours(-3, 12);
+
+  for (const WeatherArea* area : {&uusimaa, &helsinki})
+    for (const WeatherParameter parameter : {Temperature, Precipitation, WindDirection})
+      for (const Acceptor* acceptor : {static_cast<const Acceptor*>(&tester),
+                                       static_cast<const Acceptor*>(&valuetester)})
+      {
+        const string name = area->name() + " parameter " + Convert(static_cast<int>(parameter));
+
+        vector<vector<WeatherResult> > results;
+        StatisticsTools::timeSeries(fakevars,
+                                    theSources,
+                                    parameter,
+                                    functions,
+                                    Mean,
+                                    *area,
+                                    periods,
+                                    results,
+                                    DefaultAcceptor(),
+                                    DefaultAcceptor(),
+                                    *acceptor);
+
+        require_equal(name, results, parameter, Mean, *area, periods, *acceptor);
+      }
+
+  TEST_PASSED();
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Test StatisticsTools::timeSeries for several area types against GridForecaster
+ */
+// ----------------------------------------------------------------------
+
+void areatypes()
+{
+  const WeatherArea uusimaa("maps/uusimaa.svg", "uusimaa");
+  const vector<WeatherArea::Type> types{WeatherArea::Full, WeatherArea::Inland, WeatherArea::Coast};
+  const vector<WeatherPeriod> periods = hours(-1, 6);
+
+  vector<vector<vector<WeatherResult> > > results;
+  StatisticsTools::timeSeries(fakevars,
+                              theSources,
+                              Temperature,
+                              functions,
+                              Maximum,
+                              uusimaa,
+                              types,
+                              periods,
+                              results);
+
+  if (results.size() != types.size())
+    TEST_FAILED("Expected " + Convert(types.size()) + " area types, got " +
+                Convert(results.size()));
+
+  for (unsigned int label = 0; label < types.size(); label++)
+  {
+    WeatherArea area(uusimaa);
+    area.type(types[label]);
+    require_equal("area type " + Convert(static_cast<int>(types[label])),
+                  results[label],
+                  Temperature,
+                  Maximum,
+                  area,
+                  periods,
+                  NullAcceptor());
+  }
+
+  TEST_PASSED();
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief The actual test driver
+ */
+// ----------------------------------------------------------------------
+
+class tests : public tframe::tests
+{
+  //! Overridden message separator
+  virtual const char* error_message_prefix() const { return "\n\t"; }
+  //! Main test suite
+  void test(void)
+  {
+    TEST(analyze);
+    TEST(timeseries);
+    TEST(areatypes);
+  }
+
+};  // class tests
+
+}  // namespace StatisticsToolsTest
+
+int main(void)
+{
+  NFmiSettings::Init();
+  NFmiSettings::Set("textgen::default_forecast", "data");
+  NFmiSettings::Set("textgen::precipitation_forecast", "data");
+  Settings::set(NFmiSettings::ToString());
+
+  cout << endl << "StatisticsTools tests" << endl << "=====================" << endl;
+
+  StatisticsToolsTest::theQD.reset(new NFmiQueryData("data/skandinavia_pinta.sqd"));
+  StatisticsToolsTest::make_sources();
+
+  StatisticsToolsTest::tests t;
+  return t.run();
+}
@@ -1,14 +1,28 @@
+#include "AnalysisCache.h"
+#include "ClimatologyTools.h"
 #include "Dictionary.h"
 #include "DictionaryFactory.h"
+#include "GridClimatology.h"
 #include "TemperatureStoryTools.h"
+#include <calculator/AnalysisSources.h>
+#include <calculator/NullPeriodGenerator.h>
 #include <calculator/Settings.h>
+#include <calculator/UserWeatherSource.h>
+#include <calculator/WeatherArea.h>
+#include <calculator/WeatherPeriod.h>
+#include <calculator/WeatherResult.h>
 #include <regression/tframe.h>
 
+#include <newbase/NFmiQueryData.h>
 #include <newbase/NFmiSettings.h>
+#include <newbase/NFmiStringTools.h>
 
 #include <iostream>
+#include <memory>
 #include <stdexcept>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include <boost/locale.hpp>
 
@@ -39,6 +53,166 @@ void temperature_sentence()
 {
   TEST_NOT_IMPLEMENTED();
 }
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Test TemperatureStoryTools::get_fractile_temperatures
+ */
+// ----------------------------------------------------------------------
+
+void fractile_temperatures()
+{
+  using namespace TextGen;
+  using namespace TextGen::TemperatureStoryTools;
+  using NFmiStringTools::Convert;
+
+  const vector<pair<string, fractile_id>> levels{{"F02", FRACTILE_02},
+                                                 {"F12", FRACTILE_12},
+                                                 {"F37", FRACTILE_37},
+                                                 {"F50", FRACTILE_50},
+                                                 {"F63", FRACTILE_63},
+                                                 {"F88", FRACTILE_88},
+                                                 {"F98", FRACTILE_98}};
+
+  for (unsigned int i = 0; i < levels.size(); i++)
+    Settings::set("fractiletest::fake::fractile::summer::" + levels[i].first,
+                  Convert(5.0 + 3 * i));
+
+  AnalysisSources sources;
+  WeatherArea area("25,60");
+  WeatherPeriod period(TextGenPosixTime(2010, 7, 1, 12, 0, 0),
+                       TextGenPosixTime(2010, 7, 1, 18, 0, 0));
+
+  const auto fractiles =
+      get_fractile_temperatures("fractiletest", sources, area, period, MAX_FRACTILE);
+
+  if (fractiles.size() != levels.size())
+    TEST_FAILED("Expected " + Convert(levels.size()) + " fractiles, got " +
+                Convert(fractiles.size()));
+
+  for (unsigned int i = 0; i < levels.size(); i++)
+  {
+    const float expected = 5.0 + 3 * i;
+    if (fractiles.at(levels[i].second).value() != expected)
+      TEST_FAILED(levels[i].first + " should be " + Convert(expected) + ", not " +
+                  Convert(fractiles.at(levels[i].second).value()));
+
+    const WeatherResult single = get_fractile_temperature(
+        "fractiletest", levels[i].second, sources, area, period, MAX_FRACTILE);
+    if (single.value() != expected)
+      TEST_FAILED("get_fractile_temperature differs from the batch for " + levels[i].first);
+  }
+
+  if (get_fractile("fractiletest", 9.5, sources, area, period, MAX_FRACTILE) != FRACTILE_37)
+    TEST_FAILED("9.5 degrees should fall into fractile F37");
+  if (get_fractile("fractiletest", 30.0, sources, area, period, MAX_FRACTILE) != FRACTILE_100)
+    TEST_FAILED("30 degrees should be above fractile F98");
+
+  TEST_PASSED();
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Test TemperatureStoryTools::get_fractile_temperatures with a cache
+ */
+// ----------------------------------------------------------------------
+
+void fractile_temperatures_cached()
+{
+  using namespace TextGen;
+  using namespace TextGen::TemperatureStoryTools;
+  using NFmiStringTools::Convert;
+
+  std::shared_ptr<NFmiQueryData> qd(new NFmiQueryData("data/tmax_textgen.sqd"));
+  std::shared_ptr<UserWeatherSource> weathersource(new UserWeatherSource());
+  weathersource->insert("fractiles", qd);
+
+  AnalysisSources sources;
+  sources.setWeatherSource(weathersource);
+
+  Settings::set("textgen::fractiles_climatology", "fractiles");
+
+  WeatherArea area("25,60");
+  WeatherPeriod period(TextGenPosixTime(2010, 7, 1, 12, 0, 0),
+                       TextGenPosixTime(2010, 7, 1, 18, 0, 0));
+
+  const vector<pair<string, fractile_id>> levels{{"F02", FRACTILE_02},
+                                                 {"F12", FRACTILE_12},
+                                                 {"F37", FRACTILE_37},
+                                                 {"F50", FRACTILE_50},
+                                                 {"F63", FRACTILE_63},
+                                                 {"F88", FRACTILE_88},
+                                                 {"F98", FRACTILE_98}};
+
+  const auto uncached =
+      get_fractile_temperatures("cachetest", sources, area, period, MAX_FRACTILE);
+
+  AnalysisCache cache;
+  AnalysisCache::Scope scope(&cache);
+
+  const auto fractiles =
+      get_fractile_temperatures("cachetest", sources, area, period, MAX_FRACTILE);
+
+  if (cache.hits() != 0 || cache.misses() != levels.size())
+    TEST_FAILED("Expected 0 hits and " + Convert(levels.size()) + " misses, got " +
+                Convert(cache.hits()) + " and " + Convert(cache.misses()));
+
+  for (unsigned int i = 0; i < levels.size(); i++)
+  {
+    const WeatherResult& expected = uncached.at(levels[i].second);
+    if (fractiles.at(levels[i].second).value() != expected.value())
+      TEST_FAILED("Cached " + levels[i].first + " differs from the uncached result");
+
+    const WeatherResult single = get_fractile_temperature(
+        "cachetest", levels[i].second, sources, area, period, MAX_FRACTILE);
+    if (single.value() != expected.value())
+      TEST_FAILED("get_fractile_temperature differs from the batch for " + levels[i].first);
+  }
+
+  if (cache.hits() != levels.size() || cache.misses() != levels.size())
+    TEST_FAILED("Single fractiles should be served from the cache");
+
+  const auto subset = get_fractile_temperatures(
+      "cachetest", {FRACTILE_02, FRACTILE_98}, sources, area, period, MAX_FRACTILE);
+  if (subset.size() != 2 || subset.at(FRACTILE_02).value() != uncached.at(FRACTILE_02).value() ||
+      subset.at(FRACTILE_98).value() != uncached.at(FRACTILE_98).value())
+    TEST_FAILED("The subset should equal the full batch");
+  if (cache.hits() != levels.size() + 2 || cache.misses() != levels.size())
+    TEST_FAILED("The subset should be served from the cache");
+
+  // Climatology keys are prefixed to keep them apart from forecasts
+
+  const WeatherPeriod climatePeriod =
+      ClimatologyTools::getClimatologyPeriod(period, "textgen::fractiles", sources);
+  const NullPeriodGenerator periods(climatePeriod);
+
+  GridClimatology gc;
+  const WeatherResult result = gc.analyze(
+      sources, NormalMaxTemperatureF50, Mean, Mean, NullFunction, area, periods);
+
+  string key;
+  if (!AnalysisCache::key(sources,
+                          NormalMaxTemperatureF50,
+                          Mean,
+                          Mean,
+                          NullFunction,
+                          area,
+                          periods,
+                          DefaultAcceptor(),
+                          DefaultAcceptor(),
+                          NullAcceptor(),
+                          key))
+    TEST_FAILED("Climatology analysis should have a cache key");
+
+  WeatherResult found(kFloatMissing, 0);
+  if (!cache.find("climatology|" + key, found) || found.value() != result.value())
+    TEST_FAILED("Climatology result should be cached with the climatology prefix");
+  if (cache.find(key, found))
+    TEST_FAILED("Climatology result should not be cached without the prefix");
+
+  TEST_PASSED();
+}
+
 // ----------------------------------------------------------------------
 /*!
  * \brief The actual test driver
@@ -54,6 +228,8 @@ class tests : public tframe::tests
   {
     TEST(temperature_comparison_phrase);
     TEST(temperature_sentence);
+    TEST(fractile_temperatures);
+    TEST(fractile_temperatures_cached);
   }
 
 };  // class tests
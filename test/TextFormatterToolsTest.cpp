@@ -53,6 +53,53 @@ void capitalize()
   TEST_PASSED();
 }
 
+// ----------------------------------------------------------------------
+/*!
+ * \brief Test TextFormatterTools::localeName
+ */
+// ----------------------------------------------------------------------
+
+void localeName()
+{
+  if (TextFormatterTools::localeName(nullptr) != "fi_FI.UTF-8")
+    TEST_FAILED("Default locale should be fi_FI.UTF-8");
+
+  DebugDictionary dictionary;
+  dictionary.init("sv");
+  if (TextFormatterTools::localeName(&dictionary) != "sv_FI.UTF-8")
+    TEST_FAILED("Locale for sv should be sv_FI.UTF-8");
+
+  dictionary.init("de");
+  if (TextFormatterTools::localeName(&dictionary) != "de_DE.UTF-8")
+    TEST_FAILED("Locale for de should be de_DE.UTF-8");
+
+  dictionary.init("et");
+  if (TextFormatterTools::localeName(&dictionary) != "et_EE.UTF-8")
+    TEST_FAILED("Locale for et should be et_EE.UTF-8");
+
+  dictionary.init("ja");
+  if (TextFormatterTools::localeName(&dictionary) != "ja_JP.UTF-8")
+    TEST_FAILED("Locale for ja should be ja_JP.UTF-8");
+
+  dictionary.init("en-marine");
+  if (TextFormatterTools::localeName(&dictionary) != "en_GB.UTF-8")
+    TEST_FAILED("Locale for en-marine should be en_GB.UTF-8");
+
+  dictionary.init("xx");
+  if (TextFormatterTools::localeName(&dictionary) != "xx.UTF-8")
+    TEST_FAILED("Locale for an unknown language should not have a country");
+
+  dictionary.init("en_US.UTF-8");
+  if (TextFormatterTools::localeName(&dictionary) != "en_US.UTF-8")
+    TEST_FAILED("Full locale names should be used as is");
+
+  string tmp = "ähtäri";
+  if (TextFormatterTools::capitalize(tmp, &dictionary) != "Ähtäri")
+    TEST_FAILED("Failed to capitalize 'ähtäri' in locale en_US.UTF-8");
+
+  TEST_PASSED();
+}
+
 // ----------------------------------------------------------------------
 /*!
  * \brief Test TextFormatterTools::punctuate
@@ -216,6 +263,7 @@ class tests : public tframe::tests
   void test(void)
   {
     TEST(capitalize);
+    TEST(localeName);
     TEST(punctuate);
     TEST(realize);
     TEST(format_time);
@@ -1,17 +1,34 @@
+#include "CoastMaskSource.h"
 #include "Dictionary.h"
 #include "DictionaryFactory.h"
+#include "EasternMaskSource.h"
+#include "InlandMaskSource.h"
+#include "MessageLogger.h"
+#include "NorthernMaskSource.h"
 #include "Paragraph.h"
+#include "ParallelTools.h"
 #include "PlainTextFormatter.h"
+#include "SouthernMaskSource.h"
 #include "Story.h"
+#include "WeatherForecast.h"
 #include "WeatherStory.h"
+#include "WesternMaskSource.h"
+#include <calculator/AnalysisSources.h>
+#include <calculator/RegularMaskSource.h>
 #include <calculator/Settings.h>
+#include <calculator/UserWeatherSource.h>
 #include <regression/tframe.h>
 
+#include <newbase/NFmiFastQueryInfo.h>
+#include <newbase/NFmiQueryData.h>
 #include <newbase/NFmiSettings.h>
+#include <newbase/NFmiStringTools.h>
 
 #include <iostream>
+#include <memory>
 #include <stdexcept>
 #include <string>
+#include <vector>
 
 #include <boost/locale.hpp>
 
@@ -22,6 +39,7 @@ namespace WeatherStoryTest
 {
 std::shared_ptr<TextGen::Dictionary> dict;
 TextGen::PlainTextFormatter formatter;
+std::shared_ptr<NFmiQueryData> theQD;
 
 void require(const TextGen::Story& theStory,
              const string& theLanguage,
@@ -263,6 +281,183 @@ void thunderprobability_simplified()
   TEST_PASSED();
 }
 
+// ----------------------------------------------------------------------
+/*!
+ * \brief Analysis sources for the querydata as set up by TextGenerator
+ */
+// ----------------------------------------------------------------------
+
+TextGen::AnalysisSources make_sources()
+{
+  using namespace TextGen;
+
+  AnalysisSources sources;
+
+  std::shared_ptr<UserWeatherSource> weathersource(new UserWeatherSource());
+  weathersource->insert("data", theQD);
+  sources.setWeatherSource(weathersource);
+
+  std::shared_ptr<MaskSource> masksource(new RegularMaskSource());
+  sources.setMaskSource(masksource);
+  sources.setLandMaskSource(masksource);
+
+  const WeatherArea coast("data/rannikko.svg:15");
+  sources.setCoastMaskSource(std::shared_ptr<MaskSource>(new CoastMaskSource(coast)));
+  sources.setInlandMaskSource(std::shared_ptr<MaskSource>(new InlandMaskSource(coast)));
+
+  const WeatherArea area(NFmiPoint(0.0, 0.0));
+  sources.setNorthernMaskSource(std::shared_ptr<MaskSource>(new NorthernMaskSource(area)));
+  sources.setSouthernMaskSource(std::shared_ptr<MaskSource>(new SouthernMaskSource(area)));
+  sources.setEasternMaskSource(std::shared_ptr<MaskSource>(new EasternMaskSource(area)));
+  sources.setWesternMaskSource(std::shared_ptr<MaskSource>(new WesternMaskSource(area)));
+
+  return sources;
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief The first 48 hours of the querydata
+ */
+// ----------------------------------------------------------------------
+
+TextGen::WeatherPeriod data_period()
+{
+  NFmiFastQueryInfo q = NFmiFastQueryInfo(theQD.get());
+  q.First();
+
+  TextGenPosixTime time1 = q.Time();
+  TextGenPosixTime time2 = time1;
+  time2.ChangeByHours(48);
+  return TextGen::WeatherPeriod(time1, time2);
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief The weather_forecast story, its message log and its hourly data
+ */
+// ----------------------------------------------------------------------
+
+struct forecast_result
+{
+  string story;
+  string log;
+  vector<vector<float> > columns;
+};
+
+forecast_result generate_weather_forecast(const string& theVar,
+                                          const TextGen::WeatherArea& theArea,
+                                          unsigned int theThreads)
+{
+  using namespace TextGen;
+
+  // Workers see only the settings of the scope, hence the thread count is set into it
+
+  NFmiSettings::Set("textgen::parallel::threads", NFmiStringTools::Convert(theThreads));
+  ParallelTools::SettingsScope settings(NFmiSettings::ToString());
+
+  const AnalysisSources sources = make_sources();
+  const WeatherPeriod period = data_period();
+
+  dict->init("fi");
+  formatter.dictionary(dict);
+
+  forecast_result result;
+
+  MessageLogger::open();
+  WeatherStory story(period.localStartTime(), sources, theArea, period, theVar);
+  result.story = story.makeStory("weather_forecast").realize(formatter);
+  result.log = MessageLogger::str();
+  MessageLogger::open("");
+
+  MessageLogger log("weather_forecast");
+  wf_story_params parameters(
+      theVar, theArea, period, period, period.localStartTime(), sources, log);
+  if (populate_weather_forecast_data(parameters))
+    for (const auto& column : parameters.theHourlyColumns)
+    {
+      result.columns.push_back(column.values());
+      result.columns.push_back(column.errors());
+    }
+
+  return result;
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Test that weather_forecast does not depend on the thread count
+ */
+// ----------------------------------------------------------------------
+
+void weather_forecast_threads()
+{
+  using namespace TextGen;
+
+  NFmiSettings::Set("textgen::default_forecast", "data");
+  NFmiSettings::Set("textgen::precipitation_forecast", "data");
+
+  const string mappath = Settings::require_string("textgen::mappath");
+  const WeatherArea area(mappath + "/pohjois-lappi.svg", "pohjois-lappi");
+
+  const forecast_result serial = generate_weather_forecast("wf", area, 1);
+  const forecast_result parallel = generate_weather_forecast("wf", area, 4);
+
+  if (serial.story.empty())
+    TEST_FAILED("weather_forecast generated no text");
+  if (serial.columns.empty())
+    TEST_FAILED("weather_forecast filled in no hourly data");
+  if (parallel.story != serial.story)
+    TEST_FAILED("Parallel output differs:\n" + parallel.story + "\n<>\n" + serial.story);
+  if (parallel.columns != serial.columns)
+    TEST_FAILED("Parallel hourly data differs from the serial data");
+
+  TEST_PASSED();
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Test that a split weather_forecast does not depend on the thread count
+ */
+// ----------------------------------------------------------------------
+
+void split_weather_forecast_threads()
+{
+  using namespace TextGen;
+
+  NFmiSettings::Set("textgen::default_forecast", "data");
+  NFmiSettings::Set("textgen::precipitation_forecast", "data");
+
+  // Split at the middle latitude whenever the temperatures of the halves differ at all
+
+  NFmiSettings::Set("wfsplit::areas_to_split", "pohjois-lappi");
+  NFmiSettings::Set("wfsplit::mininterval", "0");
+  NFmiSettings::Set("wfsplit::always_interval_zero", "true");
+  NFmiSettings::Set("textgen::split_the_area::pohjois-lappi::method", "horizontal");
+  NFmiSettings::Set("textgen::split_the_area::pohjois-lappi::criterion",
+                    "temperature_difference:0");
+
+  const string mappath = Settings::require_string("textgen::mappath");
+  const WeatherArea area(mappath + "/pohjois-lappi.svg", "pohjois-lappi");
+
+  const forecast_result serial = generate_weather_forecast("wfsplit", area, 1);
+  const forecast_result parallel = generate_weather_forecast("wfsplit", area, 4);
+
+  if (serial.story.find("pohjoisosassa") == string::npos)
+    TEST_FAILED("weather_forecast did not split the area:\n" + serial.story);
+  if (parallel.story != serial.story)
+    TEST_FAILED("Parallel output differs:\n" + parallel.story + "\n<>\n" + serial.story);
+
+  // The parts log at the depth of the story itself, whatever the number of threads
+
+  if (serial.log.find("\n  pohjois-lappi - southern part\n") == string::npos)
+    TEST_FAILED("The southern part was not logged at the depth of the story:\n" + serial.log);
+  if (parallel.log != serial.log)
+    TEST_FAILED("Parallel message log differs from the serial log");
+  if (parallel.columns != serial.columns)
+    TEST_FAILED("Parallel hourly data differs from the serial data");
+
+  TEST_PASSED();
+}
+
 // ----------------------------------------------------------------------
 /*!
  * \brief The actual test driver
@@ -279,6 +474,8 @@ class tests : public tframe::tests
     TEST(short_overview);
     TEST(thunderprobability);
     TEST(thunderprobability_simplified);
+    TEST(weather_forecast_threads);
+    TEST(split_weather_forecast_threads);
   }
 
 };  // class tests
@@ -304,6 +501,8 @@ int main(void)
   dict->init("sv");
   dict->init("en");
 
+  theQD.reset(new NFmiQueryData("data/skandinavia_pinta.sqd"));
+
   tests t;
   return t.run();
 }
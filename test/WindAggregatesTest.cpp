@@ -0,0 +1,223 @@
+#include <regression/tframe.h>
+
+#include "WindAggregates.h"
+#include "WindForecastStructs.h"
+#include <calculator/WeatherPeriod.h>
+#include <calculator/WeatherResult.h>
+
+#include <newbase/NFmiSettings.h>
+#include <newbase/NFmiStringTools.h>
+
+#include <cmath>
+#include <iostream>
+#include <string>
+
+using namespace std;
+using namespace TextGen;
+
+namespace WindAggregatesTest
+{
+using NFmiStringTools::Convert;
+
+// 24 hourly data items starting from 1.7.2010 01:00 with irregular wind speeds
+
+void make_data(wind_data_item_vector& theData)
+{
+  TextGenPosixTime time(2010, 7, 1, 0, 0, 0);
+  for (unsigned int i = 0; i < 24; i++)
+  {
+    time.ChangeByHours(1);
+    const float speed = (i * 7) % 11 + 0.5 * (i % 3);
+    const WeatherResult result(speed, 0.1 * (i % 4));
+
+    auto* item = new WindDataItemsByArea();
+    item->addItem(WeatherPeriod(time, time),
+                  result,
+                  result,
+                  result,
+                  result,
+                  WeatherResult(speed + 2, 0),
+                  WeatherResult(45 * (i % 8), 5 + i % 5),
+                  WeatherResult(speed + 4, 0),
+                  WeatherArea::Full);
+
+    WindDataItemUnit& unit = item->getDataItem(WeatherArea::Full);
+    unit.theEqualizedMedianWind = result;
+    unit.theEqualizedWindDirection = unit.theWindDirection;
+    for (unsigned int k = 0; k < 10; k++)
+      unit.theWindSpeedDistributionTop.emplace_back(k, WeatherResult(k < speed ? 20 : 0, 0));
+
+    theData.push_back(item);
+  }
+}
+
+void delete_data(wind_data_item_vector& theData)
+{
+  for (auto* item : theData)
+    delete item;
+  theData.clear();
+}
+
+WeatherPeriod hours(const wind_data_item_vector& theData, unsigned int i, unsigned int j)
+{
+  return WeatherPeriod(theData[i]->getDataItem().thePeriod.localStartTime(),
+                       theData[j]->getDataItem().thePeriod.localStartTime());
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Test the aggregates against scanning all hours of all periods
+ */
+// ----------------------------------------------------------------------
+
+void aggregates()
+{
+  wind_data_item_vector data;
+  make_data(data);
+
+  WindAggregates index;
+  index.build(data, WeatherArea::Full, 90);
+
+  for (unsigned int i = 0; i < data.size(); i++)
+    for (unsigned int j = i; j < data.size(); j++)
+    {
+      const string name = " for hours " + Convert(i) + "..." + Convert(j);
+      const WeatherPeriod period = hours(data, i, j);
+
+      double median = 0;
+      double error = 0;
+      float top = kFloatMissing;
+      bool weak = true;
+      int peak = -1;
+      unsigned int peakhour = 0;
+      for (unsigned int h = i; h <= j; h++)
+      {
+        const WindDataItemUnit& unit = data[h]->getDataItem();
+        median += unit.theEqualizedMedianWind.value();
+        error += unit.theEqualizedWindDirection.error();
+        if (top == kFloatMissing || unit.theWindSpeedTop.value() > top)
+          top = unit.theWindSpeedTop.value();
+        if (unit.theEqualizedTopWind.value() > 8)
+          weak = false;
+        double share = 0;
+        for (unsigned int k = 0; k < unit.theWindSpeedDistributionTop.size(); k++)
+        {
+          share += unit.theWindSpeedDistributionTop[k].second.value();
+          if (share >= 90)
+          {
+            if (static_cast<int>(k) > peak)
+            {
+              peak = k;
+              peakhour = h;
+            }
+            break;
+          }
+        }
+      }
+      median /= (j - i + 1);
+      error /= (j - i + 1);
+
+      auto result = index.medianWind(data, WeatherArea::Full, period);
+      if (!result || std::abs(*result - median) > 1e-5)
+        TEST_FAILED("Wrong median wind" + name);
+
+      result = index.directionError(data, WeatherArea::Full, period);
+      if (!result || std::abs(*result - error) > 1e-5)
+        TEST_FAILED("Wrong wind direction error" + name);
+
+      result = index.topWind(data, WeatherArea::Full, period);
+      if (!result || *result != top)
+        TEST_FAILED("Wrong top wind" + name);
+
+      auto isweak = index.isWeak(data, WeatherArea::Full, period, 8);
+      if (!isweak || *isweak != weak)
+        TEST_FAILED("Wrong weak period" + name);
+
+      auto peakwind = index.peakWind(data, WeatherArea::Full, period);
+      if (!peakwind || peakwind->first != peak || (peak >= 0 && peakwind->second != peakhour))
+        TEST_FAILED("Wrong peak wind" + name);
+    }
+
+  const WeatherPeriod before(TextGenPosixTime(2010, 6, 30, 0, 0, 0),
+                             TextGenPosixTime(2010, 6, 30, 12, 0, 0));
+  if (index.medianWind(data, WeatherArea::Full, before) != 0.0f ||
+      index.topWind(data, WeatherArea::Full, before) != kFloatMissing ||
+      index.isWeak(data, WeatherArea::Full, before, 8) != true)
+    TEST_FAILED("Wrong aggregates for a period without data");
+
+  delete_data(data);
+  TEST_PASSED();
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Test that the index is not used for other data
+ */
+// ----------------------------------------------------------------------
+
+void coverage()
+{
+  wind_data_item_vector data;
+  make_data(data);
+  const WeatherPeriod period = hours(data, 2, 5);
+
+  WindAggregates index;
+  if (index.medianWind(data, WeatherArea::Full, period))
+    TEST_FAILED("An empty index should not cover the data");
+
+  index.build(data, WeatherArea::Full, 90);
+  if (!index.covers(data, WeatherArea::Full))
+    TEST_FAILED("The index should cover the data it was built from");
+  if (index.covers(data, WeatherArea::Coast))
+    TEST_FAILED("The index should not cover another area");
+
+  wind_data_item_vector copy(data);
+  copy.pop_back();
+  if (index.covers(copy, WeatherArea::Full))
+    TEST_FAILED("The index should not cover other data");
+
+  data[3]->getDataItem().theWindSpeedTop = WeatherResult(kFloatMissing, 0);
+  index.build(data, WeatherArea::Full, 90);
+  if (index.topWind(data, WeatherArea::Full, period))
+    TEST_FAILED("The top wind should not be indexed when it contains missing values");
+  if (!index.medianWind(data, WeatherArea::Full, period))
+    TEST_FAILED("The median wind should be indexed when the top wind is missing");
+
+  index.clear();
+  if (index.covers(data, WeatherArea::Full))
+    TEST_FAILED("A cleared index should not cover the data");
+
+  delete_data(data);
+  TEST_PASSED();
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief The actual test driver
+ */
+// ----------------------------------------------------------------------
+
+class tests : public tframe::tests
+{
+  //! Overridden message separator
+  virtual const char* error_message_prefix() const { return "\n\t"; }
+  //! Main test suite
+  void test(void)
+  {
+    TEST(aggregates);
+    TEST(coverage);
+  }
+
+};  // class tests
+
+}  // namespace WindAggregatesTest
+
+int main(void)
+{
+  NFmiSettings::Init();
+
+  cout << endl << "WindAggregates tests" << endl << "====================" << endl;
+
+  WindAggregatesTest::tests t;
+  return t.run();
+}
@@ -3,17 +3,32 @@
  */
 #include <regression/tframe.h>
 
+#include "CoastMaskSource.h"
 #include "Dictionary.h"
 #include "DictionaryFactory.h"
+#include "EasternMaskSource.h"
+#include "InlandMaskSource.h"
+#include "MessageLogger.h"
+#include "NorthernMaskSource.h"
 #include "Paragraph.h"
+#include "ParallelTools.h"
 #include "PlainTextFormatter.h"
+#include "SouthernMaskSource.h"
 #include "Story.h"
+#include "WesternMaskSource.h"
 #include "WindStory.h"
+#include <calculator/AnalysisSources.h>
+#include <calculator/RegularMaskSource.h>
 #include <calculator/Settings.h>
+#include <calculator/UserWeatherSource.h>
 
+#include <newbase/NFmiFastQueryInfo.h>
+#include <newbase/NFmiQueryData.h>
 #include <newbase/NFmiSettings.h>
+#include <newbase/NFmiStringTools.h>
 
 #include <iostream>
+#include <memory>
 #include <stdexcept>
 #include <string>
 
@@ -26,6 +41,7 @@ namespace WindStoryTest
 {
 std::shared_ptr<TextGen::Dictionary> dict;
 TextGen::PlainTextFormatter formatter;
+std::shared_ptr<NFmiQueryData> theQD;
 
 string require(const TextGen::Story& theStory,
                const string& theLanguage,
@@ -830,6 +846,109 @@ void wind_overview()
 {
   TEST_NOT_IMPLEMENTED();
 }
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Analysis sources for the querydata as set up by TextGenerator
+ */
+// ----------------------------------------------------------------------
+
+TextGen::AnalysisSources make_sources()
+{
+  using namespace TextGen;
+
+  AnalysisSources sources;
+
+  std::shared_ptr<UserWeatherSource> weathersource(new UserWeatherSource());
+  weathersource->insert("data", theQD);
+  sources.setWeatherSource(weathersource);
+
+  std::shared_ptr<MaskSource> masksource(new RegularMaskSource());
+  sources.setMaskSource(masksource);
+  sources.setLandMaskSource(masksource);
+
+  const WeatherArea coast("data/rannikko.svg:15");
+  sources.setCoastMaskSource(std::shared_ptr<MaskSource>(new CoastMaskSource(coast)));
+  sources.setInlandMaskSource(std::shared_ptr<MaskSource>(new InlandMaskSource(coast)));
+
+  const WeatherArea point(NFmiPoint(0.0, 0.0));
+  sources.setNorthernMaskSource(std::shared_ptr<MaskSource>(new NorthernMaskSource(point)));
+  sources.setSouthernMaskSource(std::shared_ptr<MaskSource>(new SouthernMaskSource(point)));
+  sources.setEasternMaskSource(std::shared_ptr<MaskSource>(new EasternMaskSource(point)));
+  sources.setWesternMaskSource(std::shared_ptr<MaskSource>(new WesternMaskSource(point)));
+
+  return sources;
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Generate wind_overview from the querydata with the given thread count
+ */
+// ----------------------------------------------------------------------
+
+string generate_wind_overview(const TextGen::WeatherArea& theArea, unsigned int theThreads)
+{
+  using namespace TextGen;
+
+  NFmiSettings::Set("textgen::parallel::threads", NFmiStringTools::Convert(theThreads));
+  ParallelTools::SettingsScope settings(NFmiSettings::ToString());
+
+  const AnalysisSources sources = make_sources();
+
+  NFmiFastQueryInfo q = NFmiFastQueryInfo(theQD.get());
+  q.First();
+
+  TextGenPosixTime time1 = q.Time();
+  TextGenPosixTime time2 = time1;
+  time2.ChangeByHours(48);
+  const WeatherPeriod period(time1, time2);
+
+  dict->init("fi");
+  formatter.dictionary(dict);
+
+  WindStory story(time1, sources, theArea, period, "wo");
+  return story.makeStory("wind_overview").realize(formatter);
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Test that wind_overview does not depend on the thread count
+ *
+ * The area is split so that the wind data of the split areas is
+ * generated in parallel as well.
+ */
+// ----------------------------------------------------------------------
+
+void wind_overview_threads()
+{
+  using namespace TextGen;
+
+  // wind_overview looks up the split method by the name and the type of the area
+
+  NFmiSettings::Set("textgen::default_forecast", "data");
+  NFmiSettings::Set("textgen::split_the_area::pohjois-lappi_full::method", "horizontal");
+
+  const string mappath = Settings::require_string("textgen::mappath");
+  const WeatherArea area(mappath + "/pohjois-lappi.svg", "pohjois-lappi");
+
+  MessageLogger::open();
+  const string serial = generate_wind_overview(area, 1);
+  const string log = MessageLogger::str();
+  MessageLogger::open("");
+
+  const string parallel = generate_wind_overview(area, 4);
+
+  if (serial.empty())
+    TEST_FAILED("wind_overview generated no text");
+  if (log.find("RAW DATA (southern)") == string::npos ||
+      log.find("RAW DATA (northern)") == string::npos)
+    TEST_FAILED("wind_overview did not split the area");
+  if (parallel != serial)
+    TEST_FAILED("Parallel output differs:\n" + parallel + "\n<>\n" + serial);
+
+  TEST_PASSED();
+}
+
 // ----------------------------------------------------------------------
 /*!
  * \brief The actual test driver
@@ -846,6 +965,7 @@ class tests : public tframe::tests
     TEST(wind_daily_ranges);
     TEST(wind_simple_overview);
     TEST(wind_overview);
+    TEST(wind_overview_threads);
     TEST(wind_range);
   }
 
@@ -872,6 +992,8 @@ int main(void)
   dict->init("sv");
   dict->init("en");
 
+  theQD.reset(new NFmiQueryData("data/skandinavia_pinta.sqd"));
+
   tests t;
   return t.run();
 }
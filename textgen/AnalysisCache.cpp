@@ -0,0 +1,521 @@
+// ======================================================================
+/*!
+ * \file
+ * \brief Implementation of class TextGen::AnalysisCache
+ */
+// ======================================================================
+/*!
+ * \class TextGen::AnalysisCache
+ *
+ * \brief Memoizes analysis results for the duration of one generate call
+ *
+ * Many stories in the same document analyze exactly the same
+ * parameter, functions, area, period and acceptors. The cache
+ * stores each WeatherResult under a structural key of those
+ * arguments so that the grid is scanned only once.
+ *
+ * A cache is activated for the calling thread with AnalysisCache::Scope,
+ * after which CachedGridForecaster consults it. Arguments which
+ * cannot be keyed structurally (for example acceptors unknown to
+ * this class) bypass the cache.
+ *
+ */
+// ======================================================================
+
+#include "AnalysisCache.h"
+#include "AndAcceptor.h"
+#include "ComparativeAcceptor.h"
+#include "MaskStorage.h"
+#include "OrAcceptor.h"
+#include "PositiveValueAcceptor.h"
+#include "TemplateAcceptor.h"
+#include "ValueAcceptor.h"
+#include <calculator/AnalysisSources.h>
+#include <calculator/DefaultAcceptor.h>
+#include <calculator/NullAcceptor.h>
+#include <calculator/RangeAcceptor.h>
+#include <calculator/WeatherArea.h>
+#include <calculator/WeatherPeriod.h>
+#include <calculator/WeatherPeriodGenerator.h>
+#include <macgyver/Exception.h>
+#include <newbase/NFmiGlobals.h>
+
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <typeinfo>
+
+namespace TextGen
+{
+namespace
+{
+// The cache in effect for the current thread
+thread_local AnalysisCache* tCurrentCache = nullptr;
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Append the object representation of a value to a key
+ */
+// ----------------------------------------------------------------------
+
+template <typename T>
+void append(std::string& theKey, const T& theValue)
+{
+  char buffer[sizeof(T)];
+  std::memcpy(buffer, &theValue, sizeof(T));
+  theKey.append(buffer, sizeof(T));
+}
+
+// Map the floats to unsigned integers of the same order and back
+
+std::uint32_t to_ordered(float theValue)
+{
+  std::uint32_t bits;
+  std::memcpy(&bits, &theValue, sizeof(bits));
+  return ((bits & 0x80000000U) != 0 ? ~bits : (bits | 0x80000000U));
+}
+
+float from_ordered(std::uint32_t theIndex)
+{
+  const std::uint32_t bits = ((theIndex & 0x80000000U) != 0 ? (theIndex & 0x7FFFFFFFU) : ~theIndex);
+  float value;
+  std::memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief The lower or upper limit of a range acceptor
+ *
+ * RangeAcceptor has no accessors for its limits. A copy limited from
+ * one side only accepts all values on one side of the limit, hence
+ * the limit is found by a binary search over the ordered floats. The
+ * result is the smallest or largest accepted value, and an infinity
+ * if the range is open at that end.
+ *
+ * kFloatMissing is rejected as a missing value, hence its neighbour
+ * on the accepted side is tested instead. It cannot be a limit itself,
+ * since a limit equal to kFloatMissing means that the limit is not set.
+ */
+// ----------------------------------------------------------------------
+
+float limit(const RangeAcceptor& theAcceptor, bool theLowerLimit)
+{
+  const float infinity = std::numeric_limits<float>::infinity();
+
+  RangeAcceptor acceptor(theAcceptor);
+  if (theLowerLimit)
+    acceptor.upperLimit(kFloatMissing);
+  else
+    acceptor.lowerLimit(kFloatMissing);
+
+  const float outward = (theLowerLimit ? -infinity : infinity);
+
+  auto accepts = [&](std::int64_t theIndex)
+  {
+    float value = from_ordered(static_cast<std::uint32_t>(theIndex));
+    if (value == kFloatMissing)
+      value = std::nextafter(value, outward);
+    return acceptor.accept(value);
+  };
+
+  // The search keeps one accepted and one rejected end
+
+  std::int64_t rejected = to_ordered(outward);
+  std::int64_t accepted = to_ordered(-outward);
+
+  if (accepts(rejected))
+    return outward;
+  if (!accepts(accepted))
+    return -outward;
+
+  while (std::abs(accepted - rejected) > 1)
+  {
+    const std::int64_t middle = (accepted + rejected) / 2;
+    if (accepts(middle))
+      accepted = middle;
+    else
+      rejected = middle;
+  }
+
+  return from_ordered(static_cast<std::uint32_t>(accepted));
+}
+
+}  // namespace
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Find a cached result
+ *
+ * \param theKey The structural key of the analysis
+ * \param theResult The result is stored here if found
+ * \return True if the result was found
+ */
+// ----------------------------------------------------------------------
+
+bool AnalysisCache::find(const std::string& theKey, WeatherResult& theResult) const
+{
+  try
+  {
+    std::lock_guard<std::mutex> lock(itsMutex);
+    auto it = itsResults.find(theKey);
+    if (it == itsResults.end())
+    {
+      ++itsMisses;
+      return false;
+    }
+    ++itsHits;
+    theResult = it->second;
+    return true;
+  }
+  catch (...)
+  {
+    throw Fmi::Exception::Trace(BCP, "Operation failed");
+  }
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Insert a new result into the cache
+ *
+ * \param theKey The structural key of the analysis
+ * \param theResult The result
+ */
+// ----------------------------------------------------------------------
+
+void AnalysisCache::insert(const std::string& theKey, const WeatherResult& theResult)
+{
+  try
+  {
+    std::lock_guard<std::mutex> lock(itsMutex);
+    itsResults.insert(storage_type::value_type(theKey, theResult));
+  }
+  catch (...)
+  {
+    throw Fmi::Exception::Trace(BCP, "Operation failed");
+  }
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Remove all results and reset the counters
+ */
+// ----------------------------------------------------------------------
+
+void AnalysisCache::clear()
+{
+  try
+  {
+    std::lock_guard<std::mutex> lock(itsMutex);
+    itsResults.clear();
+    itsHits = 0;
+    itsMisses = 0;
+  }
+  catch (...)
+  {
+    throw Fmi::Exception::Trace(BCP, "Operation failed");
+  }
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Return the number of cached results
+ */
+// ----------------------------------------------------------------------
+
+std::size_t AnalysisCache::size() const
+{
+  std::lock_guard<std::mutex> lock(itsMutex);
+  return itsResults.size();
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Build the structural key of a complete analysis request
+ *
+ * \param theSources Analysis sources
+ * \param theParameter The weather phenomenon to analyze
+ * \param theAreaFunction The area function
+ * \param theTimeFunction The time function
+ * \param theSubTimeFunction The time function for subperiods
+ * \param theArea The area to analyze
+ * \param thePeriods The time periods to analyze
+ * \param theAreaAcceptor The weather data acceptor in area integration
+ * \param theTimeAcceptor The weather data acceptor in time integration
+ * \param theTester The acceptor for Percentage calculations
+ * \param theKey The key to append to
+ * \return False if the request cannot be keyed
+ */
+// ----------------------------------------------------------------------
+
+bool AnalysisCache::key(const AnalysisSources& theSources,
+                        const WeatherParameter& theParameter,
+                        const WeatherFunction& theAreaFunction,
+                        const WeatherFunction& theTimeFunction,
+                        const WeatherFunction& theSubTimeFunction,
+                        const WeatherArea& theArea,
+                        const WeatherPeriodGenerator& thePeriods,
+                        const Acceptor& theAreaAcceptor,
+                        const Acceptor& theTimeAcceptor,
+                        const Acceptor& theTester,
+                        std::string& theKey)
+{
+  try
+  {
+    append(theKey, theParameter);
+    append(theKey, theAreaFunction);
+    append(theKey, theTimeFunction);
+    append(theKey, theSubTimeFunction);
+
+    if (!key(theAreaAcceptor, theKey) || !key(theTimeAcceptor, theKey) ||
+        !key(theTester, theKey))
+      return false;
+
+    key(theSources, theKey);
+    key(theArea, theKey);
+    key(thePeriods, theKey);
+    return true;
+  }
+  catch (...)
+  {
+    throw Fmi::Exception::Trace(BCP, "Operation failed");
+  }
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Append the structural key of an acceptor
+ *
+ * RangeAcceptor is keyed by its limits, which are recovered from its
+ * behaviour since it has no accessors for them.
+ *
+ * \param theAcceptor The acceptor
+ * \param theKey The key to append to
+ * \return False if the acceptor type is not known
+ */
+// ----------------------------------------------------------------------
+
+bool AnalysisCache::key(const Acceptor& theAcceptor, std::string& theKey)
+{
+  try
+  {
+    const std::type_info& type = typeid(theAcceptor);
+
+    if (type == typeid(DefaultAcceptor))
+    {
+      theKey += 'D';
+      return true;
+    }
+    if (type == typeid(NullAcceptor))
+    {
+      theKey += 'N';
+      return true;
+    }
+    if (type == typeid(PositiveValueAcceptor))
+    {
+      theKey += 'P';
+      return true;
+    }
+    if (type == typeid(RangeAcceptor))
+    {
+      const auto& acceptor = static_cast<const RangeAcceptor&>(theAcceptor);
+      theKey += 'R';
+      append(theKey, limit(acceptor, true));
+      append(theKey, limit(acceptor, false));
+      return true;
+    }
+    if (type == typeid(ValueAcceptor))
+    {
+      theKey += 'V';
+      append(theKey, static_cast<const ValueAcceptor&>(theAcceptor).value());
+      return true;
+    }
+    if (type == typeid(ComparativeAcceptor))
+    {
+      const auto& acceptor = static_cast<const ComparativeAcceptor&>(theAcceptor);
+      theKey += 'C';
+      append(theKey, acceptor.getLimit());
+      append(theKey, acceptor.getOperator());
+      return true;
+    }
+    if (type == typeid(FunctionAcceptor))
+    {
+      theKey += 'F';
+      append(theKey, static_cast<const FunctionAcceptor&>(theAcceptor).functor());
+      return true;
+    }
+    if (type == typeid(AndAcceptor))
+    {
+      const auto& acceptor = static_cast<const AndAcceptor&>(theAcceptor);
+      theKey += '&';
+      return key(acceptor.lhs(), theKey) && key(acceptor.rhs(), theKey);
+    }
+    if (type == typeid(OrAcceptor))
+    {
+      const auto& acceptor = static_cast<const OrAcceptor&>(theAcceptor);
+      theKey += '|';
+      return key(acceptor.lhs(), theKey) && key(acceptor.rhs(), theKey);
+    }
+    return false;
+  }
+  catch (...)
+  {
+    throw Fmi::Exception::Trace(BCP, "Operation failed");
+  }
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Append the structural key of a weather area
+ *
+ * The key covers everything which affects the mask of the area:
+ * the type, the point or path geometry, the radius and the division
+ * lines. The geometry is represented by the fingerprint of the mask
+ * storage instead of the full path, which keeps the keys short. The
+ * name is included too so that differently named areas never share
+ * results.
+ *
+ * \param theArea The area
+ * \param theKey The key to append to
+ */
+// ----------------------------------------------------------------------
+
+void AnalysisCache::key(const WeatherArea& theArea, std::string& theKey)
+{
+  try
+  {
+    append(theKey, theArea.type());
+    append(theKey, theArea.radius());
+    append(theKey, theArea.isMarine());
+
+    if (theArea.isNamed())
+    {
+      append(theKey, theArea.name().size());
+      theKey += theArea.name();
+    }
+
+    if (theArea.latitudeDivisionLineSet())
+    {
+      theKey += 'Y';
+      append(theKey, theArea.getLatitudeDivisionLine());
+    }
+    if (theArea.longitudeDivisionLineSet())
+    {
+      theKey += 'X';
+      append(theKey, theArea.getLongitudeDivisionLine());
+    }
+
+    append(theKey, MaskStorage::fingerprint(theArea));
+  }
+  catch (...)
+  {
+    throw Fmi::Exception::Trace(BCP, "Operation failed");
+  }
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Append the structural key of a period generator
+ *
+ * \param thePeriods The period generator
+ * \param theKey The key to append to
+ */
+// ----------------------------------------------------------------------
+
+void AnalysisCache::key(const WeatherPeriodGenerator& thePeriods, std::string& theKey)
+{
+  try
+  {
+    append(theKey, thePeriods.undivided());
+
+    const WeatherPeriod period = thePeriods.period();
+    append(theKey, period.utcStartTime().EpochTime());
+    append(theKey, period.utcEndTime().EpochTime());
+
+    const WeatherPeriodGenerator::size_type n = thePeriods.size();
+    append(theKey, n);
+    for (WeatherPeriodGenerator::size_type i = 1; i <= n; i++)
+    {
+      const WeatherPeriod subperiod = thePeriods.period(i);
+      append(theKey, subperiod.utcStartTime().EpochTime());
+      append(theKey, subperiod.utcEndTime().EpochTime());
+    }
+  }
+  catch (...)
+  {
+    throw Fmi::Exception::Trace(BCP, "Operation failed");
+  }
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Append the identity of the analysis sources
+ *
+ * Sources are keyed by the identity of the components, the data
+ * itself is assumed to stay unchanged during one generate call.
+ *
+ * \param theSources The analysis sources
+ * \param theKey The key to append to
+ */
+// ----------------------------------------------------------------------
+
+void AnalysisCache::key(const AnalysisSources& theSources, std::string& theKey)
+{
+  try
+  {
+    append(theKey, theSources.getWeatherSource().get());
+    append(theKey, theSources.getMaskSource().get());
+    append(theKey, theSources.getLandMaskSource().get());
+    append(theKey, theSources.getCoastMaskSource().get());
+    append(theKey, theSources.getInlandMaskSource().get());
+    append(theKey, theSources.getNorthernMaskSource().get());
+    append(theKey, theSources.getSouthernMaskSource().get());
+    append(theKey, theSources.getEasternMaskSource().get());
+    append(theKey, theSources.getWesternMaskSource().get());
+  }
+  catch (...)
+  {
+    throw Fmi::Exception::Trace(BCP, "Operation failed");
+  }
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Return the cache active in the calling thread, or nullptr
+ */
+// ----------------------------------------------------------------------
+
+AnalysisCache* AnalysisCache::current()
+{
+  return tCurrentCache;
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Activate the given cache for the calling thread
+ *
+ * \param theCache The cache, or nullptr to disable caching
+ */
+// ----------------------------------------------------------------------
+
+AnalysisCache::Scope::Scope(AnalysisCache* theCache) : itsPrevious(tCurrentCache)
+{
+  tCurrentCache = theCache;
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Restore the previously active cache
+ */
+// ----------------------------------------------------------------------
+
+AnalysisCache::Scope::~Scope()
+{
+  tCurrentCache = itsPrevious;
+}
+
+}  // namespace TextGen
+
+// ======================================================================
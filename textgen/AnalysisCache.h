@@ -0,0 +1,87 @@
+// ======================================================================
+/*!
+ * \file
+ * \brief Interface of class TextGen::AnalysisCache
+ */
+// ======================================================================
+
+#pragma once
+
+#include <calculator/WeatherFunction.h>
+#include <calculator/WeatherParameter.h>
+#include <calculator/WeatherResult.h>
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace TextGen
+{
+class Acceptor;
+class AnalysisSources;
+class WeatherArea;
+class WeatherPeriodGenerator;
+
+class AnalysisCache
+{
+ public:
+  AnalysisCache() = default;
+  AnalysisCache(const AnalysisCache& theOther) = delete;
+  AnalysisCache& operator=(const AnalysisCache& theOther) = delete;
+
+  bool find(const std::string& theKey, WeatherResult& theResult) const;
+  void insert(const std::string& theKey, const WeatherResult& theResult);
+  void clear();
+
+  std::size_t size() const;
+  unsigned long hits() const { return itsHits; }
+  unsigned long misses() const { return itsMisses; }
+
+  static bool key(const AnalysisSources& theSources,
+                  const WeatherParameter& theParameter,
+                  const WeatherFunction& theAreaFunction,
+                  const WeatherFunction& theTimeFunction,
+                  const WeatherFunction& theSubTimeFunction,
+                  const WeatherArea& theArea,
+                  const WeatherPeriodGenerator& thePeriods,
+                  const Acceptor& theAreaAcceptor,
+                  const Acceptor& theTimeAcceptor,
+                  const Acceptor& theTester,
+                  std::string& theKey);
+
+  static bool key(const Acceptor& theAcceptor, std::string& theKey);
+  static void key(const WeatherArea& theArea, std::string& theKey);
+  static void key(const WeatherPeriodGenerator& thePeriods, std::string& theKey);
+  static void key(const AnalysisSources& theSources, std::string& theKey);
+
+  static AnalysisCache* current();
+
+  // Activates a cache for the calling thread for the lifetime of the object
+
+  class Scope
+  {
+   public:
+    Scope() = delete;
+    Scope(const Scope& theOther) = delete;
+    Scope& operator=(const Scope& theOther) = delete;
+    explicit Scope(AnalysisCache* theCache);
+    ~Scope();
+
+   private:
+    AnalysisCache* itsPrevious;
+  };
+
+ private:
+  using storage_type = std::unordered_map<std::string, WeatherResult>;
+
+  mutable std::mutex itsMutex;
+  storage_type itsResults;
+  mutable std::atomic<unsigned long> itsHits{0};
+  mutable std::atomic<unsigned long> itsMisses{0};
+
+};  // class AnalysisCache
+
+}  // namespace TextGen
+
+// ======================================================================
@@ -26,6 +26,9 @@ class AndAcceptor : public Acceptor
   bool accept(float theValue) const override;
   Acceptor* clone() const override;
 
+  const Acceptor& lhs() const { return *itsLhs; }
+  const Acceptor& rhs() const { return *itsRhs; }
+
  private:
   Acceptor* itsLhs;
   Acceptor* itsRhs;
@@ -14,6 +14,7 @@
 // ======================================================================
 
 #include "AreaTools.h"
+#include "GridCoordinates.h"
 #include "SubMaskExtractor.h"
 #include <calculator/ParameterAnalyzer.h>
 #include <calculator/RegularMaskSource.h>
@@ -121,6 +122,37 @@ bool isPartOfArea(const WeatherArea& theWeatherArea,
 }
 #endif
 
+// ----------------------------------------------------------------------
+/*!
+ * \brief The shared coordinate table of the grid of the data
+ *
+ * Null is returned for point data, whose coordinates are read from
+ * the data itself.
+ */
+// ----------------------------------------------------------------------
+
+std::shared_ptr<const GridCoordinates> grid_coordinates(const NFmiFastQueryInfo& theQI)
+{
+  if (!theQI.IsGrid())
+    return {};
+  return GridCoordinates::get(*theQI.Grid());
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief The coordinates of a location from the table if there is one
+ */
+// ----------------------------------------------------------------------
+
+NFmiPoint location_latlon(NFmiFastQueryInfo& theQI,
+                          const std::shared_ptr<const GridCoordinates>& theCoordinates,
+                          unsigned long theIndex)
+{
+  if (theCoordinates)
+    return theCoordinates->latlon(theIndex);
+  return theQI.LatLon(theIndex);
+}
+
 }  // namespace
 
 NFmiPoint getArealDistribution(const AnalysisSources& theSources,
@@ -155,10 +187,14 @@ NFmiPoint getArealDistribution(const AnalysisSources& theSources,
 
     ExtractMask(theSources, theParameter, theArea, thePeriod, theAcceptor, indexMask);
 
+    std::shared_ptr<const GridCoordinates> coordinates;
+    if (!indexMask.empty())
+      coordinates = grid_coordinates(theQI);
+
     vector<NFmiPoint> latitudeLongitudeCoordinates;
     for (unsigned long it : indexMask)
     {
-      NFmiPoint latlon = theQI.LatLon(it);
+      NFmiPoint latlon = location_latlon(theQI, coordinates, it);
       lonSum += latlon.X();
       latSum += latlon.Y();
       latitudeLongitudeCoordinates.push_back(latlon);
@@ -411,9 +447,11 @@ Rect::Rect(const AnalysisSources& theSources,
   double lon_max = 0.0;
   double lat_max = 0.0;
 
+  const std::shared_ptr<const GridCoordinates> coordinates = grid_coordinates(theQI);
+
   for (unsigned long it : theIndexMask)
   {
-    NFmiPoint point = theQI.LatLon(it);
+    NFmiPoint point = location_latlon(theQI, coordinates, it);
     lon_min = std::min(lon_min, point.X());
     lon_max = std::max(lon_max, point.X());
     lat_min = std::min(lat_min, point.Y());
@@ -0,0 +1,120 @@
+// ======================================================================
+/*!
+ * \file
+ * \brief Implementation of class TextGen::CachedGridForecaster
+ */
+// ======================================================================
+/*!
+ * \class TextGen::CachedGridForecaster
+ *
+ * \brief A GridForecaster which memoizes its results
+ *
+ * If an AnalysisCache is active in the calling thread, results are
+ * looked up from it before the grid is analyzed, and new results are
+ * stored into it. Without an active cache the class behaves exactly
+ * like GridForecaster.
+ *
+ * Fake variables are resolved by the WeatherAnalyzer interface before
+ * the actual analysis is requested, hence faked results never enter
+ * the cache.
+ *
+ */
+// ======================================================================
+
+#include "CachedGridForecaster.h"
+#include "AnalysisCache.h"
+#include <calculator/Acceptor.h>
+#include <calculator/AnalysisSources.h>
+#include <calculator/WeatherArea.h>
+#include <calculator/WeatherPeriodGenerator.h>
+#include <calculator/WeatherResult.h>
+#include <macgyver/Exception.h>
+#include <newbase/NFmiGlobals.h>
+
+#include <string>
+
+namespace TextGen
+{
+// ----------------------------------------------------------------------
+/*!
+ * \brief Analyze weather forecast for area, consulting the active cache
+ *
+ * \param theSources Analysis sources
+ * \param theParameter The weather phenomenon to analyze
+ * \param theAreaFunction The area function
+ * \param theTimeFunction The time function
+ * \param theSubTimeFunction The time function for subperiods
+ * \param theArea The area to analyze
+ * \param thePeriods The time periods to analyze
+ * \param theAreaAcceptor The weather data acceptor in area integration
+ * \param theTimeAcceptor The weather data acceptor in time integration
+ * \param theTester The acceptor for Percentage calculations
+ * \return The result of the analysis
+ */
+// ----------------------------------------------------------------------
+
+WeatherResult CachedGridForecaster::analyze(const AnalysisSources& theSources,
+                                            const WeatherParameter& theParameter,
+                                            const WeatherFunction& theAreaFunction,
+                                            const WeatherFunction& theTimeFunction,
+                                            const WeatherFunction& theSubTimeFunction,
+                                            const WeatherArea& theArea,
+                                            const WeatherPeriodGenerator& thePeriods,
+                                            const Acceptor& theAreaAcceptor,
+                                            const Acceptor& theTimeAcceptor,
+                                            const Acceptor& theTester) const
+{
+  try
+  {
+    AnalysisCache* cache = AnalysisCache::current();
+
+    std::string key;
+
+    if (cache != nullptr)
+    {
+      if (!AnalysisCache::key(theSources,
+                              theParameter,
+                              theAreaFunction,
+                              theTimeFunction,
+                              theSubTimeFunction,
+                              theArea,
+                              thePeriods,
+                              theAreaAcceptor,
+                              theTimeAcceptor,
+                              theTester,
+                              key))
+      {
+        cache = nullptr;
+      }
+      else
+      {
+        WeatherResult result(kFloatMissing, 0);
+        if (cache->find(key, result))
+          return result;
+      }
+    }
+
+    WeatherResult result = GridForecaster::analyze(theSources,
+                                                   theParameter,
+                                                   theAreaFunction,
+                                                   theTimeFunction,
+                                                   theSubTimeFunction,
+                                                   theArea,
+                                                   thePeriods,
+                                                   theAreaAcceptor,
+                                                   theTimeAcceptor,
+                                                   theTester);
+    if (cache != nullptr)
+      cache->insert(key, result);
+
+    return result;
+  }
+  catch (...)
+  {
+    throw Fmi::Exception::Trace(BCP, "Operation failed");
+  }
+}
+
+}  // namespace TextGen
+
+// ======================================================================
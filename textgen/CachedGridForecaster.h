@@ -0,0 +1,34 @@
+// ======================================================================
+/*!
+ * \file
+ * \brief Interface of class TextGen::CachedGridForecaster
+ */
+// ======================================================================
+
+#pragma once
+
+#include <calculator/GridForecaster.h>
+
+namespace TextGen
+{
+class CachedGridForecaster : public GridForecaster
+{
+ public:
+  using GridForecaster::analyze;
+
+  WeatherResult analyze(const AnalysisSources& theSources,
+                        const WeatherParameter& theParameter,
+                        const WeatherFunction& theAreaFunction,
+                        const WeatherFunction& theTimeFunction,
+                        const WeatherFunction& theSubTimeFunction,
+                        const WeatherArea& theArea,
+                        const WeatherPeriodGenerator& thePeriods,
+                        const Acceptor& theAreaAcceptor = DefaultAcceptor(),
+                        const Acceptor& theTimeAcceptor = DefaultAcceptor(),
+                        const Acceptor& theTester = NullAcceptor()) const override;
+
+};  // class CachedGridForecaster
+
+}  // namespace TextGen
+
+// ======================================================================
@@ -351,14 +351,14 @@ float CloudinessForecast::getMeanCloudiness(const WeatherPeriod& theWeatherPerio
   {
     float cloudinessSum = 0;
     unsigned int count = 0;
+    const std::time_t startTime = theWeatherPeriod.localStartTime().EpochTime();
+    const std::time_t endTime = theWeatherPeriod.localEndTime().EpochTime();
     for (const auto& i : theDataVector)
     {
-      if (i->thePeriod.localStartTime() >= theWeatherPeriod.localStartTime() &&
-          i->thePeriod.localStartTime() <= theWeatherPeriod.localEndTime() &&
-          i->thePeriod.localEndTime() >= theWeatherPeriod.localStartTime() &&
-          i->thePeriod.localEndTime() <= theWeatherPeriod.localEndTime())
+      if (i.startTime() >= startTime && i.startTime() <= endTime && i.endTime() >= startTime &&
+          i.endTime() <= endTime)
       {
-        cloudinessSum += i->theResult.value();
+        cloudinessSum += i.value();
         count++;
       }
     }
@@ -17,10 +17,10 @@
 // ======================================================================
 
 #include "CloudinessStoryTools.h"
+#include "CachedGridForecaster.h"
 #include "MessageLogger.h"
 #include "Sentence.h"
 #include <calculator/AnalysisSources.h>
-#include <calculator/GridForecaster.h>
 #include <calculator/RangeAcceptor.h>
 #include <calculator/Settings.h>
 #include <calculator/WeatherResult.h>
@@ -547,7 +547,7 @@ Sentence cloudiness_phrase(const AnalysisSources& theSources,
     RangeAcceptor clearlimits;
     clearlimits.upperLimit(clear);
 
-    GridForecaster forecaster;
+    CachedGridForecaster forecaster;
 
     const string daystr = "day" + std::to_string(theDay);
 
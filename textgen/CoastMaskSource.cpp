@@ -20,6 +20,10 @@
 // ======================================================================
 
 #include "CoastMaskSource.h"
+#include "GridMask.h"
+#include "MaskCache.h"
+#include "MaskStorage.h"
+#include "RasterMaskTools.h"
 
 #include <calculator/WeatherArea.h>
 #include <calculator/WeatherSource.h>
@@ -29,45 +33,16 @@
 #include <newbase/NFmiGrid.h>
 #include <newbase/NFmiIndexMask.h>
 #include <newbase/NFmiIndexMaskSource.h>
-#include <newbase/NFmiIndexMaskTools.h>
 #include <newbase/NFmiQueryData.h>
 
 #include <map>
 #include <memory>
+#include <mutex>
 
 using namespace std;
 
-using namespace NFmiIndexMaskTools;
-
 namespace TextGen
 {
-// ----------------------------------------------------------------------
-/*!
- * \brief Utility structure to each cache management
- */
-// ----------------------------------------------------------------------
-
-struct WeatherAreaAndID
-{
-  WeatherId itsID;
-  WeatherArea itsArea;
-
-  WeatherAreaAndID(const WeatherId& theID, const WeatherArea& theArea)
-      : itsID(theID), itsArea(theArea)
-  {
-  }
-
-  bool operator==(const WeatherAreaAndID& theOther) const
-  {
-    return (itsID == theOther.itsID && itsArea == theOther.itsArea);
-  }
-
-  bool operator<(const WeatherAreaAndID& theOther) const
-  {
-    return (itsID != theOther.itsID ? itsID < theOther.itsID : itsArea < theOther.itsArea);
-  }
-};
-
 // ----------------------------------------------------------------------
 /*!
  * \brief Implementation hiding detail for TextGen::CoastMaskSource
@@ -79,17 +54,15 @@ class CoastMaskSource::Pimple
  public:
   Pimple(const WeatherArea& theCoast);
 
-  using mask_storage = map<WeatherAreaAndID, mask_type>;
-  using masks_storage = map<WeatherAreaAndID, masks_type>;
-
   const WeatherArea itsCoast;
 
-  mutable mask_storage itsMaskStorage;
-  mutable masks_storage itsMasksStorage;
+  using grid_storage = map<WeatherId, std::shared_ptr<const GridMask>>;
 
-  mask_type find(const WeatherId& theID, const WeatherArea& theArea) const;
+  MaskStorage itsMaskStorage;
+  mutable grid_storage itsCoastStorage;
+  mutable std::mutex itsMutex;
 
-  void insert(const WeatherId& theID, const WeatherArea& theArea, const mask_type& theMask) const;
+  std::shared_ptr<const GridMask> coast_mask(const WeatherId& theID, const NFmiGrid& theGrid) const;
 
   mask_type create_mask(const WeatherArea& theArea,
                         const std::string& theData,
@@ -107,61 +80,33 @@ CoastMaskSource::Pimple::Pimple(const WeatherArea& theCoast) : itsCoast(theCoast
 
 // ----------------------------------------------------------------------
 /*!
- * \brief Find mask from cache
- *
- * Returns a 0-shared pointer if mask is not found
- *
- * \param theID The weather ID
- * \param theArea The weather area
- * \return shared_ptr to mask or 0
- */
-// ----------------------------------------------------------------------
-
-CoastMaskSource::mask_type CoastMaskSource::Pimple::find(const WeatherId& theID,
-                                                         const WeatherArea& theArea) const
-{
-  try
-  {
-    static std::shared_ptr<NFmiIndexMask> dummy;
-
-    WeatherAreaAndID key(theID, theArea);
-
-    auto it = itsMaskStorage.find(key);
-    if (it == itsMaskStorage.end())
-      return dummy;
-
-    return it->second;
-  }
-  catch (...)
-  {
-    throw Fmi::Exception::Trace(BCP, "Operation failed");
-  }
-}
-
-// ----------------------------------------------------------------------
-/*!
- * \brief Insert a new mask into the cache
+ * \brief Find or build the coast mask for the data
  *
  * \param theID The data ID
- * \param theArea The weather area
- * \param theMask The mask itself
+ * \param theGrid The grid of the data
+ * \return The coast mask
  */
 // ----------------------------------------------------------------------
 
-void CoastMaskSource::Pimple::insert(const WeatherId& theID,
-                                     const WeatherArea& theArea,
-                                     const mask_type& theMask) const
+std::shared_ptr<const GridMask> CoastMaskSource::Pimple::coast_mask(
+    const WeatherId& theID, const NFmiGrid& theGrid) const
 {
   try
   {
-    using value_type = mask_storage::value_type;
-
-    WeatherAreaAndID key(theID, theArea);
+    {
+      std::lock_guard<std::mutex> lock(itsMutex);
+      auto it = itsCoastStorage.find(theID);
+      if (it != itsCoastStorage.end())
+        return it->second;
+    }
 
-    itsMaskStorage.insert(value_type(key, theMask));
+    const NFmiSvgPath& csvg = itsCoast.path();
+    const float cdistance = itsCoast.radius();
+    auto coastmask =
+        std::make_shared<const GridMask>(RasterMaskTools::MaskDistance(theGrid, csvg, cdistance));
 
-    if (itsMaskStorage.insert(value_type(key, theMask)).second)
-      throw Fmi::Exception(BCP, "Could not cache mask for " + theArea.name());
+    std::lock_guard<std::mutex> lock(itsMutex);
+    return itsCoastStorage.insert(grid_storage::value_type(theID, coastmask)).first->second;
   }
   catch (...)
   {
@@ -195,29 +140,29 @@ CoastMaskSource::mask_type CoastMaskSource::Pimple::create_mask(
       throw Fmi::Exception(
           BCP, "The data in " + theData + " is not gridded - cannot generate mask for it");
 
-    // First build the area mask
+    const NFmiGrid& grid = *(qi.Grid());
+    const WeatherId id = theWeatherSource.id(theData);
+    const MaskCache::Key key = MaskCache::Key("coast").add(grid).add(theArea).add(itsCoast);
 
-    const NFmiSvgPath& svg = theArea.path();
-    const float radius = theArea.radius();
-    mask_type areamask(new NFmiIndexMask(MaskExpand(*(qi.Grid()), svg, radius)));
+    auto create = [&]()
+    {
+      // First build the area mask
 
-    // Then build the coast mask
+      const NFmiSvgPath& svg = theArea.path();
+      const float radius = theArea.radius();
+      GridMask areamask = RasterMaskTools::MaskExpand(grid, svg, radius);
 
-    WeatherId id = theWeatherSource.id(theData);
-    mask_type coastmask = find(id, itsCoast);
-    if (coastmask.get() == nullptr)
-    {
-      const NFmiSvgPath& csvg = itsCoast.path();
-      const float cdistance = itsCoast.radius();
-      coastmask = std::make_shared<NFmiIndexMask>(MaskDistance(*(qi.Grid()), csvg, cdistance));
-      insert(id, itsCoast, coastmask);
-    }
+      // Then build the coast mask
 
-    // The intersection is the coastal area
+      std::shared_ptr<const GridMask> coastmask = coast_mask(id, grid);
 
-    *areamask &= *coastmask;
+      // The intersection is the coastal area
 
-    return areamask;
+      areamask &= *coastmask;
+      return areamask;
+    };
+
+    return MaskCache::find_or_create(key, grid, create).mask();
   }
   catch (...)
   {
@@ -251,13 +196,11 @@ CoastMaskSource::mask_type CoastMaskSource::mask(const WeatherArea& theArea,
     if (theArea.isPoint())
       throw Fmi::Exception(BCP, "Trying to generate mask for point");
 
-    // Establish the ID for the data
-
-    WeatherId id = theWeatherSource.id(theData);
-
     // Try to find cached mask first
 
-    mask_type areamask = itsPimple->find(id, theArea);
+    const MaskStorage::Key key(theWeatherSource.id(theData), theArea);
+
+    mask_type areamask = itsPimple->itsMaskStorage.find(key);
 
     if (areamask.get() != nullptr)
       return areamask;
@@ -265,9 +208,7 @@ CoastMaskSource::mask_type CoastMaskSource::mask(const WeatherArea& theArea,
     // Calculate new mask and cache it
 
     areamask = itsPimple->create_mask(theArea, theData, theWeatherSource);
-    itsPimple->insert(id, theArea, areamask);
-
-    return areamask;
+    return itsPimple->itsMaskStorage.insert(key, areamask);
   }
   catch (...)
   {
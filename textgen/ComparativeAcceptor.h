@@ -33,6 +33,8 @@ class ComparativeAcceptor : public Acceptor
                       const comparative_operator& theOperator = VOID_OPERATOR);
   void setLimit(float theLimit);
   void setOperator(const comparative_operator& theOperator);
+  float getLimit() const { return itsLimit; }
+  comparative_operator getOperator() const { return itsOperator; }
 
  private:
   float itsLimit;
@@ -212,7 +212,7 @@ string CssTextFormatter::visit(const Sentence& theSentence) const
   {
     const string sep = TextFormatterTools::wordSeparator(itsDictionary.get());
     string ret = TextFormatterTools::realize(theSentence.begin(), theSentence.end(), *this, sep, "");
-    ret = TextFormatterTools::capitalize(ret);
+    ret = TextFormatterTools::capitalize(ret, itsDictionary.get());
     if (!ret.empty())
       ret += TextFormatterTools::sentenceEnd(itsDictionary.get());
 
@@ -292,7 +292,7 @@ string CssTextFormatter::visit(const Header& theHeader) const
 
     const string sep = TextFormatterTools::wordSeparator(itsDictionary.get());
     string text = TextFormatterTools::realize(theHeader.begin(), theHeader.end(), *this, sep, "");
-    text = TextFormatterTools::capitalize(text);
+    text = TextFormatterTools::capitalize(text, itsDictionary.get());
 
     if (text.empty())
       return "";
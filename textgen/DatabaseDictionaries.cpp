@@ -46,6 +46,7 @@
 
 #include "DatabaseDictionaries.h"
 #ifdef UNIX
+#include "MessageLogger.h"
 #include "MySQLDictionary.h"
 #include "PostgreSQLDictionary.h"
 #include <macgyver/Exception.h>
@@ -91,8 +92,59 @@ class DatabaseDictionaries::Pimple
 
   storage_type::const_iterator itsCurrentDictionary;
 
+  bool itsPreloaded{false};
+
+  void preload(const std::string& theDictionaryId);
+
 };  // class Pimple
 
+// ----------------------------------------------------------------------
+/*!
+ * \brief Read all the languages at once if the database supports it
+ *
+ * This is attempted only once. On failure the error is logged and the
+ * languages are read one at a time as before, so that a broken table
+ * of one language does not prevent using the others.
+ *
+ * \param theDictionaryId The database type
+ */
+// ----------------------------------------------------------------------
+
+void DatabaseDictionaries::Pimple::preload(const std::string& theDictionaryId)
+{
+  if (itsPreloaded)
+    return;
+  itsPreloaded = true;
+
+  if (theDictionaryId != "postgresql")
+    return;
+
+  try
+  {
+    map<string, map<string, string>> languages;
+    PostgreSQLDictionary::getAllDataFromDB(languages);
+
+    for (auto& language : languages)
+    {
+      auto dict = std::make_shared<PostgreSQLDictionary>();
+      dict->init(language.first, std::move(language.second));
+      itsData.insert(storage_type::value_type(language.first, dict));
+    }
+  }
+  catch (const std::exception& e)
+  {
+    MessageLogger log("DatabaseDictionaries::preload");
+    log << "Reading all languages failed, reading them one at a time: " << e.what() << '\n';
+    itsData.clear();
+  }
+  catch (...)
+  {
+    MessageLogger log("DatabaseDictionaries::preload");
+    log << "Reading all languages failed, reading them one at a time\n";
+    itsData.clear();
+  }
+}
+
 // ----------------------------------------------------------------------
 /*!
  * \brief Destructor
@@ -165,6 +217,17 @@ void DatabaseDictionaries::init(const std::string& theLanguage)
     if (itsPimple->itsCurrentDictionary != itsPimple->itsData.end())
       return;
 
+    // Read all languages at once if possible
+
+    itsPimple->preload(itsDictionaryId);
+
+    itsPimple->itsCurrentDictionary = itsPimple->itsData.find(theLanguage);
+    if (itsPimple->itsCurrentDictionary != itsPimple->itsData.end())
+    {
+      itsPimple->itsInitialized = true;
+      return;
+    }
+
     // Load new language
 
     std::shared_ptr<DatabaseDictionary> dict;
@@ -239,6 +302,30 @@ std::string DatabaseDictionaries::find(const std::string& theKey) const
   }
 }
 
+// ----------------------------------------------------------------------
+/*!
+ * \brief Return the phrase for the given interned key.
+ *
+ * \param theId The interned key of the phrase
+ * \return The phrase
+ */
+// ----------------------------------------------------------------------
+
+std::string DatabaseDictionaries::lookup(PhraseId theId) const
+{
+  try
+  {
+    if (!itsPimple->itsInitialized)
+      throw Fmi::Exception(BCP, "Error: DatabaseDictionaries::lookup() called before init()");
+
+    return itsPimple->itsCurrentDictionary->second->lookup(theId);
+  }
+  catch (...)
+  {
+    throw Fmi::Exception::Trace(BCP, "Operation failed");
+  }
+}
+
 // ----------------------------------------------------------------------
 /*!
  * \brief Inserting a new phrase into the dictionary is disabled
@@ -31,6 +31,7 @@ class DatabaseDictionaries : public Dictionary
   const std::string& language() const override;
   bool contains(const std::string& theKey) const override;
   std::string find(const std::string& theKey) const override;
+  std::string lookup(PhraseId theId) const override;
   void insert(const std::string& theKey, const std::string& thePhrase) override;
 
   size_type size() const override;
@@ -40,9 +40,11 @@
  */
 // ----------------------------------------------------------------------
 #include "DatabaseDictionary.h"
+#include "PhraseIndex.h"
 #include <macgyver/Exception.h>
 
 #include <map>
+#include <utility>
 
 using namespace std;
 
@@ -65,6 +67,7 @@ class DatabaseDictionary::Pimple
   bool itsInitialized{false};
   std::string itsLanguage;
   StorageType itsData;
+  PhraseIndex itsIndex;
 
 };  // class Pimple
 
@@ -141,9 +144,39 @@ void DatabaseDictionary::init(const std::string& theLanguage)
     itsPimple->itsLanguage = theLanguage;
     itsPimple->itsInitialized = false;
     itsPimple->itsData.clear();
+    itsPimple->itsIndex.clear();
 
     getDataFromDB(theLanguage, itsPimple->itsData);
 
+    itsPimple->itsIndex.assign(itsPimple->itsData);
+    itsPimple->itsInitialized = true;
+  }
+  catch (...)
+  {
+    throw Fmi::Exception::Trace(BCP, "Operation failed").addParameter("database", itsDictionaryId);
+  }
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Initialize with given language and translations
+ *
+ * This is used when the translations of several languages have
+ * been read from the database at once.
+ *
+ * \param theLanguage The ISO-code of the language
+ * \param theData The translations
+ */
+// ----------------------------------------------------------------------
+
+void DatabaseDictionary::init(const std::string& theLanguage,
+                              std::map<std::string, std::string> theData)
+{
+  try
+  {
+    itsPimple->itsLanguage = theLanguage;
+    itsPimple->itsData = std::move(theData);
+    itsPimple->itsIndex.assign(itsPimple->itsData);
     itsPimple->itsInitialized = true;
   }
   catch (...)
@@ -206,6 +239,31 @@ std::string DatabaseDictionary::find(const std::string& theKey) const
   }
 }
 
+// ----------------------------------------------------------------------
+/*!
+ * \brief Return the phrase with the given interned key
+ *
+ * Same as find() for the key, but served from the dense phrase index.
+ *
+ * \param theId The interned key of the phrase
+ * \return The phrase
+ */
+// ----------------------------------------------------------------------
+
+std::string DatabaseDictionary::lookup(PhraseId theId) const
+{
+  try
+  {
+    if (const auto* phrase = itsPimple->itsIndex.find(theId))
+      return std::string(*phrase);
+    return find(PhraseTable::word(theId));
+  }
+  catch (...)
+  {
+    throw Fmi::Exception::Trace(BCP, "Operation failed");
+  }
+}
+
 // ----------------------------------------------------------------------
 /*!
  * \brief Inserting a new phrase into the dictionary is disabled
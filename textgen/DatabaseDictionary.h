@@ -9,6 +9,7 @@
 #ifdef UNIX
 
 #include "Dictionary.h"
+#include <map>
 #include <memory>
 #include <string>
 
@@ -27,11 +28,13 @@ class DatabaseDictionary : public Dictionary
 #endif
 
   void init(const std::string& theLanguage) override;
+  void init(const std::string& theLanguage, std::map<std::string, std::string> theData);
   virtual void getDataFromDB(const std::string& theLanguage,
                              std::map<std::string, std::string>& theDataStorage) = 0;
   const std::string& language() const override;
   bool contains(const std::string& theKey) const override;
   std::string find(const std::string& theKey) const override;
+  std::string lookup(PhraseId theId) const override;
   void insert(const std::string& theKey, const std::string& thePhrase) override;
 
   size_type size() const override;
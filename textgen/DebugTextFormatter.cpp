@@ -180,7 +180,7 @@ string DebugTextFormatter::visit(const Sentence& theSentence) const
   {
     string ret =
         TextFormatterTools::realize(theSentence.begin(), theSentence.end(), *this, "", "\n");
-    ret = TextFormatterTools::capitalize(ret);
+    ret = TextFormatterTools::capitalize(ret, &itsDictionary);
     TextFormatterTools::punctuate(ret);
 
     return ret;
@@ -222,7 +222,7 @@ string DebugTextFormatter::visit(const Header& theHeader) const
   try
   {
     string ret = TextFormatterTools::realize(theHeader.begin(), theHeader.end(), *this, "", "\n");
-    ret = TextFormatterTools::capitalize(ret);
+    ret = TextFormatterTools::capitalize(ret, &itsDictionary);
     if (!ret.empty())
       ret += ':';
 
@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include "PhraseTable.h"
 #include <macgyver/Exception.h>
 #include <iostream>
 #include <map>
@@ -32,6 +33,7 @@ class Dictionary
   virtual const std::string& language() const = 0;
   virtual bool contains(const std::string& theKey) const = 0;
   virtual std::string find(const std::string& theKey) const = 0;
+  virtual std::string lookup(PhraseId theId) const { return find(PhraseTable::word(theId)); }
   virtual void insert(const std::string& theKey, const std::string& thePhrase) = 0;
 
   virtual void geoinit(void* theReactor) {}
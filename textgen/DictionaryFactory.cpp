@@ -28,6 +28,7 @@
 #include "DatabaseDictionaries.h"
 #include "FileDictionaries.h"
 #include "FileDictionary.h"
+#include "MmapDictionary.h"
 #include "MySQLDictionary.h"
 #include "NullDictionary.h"
 #include "PoDictionaries.h"
@@ -60,6 +61,8 @@ Dictionary* DictionaryFactory::create(const std::string& theType)
       return new FileDictionaries();
     if (theType == "po")
       return new PoDictionary();
+    if (theType == "mmap" || theType == "multimmap")
+      return new MmapDictionary();
 #ifdef UNIX
     if (theType == "multipo")
       return new PoDictionaries();
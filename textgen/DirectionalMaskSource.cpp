@@ -0,0 +1,204 @@
+// ======================================================================
+/*!
+ * \file
+ * \brief Implementation of class TextGen::DirectionalMaskSource
+ */
+// ======================================================================
+/*!
+ * \class TextGen::DirectionalMaskSource
+ *
+ * \brief Provides mask services to clients (masked to a part of the area)
+ *
+ * The DirectionalMaskSource class provides access to masks calculated
+ * from named SVG paths which represent geographic areas. This class is
+ * differentiated from RegularMaskSource by the fact that any mask
+ * is restricted to the part of the area in the given direction.
+ * NorthernMaskSource, SouthernMaskSource, EasternMaskSource and
+ * WesternMaskSource are instances of this class.
+ *
+ * The name of the source identifies its masks in the MaskCache
+ * directory, hence different directions must use different names.
+ */
+// ======================================================================
+
+#include "DirectionalMaskSource.h"
+#include "GridMask.h"
+#include "MaskCache.h"
+#include "MaskStorage.h"
+#include "SubMaskExtractor.h"
+
+#include <calculator/WeatherArea.h>
+#include <calculator/WeatherSource.h>
+#include <macgyver/Exception.h>
+
+#include <newbase/NFmiFastQueryInfo.h>
+#include <newbase/NFmiGrid.h>
+#include <newbase/NFmiIndexMask.h>
+#include <newbase/NFmiQueryData.h>
+
+#include <memory>
+
+using namespace std;
+
+namespace TextGen
+{
+// ----------------------------------------------------------------------
+/*!
+ * \brief Implementation hiding detail for TextGen::DirectionalMaskSource
+ */
+// ----------------------------------------------------------------------
+
+class DirectionalMaskSource::Pimple
+{
+ public:
+  Pimple(const WeatherArea& theArea, AreaTools::direction_id theDirection, std::string theName);
+
+  const WeatherArea itsArea;
+  const AreaTools::direction_id itsDirection;
+  const std::string itsName;
+
+  MaskStorage itsMaskStorage;
+
+  mask_type create_mask(const WeatherArea& theArea,
+                        const std::string& theData,
+                        const WeatherSource& theWeatherSource) const;
+
+};  // class DirectionalMaskSource::Pimple
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Pimple constructor
+ */
+// ----------------------------------------------------------------------
+
+DirectionalMaskSource::Pimple::Pimple(const WeatherArea& theArea,
+                                      AreaTools::direction_id theDirection,
+                                      std::string theName)
+    : itsArea(theArea), itsDirection(theDirection), itsName(std::move(theName))
+{
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Create a new weather area
+ *
+ * \param theArea The area
+ * \param theData The data name
+ * \param theWeatherSource The weather source
+ * \return The mask
+ */
+// ----------------------------------------------------------------------
+
+DirectionalMaskSource::mask_type DirectionalMaskSource::Pimple::create_mask(
+    const WeatherArea& theArea,
+    const std::string& theData,
+    const WeatherSource& theWeatherSource) const
+{
+  try
+  {
+    // Establish the grid which to mask
+
+    std::shared_ptr<NFmiQueryData> qdata = theWeatherSource.data(theData);
+    NFmiFastQueryInfo qi = NFmiFastQueryInfo(qdata.get());
+    if (!qi.IsGrid())
+      throw Fmi::Exception(
+          BCP, "The data in " + theData + " is not gridded - cannot generate mask for it");
+
+    const NFmiGrid& grid = *(qi.Grid());
+    const MaskCache::Key key = MaskCache::Key(itsName).add(grid).add(theArea);
+
+    auto create = [&]() { return GridMask(MaskDirection(grid, theArea, itsDirection), grid); };
+
+    return MaskCache::find_or_create(key, grid, create).mask();
+  }
+  catch (...)
+  {
+    throw Fmi::Exception::Trace(BCP, "Operation failed").addParameter("theData", theData);
+  }
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Constructor
+ *
+ * \param theArea The area
+ * \param theDirection The part of the areas to mask
+ * \param theName The name of the masks, for example "northern"
+ */
+// ----------------------------------------------------------------------
+
+DirectionalMaskSource::DirectionalMaskSource(const WeatherArea& theArea,
+                                             AreaTools::direction_id theDirection,
+                                             const std::string& theName)
+    : itsPimple(new Pimple(theArea, theDirection, theName))
+{
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Return the mask for the given area
+ *
+ * \param theArea The weather area
+ * \param theData The data name
+ * \param theWeatherSource The source for weather data
+ */
+// ----------------------------------------------------------------------
+
+DirectionalMaskSource::mask_type DirectionalMaskSource::mask(
+    const WeatherArea& theArea,
+    const std::string& theData,
+    const WeatherSource& theWeatherSource) const
+{
+  try
+  {
+    if (theArea.isPoint())
+      throw Fmi::Exception(BCP, "Trying to generate mask for point");
+
+    // Try to find cached mask first
+
+    const MaskStorage::Key key(theWeatherSource.id(theData), theArea);
+
+    mask_type areamask = itsPimple->itsMaskStorage.find(key);
+
+    if (areamask.get() != nullptr)
+      return areamask;
+
+    // Calculate new mask and cache it
+
+    areamask = itsPimple->create_mask(theArea, theData, theWeatherSource);
+    return itsPimple->itsMaskStorage.insert(key, areamask);
+  }
+  catch (...)
+  {
+    throw Fmi::Exception::Trace(BCP, "Operation failed").addParameter("theData", theData);
+  }
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Return the mask source for the given area
+ *
+ * \param theArea The weather area
+ * \param theData The data name
+ * \param theWeatherSource The source for weather data
+ */
+// ----------------------------------------------------------------------
+
+DirectionalMaskSource::masks_type DirectionalMaskSource::masks(
+    const WeatherArea& /*theArea*/,
+    const std::string& /*theData*/,
+    const WeatherSource& /*theWeatherSource*/) const
+{
+  try
+  {
+    throw Fmi::Exception(BCP, "DirectionalMaskSource::masks not implemented");
+  }
+  catch (...)
+  {
+    throw Fmi::Exception::Trace(BCP, "Operation failed");
+  }
+}
+
+}  // namespace TextGen
+
+// ======================================================================
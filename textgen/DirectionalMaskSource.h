@@ -0,0 +1,44 @@
+// ======================================================================
+/*!
+ * \file
+ * \brief Interface of class TextGen::DirectionalMaskSource
+ */
+// ======================================================================
+
+#pragma once
+
+#include "AreaTools.h"
+#include <calculator/MaskSource.h>
+
+#include <string>
+
+namespace TextGen
+{
+class DirectionalMaskSource : public MaskSource
+{
+ public:
+  using mask_type = MaskSource::mask_type;
+  using masks_type = MaskSource::masks_type;
+
+  DirectionalMaskSource() = delete;
+  DirectionalMaskSource(const WeatherArea& theArea,
+                        AreaTools::direction_id theDirection,
+                        const std::string& theName);
+
+  mask_type mask(const WeatherArea& theArea,
+                 const std::string& theData,
+                 const WeatherSource& theWeatherSource) const override;
+
+  masks_type masks(const WeatherArea& theArea,
+                   const std::string& theData,
+                   const WeatherSource& theWeatherSource) const override;
+
+ private:
+  class Pimple;
+  std::shared_ptr<Pimple> itsPimple;
+
+};  // class DirectionalMaskSource
+
+}  // namespace TextGen
+
+// ======================================================================
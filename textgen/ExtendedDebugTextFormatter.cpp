@@ -180,7 +180,7 @@ string ExtendedDebugTextFormatter::visit(const Sentence& theSentence) const
   {
     string txt =
         TextFormatterTools::realize(theSentence.begin(), theSentence.end(), *this, "", "\n");
-    txt = TextFormatterTools::capitalize(txt);
+    txt = TextFormatterTools::capitalize(txt, &itsDictionary);
     TextFormatterTools::punctuate(txt);
 
     return "<sentence var=\"" + itsSectionVar + "\">\n" + txt + "\n</sentence>\n";
@@ -222,7 +222,7 @@ string ExtendedDebugTextFormatter::visit(const Header& theHeader) const
   try
   {
     string txt = TextFormatterTools::realize(theHeader.begin(), theHeader.end(), *this, "", "\n");
-    txt = TextFormatterTools::capitalize(txt);
+    txt = TextFormatterTools::capitalize(txt, &itsDictionary);
     if (!txt.empty())
       txt += ':';
 
@@ -216,6 +216,30 @@ std::string FileDictionaries::find(const std::string& theKey) const
   }
 }
 
+// ----------------------------------------------------------------------
+/*!
+ * \brief Return the phrase for the given interned key.
+ *
+ * \param theId The interned key of the phrase
+ * \return The phrase
+ */
+// ----------------------------------------------------------------------
+
+std::string FileDictionaries::lookup(PhraseId theId) const
+{
+  try
+  {
+    if (!itsPimple->itsInitialized)
+      throw Fmi::Exception(BCP, "Error: FileDictionaries::lookup() called before init()");
+
+    return itsPimple->itsCurrentDictionary->second->lookup(theId);
+  }
+  catch (...)
+  {
+    throw Fmi::Exception::Trace(BCP, "Operation failed");
+  }
+}
+
 // ----------------------------------------------------------------------
 /*!
  * \brief Inserting a new phrase into the dictionary is disabled
@@ -40,6 +40,7 @@
 // ----------------------------------------------------------------------
 
 #include "FileDictionary.h"
+#include "PhraseIndex.h"
 #include <calculator/Settings.h>
 #include <macgyver/Exception.h>
 #include <newbase/NFmiFileSystem.h>
@@ -67,6 +68,7 @@ class FileDictionary::Pimple
   bool itsInitialized{false};
   std::string itsLanguage;
   StorageType itsData;
+  PhraseIndex itsIndex;
 
 };  // class Pimple
 
@@ -144,6 +146,7 @@ void FileDictionary::init(const std::string& theLanguage)
     itsPimple->itsLanguage = theLanguage;
     itsPimple->itsInitialized = false;
     itsPimple->itsData.clear();
+    itsPimple->itsIndex.clear();
 
     // Establish the settings for TextGen
 
@@ -170,6 +173,7 @@ void FileDictionary::init(const std::string& theLanguage)
         itsPimple->itsData.insert(Pimple::value_type(parts[0], parts[1]));
     }
 
+    itsPimple->itsIndex.assign(itsPimple->itsData);
     itsPimple->itsInitialized = true;
   }
   catch (...)
@@ -231,6 +235,31 @@ std::string FileDictionary::find(const std::string& theKey) const
   }
 }
 
+// ----------------------------------------------------------------------
+/*!
+ * \brief Return the phrase with the given interned key
+ *
+ * Same as find() for the key, but served from the dense phrase index.
+ *
+ * \param theId The interned key of the phrase
+ * \return The phrase
+ */
+// ----------------------------------------------------------------------
+
+std::string FileDictionary::lookup(PhraseId theId) const
+{
+  try
+  {
+    if (const auto* phrase = itsPimple->itsIndex.find(theId))
+      return std::string(*phrase);
+    return find(PhraseTable::word(theId));
+  }
+  catch (...)
+  {
+    throw Fmi::Exception::Trace(BCP, "Operation failed");
+  }
+}
+
 // ----------------------------------------------------------------------
 /*!
  * \brief Inserting a new phrase into the dictionary is disabled
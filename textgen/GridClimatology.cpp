@@ -14,10 +14,16 @@
  * grid climatology. Probabilities are calculated by analyzing the
  * gridded climatology.
  *
+ * If an AnalysisCache is active in the calling thread, the results
+ * are memoized in it like those of CachedGridForecaster. The keys are
+ * prefixed so that climatology and forecast analyses of the same
+ * parameter do not collide.
+ *
  */
 // ======================================================================
 
 #include "GridClimatology.h"
+#include "AnalysisCache.h"
 #include <calculator/Acceptor.h>
 #include <calculator/AnalysisSources.h>
 #include <calculator/ParameterAnalyzerFactory.h>
@@ -26,8 +32,10 @@
 #include <calculator/WeatherPeriodGenerator.h>
 #include <calculator/WeatherResult.h>
 #include <macgyver/Exception.h>
+#include <newbase/NFmiGlobals.h>
 
 #include <memory>
+#include <string>
 
 namespace TextGen
 {
@@ -62,18 +70,51 @@ WeatherResult GridClimatology::analyze(const AnalysisSources& theSources,
 {
   try
   {
+    AnalysisCache* cache = AnalysisCache::current();
+
+    std::string key;
+
+    if (cache != nullptr)
+    {
+      if (!AnalysisCache::key(theSources,
+                              theParameter,
+                              theAreaFunction,
+                              theTimeFunction,
+                              theSubTimeFunction,
+                              theArea,
+                              thePeriods,
+                              theAreaAcceptor,
+                              theTimeAcceptor,
+                              theTester,
+                              key))
+      {
+        cache = nullptr;
+      }
+      else
+      {
+        key.insert(0, "climatology|");
+        WeatherResult result(kFloatMissing, 0);
+        if (cache->find(key, result))
+          return result;
+      }
+    }
+
     std::shared_ptr<ParameterAnalyzer> analyzer(ParameterAnalyzerFactory::create(theParameter));
 
-    return analyzer->analyze(theSources,
-                             Climatology,
-                             theAreaFunction,
-                             theTimeFunction,
-                             theSubTimeFunction,
-                             theArea,
-                             thePeriods,
-                             theAreaAcceptor,
-                             theTimeAcceptor,
-                             theTester);
+    WeatherResult result = analyzer->analyze(theSources,
+                                             Climatology,
+                                             theAreaFunction,
+                                             theTimeFunction,
+                                             theSubTimeFunction,
+                                             theArea,
+                                             thePeriods,
+                                             theAreaAcceptor,
+                                             theTimeAcceptor,
+                                             theTester);
+    if (cache != nullptr)
+      cache->insert(key, result);
+
+    return result;
   }
   catch (...)
   {
@@ -0,0 +1,143 @@
+// ======================================================================
+/*!
+ * \file
+ * \brief Implementation of class TextGen::GridCoordinates
+ */
+// ======================================================================
+/*!
+ * \class TextGen::GridCoordinates
+ *
+ * \brief The longitudes and latitudes of all points of a grid
+ *
+ * NFmiGrid::LatLon runs the inverse projection on every call, and the
+ * area tools used to call it for every masked point at every time
+ * step. GridCoordinates calculates the coordinates once into separate
+ * longitude and latitude arrays, and get() shares one table between
+ * all users of the same grid.
+ *
+ * Grids are identified by the same key as in MaskCache: the grid size
+ * and the coordinates of the corners and the center. The full key is
+ * compared, not just its hash. Only the capacity() most recently used
+ * tables are kept, since a table takes 16 bytes per grid point. The
+ * coordinates are stored as doubles so that the results are identical
+ * to those calculated with NFmiGrid::LatLon.
+ */
+// ======================================================================
+
+#include "GridCoordinates.h"
+#include "MaskCache.h"
+
+#include <macgyver/Exception.h>
+
+#include <newbase/NFmiGrid.h>
+
+#include <list>
+#include <mutex>
+#include <string>
+#include <utility>
+
+namespace TextGen
+{
+namespace
+{
+// The shared tables and their keys, the most recently used first
+
+using entry_type = std::pair<std::string, std::shared_ptr<const GridCoordinates>>;
+
+std::mutex sMutex;
+std::list<entry_type> sEntries;
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Find a table and mark it the most recently used
+ *
+ * The caller must hold sMutex.
+ */
+// ----------------------------------------------------------------------
+
+std::shared_ptr<const GridCoordinates> find(const std::string& theKey)
+{
+  for (auto it = sEntries.begin(); it != sEntries.end(); ++it)
+  {
+    if (it->first == theKey)
+    {
+      sEntries.splice(sEntries.begin(), sEntries, it);
+      return it->second;
+    }
+  }
+  return {};
+}
+
+}  // namespace
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Calculate the coordinates of all grid points
+ */
+// ----------------------------------------------------------------------
+
+GridCoordinates::GridCoordinates(const NFmiGrid& theGrid)
+{
+  try
+  {
+    const unsigned long n = theGrid.XNumber() * theGrid.YNumber();
+    itsLon.resize(n);
+    itsLat.resize(n);
+    for (unsigned long idx = 0; idx < n; idx++)
+    {
+      const NFmiPoint p = theGrid.LatLon(idx);
+      itsLon[idx] = p.X();
+      itsLat[idx] = p.Y();
+    }
+  }
+  catch (...)
+  {
+    throw Fmi::Exception::Trace(BCP, "Operation failed");
+  }
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief The shared coordinate table of a grid
+ *
+ * The table is calculated on first use outside the lock. If two
+ * threads calculate the same table, the first one stored is used.
+ * Tables dropped from the cache remain valid for as long as they
+ * are used.
+ */
+// ----------------------------------------------------------------------
+
+std::shared_ptr<const GridCoordinates> GridCoordinates::get(const NFmiGrid& theGrid)
+{
+  try
+  {
+    const std::string key = MaskCache::Key("coordinates").add(theGrid).bytes();
+
+    {
+      std::lock_guard<std::mutex> lock(sMutex);
+      auto coordinates = find(key);
+      if (coordinates)
+        return coordinates;
+    }
+
+    auto coordinates = std::make_shared<const GridCoordinates>(theGrid);
+
+    std::lock_guard<std::mutex> lock(sMutex);
+    auto stored = find(key);
+    if (stored)
+      return stored;
+
+    sEntries.emplace_front(key, coordinates);
+    if (sEntries.size() > capacity())
+      sEntries.pop_back();
+    return coordinates;
+  }
+  catch (...)
+  {
+    throw Fmi::Exception::Trace(BCP, "Operation failed");
+  }
+}
+
+}  // namespace TextGen
+
+// ======================================================================
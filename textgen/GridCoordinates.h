@@ -0,0 +1,45 @@
+// ======================================================================
+/*!
+ * \file
+ * \brief Interface of class TextGen::GridCoordinates
+ */
+// ======================================================================
+
+#pragma once
+
+#include <newbase/NFmiPoint.h>
+
+#include <memory>
+#include <vector>
+
+class NFmiGrid;
+
+namespace TextGen
+{
+class GridCoordinates
+{
+ public:
+  explicit GridCoordinates(const NFmiGrid& theGrid);
+
+  static std::shared_ptr<const GridCoordinates> get(const NFmiGrid& theGrid);
+  // the number of most recently used tables kept by get()
+  static std::size_t capacity() { return 8; }
+
+  std::size_t size() const { return itsLon.size(); }
+
+  double lon(unsigned long theIndex) const { return itsLon[theIndex]; }
+  double lat(unsigned long theIndex) const { return itsLat[theIndex]; }
+  NFmiPoint latlon(unsigned long theIndex) const
+  {
+    return NFmiPoint(itsLon[theIndex], itsLat[theIndex]);
+  }
+
+ private:
+  std::vector<double> itsLon;
+  std::vector<double> itsLat;
+
+};  // class GridCoordinates
+
+}  // namespace TextGen
+
+// ======================================================================
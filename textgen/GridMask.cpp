@@ -0,0 +1,407 @@
+// ======================================================================
+/*!
+ * \file
+ * \brief Implementation of class TextGen::GridMask
+ */
+// ======================================================================
+/*!
+ * \class TextGen::GridMask
+ *
+ * \brief A mask over a grid stored as one bit per grid point
+ *
+ * NFmiIndexMask is a set of grid point indexes, hence building one
+ * allocates a node per point and intersecting two masks walks two
+ * trees. GridMask stores the same information in a bitset the size
+ * of the grid, 1/8 of a byte per grid point regardless of how many
+ * points are selected. Intersections, unions and differences are done
+ * 64 grid points at a time, and counting uses popcount.
+ *
+ * The mask can be read back as the indexes of the selected points,
+ * as runs of consecutive points on one grid row, or converted into
+ * an NFmiIndexMask for the MaskSource interface. The indexes are
+ * inserted in ascending order, which is the order of NFmiIndexMask.
+ *
+ * Sample usage:
+ * \code
+ * GridMask area(MaskExpand(grid, svg, radius), grid);
+ * area &= coast;
+ * return area.mask();
+ * \endcode
+ */
+// ======================================================================
+
+#include "GridMask.h"
+#include <macgyver/Exception.h>
+
+#include <newbase/NFmiGrid.h>
+#include <newbase/NFmiIndexMask.h>
+
+#include <algorithm>
+
+using namespace std;
+
+namespace TextGen
+{
+namespace
+{
+// ----------------------------------------------------------------------
+/*!
+ * \brief Find the first bit at or after the position with the given value
+ *
+ * \param theWords The bits
+ * \param thePos The position to start from
+ * \param theSize The number of bits, returned if no bit is found
+ * \param theValue True if searching for a set bit
+ */
+// ----------------------------------------------------------------------
+
+unsigned long find_bit(const vector<uint64_t>& theWords,
+                       unsigned long thePos,
+                       unsigned long theSize,
+                       bool theValue)
+{
+  const uint64_t flip = (theValue ? 0 : ~uint64_t(0));
+
+  unsigned long w = thePos / 64;
+  if (w >= theWords.size())
+    return theSize;
+
+  uint64_t word = (theWords[w] ^ flip) & (~uint64_t(0) << (thePos % 64));
+
+  while (word == 0)
+  {
+    if (++w >= theWords.size())
+      return theSize;
+    word = theWords[w] ^ flip;
+  }
+
+  return std::min(theSize, w * 64 + static_cast<unsigned long>(__builtin_ctzll(word)));
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Insert the points of the spans into an index mask
+ */
+// ----------------------------------------------------------------------
+
+void insert_spans(const vector<GridMask::Span>& theSpans, NFmiIndexMask& theMask)
+{
+  for (const auto& span : theSpans)
+    for (unsigned long idx = span.begin; idx < span.end; idx++)
+      theMask.insert(idx);
+}
+
+}  // namespace
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Construct an empty mask
+ *
+ * \param theWidth The number of grid points on a row
+ * \param theHeight The number of rows
+ */
+// ----------------------------------------------------------------------
+
+GridMask::GridMask(unsigned long theWidth, unsigned long theHeight)
+    : itsWidth(theWidth),
+      itsHeight(theHeight),
+      itsWords((theWidth * theHeight + word_bits - 1) / word_bits, 0)
+{
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Construct an empty mask for a grid
+ */
+// ----------------------------------------------------------------------
+
+GridMask::GridMask(const NFmiGrid& theGrid) : GridMask(theGrid.XNumber(), theGrid.YNumber()) {}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Construct from an index mask over a grid
+ */
+// ----------------------------------------------------------------------
+
+GridMask::GridMask(const NFmiIndexMask& theMask, const NFmiGrid& theGrid)
+    : GridMask(theMask, theGrid.XNumber(), theGrid.YNumber())
+{
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Construct from an index mask
+ *
+ * \param theMask The mask
+ * \param theWidth The number of grid points on a row
+ * \param theHeight The number of rows
+ */
+// ----------------------------------------------------------------------
+
+GridMask::GridMask(const NFmiIndexMask& theMask, unsigned long theWidth, unsigned long theHeight)
+    : GridMask(theWidth, theHeight)
+{
+  try
+  {
+    const unsigned long n = size();
+    for (unsigned long idx : theMask)
+    {
+      if (idx >= n)
+        throw Fmi::Exception(BCP, "Mask index is outside the grid");
+      set(idx);
+    }
+  }
+  catch (...)
+  {
+    throw Fmi::Exception::Trace(BCP, "Operation failed");
+  }
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Select a run of consecutive points
+ */
+// ----------------------------------------------------------------------
+
+void GridMask::set(const Span& theSpan)
+{
+  try
+  {
+    if (theSpan.begin > theSpan.end || theSpan.end > size())
+      throw Fmi::Exception(BCP, "Mask span is outside the grid");
+
+    unsigned long idx = theSpan.begin;
+    while (idx < theSpan.end && idx % word_bits != 0)
+      set(idx++);
+    while (idx + word_bits <= theSpan.end)
+    {
+      itsWords[idx / word_bits] = ~word_type(0);
+      idx += word_bits;
+    }
+    while (idx < theSpan.end)
+      set(idx++);
+  }
+  catch (...)
+  {
+    throw Fmi::Exception::Trace(BCP, "Operation failed");
+  }
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief The number of selected grid points
+ */
+// ----------------------------------------------------------------------
+
+std::size_t GridMask::count() const
+{
+  try
+  {
+    std::size_t n = 0;
+    for (word_type word : itsWords)
+      n += __builtin_popcountll(word);
+    return n;
+  }
+  catch (...)
+  {
+    throw Fmi::Exception::Trace(BCP, "Operation failed");
+  }
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief True if no grid point is selected
+ */
+// ----------------------------------------------------------------------
+
+bool GridMask::empty() const
+{
+  try
+  {
+    return std::all_of(itsWords.begin(), itsWords.end(), [](word_type word) { return word == 0; });
+  }
+  catch (...)
+  {
+    throw Fmi::Exception::Trace(BCP, "Operation failed");
+  }
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Intersection with another mask over the same grid
+ */
+// ----------------------------------------------------------------------
+
+GridMask& GridMask::operator&=(const GridMask& theOther)
+{
+  try
+  {
+    check(theOther);
+    for (std::size_t i = 0; i < itsWords.size(); i++)
+      itsWords[i] &= theOther.itsWords[i];
+    return *this;
+  }
+  catch (...)
+  {
+    throw Fmi::Exception::Trace(BCP, "Operation failed");
+  }
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Union with another mask over the same grid
+ */
+// ----------------------------------------------------------------------
+
+GridMask& GridMask::operator|=(const GridMask& theOther)
+{
+  try
+  {
+    check(theOther);
+    for (std::size_t i = 0; i < itsWords.size(); i++)
+      itsWords[i] |= theOther.itsWords[i];
+    return *this;
+  }
+  catch (...)
+  {
+    throw Fmi::Exception::Trace(BCP, "Operation failed");
+  }
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Remove the points of another mask over the same grid
+ */
+// ----------------------------------------------------------------------
+
+GridMask& GridMask::operator-=(const GridMask& theOther)
+{
+  try
+  {
+    check(theOther);
+    for (std::size_t i = 0; i < itsWords.size(); i++)
+      itsWords[i] &= ~theOther.itsWords[i];
+    return *this;
+  }
+  catch (...)
+  {
+    throw Fmi::Exception::Trace(BCP, "Operation failed");
+  }
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief The runs of consecutive selected points
+ *
+ * A run never continues from the end of a row to the start of the next.
+ */
+// ----------------------------------------------------------------------
+
+std::vector<GridMask::Span> GridMask::spans() const
+{
+  try
+  {
+    std::vector<Span> ret;
+
+    const unsigned long n = size();
+    unsigned long pos = find_bit(itsWords, 0, n, true);
+    while (pos < n)
+    {
+      const unsigned long rowend = (pos / itsWidth + 1) * itsWidth;
+      const unsigned long end = find_bit(itsWords, pos, rowend, false);
+      ret.push_back(Span{pos, end});
+      pos = find_bit(itsWords, end, n, true);
+    }
+    return ret;
+  }
+  catch (...)
+  {
+    throw Fmi::Exception::Trace(BCP, "Operation failed");
+  }
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief The indexes of the selected points in ascending order
+ */
+// ----------------------------------------------------------------------
+
+std::vector<unsigned long> GridMask::indexes() const
+{
+  try
+  {
+    std::vector<unsigned long> ret;
+    ret.reserve(count());
+
+    for (std::size_t w = 0; w < itsWords.size(); w++)
+    {
+      word_type word = itsWords[w];
+      while (word != 0)
+      {
+        ret.push_back(w * word_bits + __builtin_ctzll(word));
+        word &= word - 1;
+      }
+    }
+    return ret;
+  }
+  catch (...)
+  {
+    throw Fmi::Exception::Trace(BCP, "Operation failed");
+  }
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Convert to an index mask
+ */
+// ----------------------------------------------------------------------
+
+NFmiIndexMask GridMask::indexMask() const
+{
+  try
+  {
+    NFmiIndexMask ret;
+    insert_spans(spans(), ret);
+    return ret;
+  }
+  catch (...)
+  {
+    throw Fmi::Exception::Trace(BCP, "Operation failed");
+  }
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Convert to a mask as returned by mask sources
+ */
+// ----------------------------------------------------------------------
+
+MaskSource::mask_type GridMask::mask() const
+{
+  try
+  {
+    auto ret = std::make_shared<NFmiIndexMask>();
+    insert_spans(spans(), *ret);
+    return ret;
+  }
+  catch (...)
+  {
+    throw Fmi::Exception::Trace(BCP, "Operation failed");
+  }
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Check that the other mask is over a grid of the same size
+ */
+// ----------------------------------------------------------------------
+
+void GridMask::check(const GridMask& theOther) const
+{
+  if (itsWidth != theOther.itsWidth || itsHeight != theOther.itsHeight)
+    throw Fmi::Exception(BCP, "Cannot combine masks over grids of different sizes");
+}
+
+}  // namespace TextGen
+
+// ======================================================================
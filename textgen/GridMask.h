@@ -0,0 +1,80 @@
+// ======================================================================
+/*!
+ * \file
+ * \brief Interface of class TextGen::GridMask
+ */
+// ======================================================================
+
+#pragma once
+
+#include <calculator/MaskSource.h>
+
+#include <cstdint>
+#include <vector>
+
+class NFmiGrid;
+class NFmiIndexMask;
+
+namespace TextGen
+{
+class GridMask
+{
+ public:
+  //! Consecutive grid points [begin, end) on one grid row
+  struct Span
+  {
+    unsigned long begin;
+    unsigned long end;
+  };
+
+  GridMask(unsigned long theWidth, unsigned long theHeight);
+  explicit GridMask(const NFmiGrid& theGrid);
+  GridMask(const NFmiIndexMask& theMask, const NFmiGrid& theGrid);
+  GridMask(const NFmiIndexMask& theMask, unsigned long theWidth, unsigned long theHeight);
+
+  unsigned long width() const { return itsWidth; }
+  unsigned long height() const { return itsHeight; }
+  unsigned long size() const { return itsWidth * itsHeight; }
+
+  bool test(unsigned long theIndex) const
+  {
+    return (itsWords[theIndex / word_bits] >> (theIndex % word_bits)) & 1U;
+  }
+  void set(unsigned long theIndex)
+  {
+    itsWords[theIndex / word_bits] |= (word_type(1) << (theIndex % word_bits));
+  }
+  void reset(unsigned long theIndex)
+  {
+    itsWords[theIndex / word_bits] &= ~(word_type(1) << (theIndex % word_bits));
+  }
+  void set(const Span& theSpan);
+
+  std::size_t count() const;
+  bool empty() const;
+
+  GridMask& operator&=(const GridMask& theOther);
+  GridMask& operator|=(const GridMask& theOther);
+  GridMask& operator-=(const GridMask& theOther);
+
+  std::vector<Span> spans() const;
+  std::vector<unsigned long> indexes() const;
+
+  NFmiIndexMask indexMask() const;
+  MaskSource::mask_type mask() const;
+
+ private:
+  using word_type = std::uint64_t;
+  static const unsigned int word_bits = 64;
+
+  void check(const GridMask& theOther) const;
+
+  unsigned long itsWidth;
+  unsigned long itsHeight;
+  std::vector<word_type> itsWords;
+
+};  // class GridMask
+
+}  // namespace TextGen
+
+// ======================================================================
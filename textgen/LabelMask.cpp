@@ -0,0 +1,176 @@
+// ======================================================================
+/*!
+ * \file
+ * \brief Implementation of class TextGen::LabelMask
+ */
+// ======================================================================
+/*!
+ * \class TextGen::LabelMask
+ *
+ * \brief Membership of grid points in several masks of the same area
+ *
+ * Stories often analyze the same area as a whole and split into
+ * parts, for example the full, inland and coastal areas, or the full
+ * area and its northern and southern halves. The masks of the parts
+ * overlap, and analyzing each of them separately visits most grid
+ * points several times.
+ *
+ * A LabelMask is the union of the masks, with a set of labels for
+ * each grid point telling which of the masks contain it. Label i
+ * corresponds to the i'th mask, or the i'th area type. An analysis
+ * can then visit each grid point once and pass the value to the
+ * calculators of the labels the point has.
+ *
+ * The grid points are in ascending order, hence the points of each
+ * label are visited in the same order as with the original mask.
+ *
+ * Sample usage:
+ * \code
+ * LabelMask mask(sources, area, {WeatherArea::Full, WeatherArea::Coast}, "forecast");
+ * for (std::size_t i = 0; i < mask.size(); i++)
+ *   if (mask.memberships()[i].test(1))
+ *     ; // mask.indexes()[i] is on the coast
+ * \endcode
+ */
+// ======================================================================
+
+#include "LabelMask.h"
+#include "SubMaskExtractor.h"
+#include <macgyver/Exception.h>
+
+#include <newbase/NFmiIndexMask.h>
+
+#include <algorithm>
+
+using namespace std;
+
+namespace TextGen
+{
+// ----------------------------------------------------------------------
+/*!
+ * \brief Construct from the given masks
+ *
+ * \param theMasks The masks, at most max_labels
+ */
+// ----------------------------------------------------------------------
+
+LabelMask::LabelMask(const vector<MaskSource::mask_type>& theMasks)
+{
+  try
+  {
+    build(theMasks);
+  }
+  catch (...)
+  {
+    throw Fmi::Exception::Trace(BCP, "Operation failed");
+  }
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Construct from the masks of the given area types
+ *
+ * The masks are the same GetIndexMask returns for the area with each
+ * of the given types.
+ *
+ * \param theSources The analysis sources
+ * \param theArea The area
+ * \param theTypes The area types, at most max_labels
+ * \param theData The name of the data
+ */
+// ----------------------------------------------------------------------
+
+LabelMask::LabelMask(const AnalysisSources& theSources,
+                     const WeatherArea& theArea,
+                     const vector<WeatherArea::Type>& theTypes,
+                     const string& theData)
+{
+  try
+  {
+    vector<MaskSource::mask_type> masks;
+    for (auto type : theTypes)
+    {
+      WeatherArea area(theArea);
+      area.type(type);
+      masks.push_back(GetIndexMask(theSources, area, theData));
+    }
+    build(masks);
+  }
+  catch (...)
+  {
+    throw Fmi::Exception::Trace(BCP, "Operation failed");
+  }
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Merge the masks into the label sets of the grid points
+ *
+ * NFmiIndexMask iterates its grid points in ascending order, hence the
+ * union is formed by merging the masks in one linear pass.
+ */
+// ----------------------------------------------------------------------
+
+void LabelMask::build(const vector<MaskSource::mask_type>& theMasks)
+{
+  try
+  {
+    if (theMasks.size() > max_labels)
+      throw Fmi::Exception(BCP, "A label mask can hold at most 8 masks");
+
+    using iterator = NFmiIndexMask::const_iterator;
+
+    vector<iterator> positions;
+    vector<iterator> ends;
+    std::size_t largest = 0;
+    for (const auto& mask : theMasks)
+    {
+      positions.push_back(mask->begin());
+      ends.push_back(mask->end());
+      largest = std::max(largest, mask->size());
+    }
+
+    itsSizes.assign(theMasks.size(), 0);
+    itsIndexes.clear();
+    itsMemberships.clear();
+    itsIndexes.reserve(largest);
+    itsMemberships.reserve(largest);
+
+    while (true)
+    {
+      // The smallest grid point not yet merged
+
+      bool found = false;
+      unsigned long idx = 0;
+      for (unsigned int i = 0; i < positions.size(); i++)
+        if (positions[i] != ends[i] && (!found || *positions[i] < idx))
+        {
+          idx = *positions[i];
+          found = true;
+        }
+
+      if (!found)
+        break;
+
+      label_set labels;
+      for (unsigned int i = 0; i < positions.size(); i++)
+        if (positions[i] != ends[i] && *positions[i] == idx)
+        {
+          labels.set(i);
+          ++itsSizes[i];
+          ++positions[i];
+        }
+
+      itsIndexes.push_back(idx);
+      itsMemberships.push_back(labels);
+    }
+  }
+  catch (...)
+  {
+    throw Fmi::Exception::Trace(BCP, "Operation failed");
+  }
+}
+
+}  // namespace TextGen
+
+// ======================================================================
@@ -0,0 +1,55 @@
+// ======================================================================
+/*!
+ * \file
+ * \brief Interface of class TextGen::LabelMask
+ */
+// ======================================================================
+
+#pragma once
+
+#include <calculator/AnalysisSources.h>
+#include <calculator/MaskSource.h>
+#include <calculator/WeatherArea.h>
+
+#include <bitset>
+#include <string>
+#include <vector>
+
+namespace TextGen
+{
+class LabelMask
+{
+ public:
+  static const unsigned int max_labels = 8;
+  using label_set = std::bitset<max_labels>;
+
+  LabelMask() = default;
+  explicit LabelMask(const std::vector<MaskSource::mask_type>& theMasks);
+  LabelMask(const AnalysisSources& theSources,
+            const WeatherArea& theArea,
+            const std::vector<WeatherArea::Type>& theTypes,
+            const std::string& theData);
+
+  std::size_t labels() const { return itsSizes.size(); }
+  std::size_t size() const { return itsIndexes.size(); }
+  std::size_t size(unsigned int theLabel) const { return itsSizes.at(theLabel); }
+  bool empty() const { return itsIndexes.empty(); }
+
+  //! The grid point indexes of all the labels in ascending order
+  const std::vector<unsigned long>& indexes() const { return itsIndexes; }
+
+  //! The labels of each grid point in indexes()
+  const std::vector<label_set>& memberships() const { return itsMemberships; }
+
+ private:
+  void build(const std::vector<MaskSource::mask_type>& theMasks);
+
+  std::vector<unsigned long> itsIndexes;
+  std::vector<label_set> itsMemberships;
+  std::vector<std::size_t> itsSizes;
+
+};  // class LabelMask
+
+}  // namespace TextGen
+
+// ======================================================================
@@ -20,6 +20,10 @@
 // ======================================================================
 
 #include "LandMaskSource.h"
+#include "GridMask.h"
+#include "MaskCache.h"
+#include "MaskStorage.h"
+#include "RasterMaskTools.h"
 
 #include <calculator/WeatherArea.h>
 #include <calculator/WeatherSource.h>
@@ -29,44 +33,12 @@
 #include <newbase/NFmiGrid.h>
 #include <newbase/NFmiIndexMask.h>
 #include <newbase/NFmiIndexMaskSource.h>
-#include <newbase/NFmiIndexMaskTools.h>
 #include <newbase/NFmiQueryData.h>
 
-#include <map>
-
 using namespace std;
 
-using namespace NFmiIndexMaskTools;
-
 namespace TextGen
 {
-// ----------------------------------------------------------------------
-/*!
- * \brief Utility structure to each cache management
- */
-// ----------------------------------------------------------------------
-
-struct WeatherAreaAndID
-{
-  WeatherId itsID;
-  WeatherArea itsArea;
-
-  WeatherAreaAndID(const WeatherId& theID, const WeatherArea& theArea)
-      : itsID(theID), itsArea(theArea)
-  {
-  }
-
-  bool operator==(const WeatherAreaAndID& theOther) const
-  {
-    return (itsID == theOther.itsID && itsArea == theOther.itsArea);
-  }
-
-  bool operator<(const WeatherAreaAndID& theOther) const
-  {
-    return (itsID != theOther.itsID ? itsID < theOther.itsID : itsArea < theOther.itsArea);
-  }
-};
-
 // ----------------------------------------------------------------------
 /*!
  * \brief Implementation hiding detail for TextGen::LandMaskSource
@@ -80,15 +52,7 @@ class LandMaskSource::Pimple
 
   const WeatherArea itsLand;
 
-  using mask_storage = map<WeatherAreaAndID, mask_type>;
-  using masks_storage = map<WeatherAreaAndID, masks_type>;
-
-  mask_storage itsMaskStorage;
-  masks_storage itsMasksStorage;
-
-  mask_type find(const WeatherId& theID, const WeatherArea& theArea) const;
-
-  void insert(const WeatherId& theID, const WeatherArea& theArea, const mask_type& theMask);
+  MaskStorage itsMaskStorage;
 
   mask_type create_mask(const WeatherArea& theArea,
                         const std::string& theData,
@@ -104,70 +68,6 @@ class LandMaskSource::Pimple
 
 LandMaskSource::Pimple::Pimple(const WeatherArea& theLand) : itsLand(theLand) {}
 
-// ----------------------------------------------------------------------
-/*!
- * \brief Find mask from cache
- *
- * Returns a 0-shared pointer if mask is not found
- *
- * \param theID The weather ID
- * \param theArea The weather area
- * \return std::shared_ptr to mask or 0
- */
-// ----------------------------------------------------------------------
-
-LandMaskSource::mask_type LandMaskSource::Pimple::find(const WeatherId& theID,
-                                                       const WeatherArea& theArea) const
-{
-  try
-  {
-    static std::shared_ptr<NFmiIndexMask> dummy;
-
-    WeatherAreaAndID key(theID, theArea);
-
-    auto it = itsMaskStorage.find(key);
-    if (it == itsMaskStorage.end())
-      return dummy;
-
-    return it->second;
-  }
-  catch (...)
-  {
-    throw Fmi::Exception::Trace(BCP, "Operation failed");
-  }
-}
-
-// ----------------------------------------------------------------------
-/*!
- * \brief Insert a new mask into the cache
- *
- * \param theID The data ID
- * \param theArea The weather area
- * \param theMask The mask itself
- */
-// ----------------------------------------------------------------------
-
-void LandMaskSource::Pimple::insert(const WeatherId& theID,
-                                    const WeatherArea& theArea,
-                                    const mask_type& theMask)
-{
-  try
-  {
-    using value_type = mask_storage::value_type;
-
-    WeatherAreaAndID key(theID, theArea);
-
-    itsMaskStorage.insert(value_type(key, theMask));
-
-    if (itsMaskStorage.insert(value_type(key, theMask)).second)
-      throw Fmi::Exception(BCP, "Could not cache mask for " + theArea.name());
-  }
-  catch (...)
-  {
-    throw Fmi::Exception::Trace(BCP, "Operation failed");
-  }
-}
-
 // ----------------------------------------------------------------------
 /*!
  * \brief Create a new weather area
@@ -193,24 +93,30 @@ LandMaskSource::mask_type LandMaskSource::Pimple::create_mask(const WeatherArea&
       throw Fmi::Exception(
           BCP, "The data in " + theData + " is not gridded - cannot generate mask for it");
 
-    // First build the area mask
+    const NFmiGrid& grid = *(qi.Grid());
+    const MaskCache::Key key = MaskCache::Key("land").add(grid).add(theArea).add(itsLand);
 
-    const NFmiSvgPath& svg = theArea.path();
-    const float radius = theArea.radius();
+    auto create = [&]()
+    {
+      // First build the area mask
 
-    mask_type areamask(new NFmiIndexMask(MaskExpand(*(qi.Grid()), svg, radius)));
+      const NFmiSvgPath& svg = theArea.path();
+      const float radius = theArea.radius();
+      GridMask areamask = RasterMaskTools::MaskExpand(grid, svg, radius);
 
-    // Then build the land mask
+      // Then build the land mask
 
-    const NFmiSvgPath& lsvg = itsLand.path();
-    const float ldistance = itsLand.radius();
-    mask_type landmask(new NFmiIndexMask(MaskExpand(*(qi.Grid()), lsvg, ldistance)));
+      const NFmiSvgPath& lsvg = itsLand.path();
+      const float ldistance = itsLand.radius();
+      GridMask landmask = RasterMaskTools::MaskExpand(grid, lsvg, ldistance);
 
-    // The intersection is the land area
+      // The intersection is the land area
 
-    *areamask &= *landmask;
+      areamask &= landmask;
+      return areamask;
+    };
 
-    return areamask;
+    return MaskCache::find_or_create(key, grid, create).mask();
   }
   catch (...)
   {
@@ -246,13 +152,11 @@ LandMaskSource::mask_type LandMaskSource::mask(const WeatherArea& theArea,
     if (theArea.isPoint())
       throw Fmi::Exception(BCP, "Trying to generate mask for point");
 
-    // Establish the ID for the data
-
-    WeatherId id = theWeatherSource.id(theData);
-
     // Try to find cached mask first
 
-    mask_type areamask = itsPimple->find(id, theArea);
+    const MaskStorage::Key key(theWeatherSource.id(theData), theArea);
+
+    mask_type areamask = itsPimple->itsMaskStorage.find(key);
 
     if (areamask.get() != nullptr)
       return areamask;
@@ -260,9 +164,7 @@ LandMaskSource::mask_type LandMaskSource::mask(const WeatherArea& theArea,
     // Calculate new mask and cache it
 
     areamask = itsPimple->create_mask(theArea, theData, theWeatherSource);
-    itsPimple->insert(id, theArea, areamask);
-
-    return areamask;
+    return itsPimple->itsMaskStorage.insert(key, areamask);
   }
   catch (...)
   {
@@ -92,8 +92,8 @@ std::string LocationPhrase::realize(const Dictionary& theDictionary) const
     if (theDictionary.geocontains(location))
       return theDictionary.geofind(location);
 
-    generator gen;
-    std::locale loc(gen("fi_FI.UTF-8"));
+    const std::locale& loc =
+        TextFormatterTools::getLocale(TextFormatterTools::localeName(&theDictionary));
     return to_title(location, loc);
 
 #if 0
@@ -0,0 +1,438 @@
+// ======================================================================
+/*!
+ * \file
+ * \brief Implementation of namespace TextGen::MaskCache
+ */
+// ======================================================================
+/*!
+ * \namespace TextGen::MaskCache
+ *
+ * \brief A directory of masks shared by processes
+ *
+ * The mask sources cache their masks only for the lifetime of the
+ * process, and building the coast and directional masks for a fine
+ * grid takes long. If textgen::mask::cachedir is set, the masks are
+ * also stored in that directory, and any process using the same
+ * directory loads them from there instead of building them again.
+ *
+ * A mask is identified by everything it depends on: the kind of the
+ * mask, the grid size and the coordinates of its corners and center,
+ * the SVG paths, distances and division lines of the areas and so on.
+ * The file of a mask is named by the 64-bit FNV-1a hash of the key in
+ * hexadecimal, and the file contains the full key so that a hash
+ * collision is detected. The masks are read only when first requested,
+ * after that the mask sources serve them from memory.
+ *
+ * The file is a memory mappable image of little endian 32-bit
+ * integers:
+ *
+ * -# magic "TGMASK02"
+ * -# the hash (low and high halves), grid width, grid height,
+ *    number of spans N and the size K of the key in bytes
+ * -# the key, padded with zeros to a multiple of 8 bytes
+ * -# N spans, each consisting of the first grid point and the grid
+ *    point after the last one
+ *
+ * The version in the magic is changed whenever the file format or the
+ * way the masks are built changes, so that masks built by older
+ * versions are not used. Version 02 added the key and the raster
+ * based mask construction.
+ *
+ * Files are written to a unique temporary name and then renamed, so
+ * that concurrent processes and threads see either a complete file or
+ * no file. A file which does not match the key or the grid is ignored
+ * and replaced.
+ */
+// ======================================================================
+
+#include "MaskCache.h"
+#include <calculator/Settings.h>
+#include <calculator/WeatherArea.h>
+#include <macgyver/Exception.h>
+
+#include <newbase/NFmiFileSystem.h>
+#include <newbase/NFmiGrid.h>
+#include <newbase/NFmiPoint.h>
+#include <newbase/NFmiSvgPath.h>
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace std;
+
+namespace TextGen
+{
+namespace MaskCache
+{
+namespace
+{
+const char magic[8] = {'T', 'G', 'M', 'A', 'S', 'K', '0', '2'};
+const std::size_t header_size = 32;
+const std::size_t span_size = 8;
+
+// the size of the key rounded up to a multiple of 8 bytes
+std::size_t padded_size(std::size_t theSize)
+{
+  return (theSize + 7) / 8 * 8;
+}
+
+std::uint32_t read_u32(const char* thePtr)
+{
+  const auto* p = reinterpret_cast<const unsigned char*>(thePtr);
+  return (std::uint32_t(p[0]) | (std::uint32_t(p[1]) << 8) | (std::uint32_t(p[2]) << 16) |
+          (std::uint32_t(p[3]) << 24));
+}
+
+void write_u32(std::string& theOutput, std::uint32_t theValue)
+{
+  for (int i = 0; i < 4; i++)
+    theOutput += static_cast<char>((theValue >> (8 * i)) & 0xFF);
+}
+
+}  // namespace
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Start a key for the given kind of mask
+ *
+ * A key for hashing only is cheaper to build when the content of the
+ * key is not needed, but it cannot be used for the cache files.
+ */
+// ----------------------------------------------------------------------
+
+Key::Key(const std::string& theKind, bool theHashOnly)
+    : itsHash(14695981039346656037ULL), itsHashOnly(theHashOnly)
+{
+  add(theKind);
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Add raw bytes to the key and its hash
+ */
+// ----------------------------------------------------------------------
+
+void Key::addBytes(const void* theData, std::size_t theSize)
+{
+  const auto* p = static_cast<const unsigned char*>(theData);
+  if (!itsHashOnly)
+    itsBytes.append(static_cast<const char*>(theData), theSize);
+  for (std::size_t i = 0; i < theSize; i++)
+  {
+    itsHash ^= p[i];
+    itsHash *= 1099511628211ULL;
+  }
+}
+
+Key& Key::add(const std::string& theValue)
+{
+  const std::uint64_t n = theValue.size();
+  addBytes(&n, sizeof(n));
+  addBytes(theValue.data(), theValue.size());
+  return *this;
+}
+
+Key& Key::add(double theValue)
+{
+  addBytes(&theValue, sizeof(theValue));
+  return *this;
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Add the grid size and the corner and center coordinates
+ */
+// ----------------------------------------------------------------------
+
+Key& Key::add(const NFmiGrid& theGrid)
+{
+  try
+  {
+    const unsigned long nx = theGrid.XNumber();
+    const unsigned long ny = theGrid.YNumber();
+    add(static_cast<double>(nx));
+    add(static_cast<double>(ny));
+    if (nx == 0 || ny == 0)
+      return *this;
+
+    const unsigned long n = nx * ny;
+    for (unsigned long idx : {0UL, nx - 1, n - nx, n - 1, (ny / 2) * nx + nx / 2})
+    {
+      const NFmiPoint p = theGrid.LatLon(idx);
+      add(p.X());
+      add(p.Y());
+    }
+    return *this;
+  }
+  catch (...)
+  {
+    throw Fmi::Exception::Trace(BCP, "Operation failed");
+  }
+}
+
+Key& Key::add(const NFmiSvgPath& thePath)
+{
+  add(static_cast<double>(thePath.size()));
+  for (const auto& element : thePath)
+  {
+    add(static_cast<double>(element.itsType));
+    add(element.itsX);
+    add(element.itsY);
+  }
+  return *this;
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Add the path, radius and division lines of an area
+ */
+// ----------------------------------------------------------------------
+
+Key& Key::add(const WeatherArea& theArea)
+{
+  try
+  {
+    add(theArea.path());
+    add(theArea.radius());
+    add(theArea.latitudeDivisionLineSet() ? theArea.getLatitudeDivisionLine() : -999.0);
+    add(theArea.longitudeDivisionLineSet() ? theArea.getLongitudeDivisionLine() : -999.0);
+    return *this;
+  }
+  catch (...)
+  {
+    throw Fmi::Exception::Trace(BCP, "Operation failed");
+  }
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief The file name of the mask without the directory
+ */
+// ----------------------------------------------------------------------
+
+std::string Key::name() const
+{
+  char buffer[17];
+  std::snprintf(buffer, sizeof(buffer), "%016llx", static_cast<unsigned long long>(itsHash));
+  return std::string(buffer) + ".mask";
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief The cache directory, or an empty string if caching is disabled
+ */
+// ----------------------------------------------------------------------
+
+std::string directory()
+{
+  try
+  {
+    return Settings::optional_string("textgen::mask::cachedir", "");
+  }
+  catch (...)
+  {
+    throw Fmi::Exception::Trace(BCP, "Operation failed");
+  }
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Read a mask from the cache, or create it and store it there
+ *
+ * A cache directory which cannot be written to only means that the
+ * next process has to create the mask again, hence write errors are
+ * ignored.
+ *
+ * \param theKey The key of the mask
+ * \param theGrid The grid of the mask
+ * \param theCreator Function creating the mask if it is not cached
+ */
+// ----------------------------------------------------------------------
+
+GridMask find_or_create(const Key& theKey,
+                        const NFmiGrid& theGrid,
+                        const std::function<GridMask()>& theCreator)
+{
+  try
+  {
+    const std::string dir = directory();
+    if (dir.empty())
+      return theCreator();
+
+    const std::string filename = dir + '/' + theKey.name();
+
+    GridMask mask(theGrid);
+    if (read(filename, theKey, mask))
+      return mask;
+
+    mask = theCreator();
+
+    try
+    {
+      write(filename, theKey, mask);
+    }
+    catch (...)
+    {
+      // The mask is still valid, it just was not cached
+    }
+
+    return mask;
+  }
+  catch (...)
+  {
+    throw Fmi::Exception::Trace(BCP, "Operation failed");
+  }
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Read a cached mask
+ *
+ * \param theFilename The file to read
+ * \param theKey The expected key of the mask
+ * \param theMask The mask to fill, which determines the expected grid size
+ * \return True if the file exists and matches the key and the grid
+ */
+// ----------------------------------------------------------------------
+
+bool read(const std::string& theFilename, const Key& theKey, GridMask& theMask)
+{
+  try
+  {
+    if (!NFmiFileSystem::FileExists(theFilename))
+      return false;
+
+    // An empty or unreadable file is treated as a missing one
+
+    boost::interprocess::file_mapping file;
+    boost::interprocess::mapped_region region;
+    try
+    {
+      boost::interprocess::file_mapping(theFilename.c_str(), boost::interprocess::read_only)
+          .swap(file);
+      boost::interprocess::mapped_region(file, boost::interprocess::read_only).swap(region);
+    }
+    catch (const boost::interprocess::interprocess_exception&)
+    {
+      return false;
+    }
+
+    const char* data = static_cast<const char*>(region.get_address());
+    const std::size_t size = region.get_size();
+
+    if (size < header_size || std::memcmp(data, magic, sizeof(magic)) != 0)
+      return false;
+
+    const std::uint64_t hash = read_u32(data + 8) | (std::uint64_t(read_u32(data + 12)) << 32);
+    const std::uint32_t width = read_u32(data + 16);
+    const std::uint32_t height = read_u32(data + 20);
+    const std::uint32_t count = read_u32(data + 24);
+    const std::uint32_t keysize = read_u32(data + 28);
+
+    const std::string& key = theKey.bytes();
+    const std::size_t spans = header_size + padded_size(keysize);
+
+    if (hash != theKey.hash() || width != theMask.width() || height != theMask.height() ||
+        keysize != key.size() || size != spans + span_size * count ||
+        std::memcmp(data + header_size, key.data(), key.size()) != 0)
+      return false;
+
+    GridMask mask(width, height);
+    for (std::uint32_t i = 0; i < count; i++)
+    {
+      const char* span = data + spans + span_size * i;
+      const GridMask::Span s{read_u32(span), read_u32(span + 4)};
+      if (s.begin > s.end || s.end > mask.size())
+        return false;
+      mask.set(s);
+    }
+
+    theMask = mask;
+    return true;
+  }
+  catch (...)
+  {
+    throw Fmi::Exception::Trace(BCP, "Operation failed").addParameter("filename", theFilename);
+  }
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Write a mask into the cache
+ *
+ * \param theFilename The file to write
+ * \param theKey The key of the mask
+ * \param theMask The mask
+ */
+// ----------------------------------------------------------------------
+
+void write(const std::string& theFilename, const Key& theKey, const GridMask& theMask)
+{
+  try
+  {
+    const std::vector<GridMask::Span> spans = theMask.spans();
+
+    std::string image(magic, sizeof(magic));
+    write_u32(image, static_cast<std::uint32_t>(theKey.hash()));
+    write_u32(image, static_cast<std::uint32_t>(theKey.hash() >> 32));
+    write_u32(image, theMask.width());
+    write_u32(image, theMask.height());
+    write_u32(image, spans.size());
+    write_u32(image, theKey.bytes().size());
+    image += theKey.bytes();
+    image.resize(header_size + padded_size(theKey.bytes().size()), '\0');
+    for (const auto& span : spans)
+    {
+      write_u32(image, span.begin);
+      write_u32(image, span.end);
+    }
+
+    // mkstemp gives a name unique to this thread even within one process
+
+    std::string tmpfile = theFilename + ".XXXXXX";
+    const int fd = ::mkstemp(&tmpfile[0]);
+    if (fd < 0)
+      throw Fmi::Exception(BCP,
+                           "Error: Could not create a temporary file for '" + theFilename + "'");
+
+    // mkstemp creates the file readable only by the owner
+    bool ok = (::fchmod(fd, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH) == 0);
+    for (std::size_t pos = 0; ok && pos < image.size();)
+    {
+      const ssize_t n = ::write(fd, image.data() + pos, image.size() - pos);
+      ok = (n > 0);
+      if (ok)
+        pos += n;
+    }
+    ok = (::close(fd) == 0 && ok);
+
+    if (!ok)
+    {
+      std::remove(tmpfile.c_str());
+      throw Fmi::Exception(BCP, "Error: Failed to write '" + tmpfile + "'");
+    }
+
+    if (std::rename(tmpfile.c_str(), theFilename.c_str()) != 0)
+    {
+      std::remove(tmpfile.c_str());
+      throw Fmi::Exception(
+          BCP, "Error: Failed to rename '" + tmpfile + "' to '" + theFilename + "'");
+    }
+  }
+  catch (...)
+  {
+    throw Fmi::Exception::Trace(BCP, "Operation failed").addParameter("filename", theFilename);
+  }
+}
+
+}  // namespace MaskCache
+}  // namespace TextGen
+
+// ======================================================================
@@ -0,0 +1,68 @@
+// ======================================================================
+/*!
+ * \file
+ * \brief Interface of namespace TextGen::MaskCache
+ */
+// ======================================================================
+
+#pragma once
+
+#include "GridMask.h"
+
+#include <cstdint>
+#include <functional>
+#include <string>
+
+class NFmiGrid;
+class NFmiSvgPath;
+
+namespace TextGen
+{
+class WeatherArea;
+
+namespace MaskCache
+{
+// ----------------------------------------------------------------------
+/*!
+ * \brief The content identifying a cached mask and its hash
+ */
+// ----------------------------------------------------------------------
+
+class Key
+{
+ public:
+  // a key for hashing only does not keep the bytes needed by the cache files
+  explicit Key(const std::string& theKind, bool theHashOnly = false);
+
+  Key& add(const std::string& theValue);
+  Key& add(double theValue);
+  Key& add(const NFmiGrid& theGrid);
+  Key& add(const NFmiSvgPath& thePath);
+  Key& add(const WeatherArea& theArea);
+
+  std::uint64_t hash() const { return itsHash; }
+  const std::string& bytes() const { return itsBytes; }
+  std::string name() const;
+
+ private:
+  void addBytes(const void* theData, std::size_t theSize);
+
+  std::uint64_t itsHash;
+  bool itsHashOnly;
+  std::string itsBytes;
+
+};  // class Key
+
+std::string directory();
+
+GridMask find_or_create(const Key& theKey,
+                        const NFmiGrid& theGrid,
+                        const std::function<GridMask()>& theCreator);
+
+bool read(const std::string& theFilename, const Key& theKey, GridMask& theMask);
+void write(const std::string& theFilename, const Key& theKey, const GridMask& theMask);
+
+}  // namespace MaskCache
+}  // namespace TextGen
+
+// ======================================================================
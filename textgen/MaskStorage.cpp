@@ -0,0 +1,150 @@
+// ======================================================================
+/*!
+ * \file
+ * \brief Implementation of class TextGen::MaskStorage
+ */
+// ======================================================================
+/*!
+ * \class TextGen::MaskStorage
+ *
+ * \brief A thread safe in-memory cache of the masks of a mask source
+ *
+ * The masks are keyed by the data ID and the area. The area part of
+ * the key is a fingerprint hashing the path geometry, the radius, the
+ * division lines and the type of the area. The fingerprint is
+ * calculated once when the key is constructed, and the same key is
+ * then used both for finding the mask and for inserting a newly
+ * created one, making the lookup independent of the number of cached
+ * masks. Keys with equal hashes are still compared with
+ * WeatherArea::identicalArea, hence hash collisions cannot return a
+ * mask for the wrong area.
+ *
+ * Masks are created outside the lock. If two threads create the same
+ * mask concurrently, the first one inserted is kept and returned to
+ * both.
+ */
+// ======================================================================
+
+#include "MaskStorage.h"
+#include "MaskCache.h"
+
+#include <macgyver/Exception.h>
+
+#include <newbase/NFmiIndexMask.h>
+#include <newbase/NFmiPoint.h>
+
+namespace TextGen
+{
+// ----------------------------------------------------------------------
+/*!
+ * \brief Construct the key and calculate the fingerprint of the area
+ */
+// ----------------------------------------------------------------------
+
+MaskStorage::Key::Key(const WeatherId& theID, const WeatherArea& theArea)
+    : itsID(theID), itsArea(theArea), itsHash(fingerprint(theArea))
+{
+  itsHash ^= static_cast<std::uint64_t>(theID) * 0x9E3779B97F4A7C15ULL;
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Equality comparison, which compares the full area geometry
+ */
+// ----------------------------------------------------------------------
+
+bool MaskStorage::Key::operator==(const Key& theOther) const
+{
+  return (itsHash == theOther.itsHash && itsID == theOther.itsID &&
+          itsArea.type() == theOther.itsArea.type() && itsArea.identicalArea(theOther.itsArea));
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Hash the path, radius, division lines and type of an area
+ */
+// ----------------------------------------------------------------------
+
+std::uint64_t MaskStorage::fingerprint(const WeatherArea& theArea)
+{
+  try
+  {
+    MaskCache::Key key("area", true);
+    key.add(static_cast<double>(theArea.type()));
+    if (theArea.isPoint())
+      key.add(theArea.point().X()).add(theArea.point().Y()).add(theArea.radius());
+    else
+      key.add(theArea);
+    return key.hash();
+  }
+  catch (...)
+  {
+    throw Fmi::Exception::Trace(BCP, "Operation failed");
+  }
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Find a mask from the cache
+ *
+ * \param theKey The key of the mask
+ * \return The mask, or a null pointer if it is not cached
+ */
+// ----------------------------------------------------------------------
+
+MaskStorage::mask_type MaskStorage::find(const Key& theKey) const
+{
+  try
+  {
+    std::lock_guard<std::mutex> lock(itsMutex);
+
+    auto it = itsStorage.find(theKey);
+    if (it == itsStorage.end())
+      return mask_type();
+
+    return it->second;
+  }
+  catch (...)
+  {
+    throw Fmi::Exception::Trace(BCP, "Operation failed");
+  }
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Insert a new mask into the cache
+ *
+ * \param theKey The key of the mask
+ * \param theMask The mask
+ * \return The cached mask, which is an earlier one if some other thread won the race
+ */
+// ----------------------------------------------------------------------
+
+MaskStorage::mask_type MaskStorage::insert(const Key& theKey, const mask_type& theMask)
+{
+  try
+  {
+    std::lock_guard<std::mutex> lock(itsMutex);
+    return itsStorage.insert(storage_type::value_type(theKey, theMask)).first->second;
+  }
+  catch (...)
+  {
+    throw Fmi::Exception::Trace(BCP, "Operation failed");
+  }
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief The number of cached masks
+ */
+// ----------------------------------------------------------------------
+
+std::size_t MaskStorage::size() const
+{
+  std::lock_guard<std::mutex> lock(itsMutex);
+  return itsStorage.size();
+}
+
+}  // namespace TextGen
+
+// ======================================================================
@@ -0,0 +1,66 @@
+// ======================================================================
+/*!
+ * \file
+ * \brief Interface of class TextGen::MaskStorage
+ */
+// ======================================================================
+
+#pragma once
+
+#include <calculator/MaskSource.h>
+#include <calculator/WeatherArea.h>
+#include <calculator/WeatherSource.h>
+
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+
+namespace TextGen
+{
+class MaskStorage
+{
+ public:
+  using mask_type = MaskSource::mask_type;
+
+  //! The data ID and the area of a mask, with the area fingerprint
+  class Key
+  {
+   public:
+    Key(const WeatherId& theID, const WeatherArea& theArea);
+
+    const WeatherId& id() const { return itsID; }
+    const WeatherArea& area() const { return itsArea; }
+    std::uint64_t hash() const { return itsHash; }
+
+    bool operator==(const Key& theOther) const;
+
+   private:
+    WeatherId itsID;
+    WeatherArea itsArea;
+    std::uint64_t itsHash;
+
+  };  // class Key
+
+  static std::uint64_t fingerprint(const WeatherArea& theArea);
+
+  mask_type find(const Key& theKey) const;
+  mask_type insert(const Key& theKey, const mask_type& theMask);
+
+  std::size_t size() const;
+
+ private:
+  struct KeyHash
+  {
+    std::size_t operator()(const Key& theKey) const { return theKey.hash(); }
+  };
+
+  using storage_type = std::unordered_map<Key, mask_type, KeyHash>;
+
+  mutable std::mutex itsMutex;
+  storage_type itsStorage;
+
+};  // class MaskStorage
+
+}  // namespace TextGen
+
+// ======================================================================
@@ -0,0 +1,160 @@
+// ======================================================================
+/*!
+ * \file
+ * \brief Implementation of class TextGen::MaskedCube
+ */
+// ======================================================================
+/*!
+ * \class TextGen::MaskedCube
+ *
+ * \brief The values of one parameter at the points of a mask during a period
+ *
+ * Reading the values one by one from NFmiFastQueryInfo costs an index
+ * calculation and a jump around the querydata for every grid point
+ * and time step, and the analyses often read the same values several
+ * times. A MaskedCube gathers the values of the active parameter and
+ * level of the query info once into a dense array, after which all the
+ * calculations run over contiguous memory.
+ *
+ * The array is time-major: the values of all the points at one time
+ * step are contiguous. Each time step starts at an address aligned to
+ * MaskedCube::alignment bytes, the gap after the last point being
+ * filled with kFloatMissing. The points are in the order of the mask,
+ * hence the results of calculations over the cube are identical to
+ * those of reading the data directly.
+ *
+ * Sample usage:
+ * \code
+ * MaskedCube cube(qi, *mask, startindex, endindex);
+ * for (std::size_t t = 0; t < cube.times(); t++)
+ * {
+ *   const float* values = cube.row(t);
+ *   for (std::size_t i = 0; i < cube.points(); i++)
+ *     calculator(values[i]);
+ * }
+ * \endcode
+ */
+// ======================================================================
+
+#include "MaskedCube.h"
+#include <macgyver/Exception.h>
+
+#include <newbase/NFmiFastQueryInfo.h>
+#include <newbase/NFmiGlobals.h>
+#include <newbase/NFmiIndexMask.h>
+
+#include <algorithm>
+#include <new>
+
+using namespace std;
+
+namespace TextGen
+{
+// ----------------------------------------------------------------------
+/*!
+ * \brief Gather the values at the points of a mask
+ *
+ * \param theQI The query info with the parameter and level activated
+ * \param theMask The grid points
+ * \param theStartIndex The first time index
+ * \param theEndIndex The time index after the last one
+ */
+// ----------------------------------------------------------------------
+
+MaskedCube::MaskedCube(NFmiFastQueryInfo& theQI,
+                       const NFmiIndexMask& theMask,
+                       unsigned long theStartIndex,
+                       unsigned long theEndIndex)
+    : itsIndexes(theMask.begin(), theMask.end())
+{
+  try
+  {
+    gather(theQI, theStartIndex, theEndIndex);
+  }
+  catch (...)
+  {
+    throw Fmi::Exception::Trace(BCP, "Operation failed");
+  }
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Gather the values at the given grid points
+ *
+ * \param theQI The query info with the parameter and level activated
+ * \param theIndexes The grid points
+ * \param theStartIndex The first time index
+ * \param theEndIndex The time index after the last one
+ */
+// ----------------------------------------------------------------------
+
+MaskedCube::MaskedCube(NFmiFastQueryInfo& theQI,
+                       const vector<unsigned long>& theIndexes,
+                       unsigned long theStartIndex,
+                       unsigned long theEndIndex)
+    : itsIndexes(theIndexes)
+{
+  try
+  {
+    gather(theQI, theStartIndex, theEndIndex);
+  }
+  catch (...)
+  {
+    throw Fmi::Exception::Trace(BCP, "Operation failed");
+  }
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Read the values from the query data
+ *
+ * The data is read point by point, since the time steps of one point
+ * are adjacent in the query data.
+ */
+// ----------------------------------------------------------------------
+
+void MaskedCube::gather(NFmiFastQueryInfo& theQI,
+                        unsigned long theStartIndex,
+                        unsigned long theEndIndex)
+{
+  try
+  {
+    const size_t floats_per_line = alignment / sizeof(float);
+
+    itsStartIndex = theStartIndex;
+    itsTimes = (theEndIndex > theStartIndex ? theEndIndex - theStartIndex : 0);
+    itsStride = (itsIndexes.size() + floats_per_line - 1) / floats_per_line * floats_per_line;
+
+    const size_t n = itsTimes * itsStride;
+    if (n == 0)
+      return;
+
+    itsValues.reset(static_cast<float*>(std::aligned_alloc(alignment, n * sizeof(float))));
+    if (!itsValues)
+      throw std::bad_alloc();
+
+    std::fill(itsValues.get(), itsValues.get() + n, kFloatMissing);
+
+    const unsigned long paramindex = theQI.ParamIndex();
+    const unsigned long levelindex = theQI.LevelIndex();
+
+    for (size_t i = 0; i < itsIndexes.size(); i++)
+    {
+      float* values = itsValues.get() + i;
+      for (size_t t = 0; t < itsTimes; t++)
+      {
+        const unsigned long idx =
+            theQI.Index(paramindex, itsIndexes[i], levelindex, theStartIndex + t);
+        values[t * itsStride] = theQI.GetFloatValue(idx);
+      }
+    }
+  }
+  catch (...)
+  {
+    throw Fmi::Exception::Trace(BCP, "Operation failed");
+  }
+}
+
+}  // namespace TextGen
+
+// ======================================================================
@@ -0,0 +1,74 @@
+// ======================================================================
+/*!
+ * \file
+ * \brief Interface of class TextGen::MaskedCube
+ */
+// ======================================================================
+
+#pragma once
+
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+class NFmiFastQueryInfo;
+class NFmiIndexMask;
+
+namespace TextGen
+{
+class MaskedCube
+{
+ public:
+  //! The alignment of each time step in bytes
+  static const std::size_t alignment = 64;
+
+  MaskedCube() = default;
+  MaskedCube(NFmiFastQueryInfo& theQI,
+             const NFmiIndexMask& theMask,
+             unsigned long theStartIndex,
+             unsigned long theEndIndex);
+  MaskedCube(NFmiFastQueryInfo& theQI,
+             const std::vector<unsigned long>& theIndexes,
+             unsigned long theStartIndex,
+             unsigned long theEndIndex);
+
+  std::size_t points() const { return itsIndexes.size(); }
+  std::size_t times() const { return itsTimes; }
+  bool empty() const { return itsIndexes.empty() || itsTimes == 0; }
+
+  //! The distance between consecutive time steps in floats
+  std::size_t stride() const { return itsStride; }
+
+  //! The time index of the first time step in the data
+  unsigned long startIndex() const { return itsStartIndex; }
+
+  //! The grid point indexes in the order of the values
+  const std::vector<unsigned long>& indexes() const { return itsIndexes; }
+
+  //! The values of all the points at the given time step
+  const float* row(std::size_t theTime) const { return itsValues.get() + theTime * itsStride; }
+
+  float value(std::size_t theTime, std::size_t thePoint) const
+  {
+    return itsValues[theTime * itsStride + thePoint];
+  }
+
+ private:
+  struct Deleter
+  {
+    void operator()(float* thePtr) const { std::free(thePtr); }
+  };
+
+  void gather(NFmiFastQueryInfo& theQI, unsigned long theStartIndex, unsigned long theEndIndex);
+
+  std::vector<unsigned long> itsIndexes;
+  std::unique_ptr<float[], Deleter> itsValues;
+  std::size_t itsTimes = 0;
+  std::size_t itsStride = 0;
+  unsigned long itsStartIndex = 0;
+
+};  // class MaskedCube
+
+}  // namespace TextGen
+
+// ======================================================================
@@ -29,7 +29,20 @@
  *   log << "calculating some result " << 10 << '\n';
  * }
  * \endcode
-
+ *
+ * The logger state is thread specific. Messages written by worker
+ * threads can be relayed to the log of the parent thread:
+ * \code
+ * const MessageLogger::Context context = MessageLogger::context();
+ * ...
+ * // in the worker thread
+ * MessageLogger::Capture capture(context);
+ * ...
+ * text = capture.str();
+ * ...
+ * // in the parent thread
+ * MessageLogger::append(text);
+ * \endcode
  */
 // ======================================================================
 
@@ -95,6 +108,9 @@ void output_timestamp(bool theFlag)
 
 MessageLogger::~MessageLogger()
 {
+  if (!itsScoped)
+    return;
+
   --sDepth;
   output_timestamp(sTimeStampOn);
 
@@ -128,6 +144,18 @@ MessageLogger::MessageLogger(string theFunction) : itsFunction(std::move(theFunc
   ++sDepth;
 }
 
+// ----------------------------------------------------------------------
+/*!
+ * \brief Constructor for continuing the current function
+ *
+ * The messages are written at the current depth, and no entering
+ * or leaving lines are written. This is used by tasks which write
+ * on behalf of the function which started them.
+ */
+// ----------------------------------------------------------------------
+
+MessageLogger::MessageLogger(Continue) : itsScoped(false) {}
+
 // ----------------------------------------------------------------------
 /*!
  * \brief Write a new message when flush occurs
@@ -223,6 +251,101 @@ void MessageLogger::timestamp(bool theFlag)
   sTimeStampOn = theFlag;
 }
 
+// ----------------------------------------------------------------------
+/*!
+ * \brief Return the logging state of the calling thread
+ */
+// ----------------------------------------------------------------------
+
+MessageLogger::Context MessageLogger::context()
+{
+  Context context;
+  context.enabled = (sOutputFile != nullptr || sOutputStream != nullptr);
+  context.depth = sDepth;
+  context.indentchar = sIndentChar;
+  context.indentstep = sIndentStep;
+  context.timestamp = sTimeStampOn;
+  return context;
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Append text as is to the log of the calling thread
+ *
+ * \param theText The text, usually captured from a worker thread
+ */
+// ----------------------------------------------------------------------
+
+void MessageLogger::append(const std::string& theText)
+{
+  try
+  {
+    if (theText.empty())
+      return;
+    if (sOutputFile != nullptr)
+      *sOutputFile << theText;
+    if (sOutputStream != nullptr)
+      *sOutputStream << theText;
+  }
+  catch (...)
+  {
+    throw Fmi::Exception::Trace(BCP, "Operation failed");
+  }
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Start capturing the messages of the calling thread
+ *
+ * The messages are indented as if they were written by the thread
+ * the context was taken from. Nothing is captured if that thread
+ * was not logging anything. The previous state of the calling
+ * thread is restored by the destructor.
+ *
+ * \param theContext The logging state of the parent thread
+ */
+// ----------------------------------------------------------------------
+
+MessageLogger::Capture::Capture(const Context& theContext)
+    : itsFile(std::move(sOutputFile)),
+      itsStream(std::move(sOutputStream)),
+      itsPrevious(context())
+{
+  if (theContext.enabled)
+    sOutputStream.reset(new ostringstream());
+  sDepth = theContext.depth;
+  sIndentChar = theContext.indentchar;
+  sIndentStep = theContext.indentstep;
+  sTimeStampOn = theContext.timestamp;
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Restore the previous logging state of the calling thread
+ */
+// ----------------------------------------------------------------------
+
+MessageLogger::Capture::~Capture()
+{
+  sOutputFile = std::move(itsFile);
+  sOutputStream = std::move(itsStream);
+  sDepth = itsPrevious.depth;
+  sIndentChar = itsPrevious.indentchar;
+  sIndentStep = itsPrevious.indentstep;
+  sTimeStampOn = itsPrevious.timestamp;
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Return the messages captured so far
+ */
+// ----------------------------------------------------------------------
+
+std::string MessageLogger::Capture::str() const
+{
+  return MessageLogger::str();
+}
+
 std::string MessageLogger::str()
 {
   if (sOutputStream != nullptr)
@@ -9,6 +9,9 @@
 
 #include "MessageLoggerStream.h"
 
+#include <fstream>
+#include <memory>
+#include <sstream>
 #include <stdexcept>
 
 namespace TextGen
@@ -26,6 +29,13 @@ class MessageLogger : public MessageLoggerStream<>
   ~MessageLogger() override;
   MessageLogger(std::string theFunction);
 
+  // Writes at the depth of the calling thread without entering a new function
+
+  struct Continue
+  {
+  };
+  explicit MessageLogger(Continue);
+
   void onNewMessage(const string_type& theMessage) override;
   static std::string str();
   MessageLogger& operator<<(const TextGen::Glyph& theGlyph);
@@ -36,8 +46,42 @@ class MessageLogger : public MessageLoggerStream<>
   static void indentstep(unsigned int theStep);
   static void timestamp(bool theFlag);
 
+  // Logging state of a thread, used for relaying messages from worker threads
+
+  struct Context
+  {
+    bool enabled = false;
+    unsigned long depth = 0;
+    char indentchar = ' ';
+    unsigned int indentstep = 2;
+    bool timestamp = false;
+  };
+
+  static Context context();
+  static void append(const std::string& theText);
+
+  // Captures the messages of the calling thread for the lifetime of the object
+
+  class Capture
+  {
+   public:
+    Capture() = delete;
+    Capture(const Capture& theOther) = delete;
+    Capture& operator=(const Capture& theOther) = delete;
+    explicit Capture(const Context& theContext);
+    ~Capture();
+
+    std::string str() const;
+
+   private:
+    std::unique_ptr<std::ofstream> itsFile;
+    std::unique_ptr<std::ostringstream> itsStream;
+    Context itsPrevious;
+  };
+
  private:
   std::string itsFunction;
+  bool itsScoped = true;
 
 };  // MessageLogger
 
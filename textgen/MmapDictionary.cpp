@@ -0,0 +1,558 @@
+// ======================================================================
+/*!
+ * \file
+ * \brief Implementation of class TextGen::MmapDictionary
+ */
+// ======================================================================
+/*!
+ * \class TextGen::MmapDictionary
+ *
+ * \brief Provides dictionary services from compiled memory mapped files
+ *
+ * The dictionary of each language is read from a binary image
+ * compiled from the .po file of the language, either with
+ * tools/po_to_dict.py or with MmapDictionary::compile. The image
+ * is mapped into memory and the lookups are served directly from
+ * the mapping, hence initialization requires no parsing and the
+ * pages are shared by all the processes using the same file. The
+ * keys are interned at initialization so that Phrase glyphs can be
+ * realized with a single array lookup.
+ *
+ * Sample usage:
+ * \code
+ * using namespace TextGen;
+ *
+ * MmapDictionary dict;
+ * dict.init("fi");
+ * dict.init("en");
+ *
+ * cout << dict.find("1-aamusta") << '\n';
+ * dict.changeLanguage("fi");
+ * cout << dict.find("1-aamusta") << '\n';
+ * \endcode
+ *
+ * All the languages initialized remain mapped, and changing back
+ * to a language initialized earlier is essentially free.
+ *
+ * The images are read from textgen::mmapdictionaries, which defaults
+ * to the value of textgen::podictionaries. The image of language xx
+ * is named xx.dict.
+ *
+ * The image consists of little endian 32-bit integers and bytes:
+ *
+ * -# magic "TGDICT01"
+ * -# number of entries N, number of hash buckets B, size of string data S
+ *    and a reserved zero
+ * -# B hash displacements
+ * -# N entry indices, one per hash slot
+ * -# N entries sorted by key, each consisting of the key offset, key size,
+ *    value offset and value size in the string data
+ * -# S bytes of string data
+ *
+ * The hash is a minimal perfect hash built with the hash and displace
+ * algorithm: the bucket of a key is mix(h) % B and its slot is
+ * mix(h ^ d * 0x9E3779B97F4A7C15) % N, where h is the 64-bit FNV-1a
+ * hash of the key, d is the displacement of the bucket and mix is
+ * the splitmix64 finalizer.
+ */
+// ----------------------------------------------------------------------
+
+#include "MmapDictionary.h"
+#include "PhraseIndex.h"
+#include <calculator/Settings.h>
+#include <macgyver/Exception.h>
+#include <newbase/NFmiFileSystem.h>
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+namespace TextGen
+{
+namespace
+{
+const char magic[8] = {'T', 'G', 'D', 'I', 'C', 'T', '0', '1'};
+const std::size_t header_size = 24;
+const std::size_t entry_size = 16;
+const std::uint32_t max_displacement = 1U << 24;
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief 64-bit FNV-1a hash
+ */
+// ----------------------------------------------------------------------
+
+std::uint64_t fnv1a(const char* theData, std::size_t theSize)
+{
+  std::uint64_t h = 14695981039346656037ULL;
+  for (std::size_t i = 0; i < theSize; i++)
+  {
+    h ^= static_cast<unsigned char>(theData[i]);
+    h *= 1099511628211ULL;
+  }
+  return h;
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief The splitmix64 finalizer
+ */
+// ----------------------------------------------------------------------
+
+std::uint64_t mix(std::uint64_t h)
+{
+  h ^= h >> 30;
+  h *= 0xBF58476D1CE4E5B9ULL;
+  h ^= h >> 27;
+  h *= 0x94D049BB133111EBULL;
+  h ^= h >> 31;
+  return h;
+}
+
+std::uint32_t bucket_index(std::uint64_t theHash, std::uint32_t theBuckets)
+{
+  return static_cast<std::uint32_t>(mix(theHash) % theBuckets);
+}
+
+std::uint32_t slot_index(std::uint64_t theHash,
+                         std::uint32_t theDisplacement,
+                         std::uint32_t theSlots)
+{
+  return static_cast<std::uint32_t>(mix(theHash ^ (theDisplacement * 0x9E3779B97F4A7C15ULL)) %
+                                    theSlots);
+}
+
+std::uint32_t read_u32(const char* thePtr)
+{
+  const auto* p = reinterpret_cast<const unsigned char*>(thePtr);
+  return (std::uint32_t(p[0]) | (std::uint32_t(p[1]) << 8) | (std::uint32_t(p[2]) << 16) |
+          (std::uint32_t(p[3]) << 24));
+}
+
+void write_u32(std::string& theOutput, std::uint32_t theValue)
+{
+  for (int i = 0; i < 4; i++)
+    theOutput += static_cast<char>((theValue >> (8 * i)) & 0xFF);
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief A memory mapped dictionary image of one language
+ */
+// ----------------------------------------------------------------------
+
+class Image
+{
+ public:
+  Image(const std::string& theFilename);
+  Image(const Image& theOther) = delete;
+  Image& operator=(const Image& theOther) = delete;
+
+  const char* find(const std::string& theKey, std::size_t& theSize) const;
+  const std::string_view* find(PhraseId theId) const { return itsIndex.find(theId); }
+  std::uint32_t size() const { return itsCount; }
+
+ private:
+  boost::interprocess::file_mapping itsFile;
+  boost::interprocess::mapped_region itsRegion;
+
+  std::uint32_t itsCount = 0;
+  std::uint32_t itsBuckets = 0;
+  std::uint32_t itsStringsSize = 0;
+  const char* itsDisplacements = nullptr;
+  const char* itsSlots = nullptr;
+  const char* itsEntries = nullptr;
+  const char* itsStrings = nullptr;
+  PhraseIndex itsIndex;
+};
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Map the image and validate its structure
+ */
+// ----------------------------------------------------------------------
+
+Image::Image(const std::string& theFilename)
+    : itsFile(theFilename.c_str(), boost::interprocess::read_only),
+      itsRegion(itsFile, boost::interprocess::read_only)
+{
+  const char* data = static_cast<const char*>(itsRegion.get_address());
+  const std::size_t size = itsRegion.get_size();
+
+  if (size < header_size || std::memcmp(data, magic, sizeof(magic)) != 0)
+    throw Fmi::Exception(BCP, "Error: '" + theFilename + "' is not a compiled dictionary");
+
+  itsCount = read_u32(data + 8);
+  itsBuckets = read_u32(data + 12);
+  itsStringsSize = read_u32(data + 16);
+
+  const std::size_t expected = header_size + 4UL * itsBuckets + 4UL * itsCount +
+                               entry_size * itsCount + itsStringsSize;
+
+  if (itsBuckets == 0 || size != expected)
+    throw Fmi::Exception(BCP, "Error: Compiled dictionary '" + theFilename + "' is corrupted");
+
+  itsDisplacements = data + header_size;
+  itsSlots = itsDisplacements + 4UL * itsBuckets;
+  itsEntries = itsSlots + 4UL * itsCount;
+  itsStrings = itsEntries + entry_size * itsCount;
+
+  for (std::uint32_t i = 0; i < itsCount; i++)
+  {
+    const char* entry = itsEntries + entry_size * i;
+    const std::uint64_t keyend = std::uint64_t(read_u32(entry)) + read_u32(entry + 4);
+    const std::uint64_t valueend = std::uint64_t(read_u32(entry + 8)) + read_u32(entry + 12);
+    if (read_u32(itsSlots + 4UL * i) >= itsCount || keyend > itsStringsSize ||
+        valueend > itsStringsSize)
+      throw Fmi::Exception(BCP, "Error: Compiled dictionary '" + theFilename + "' is corrupted");
+
+    itsIndex.insert(std::string(itsStrings + read_u32(entry), read_u32(entry + 4)),
+                    std::string_view(itsStrings + read_u32(entry + 8), read_u32(entry + 12)));
+  }
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Find the translation of the key
+ *
+ * \param theKey The key
+ * \param theSize The size of the translation
+ * \return Pointer to the translation, or nullptr if the key is not found
+ */
+// ----------------------------------------------------------------------
+
+const char* Image::find(const std::string& theKey, std::size_t& theSize) const
+{
+  if (itsCount == 0)
+    return nullptr;
+
+  const std::uint64_t h = fnv1a(theKey.data(), theKey.size());
+  const std::uint32_t d = read_u32(itsDisplacements + 4UL * bucket_index(h, itsBuckets));
+  const std::uint32_t e = read_u32(itsSlots + 4UL * slot_index(h, d, itsCount));
+
+  const char* entry = itsEntries + entry_size * e;
+  const std::uint32_t keysize = read_u32(entry + 4);
+
+  if (keysize != theKey.size() ||
+      std::memcmp(itsStrings + read_u32(entry), theKey.data(), keysize) != 0)
+    return nullptr;
+
+  theSize = read_u32(entry + 12);
+  return itsStrings + read_u32(entry + 8);
+}
+
+}  // namespace
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Implementation hiding pimple
+ */
+// ----------------------------------------------------------------------
+
+class MmapDictionary::Pimple
+{
+ public:
+  using storage_type = std::map<std::string, std::shared_ptr<const Image>>;
+
+  storage_type itsImages;
+  std::string itsLanguage;
+  std::shared_ptr<const Image> itsImage;
+
+};  // class Pimple
+
+MmapDictionary::~MmapDictionary() = default;
+
+MmapDictionary::MmapDictionary() : itsPimple(new Pimple())
+{
+  try
+  {
+    itsDictionaryId = "mmap";
+  }
+  catch (...)
+  {
+    throw Fmi::Exception::Trace(BCP, "Operation failed");
+  }
+}
+
+const std::string& MmapDictionary::language() const
+{
+  return itsPimple->itsLanguage;
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Initialize with given language
+ *
+ * Maps `<textgen::mmapdictionaries>/<theLanguage>.dict` unless
+ * the language has already been mapped.
+ */
+// ----------------------------------------------------------------------
+
+void MmapDictionary::init(const std::string& theLanguage)
+{
+  try
+  {
+    itsPimple->itsLanguage = theLanguage;
+    itsPimple->itsImage.reset();
+
+    auto it = itsPimple->itsImages.find(theLanguage);
+    if (it != itsPimple->itsImages.end())
+    {
+      itsPimple->itsImage = it->second;
+      return;
+    }
+
+    const std::string podir =
+        Settings::optional_string("textgen::podictionaries", "/usr/share/smartmet/textgen");
+    const std::string database = Settings::optional_string("textgen::mmapdictionaries", podir);
+    const std::string filename = database + '/' + theLanguage + ".dict";
+
+    if (!NFmiFileSystem::FileExists(filename))
+      throw Fmi::Exception(BCP, "Error: Could not find dictionary '" + filename + "'");
+
+    auto image = std::make_shared<const Image>(filename);
+    itsPimple->itsImages.insert(std::make_pair(theLanguage, image));
+    itsPimple->itsImage = image;
+  }
+  catch (...)
+  {
+    throw Fmi::Exception::Trace(BCP, "Operation failed").addParameter("language", theLanguage);
+  }
+}
+
+bool MmapDictionary::contains(const std::string& theKey) const
+{
+  try
+  {
+    std::size_t size = 0;
+    return (itsPimple->itsImage != nullptr && itsPimple->itsImage->find(theKey, size) != nullptr);
+  }
+  catch (...)
+  {
+    throw Fmi::Exception::Trace(BCP, "Operation failed").addParameter("key", theKey);
+  }
+}
+
+std::string MmapDictionary::find(const std::string& theKey) const
+{
+  try
+  {
+    if (itsPimple->itsImage == nullptr)
+      throw Fmi::Exception(BCP, "Error: MmapDictionary::find() called before init()");
+
+    std::size_t size = 0;
+    const char* phrase = itsPimple->itsImage->find(theKey, size);
+
+    if (phrase != nullptr)
+      return std::string(phrase, size);
+    throw Fmi::Exception(
+        BCP,
+        "Error: MmapDictionary::find(" + theKey + ") failed in language " + itsPimple->itsLanguage);
+  }
+  catch (...)
+  {
+    throw Fmi::Exception::Trace(BCP, "Operation failed").addParameter("key", theKey);
+  }
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Return the phrase with the given interned key
+ */
+// ----------------------------------------------------------------------
+
+std::string MmapDictionary::lookup(PhraseId theId) const
+{
+  try
+  {
+    if (itsPimple->itsImage != nullptr)
+      if (const auto* phrase = itsPimple->itsImage->find(theId))
+        return std::string(*phrase);
+    return find(PhraseTable::word(theId));
+  }
+  catch (...)
+  {
+    throw Fmi::Exception::Trace(BCP, "Operation failed");
+  }
+}
+
+void MmapDictionary::insert(const std::string& /*theKey*/, const std::string& /*thePhrase*/)
+{
+  try
+  {
+    throw Fmi::Exception(BCP, "Error: MmapDictionary::insert() is not allowed");
+  }
+  catch (...)
+  {
+    throw Fmi::Exception::Trace(BCP, "Operation failed");
+  }
+}
+
+MmapDictionary::size_type MmapDictionary::size() const
+{
+  try
+  {
+    return (itsPimple->itsImage == nullptr ? 0 : itsPimple->itsImage->size());
+  }
+  catch (...)
+  {
+    throw Fmi::Exception::Trace(BCP, "Operation failed");
+  }
+}
+
+bool MmapDictionary::empty() const
+{
+  try
+  {
+    return (size() == 0);
+  }
+  catch (...)
+  {
+    throw Fmi::Exception::Trace(BCP, "Operation failed");
+  }
+}
+
+void MmapDictionary::changeLanguage(const std::string& theLanguage)
+{
+  try
+  {
+    init(theLanguage);
+  }
+  catch (...)
+  {
+    throw Fmi::Exception::Trace(BCP, "Operation failed").addParameter("language", theLanguage);
+  }
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Write a compiled dictionary image
+ *
+ * The image is written to a temporary file which is then renamed,
+ * so that processes which have mapped the old image are unaffected.
+ *
+ * \param theData The translations
+ * \param theFilename The name of the image
+ */
+// ----------------------------------------------------------------------
+
+void MmapDictionary::compile(const std::map<std::string, std::string>& theData,
+                             const std::string& theFilename)
+{
+  try
+  {
+    const std::uint32_t count = theData.size();
+    const std::uint32_t nbuckets = std::max(1U, count / 2);
+
+    // Entries and string data in key order
+
+    std::vector<std::uint64_t> hashes;
+    std::string entries;
+    std::string strings;
+    for (const auto& item : theData)
+    {
+      hashes.push_back(fnv1a(item.first.data(), item.first.size()));
+      write_u32(entries, strings.size());
+      write_u32(entries, item.first.size());
+      strings += item.first;
+      write_u32(entries, strings.size());
+      write_u32(entries, item.second.size());
+      strings += item.second;
+    }
+
+    // Place the largest buckets first
+
+    std::vector<std::vector<std::uint32_t>> buckets(nbuckets);
+    for (std::uint32_t i = 0; i < count; i++)
+      buckets[bucket_index(hashes[i], nbuckets)].push_back(i);
+
+    std::vector<std::uint32_t> order(nbuckets);
+    for (std::uint32_t b = 0; b < nbuckets; b++)
+      order[b] = b;
+    std::stable_sort(order.begin(),
+                     order.end(),
+                     [&buckets](std::uint32_t a, std::uint32_t b)
+                     { return buckets[a].size() > buckets[b].size(); });
+
+    std::vector<std::uint32_t> displacements(nbuckets, 0);
+    std::vector<std::uint32_t> slots(count, 0);
+    std::vector<bool> used(count, false);
+    std::vector<std::uint32_t> candidate;
+
+    for (std::uint32_t b : order)
+    {
+      if (buckets[b].empty())
+        break;
+
+      std::uint32_t d = 0;
+      for (; d < max_displacement; d++)
+      {
+        candidate.clear();
+        bool ok = true;
+        for (std::uint32_t i : buckets[b])
+        {
+          const std::uint32_t s = slot_index(hashes[i], d, count);
+          if (used[s] || std::find(candidate.begin(), candidate.end(), s) != candidate.end())
+          {
+            ok = false;
+            break;
+          }
+          candidate.push_back(s);
+        }
+        if (ok)
+          break;
+      }
+      if (d == max_displacement)
+        throw Fmi::Exception(BCP, "Error: Failed to build a perfect hash for the dictionary");
+
+      displacements[b] = d;
+      for (std::size_t k = 0; k < candidate.size(); k++)
+      {
+        used[candidate[k]] = true;
+        slots[candidate[k]] = buckets[b][k];
+      }
+    }
+
+    // Assemble the image
+
+    std::string image(magic, sizeof(magic));
+    write_u32(image, count);
+    write_u32(image, nbuckets);
+    write_u32(image, strings.size());
+    write_u32(image, 0);
+    for (std::uint32_t d : displacements)
+      write_u32(image, d);
+    for (std::uint32_t s : slots)
+      write_u32(image, s);
+    image += entries;
+    image += strings;
+
+    const std::string tmpfile = theFilename + ".tmp";
+    {
+      std::ofstream out(tmpfile.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+      if (!out)
+        throw Fmi::Exception(BCP, "Error: Could not open '" + tmpfile + "' for writing");
+      out.write(image.data(), image.size());
+      if (!out)
+        throw Fmi::Exception(BCP, "Error: Failed to write '" + tmpfile + "'");
+    }
+
+    if (std::rename(tmpfile.c_str(), theFilename.c_str()) != 0)
+      throw Fmi::Exception(
+          BCP, "Error: Failed to rename '" + tmpfile + "' to '" + theFilename + "'");
+  }
+  catch (...)
+  {
+    throw Fmi::Exception::Trace(BCP, "Operation failed").addParameter("filename", theFilename);
+  }
+}
+
+}  // namespace TextGen
+
+// ======================================================================
@@ -0,0 +1,52 @@
+// ======================================================================
+/*!
+ * \file
+ * \brief Interface of class TextGen::MmapDictionary
+ */
+// ======================================================================
+
+#pragma once
+
+#include "Dictionary.h"
+
+#include <map>
+#include <memory>
+#include <string>
+
+namespace TextGen
+{
+class MmapDictionary : public Dictionary
+{
+ public:
+  using size_type = Dictionary::size_type;
+
+  ~MmapDictionary() override;
+  MmapDictionary();
+#ifdef NO_COMPILER_OPTIMIZE
+  MmapDictionary(const MmapDictionary& theDict);
+  MmapDictionary& operator=(const MmapDictionary& theDict);
+#endif
+
+  void init(const std::string& theLanguage) override;
+  const std::string& language() const override;
+  bool contains(const std::string& theKey) const override;
+  std::string find(const std::string& theKey) const override;
+  std::string lookup(PhraseId theId) const override;
+  void insert(const std::string& theKey, const std::string& thePhrase) override;
+
+  size_type size() const override;
+  bool empty() const override;
+  void changeLanguage(const std::string& theLanguage) override;
+
+  static void compile(const std::map<std::string, std::string>& theData,
+                      const std::string& theFilename);
+
+ private:
+  class Pimple;
+  std::shared_ptr<Pimple> itsPimple;
+
+};  // class MmapDictionary
+
+}  // namespace TextGen
+
+// ======================================================================
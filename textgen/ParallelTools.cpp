@@ -0,0 +1,431 @@
+// ======================================================================
+/*!
+ * \file
+ * \brief Implementation of namespace TextGen::ParallelTools
+ */
+// ======================================================================
+/*!
+ * \namespace TextGen::ParallelTools
+ *
+ * \brief Utilities for evaluating independent tasks concurrently
+ *
+ * The tasks are taken from a shared queue in their original order
+ * by a fixed number of threads, the calling thread being one of them.
+ * The other threads come from a process wide pool, which is created
+ * on first use and grows to the largest number of threads requested,
+ * hence repeated calls do not pay for starting new threads.
+ * Each task runs with the analysis cache and the settings of the
+ * calling thread active, and its log messages are captured and appended
+ * to the log of the calling thread in task order once all the tasks
+ * have finished. Hence the log looks the same as if the tasks had been
+ * run serially.
+ *
+ * The thread specific settings of the calling thread cannot be read
+ * back from Settings, hence they must be installed with a SettingsScope
+ * for the workers to see them. A pool thread parses the settings only
+ * when they differ from those it installed last, which is once per
+ * SettingsScope. If no SettingsScope is active, or if any
+ * of the qdtext::append_* debugging outputs is enabled, the tasks are
+ * run serially in the calling thread, since the workers would otherwise
+ * read different settings or modify them.
+ *
+ * Tasks started from within a task are run serially in the worker
+ * thread, so nested parallel sections do not multiply the number
+ * of threads.
+ */
+// ======================================================================
+
+#include "ParallelTools.h"
+#include "AnalysisCache.h"
+#include "MessageLogger.h"
+#include <calculator/Settings.h>
+#include <macgyver/Exception.h>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+using namespace std;
+
+namespace TextGen
+{
+namespace ParallelTools
+{
+namespace
+{
+thread_local bool sInWorker = false;
+
+// The settings installed by the innermost SettingsScope of the thread
+thread_local std::shared_ptr<const std::string> sSettings;
+
+// The settings a pool thread has installed last
+thread_local std::shared_ptr<const std::string> sInstalled;
+
+// Debugging outputs which collect data into a shared setting
+const char* const debug_outputs[] = {"qdtext::append_graph",
+                                     "qdtext::append_rawdata",
+                                     "qdtext::append_windspeed_distribution",
+                                     "qdtext::append_winddirection_distribution"};
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Return true if the tasks must see the settings of the calling thread only
+ */
+// ----------------------------------------------------------------------
+
+bool serial_settings()
+{
+  if (!sSettings)
+    return true;
+
+  for (const char* name : debug_outputs)
+    if (Settings::optional_bool(name, false))
+      return true;
+
+  return false;
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Marks the calling thread as a worker for the lifetime of the object
+ */
+// ----------------------------------------------------------------------
+
+class WorkerScope
+{
+ public:
+  WorkerScope() : itsPrevious(sInWorker) { sInWorker = true; }
+  ~WorkerScope() { sInWorker = itsPrevious; }
+  WorkerScope(const WorkerScope& theOther) = delete;
+  WorkerScope& operator=(const WorkerScope& theOther) = delete;
+
+ private:
+  bool itsPrevious;
+};
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Threads which run the jobs of run() for the lifetime of the process
+ */
+// ----------------------------------------------------------------------
+
+class Pool
+{
+ public:
+  using job_type = std::function<void()>;
+
+  Pool() = default;
+  Pool(const Pool& theOther) = delete;
+  Pool& operator=(const Pool& theOther) = delete;
+  ~Pool();
+
+  void submit(const job_type& theJob, unsigned int theThreads);
+
+ private:
+  void work();
+
+  std::mutex itsMutex;
+  std::condition_variable itsCondition;
+  std::deque<job_type> itsJobs;
+  std::vector<std::thread> itsThreads;
+  bool itsStopped = false;
+};
+
+Pool::~Pool()
+{
+  {
+    std::lock_guard<std::mutex> lock(itsMutex);
+    itsStopped = true;
+  }
+  itsCondition.notify_all();
+  for (auto& thread : itsThreads)
+    thread.join();
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Queue a job for each of the given number of threads
+ *
+ * The pool is grown to the number of threads first.
+ */
+// ----------------------------------------------------------------------
+
+void Pool::submit(const job_type& theJob, unsigned int theThreads)
+{
+  try
+  {
+    {
+      std::lock_guard<std::mutex> lock(itsMutex);
+      while (itsThreads.size() < theThreads)
+        itsThreads.emplace_back(&Pool::work, this);
+      for (unsigned int i = 0; i < theThreads; i++)
+        itsJobs.push_back(theJob);
+    }
+    itsCondition.notify_all();
+  }
+  catch (...)
+  {
+    throw Fmi::Exception::Trace(BCP, "Operation failed");
+  }
+}
+
+void Pool::work()
+{
+  while (true)
+  {
+    job_type job;
+    {
+      std::unique_lock<std::mutex> lock(itsMutex);
+      itsCondition.wait(lock, [this]() { return itsStopped || !itsJobs.empty(); });
+      if (itsJobs.empty())
+        return;
+      job = std::move(itsJobs.front());
+      itsJobs.pop_front();
+    }
+    job();
+  }
+}
+
+Pool& pool()
+{
+  static Pool instance;
+  return instance;
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief The state shared by run() and its pool jobs
+ *
+ * Jobs still queued when run() returns must not touch the tasks,
+ * hence they are admitted only until run() closes the state, and
+ * run() waits for the admitted ones to finish.
+ */
+// ----------------------------------------------------------------------
+
+struct Admission
+{
+  std::mutex itsMutex;
+  std::condition_variable itsCondition;
+  unsigned int itsActive = 0;
+  bool itsClosed = false;
+
+  bool enter()
+  {
+    std::lock_guard<std::mutex> lock(itsMutex);
+    if (itsClosed)
+      return false;
+    ++itsActive;
+    return true;
+  }
+
+  void leave()
+  {
+    {
+      std::lock_guard<std::mutex> lock(itsMutex);
+      --itsActive;
+    }
+    itsCondition.notify_all();
+  }
+
+  void close()
+  {
+    std::unique_lock<std::mutex> lock(itsMutex);
+    itsClosed = true;
+    itsCondition.wait(lock, [this]() { return itsActive == 0; });
+  }
+};
+
+}  // namespace
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Return the configured number of threads
+ *
+ * Value 0 means the number of hardware threads. The default is 1,
+ * which means the tasks are run serially in the calling thread.
+ *
+ * \param theVariable The name of the setting
+ * \return The number of threads, at least 1
+ */
+// ----------------------------------------------------------------------
+
+unsigned int threads(const string& theVariable)
+{
+  try
+  {
+    const int n = Settings::optional_int(theVariable, 1);
+    if (n < 0)
+      throw Fmi::Exception(BCP, theVariable + " must be nonnegative");
+    if (n == 0)
+      return std::max(1U, std::thread::hardware_concurrency());
+    return n;
+  }
+  catch (...)
+  {
+    throw Fmi::Exception::Trace(BCP, "Operation failed").addParameter("theVariable", theVariable);
+  }
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Return true if the calling thread is running a task
+ */
+// ----------------------------------------------------------------------
+
+bool inWorker()
+{
+  return sInWorker;
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Install the settings in the calling thread
+ *
+ * The settings remain published to run() until the scope ends, after
+ * which the settings of the enclosing scope are published again. The
+ * settings installed in the calling thread are not reverted.
+ *
+ * \param theSettings The settings in the format of NFmiSettings::ToString
+ */
+// ----------------------------------------------------------------------
+
+SettingsScope::SettingsScope(const string& theSettings) : itsPrevious(sSettings)
+{
+  try
+  {
+    Settings::set(theSettings);
+    sSettings = std::make_shared<const string>(theSettings);
+  }
+  catch (...)
+  {
+    throw Fmi::Exception::Trace(BCP, "Operation failed");
+  }
+}
+
+SettingsScope::~SettingsScope()
+{
+  sSettings = itsPrevious;
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Run the tasks using the given number of threads
+ *
+ * If any task throws, the remaining tasks are skipped and the
+ * exception of the first failed task in task order is rethrown
+ * once all the threads have finished.
+ *
+ * The tasks are run serially in the calling thread if no SettingsScope
+ * is active or if a qdtext::append_* debugging output is enabled.
+ *
+ * \param theTasks The tasks
+ * \param theThreads The maximum number of threads
+ */
+// ----------------------------------------------------------------------
+
+void run(const vector<task_type>& theTasks, unsigned int theThreads)
+{
+  try
+  {
+    const unsigned int nthreads =
+        std::min<std::size_t>(std::max(1U, theThreads), theTasks.size());
+
+    if (nthreads <= 1 || sInWorker || serial_settings())
+    {
+      for (const auto& task : theTasks)
+        task();
+      return;
+    }
+
+    const std::shared_ptr<const string> settings = sSettings;
+    AnalysisCache* cache = AnalysisCache::current();
+    const MessageLogger::Context context = MessageLogger::context();
+
+    vector<string> logs(theTasks.size());
+    vector<exception_ptr> errors(theTasks.size());
+    atomic<std::size_t> next{0};
+    atomic<bool> failed{false};
+
+    auto worker = [&](bool thePoolThread)
+    {
+      WorkerScope worker_scope;
+      AnalysisCache::Scope cache_scope(cache);
+
+      for (std::size_t i = next++; i < theTasks.size() && !failed; i = next++)
+      {
+        try
+        {
+          if (thePoolThread && sInstalled != settings)
+          {
+            Settings::set(*settings);
+            sInstalled = settings;
+          }
+          MessageLogger::Capture capture(context);
+          theTasks[i]();
+          logs[i] = capture.str();
+        }
+        catch (...)
+        {
+          errors[i] = std::current_exception();
+          failed = true;
+        }
+      }
+    };
+
+    const std::shared_ptr<Admission> admission = std::make_shared<Admission>();
+
+    try
+    {
+      pool().submit(
+          [admission, &worker]()
+          {
+            if (admission->enter())
+            {
+              worker(true);
+              admission->leave();
+            }
+          },
+          nthreads - 1);
+    }
+    catch (...)
+    {
+      failed = true;
+      admission->close();
+      throw;
+    }
+
+    try
+    {
+      worker(false);
+    }
+    catch (...)
+    {
+      failed = true;
+      admission->close();
+      throw;
+    }
+
+    admission->close();
+
+    for (const auto& error : errors)
+      if (error)
+        std::rethrow_exception(error);
+
+    for (const auto& log : logs)
+      MessageLogger::append(log);
+  }
+  catch (...)
+  {
+    throw Fmi::Exception::Trace(BCP, "Operation failed");
+  }
+}
+
+}  // namespace ParallelTools
+}  // namespace TextGen
+
+// ======================================================================
@@ -0,0 +1,45 @@
+// ======================================================================
+/*!
+ * \file
+ * \brief Interface of namespace TextGen::ParallelTools
+ */
+// ======================================================================
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace TextGen
+{
+namespace ParallelTools
+{
+using task_type = std::function<void()>;
+
+unsigned int threads(const std::string& theVariable = "textgen::parallel::threads");
+
+void run(const std::vector<task_type>& theTasks, unsigned int theThreads);
+
+bool inWorker();
+
+// Installs the settings in the calling thread and in the worker threads
+// of run() for the lifetime of the object
+
+class SettingsScope
+{
+ public:
+  explicit SettingsScope(const std::string& theSettings);
+  ~SettingsScope();
+  SettingsScope(const SettingsScope& theOther) = delete;
+  SettingsScope& operator=(const SettingsScope& theOther) = delete;
+
+ private:
+  std::shared_ptr<const std::string> itsPrevious;
+};
+
+}  // namespace ParallelTools
+}  // namespace TextGen
+
+// ======================================================================
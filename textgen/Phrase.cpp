@@ -15,7 +15,6 @@
 #include "Dictionary.h"
 #include "TextFormatter.h"
 #include <macgyver/Exception.h>
-#include <utility>
 
 using namespace std;
 
@@ -32,11 +31,18 @@ Phrase::~Phrase() = default;
 /*!
  * \brief Constructor
  *
+ * The word is interned so that realization needs no string lookups.
+ * If the phrase table is full the word is kept as is.
+ *
  * \param theWord The word
  */
 // ----------------------------------------------------------------------
 
-Phrase::Phrase(std::string theWord) : itsWord(std::move(theWord)) {}
+Phrase::Phrase(std::string theWord) : itsId(PhraseTable::intern(theWord))
+{
+  if (itsId == PhraseTable::noId)
+    itsWord = std::move(theWord);
+}
 // ----------------------------------------------------------------------
 /*!
  * \brief Return a clone
@@ -69,7 +75,9 @@ std::string Phrase::realize(const Dictionary& theDictionary) const
 {
   try
   {
-    return theDictionary.find(itsWord);
+    if (itsId == PhraseTable::noId)
+      return theDictionary.find(itsWord);
+    return theDictionary.lookup(itsId);
   }
   catch (...)
   {
@@ -8,6 +8,7 @@
 #pragma once
 
 #include "Glyph.h"
+#include "PhraseTable.h"
 #include <string>
 
 namespace TextGen
@@ -29,8 +30,12 @@ class Phrase : public Glyph
   std::string realize(const TextFormatter& theFormatter) const override;
   bool isDelimiter() const override;
 
+  // PhraseTable::noId if the phrase table was full
+  PhraseId id() const { return itsId; }
+
  private:
-  std::string itsWord;
+  PhraseId itsId;
+  std::string itsWord;  // only if the word could not be interned
 
 };  // class Phrase
 
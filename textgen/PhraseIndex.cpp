@@ -0,0 +1,89 @@
+// ======================================================================
+/*!
+ * \file
+ * \brief Implementation of class TextGen::PhraseIndex
+ */
+// ======================================================================
+/*!
+ * \class TextGen::PhraseIndex
+ *
+ * \brief Dense array of the translations of one language indexed by PhraseId
+ *
+ * The index stores views to translations owned by the dictionary,
+ * which must hence outlive the index and must not modify the indexed
+ * translations. Ids not present in the dictionary map to a null view,
+ * which is distinct from an empty translation.
+ */
+// ======================================================================
+
+#include "PhraseIndex.h"
+#include <macgyver/Exception.h>
+
+namespace TextGen
+{
+// ----------------------------------------------------------------------
+/*!
+ * \brief Remove all phrases from the index
+ */
+// ----------------------------------------------------------------------
+
+void PhraseIndex::clear()
+{
+  itsPhrases.clear();
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Index all the translations of a dictionary
+ *
+ * \param theData The translations, which must outlive the index
+ */
+// ----------------------------------------------------------------------
+
+void PhraseIndex::assign(const std::map<std::string, std::string>& theData)
+{
+  try
+  {
+    itsPhrases.clear();
+    for (const auto& item : theData)
+      insert(item.first, item.second);
+  }
+  catch (...)
+  {
+    throw Fmi::Exception::Trace(BCP, "Operation failed");
+  }
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Index a single translation
+ *
+ * \param theKey The key of the phrase
+ * \param thePhrase The translation, which must outlive the index
+ */
+// ----------------------------------------------------------------------
+
+void PhraseIndex::insert(const std::string& theKey, std::string_view thePhrase)
+{
+  try
+  {
+    // Keys which could not be interned are looked up by the word
+    const PhraseId id = PhraseTable::intern(theKey);
+    if (id == PhraseTable::noId)
+      return;
+    if (id >= itsPhrases.size())
+      itsPhrases.resize(id + 1);
+
+    // Keep the first translation like std::map::insert does
+    if (itsPhrases[id].data() == nullptr)
+      itsPhrases[id] = (thePhrase.data() != nullptr ? thePhrase : std::string_view(""));
+  }
+  catch (...)
+  {
+    throw Fmi::Exception::Trace(BCP, "Operation failed").addParameter("key", theKey);
+  }
+}
+
+}  // namespace TextGen
+
+// ======================================================================
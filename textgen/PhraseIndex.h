@@ -0,0 +1,48 @@
+// ======================================================================
+/*!
+ * \file
+ * \brief Interface of class TextGen::PhraseIndex
+ */
+// ======================================================================
+
+#pragma once
+
+#include "PhraseTable.h"
+
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace TextGen
+{
+class PhraseIndex
+{
+ public:
+  void clear();
+  void assign(const std::map<std::string, std::string>& theData);
+  void insert(const std::string& theKey, std::string_view thePhrase);
+
+  // ----------------------------------------------------------------------
+  /*!
+   * \brief Return the phrase with the given id
+   *
+   * \return Pointer to the phrase, or nullptr if the id is not indexed
+   */
+  // ----------------------------------------------------------------------
+
+  const std::string_view* find(PhraseId theId) const
+  {
+    if (theId >= itsPhrases.size() || itsPhrases[theId].data() == nullptr)
+      return nullptr;
+    return &itsPhrases[theId];
+  }
+
+ private:
+  std::vector<std::string_view> itsPhrases;
+
+};  // class PhraseIndex
+
+}  // namespace TextGen
+
+// ======================================================================
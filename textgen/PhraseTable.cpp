@@ -0,0 +1,170 @@
+// ======================================================================
+/*!
+ * \file
+ * \brief Implementation of namespace TextGen::PhraseTable
+ */
+// ======================================================================
+/*!
+ * \namespace TextGen::PhraseTable
+ *
+ * \brief Process wide table of interned dictionary keys
+ *
+ * Each distinct dictionary key is given a small integer id the first
+ * time it is seen. The ids are shared by all dictionaries and all
+ * languages, which can hence store their translations in dense arrays
+ * indexed by the id, see PhraseIndex.
+ *
+ * Every Phrase constructor interns its word, so the table is split
+ * into shards by the hash of the word, each with its own read-write
+ * lock. Lookups of known words only take the read lock of one shard.
+ * The shard is encoded in the low bits of the id, so word() finds the
+ * shard without hashing.
+ *
+ * Ids are never released, since phrases keep only the id. Instead the
+ * table holds at most capacity() words, which is well above the number
+ * of dictionary keys. Once a shard is full intern() returns noId for
+ * new words, and phrases keep the word itself instead.
+ */
+// ======================================================================
+
+#include "PhraseTable.h"
+#include <macgyver/Exception.h>
+
+#include <array>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
+namespace TextGen
+{
+namespace PhraseTable
+{
+namespace
+{
+// The number of shards and the maximum number of words in each
+
+const std::size_t shard_count = 16;
+const std::size_t shard_capacity = 4096;
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief The interned words of one shard
+ *
+ * A deque is used since it does not move its elements when it grows,
+ * so the references returned by word() remain valid.
+ */
+// ----------------------------------------------------------------------
+
+struct Shard
+{
+  std::shared_mutex itsMutex;
+  std::unordered_map<std::string, PhraseId> itsIds;
+  std::deque<std::string> itsWords;
+};
+
+std::array<Shard, shard_count>& shards()
+{
+  static std::array<Shard, shard_count> sShards;
+  return sShards;
+}
+
+}  // namespace
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Return the id of the given word, adding it to the table if necessary
+ *
+ * \return The id, or noId if the word is new and its shard is full
+ */
+// ----------------------------------------------------------------------
+
+PhraseId intern(const std::string& theWord)
+{
+  try
+  {
+    const std::size_t index = std::hash<std::string>()(theWord) % shard_count;
+    Shard& shard = shards()[index];
+    {
+      std::shared_lock<std::shared_mutex> lock(shard.itsMutex);
+      auto it = shard.itsIds.find(theWord);
+      if (it != shard.itsIds.end())
+        return it->second;
+    }
+
+    std::unique_lock<std::shared_mutex> lock(shard.itsMutex);
+    auto it = shard.itsIds.find(theWord);
+    if (it != shard.itsIds.end())
+      return it->second;
+
+    if (shard.itsWords.size() >= shard_capacity)
+      return noId;
+
+    const auto id = static_cast<PhraseId>(shard.itsWords.size() * shard_count + index);
+    shard.itsWords.push_back(theWord);
+    shard.itsIds.insert(std::make_pair(theWord, id));
+    return id;
+  }
+  catch (...)
+  {
+    throw Fmi::Exception::Trace(BCP, "Operation failed").addParameter("word", theWord);
+  }
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Return the word with the given id
+ */
+// ----------------------------------------------------------------------
+
+const std::string& word(PhraseId theId)
+{
+  try
+  {
+    Shard& shard = shards()[theId % shard_count];
+    const std::size_t pos = theId / shard_count;
+
+    std::shared_lock<std::shared_mutex> lock(shard.itsMutex);
+    if (theId == noId || pos >= shard.itsWords.size())
+      throw Fmi::Exception(BCP, "Error: Unknown phrase id " + std::to_string(theId));
+    return shard.itsWords[pos];
+  }
+  catch (...)
+  {
+    throw Fmi::Exception::Trace(BCP, "Operation failed");
+  }
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Return the number of interned words
+ */
+// ----------------------------------------------------------------------
+
+std::size_t size()
+{
+  std::size_t n = 0;
+  for (Shard& shard : shards())
+  {
+    std::shared_lock<std::shared_mutex> lock(shard.itsMutex);
+    n += shard.itsWords.size();
+  }
+  return n;
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Return the maximum number of interned words
+ */
+// ----------------------------------------------------------------------
+
+std::size_t capacity()
+{
+  return shard_count * shard_capacity;
+}
+
+}  // namespace PhraseTable
+}  // namespace TextGen
+
+// ======================================================================
@@ -0,0 +1,31 @@
+// ======================================================================
+/*!
+ * \file
+ * \brief Interface of namespace TextGen::PhraseTable
+ */
+// ======================================================================
+
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <string>
+
+namespace TextGen
+{
+using PhraseId = std::uint32_t;
+
+namespace PhraseTable
+{
+// returned by intern() once the table is full
+constexpr PhraseId noId = std::numeric_limits<PhraseId>::max();
+
+PhraseId intern(const std::string& theWord);
+const std::string& word(PhraseId theId);
+std::size_t size();
+std::size_t capacity();
+
+}  // namespace PhraseTable
+}  // namespace TextGen
+
+// ======================================================================
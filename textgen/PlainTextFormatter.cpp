@@ -199,7 +199,7 @@ string PlainTextFormatter::visit(const Sentence& theSentence) const
     const string sep = TextFormatterTools::wordSeparator(itsDictionary.get());
     string ret =
         TextFormatterTools::realize(theSentence.begin(), theSentence.end(), *this, sep, "");
-    ret = TextFormatterTools::capitalize(ret);
+    ret = TextFormatterTools::capitalize(ret, itsDictionary.get());
     if (!ret.empty())
       ret += TextFormatterTools::sentenceEnd(itsDictionary.get());
 
@@ -246,7 +246,7 @@ string PlainTextFormatter::visit(const Header& theHeader) const
 
     const string sep = TextFormatterTools::wordSeparator(itsDictionary.get());
     string ret = TextFormatterTools::realize(theHeader.begin(), theHeader.end(), *this, sep, "");
-    ret = TextFormatterTools::capitalize(ret);
+    ret = TextFormatterTools::capitalize(ret, itsDictionary.get());
     if (!ret.empty() && colon)
       ret += ':';
 
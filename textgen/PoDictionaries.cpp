@@ -138,6 +138,21 @@ std::string PoDictionaries::find(const std::string& theKey) const
   }
 }
 
+std::string PoDictionaries::lookup(PhraseId theId) const
+{
+  try
+  {
+    if (!itsPimple->itsInitialized)
+      throw Fmi::Exception(BCP, "Error: PoDictionaries::lookup() called before init()");
+
+    return itsPimple->itsCurrentDictionary->second->lookup(theId);
+  }
+  catch (...)
+  {
+    throw Fmi::Exception::Trace(BCP, "Operation failed");
+  }
+}
+
 void PoDictionaries::insert(const std::string& theKey, const std::string& thePhrase)
 {
   try
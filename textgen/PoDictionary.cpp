@@ -34,12 +34,14 @@
 // ----------------------------------------------------------------------
 
 #include "PoDictionary.h"
+#include "PhraseIndex.h"
 #include <calculator/Settings.h>
 #include <macgyver/Exception.h>
 #include <newbase/NFmiFileSystem.h>
 
 #include <fstream>
 #include <map>
+#include <utility>
 
 namespace TextGen
 {
@@ -134,6 +136,7 @@ class PoDictionary::Pimple
   bool itsInitialized{false};
   std::string itsLanguage;
   StorageType itsData;
+  PhraseIndex itsIndex;
 
 };  // class Pimple
 
@@ -179,6 +182,7 @@ void PoDictionary::init(const std::string& theLanguage)
     itsPimple->itsLanguage = theLanguage;
     itsPimple->itsInitialized = false;
     itsPimple->itsData.clear();
+    itsPimple->itsIndex.clear();
 
     std::string database = Settings::optional_string("textgen::podictionaries", "/usr/share/smartmet/textgen");
     std::string filename = database + '/' + theLanguage + ".po";
@@ -186,9 +190,34 @@ void PoDictionary::init(const std::string& theLanguage)
     if (!NFmiFileSystem::FileExists(filename))
       throw Fmi::Exception(BCP, "Error: Could not find dictionary '" + filename + "'");
 
-    std::ifstream in(filename.c_str());
+    read(filename, itsPimple->itsData);
+
+    itsPimple->itsIndex.assign(itsPimple->itsData);
+    itsPimple->itsInitialized = true;
+  }
+  catch (...)
+  {
+    throw Fmi::Exception::Trace(BCP, "Operation failed").addParameter("language", theLanguage);
+  }
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Read the translations from a .po file
+ *
+ * \param theFilename The name of the .po file
+ * \param theData The storage for the translations
+ */
+// ----------------------------------------------------------------------
+
+void PoDictionary::read(const std::string& theFilename, std::map<std::string, std::string>& theData)
+{
+  try
+  {
+    std::ifstream in(theFilename.c_str());
     if (!in)
-      throw Fmi::Exception(BCP, "Error: Could not open dictionary '" + filename + "' for reading");
+      throw Fmi::Exception(BCP,
+                           "Error: Could not open dictionary '" + theFilename + "' for reading");
 
     // A gettext .po file is a sequence of entries separated by blank lines.
     // Each entry has a msgid and a msgstr, either of which may be spread
@@ -207,7 +236,7 @@ void PoDictionary::init(const std::string& theLanguage)
     auto commit = [&]()
     {
       if (state != State::None && !msgid.empty())
-        itsPimple->itsData.insert(Pimple::value_type(msgid, msgstr));
+        theData.insert(std::make_pair(msgid, msgstr));
       msgid.clear();
       msgstr.clear();
       state = State::None;
@@ -231,39 +260,37 @@ void PoDictionary::init(const std::string& theLanguage)
       if (starts_with(line, "msgid \""))
       {
         commit();
-        msgid = po_unquote(line.substr(6), filename, lineno);
+        msgid = po_unquote(line.substr(6), theFilename, lineno);
         state = State::Msgid;
       }
       else if (starts_with(line, "msgstr \""))
       {
-        msgstr = po_unquote(line.substr(7), filename, lineno);
+        msgstr = po_unquote(line.substr(7), theFilename, lineno);
         state = State::Msgstr;
       }
       else if (line[0] == '"')
       {
-        std::string piece = po_unquote(line, filename, lineno);
+        std::string piece = po_unquote(line, theFilename, lineno);
         if (state == State::Msgid)
           msgid += piece;
         else if (state == State::Msgstr)
           msgstr += piece;
         else
           throw Fmi::Exception(BCP,
-                               filename + ":" + std::to_string(lineno) +
+                               theFilename + ":" + std::to_string(lineno) +
                                    ": continuation string outside msgid/msgstr");
       }
       else
       {
         throw Fmi::Exception(
-            BCP, filename + ":" + std::to_string(lineno) + ": unexpected line '" + line + "'");
+            BCP, theFilename + ":" + std::to_string(lineno) + ": unexpected line '" + line + "'");
       }
     }
     commit();
-
-    itsPimple->itsInitialized = true;
   }
   catch (...)
   {
-    throw Fmi::Exception::Trace(BCP, "Operation failed").addParameter("language", theLanguage);
+    throw Fmi::Exception::Trace(BCP, "Operation failed").addParameter("filename", theFilename);
   }
 }
 
@@ -299,6 +326,31 @@ std::string PoDictionary::find(const std::string& theKey) const
   }
 }
 
+// ----------------------------------------------------------------------
+/*!
+ * \brief Return the phrase with the given interned key
+ *
+ * Same as find() for the key, but served from the dense phrase index.
+ *
+ * \param theId The interned key of the phrase
+ * \return The phrase
+ */
+// ----------------------------------------------------------------------
+
+std::string PoDictionary::lookup(PhraseId theId) const
+{
+  try
+  {
+    if (const auto* phrase = itsPimple->itsIndex.find(theId))
+      return std::string(*phrase);
+    return find(PhraseTable::word(theId));
+  }
+  catch (...)
+  {
+    throw Fmi::Exception::Trace(BCP, "Operation failed");
+  }
+}
+
 void PoDictionary::insert(const std::string& /*theKey*/, const std::string& /*thePhrase*/)
 {
   try
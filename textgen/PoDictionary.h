@@ -9,6 +9,7 @@
 
 #include "Dictionary.h"
 
+#include <map>
 #include <memory>
 #include <string>
 
@@ -30,12 +31,15 @@ class PoDictionary : public Dictionary
   const std::string& language() const override;
   bool contains(const std::string& theKey) const override;
   std::string find(const std::string& theKey) const override;
+  std::string lookup(PhraseId theId) const override;
   void insert(const std::string& theKey, const std::string& thePhrase) override;
 
   size_type size() const override;
   bool empty() const override;
   void changeLanguage(const std::string& theLanguage) override;
 
+  static void read(const std::string& theFilename, std::map<std::string, std::string>& theData);
+
  private:
   class Pimple;
   std::shared_ptr<Pimple> itsPimple;
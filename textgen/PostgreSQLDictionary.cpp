@@ -7,6 +7,11 @@
 /*!
  * \class TextGen::PostgreSQLDictionary
  *
+ * \brief Dictionary read from the PostgreSQL translation tables
+ *
+ * All dictionaries share a single connection, which is opened on
+ * first use and reopened only if it has been lost or the connection
+ * settings have changed.
  */
 // ----------------------------------------------------------------------
 
@@ -16,9 +21,9 @@
 #include <macgyver/PostgreSQLConnection.h>
 #include <macgyver/StringConversion.h>
 
-#include <thread>
-
 #include <map>
+#include <memory>
+#include <mutex>
 
 using namespace std;
 
@@ -55,35 +60,78 @@ inline int as_int(const pqxx::field& obj)
     throw Fmi::Exception::Trace(BCP, "Operation failed");
   }
 }
-}  // namespace
 
-namespace TextGen
+// The connection shared by all dictionaries and the options it was opened with
+
+std::mutex sConnectionMutex;
+std::unique_ptr<Fmi::Database::PostgreSQLConnection> sConnection;
+std::string sConnectionOptions;
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Establish the connection options for TextGen
+ */
+// ----------------------------------------------------------------------
+
+Fmi::Database::PostgreSQLConnectionOptions connection_options()
 {
-void PostgreSQLDictionary::getDataFromDB(const std::string& theLanguage,
-                                         std::map<std::string, std::string>& theDataStorage)
+  try
+  {
+    Fmi::Database::PostgreSQLConnectionOptions connectionOptions;
+    connectionOptions.host = TextGen::Settings::require_string("textgen::host");
+    connectionOptions.port = TextGen::Settings::require_int("textgen::port");
+    connectionOptions.database = TextGen::Settings::require_string("textgen::database");
+    connectionOptions.username = TextGen::Settings::require_string("textgen::user");
+    connectionOptions.password = TextGen::Settings::require_string("textgen::passwd");
+    connectionOptions.encoding = TextGen::Settings::require_string("textgen::encoding");
+    connectionOptions.connect_timeout = TextGen::Settings::require_int("textgen::connect_timeout");
+    return connectionOptions;
+  }
+  catch (...)
+  {
+    throw Fmi::Exception::Trace(BCP, "Operation failed");
+  }
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Return the schema prefix for table names
+ */
+// ----------------------------------------------------------------------
+
+std::string schema_prefix()
+{
+  std::string schema_name = TextGen::Settings::optional_string("textgen::schema", "textgen");
+  if (!schema_name.empty())
+    schema_name += ".";
+  return schema_name;
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Return the shared connection, opening it if necessary
+ *
+ * The connection is reopened if the options have changed or the
+ * connection has been lost. The caller must hold sConnectionMutex.
+ */
+// ----------------------------------------------------------------------
+
+Fmi::Database::PostgreSQLConnection& connection(
+    const Fmi::Database::PostgreSQLConnectionOptions& theOptions)
 {
   try
   {
-    // Establish the settings for TextGen
+    const std::string options(theOptions);
 
-    Fmi::Database::PostgreSQLConnectionOptions connectionOptions;
-    connectionOptions.host = Settings::require_string("textgen::host");
-    connectionOptions.port = Settings::require_int("textgen::port");
-    connectionOptions.database = Settings::require_string("textgen::database");
-    connectionOptions.username = Settings::require_string("textgen::user");
-    connectionOptions.password = Settings::require_string("textgen::passwd");
-    connectionOptions.encoding = Settings::require_string("textgen::encoding");
-    connectionOptions.connect_timeout = Settings::require_int("textgen::connect_timeout");
-    std::string schema_name = Settings::optional_string("textgen::schema", "textgen");
-    if (!schema_name.empty())
-      schema_name += ".";
-
-    Fmi::Database::PostgreSQLConnection dbConnection;
+    if (sConnection != nullptr && sConnectionOptions == options && sConnection->isConnected())
+      return *sConnection;
+
+    sConnection.reset();
+
+    auto dbConnection = std::make_unique<Fmi::Database::PostgreSQLConnection>();
     try
     {
-      dbConnection.open(connectionOptions);
-
-      std::this_thread::sleep_for(std::chrono::milliseconds(1000));
+      dbConnection->open(theOptions);
     }
     catch (const std::exception& e)
     {
@@ -94,16 +142,89 @@ void PostgreSQLDictionary::getDataFromDB(const std::string& theLanguage,
       throw Fmi::Exception(
           BCP,
           "SmartMet::Textgen::PostgreSQLDictionary: Creating database connection failed: " +
-              std::string(connectionOptions));
+              options);
     }
 
+    // Check the connection is usable instead of waiting for a fixed time
+
+    if (!dbConnection->isConnected())
+      throw Fmi::Exception(
+          BCP,
+          "SmartMet::Textgen::PostgreSQLDictionary: Database connection is not ready: " + options);
+
+    sConnection = std::move(dbConnection);
+    sConnectionOptions = options;
+    return *sConnection;
+  }
+  catch (...)
+  {
+    throw Fmi::Exception::Trace(BCP, "Operation failed");
+  }
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Execute a query using the shared connection
+ *
+ * The query is retried once with a new connection if the server has
+ * closed the idle shared connection. Errors in the query itself are
+ * not retried.
+ */
+// ----------------------------------------------------------------------
+
+pqxx::result execute(const std::string& theSqlStmt)
+{
+  try
+  {
+    const auto options = connection_options();
+
+    std::lock_guard<std::mutex> lock(sConnectionMutex);
+
+    try
+    {
+      return connection(options).executeNonTransaction(theSqlStmt);
+    }
+    catch (...)
+    {
+      if (sConnection != nullptr && sConnection->isConnected())
+        throw;
+      sConnection.reset();
+    }
+    return connection(options).executeNonTransaction(theSqlStmt);
+  }
+  catch (...)
+  {
+    throw Fmi::Exception::Trace(BCP, "Operation failed").addParameter("sql", theSqlStmt);
+  }
+}
+
+}  // namespace
+
+namespace TextGen
+{
+// ----------------------------------------------------------------------
+/*!
+ * \brief Read the translations of the given language
+ *
+ * \param theLanguage The ISO-code of the language
+ * \param theDataStorage The storage for the translations
+ */
+// ----------------------------------------------------------------------
+
+void PostgreSQLDictionary::getDataFromDB(const std::string& theLanguage,
+                                         std::map<std::string, std::string>& theDataStorage)
+{
+  try
+  {
+    const std::string schema_name = schema_prefix();
+
     // select the right translation table
     std::string sqlStmt = ("select translationtable, active from " + schema_name + "languages");
     sqlStmt += " where isocode = '";
     sqlStmt += theLanguage;
     sqlStmt += "'";
 
-    pqxx::result result_set = dbConnection.executeNonTransaction(sqlStmt);
+    pqxx::result result_set = execute(sqlStmt);
 
     if (result_set.empty())
     {
@@ -118,7 +239,7 @@ void PostgreSQLDictionary::getDataFromDB(const std::string& theLanguage,
 
     auto row = result_set.at(0);
     auto translationtable = row.at(0).as<std::string>();
-    int active = row.at(1).as<int>();
+    int active = as_int(row.at(1));
 
     if (active != 1)
       throw Fmi::Exception(BCP, "Error: Language " + theLanguage + " is not active");
@@ -127,7 +248,7 @@ void PostgreSQLDictionary::getDataFromDB(const std::string& theLanguage,
 
     sqlStmt = ("select keyword, translation from " + schema_name + translationtable);
 
-    result_set = dbConnection.executeNonTransaction(sqlStmt);
+    result_set = execute(sqlStmt);
 
     for (auto row : result_set)
     {
@@ -136,8 +257,65 @@ void PostgreSQLDictionary::getDataFromDB(const std::string& theLanguage,
       if (!keyword.empty())
         theDataStorage.insert(std::make_pair(keyword, translation));
     }
+  }
+  catch (...)
+  {
+    throw Fmi::Exception::Trace(BCP, "Operation failed");
+  }
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Read the translations of all active languages
+ *
+ * The languages are read with two queries regardless of the number
+ * of languages: one for the translation tables and one for the
+ * union of all the tables.
+ *
+ * \param theDataStorage The translations keyed by the ISO-code of the language
+ */
+// ----------------------------------------------------------------------
+
+void PostgreSQLDictionary::getAllDataFromDB(
+    std::map<std::string, std::map<std::string, std::string> >& theDataStorage)
+{
+  try
+  {
+    const std::string schema_name = schema_prefix();
+
+    std::string sqlStmt = "select isocode, translationtable from " + schema_name + "languages";
+    sqlStmt += " where active = 1";
+
+    pqxx::result result_set = execute(sqlStmt);
 
-    dbConnection.close();
+    std::string unionStmt;
+    for (auto row : result_set)
+    {
+      auto isocode = row.at(0).as<std::string>();
+      auto translationtable = row.at(1).as<std::string>();
+      if (isocode.empty() || translationtable.empty())
+        continue;
+
+      if (!unionStmt.empty())
+        unionStmt += " union all ";
+      unionStmt += "select '" + isocode + "', keyword, translation from " + schema_name +
+                   translationtable;
+      theDataStorage[isocode];
+    }
+
+    if (unionStmt.empty())
+      return;
+
+    result_set = execute(unionStmt);
+
+    for (auto row : result_set)
+    {
+      auto isocode = row.at(0).as<std::string>();
+      auto keyword = row.at(1).as<std::string>();
+      auto translation = row.at(2).as<std::string>();
+      if (!keyword.empty())
+        theDataStorage[isocode].insert(std::make_pair(keyword, translation));
+    }
   }
   catch (...)
   {
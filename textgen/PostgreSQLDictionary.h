@@ -22,6 +22,9 @@ class PostgreSQLDictionary : public DatabaseDictionary
  public:
   PostgreSQLDictionary() { itsDictionaryId = "postgresql"; }
 
+  static void getAllDataFromDB(
+      std::map<std::string, std::map<std::string, std::string> >& theDataStorage);
+
  private:
   void getDataFromDB(const std::string& theLanguage,
                      std::map<std::string, std::string>& theDataStorage) override;
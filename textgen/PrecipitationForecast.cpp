@@ -27,7 +27,6 @@
 #include "WeekdayTools.h"
 #include <boost/algorithm/string.hpp>
 #include <boost/lexical_cast.hpp>
-#include <boost/thread.hpp>
 #include <calculator/GridForecaster.h>
 #include <calculator/HourPeriodGenerator.h>
 #include <calculator/MathTools.h>
@@ -287,16 +286,6 @@ using namespace TimeTools;
 
 namespace
 {
-InPlacesPhrase& get_in_places_phrase()
-{
-  static boost::thread_specific_ptr<InPlacesPhrase> tls;
-
-  if (!tls.get())
-    tls.reset(new InPlacesPhrase);
-
-  return *tls;
-}
-
 std::ostream& operator<<(std::ostream& theOutput,
                          const PrecipitationDataItemData& thePrecipitationDataItemData)
 {
@@ -385,12 +374,14 @@ bool get_period_start_end_index(const WeatherPeriod& thePeriod,
   theStartIndex = 0;
   theEndIndex = 0;
 
+  const std::time_t startTime = thePeriod.localStartTime().EpochTime();
+  const std::time_t endTime = thePeriod.localEndTime().EpochTime();
+
   bool startFound = false;
   for (unsigned int i = 0; i < theDataVector.size(); i++)
   {
     // Note: in weather result vector start and end times are same
-    if (theDataVector.at(i)->thePeriod.localStartTime() >= thePeriod.localStartTime() &&
-        theDataVector.at(i)->thePeriod.localStartTime() <= thePeriod.localEndTime())
+    if (theDataVector[i].startTime() >= startTime && theDataVector[i].startTime() <= endTime)
     {
       if (!startFound)
       {
@@ -688,7 +679,7 @@ void PrecipitationForecast::getTransformationPhraseElements(
     // check if intensity is heavy
     theCheckHeavyIntensityFlag = CONTINUOUS;
 
-    InPlacesPhrase& inPlacesPhraseMaker = get_in_places_phrase();
+    InPlacesPhrase& inPlacesPhraseMaker = theParameters.theInPlacesPhrase;
     InPlacesPhrase::PhraseType phraseType(InPlacesPhrase::NONEXISTENT_PHRASE);
     if (in_some_places)
       phraseType = InPlacesPhrase::IN_SOME_PLACES_PHRASE;
@@ -807,8 +798,8 @@ void PrecipitationForecast::handleWaterFormPhrase(const PrecipPhraseContext& ctx
                              elems);
       return;
     }
-    elems[IN_PLACES_PARAMETER] << get_in_places_phrase().getInPlacesPhrase(ctx.phraseType,
-                                                                           theUseOllaVerbFlag);
+    elems[IN_PLACES_PARAMETER] << theParameters.theInPlacesPhrase.getInPlacesPhrase(
+        ctx.phraseType, theUseOllaVerbFlag);
     if (ctx.is_showers)
       handleWaterFormShowersPhrase(ctx, elems);
     else
@@ -837,8 +828,8 @@ void PrecipitationForecast::handleSleetFormPhrase(const PrecipPhraseContext& ctx
           ctx.is_showers, ctx.period, YKSITTAISET_RANTAKUUROT_MAHDOLLISIA_PHRASE, elems);
       return;
     }
-    elems[IN_PLACES_PARAMETER] << get_in_places_phrase().getInPlacesPhrase(ctx.phraseType,
-                                                                           theUseOllaVerbFlag);
+    elems[IN_PLACES_PARAMETER] << theParameters.theInPlacesPhrase.getInPlacesPhrase(
+        ctx.phraseType, theUseOllaVerbFlag);
     if (ctx.is_showers)
     {
       elems[PRECIPITATION_PARAMETER] << RANTAKUUROJA_WORD;
@@ -878,8 +869,8 @@ void PrecipitationForecast::handleSnowFormPhrase(const PrecipPhraseContext& ctx,
           ctx.is_showers, ctx.period, YKSITTAISET_LUMIKUUROT_MAHDOLLISIA_PHRASE, elems);
       return;
     }
-    elems[IN_PLACES_PARAMETER] << get_in_places_phrase().getInPlacesPhrase(ctx.phraseType,
-                                                                           theUseOllaVerbFlag);
+    elems[IN_PLACES_PARAMETER] << theParameters.theInPlacesPhrase.getInPlacesPhrase(
+        ctx.phraseType, theUseOllaVerbFlag);
     if (ctx.is_showers)
     {
       if (ctx.intensity >= theParameters.theHeavyPrecipitationLimitSnow)
@@ -931,8 +922,8 @@ void PrecipitationForecast::handleDrizzleFormPhrase(const PrecipPhraseContext& c
                              elems);
       return;
     }
-    elems[IN_PLACES_PARAMETER] << get_in_places_phrase().getInPlacesPhrase(ctx.phraseType,
-                                                                           theUseOllaVerbFlag);
+    elems[IN_PLACES_PARAMETER] << theParameters.theInPlacesPhrase.getInPlacesPhrase(
+        ctx.phraseType, theUseOllaVerbFlag);
     if (ctx.is_showers)
     {
       elems[PRECIPITATION_PARAMETER]
@@ -972,8 +963,8 @@ void PrecipitationForecast::handleWaterDrizzleFormPhrase(const PrecipPhraseConte
                              elems);
       return;
     }
-    elems[IN_PLACES_PARAMETER] << get_in_places_phrase().getInPlacesPhrase(ctx.phraseType,
-                                                                           theUseOllaVerbFlag);
+    elems[IN_PLACES_PARAMETER] << theParameters.theInPlacesPhrase.getInPlacesPhrase(
+        ctx.phraseType, theUseOllaVerbFlag);
     if (ctx.is_showers)
     {
       elems[PRECIPITATION_PARAMETER]
@@ -1018,8 +1009,8 @@ void PrecipitationForecast::handleWaterSleetFormPhrase(const PrecipPhraseContext
           elems);
       return;
     }
-    elems[IN_PLACES_PARAMETER] << get_in_places_phrase().getInPlacesPhrase(ctx.phraseType,
-                                                                           theUseOllaVerbFlag);
+    elems[IN_PLACES_PARAMETER] << theParameters.theInPlacesPhrase.getInPlacesPhrase(
+        ctx.phraseType, theUseOllaVerbFlag);
     if (ctx.is_showers)
     {
       if (ctx.formWater >= ctx.formSleet && !ctx.can_be_freezing)
@@ -1062,8 +1053,8 @@ void PrecipitationForecast::handleWaterSnowFormPhrase(const PrecipPhraseContext&
           ctx.is_showers, ctx.period, YKSITTAISET_VESI_LUMI_KUUROT_MAHDOLLISIA_PHRASE, elems);
       return;
     }
-    elems[IN_PLACES_PARAMETER] << get_in_places_phrase().getInPlacesPhrase(ctx.phraseType,
-                                                                           theUseOllaVerbFlag);
+    elems[IN_PLACES_PARAMETER] << theParameters.theInPlacesPhrase.getInPlacesPhrase(
+        ctx.phraseType, theUseOllaVerbFlag);
     if (ctx.is_showers)
     {
       waterAndSnowShowersPhrase(ctx.intensity,
@@ -1124,8 +1115,8 @@ void PrecipitationForecast::handleSleetSnowFormPhrase(const PrecipPhraseContext&
           ctx.is_showers, ctx.period, YKSITTAISET_LUMI_RANTA_KUUROT_MAHDOLLISIA_PHRASE, elems);
       return;
     }
-    elems[IN_PLACES_PARAMETER] << get_in_places_phrase().getInPlacesPhrase(ctx.phraseType,
-                                                                           theUseOllaVerbFlag);
+    elems[IN_PLACES_PARAMETER] << theParameters.theInPlacesPhrase.getInPlacesPhrase(
+        ctx.phraseType, theUseOllaVerbFlag);
     if (ctx.is_showers)
     {
       waterAndSnowShowersPhrase(ctx.intensity,
@@ -3907,11 +3898,11 @@ Sentence PrecipitationForecast::constructPrecipitationSentence(
 
         // ARE 22.02.2011: this is to prevent tautology e.g. sisamaassa moinin paikoin rantasadetta,
         // rannikolla monin paikoin vesisadetta
-        get_in_places_phrase().preventTautology(true);
+        theParameters.theInPlacesPhrase.preventTautology(true);
         sentence << Delimiter(COMMA_PUNCTUATION_MARK);
         sentence << constructPrecipitationSentence(
             thePeriod, thePeriodPhrase, COASTAL_AREA, COAST_PHRASE, theAdditionalSentences);
-        get_in_places_phrase().preventTautology(false);
+        theParameters.theInPlacesPhrase.preventTautology(false);
         return sentence;
       }
       return buildSingleAreaPrecipitationSentence(thePeriod,
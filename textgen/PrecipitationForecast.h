@@ -4,29 +4,6 @@
 
 namespace TextGen
 {
-// Declaration
-class InPlacesPhrase
-{
- public:
-  enum PhraseType
-  {
-    NONEXISTENT_PHRASE,
-    IN_SOME_PLACES_PHRASE,
-    IN_MANY_PLACES_PHRASE
-  };
-
-  InPlacesPhrase();
-  void preventTautology(bool preventTautologyFlag)
-  {
-    thePreventTautologyFlag = preventTautologyFlag;
-  }
-  Sentence getInPlacesPhrase(PhraseType thePhraseType, bool useOllaVerbFlag);
-
- private:
-  PhraseType thePreviousPhrase{NONEXISTENT_PHRASE};
-  bool thePreventTautologyFlag{false};
-};
-
 class PrecipitationForecast
 {
  public:
@@ -18,13 +18,12 @@
 // ======================================================================
 
 #include "PrecipitationPeriodTools.h"
+#include "MaskedCube.h"
+#include "ReductionTools.h"
 
 #include <calculator/AnalysisSources.h>
 #include <calculator/MaskSource.h>
-#include <calculator/PercentageCalculator.h>
-#include <calculator/QueryDataIntegrator.h>
 #include <calculator/QueryDataTools.h>
-#include <calculator/RangeAcceptor.h>
 #include <calculator/Settings.h>
 #include <calculator/TimeTools.h>
 #include <calculator/WeatherArea.h>
@@ -36,6 +35,7 @@
 #include <calculator/TextGenPosixTime.h>
 #include <newbase/NFmiFastQueryInfo.h>
 #include <newbase/NFmiQueryData.h>
+#include <limits>
 #include <memory>
 
 using namespace std;
@@ -199,15 +199,27 @@ RainTimes findRainTimes(const AnalysisSources& theSources,
     {
       std::shared_ptr<MaskSource> msource = theSources.getMaskSource();
       MaskSource::mask_type mask = msource->mask(theArea, dataname, *wsource);
-      RangeAcceptor acceptor;
-      acceptor.lowerLimit(minimum_rain);
-      PercentageCalculator calculator;
-      calculator.condition(acceptor);
+      const float rain_limit = static_cast<float>(minimum_rain);
+      const float no_limit = std::numeric_limits<float>::max();
+
+      // Gather the whole period at once
+
+      const unsigned long startindex = qi.TimeIndex();
+      unsigned long endindex = startindex;
       do
       {
-        const float tmp = QueryDataIntegrator::Integrate(qi, *mask, calculator);
+        ++endindex;
+      } while (qi.NextTime() && qi.Time() <= thePeriod.utcEndTime());
+
+      const MaskedCube cube(qi, *mask, startindex, endindex);
+
+      for (size_t t = 0; t < cube.times(); t++)
+      {
+        const float tmp =
+            ReductionTools::percentage(cube.row(t), cube.points(), rain_limit, no_limit);
         if (tmp != kFloatMissing && tmp >= minimum_area)
         {
+          qi.TimeIndex(startindex + t);
           const NFmiMetTime& metTime(qi.Time());
           TextGenPosixTime textgenTime(metTime.GetYear(),
                                        metTime.GetMonth(),
@@ -217,7 +229,7 @@ RainTimes findRainTimes(const AnalysisSources& theSources,
                                        metTime.GetSec());
           times.push_back(TextGenPosixTime::LocalTime(textgenTime));
         }
-      } while (qi.NextTime() && qi.Time() <= thePeriod.utcEndTime());
+      }
     }
     else
     {
@@ -17,6 +17,7 @@
 // ======================================================================
 
 #include "PrecipitationStoryTools.h"
+#include "CachedGridForecaster.h"
 #include "Integer.h"
 #include "MessageLogger.h"
 #include "PositiveRange.h"
@@ -24,7 +25,6 @@
 #include "UnitFactory.h"
 #include "ValueAcceptor.h"
 #include <calculator/AnalysisSources.h>
-#include <calculator/GridForecaster.h>
 #include <calculator/RangeAcceptor.h>
 #include <calculator/Settings.h>
 #include <calculator/WeatherPeriod.h>
@@ -310,7 +310,7 @@ Sentence places_phrase(const AnalysisSources& theSources,
     const int some_places = optional_percentage(theVar + "places::some", 50);
     const double minrain = optional_double(theVar + "::minrain", 0.1);
 
-    GridForecaster forecaster;
+    CachedGridForecaster forecaster;
 
     RangeAcceptor rainlimits;
     rainlimits.lowerLimit(minrain);
@@ -391,7 +391,7 @@ Sentence type_phrase(const AnalysisSources& theSources,
     const int ignore_limit = optional_percentage(theVar + "::ignore_limit", 5);
     const int shower_limit = optional_percentage(theVar + "::shower_limit", 80);
 
-    GridForecaster forecaster;
+    CachedGridForecaster forecaster;
     Sentence sentence;
 
     const string day = std::to_string(theDay);
@@ -0,0 +1,552 @@
+// ======================================================================
+/*!
+ * \file
+ * \brief Implementation of namespace TextGen::RasterMaskTools
+ */
+// ======================================================================
+/*!
+ * \namespace TextGen::RasterMaskTools
+ *
+ * \brief Mask construction by rasterizing paths onto the grid
+ *
+ * NFmiIndexMaskTools::MaskDistance and MaskExpand calculate the
+ * distance from every grid point to every edge of the path. For a
+ * coast line and a fine grid this takes long, and the masks are built
+ * on first use for every new data grid.
+ *
+ * The functions here rasterize the path onto the grid instead and
+ * calculate the Euclidean distance of every grid point from the
+ * nearest rasterized path point with a linear time distance transform
+ * (Felzenszwalb & Huttenlocher). The transform is done in grid
+ * coordinates scaled to kilometres at the middle of the grid, which
+ * is the projected world XY system of the grid up to a constant.
+ *
+ * The distance field differs from the true distance by the
+ * rasterization error and the scale variation of the projection. Both
+ * are bounded: the scale is sampled over the grid, and the rasterized
+ * point is within a grid cell of the path. Only the grid points whose
+ * distance is within these bounds of the limit are tested with the
+ * exact NFmiSvgTools functions, hence the masks are the same as those
+ * of NFmiIndexMaskTools.
+ */
+// ======================================================================
+
+#include "RasterMaskTools.h"
+#include "GridCoordinates.h"
+#include <macgyver/Exception.h>
+
+#include <newbase/NFmiGrid.h>
+#include <newbase/NFmiIndexMaskTools.h>
+#include <newbase/NFmiPoint.h>
+#include <newbase/NFmiSvgPath.h>
+#include <newbase/NFmiSvgTools.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+using namespace std;
+
+namespace TextGen
+{
+namespace RasterMaskTools
+{
+namespace
+{
+// Maximum length of a projected edge in grid units
+const double max_edge_length = 0.25;
+
+// Safety factor for the sampled scale variation of the projection
+const double scale_margin = 0.05;
+
+// Do not rasterize into a padded grid larger than this relative to the grid
+const double max_padding_factor = 4;
+
+const double infinity = std::numeric_limits<double>::infinity();
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Great circle distance in kilometres
+ */
+// ----------------------------------------------------------------------
+
+double geodistance(const NFmiPoint& theP1, const NFmiPoint& theP2)
+{
+  const double rad = M_PI / 180;
+  const double lat1 = theP1.Y() * rad;
+  const double lat2 = theP2.Y() * rad;
+  const double dlat = lat2 - lat1;
+  const double dlon = (theP2.X() - theP1.X()) * rad;
+  const double a = std::sin(dlat / 2) * std::sin(dlat / 2) +
+                   std::cos(lat1) * std::cos(lat2) * std::sin(dlon / 2) * std::sin(dlon / 2);
+  return 2 * 6371.0 * std::asin(std::min(1.0, std::sqrt(a)));
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Call a function for each short projected piece of the path
+ *
+ * The lat/lon edges are subdivided so that the projected pieces are
+ * short, which keeps the projected path within a fraction of a grid
+ * cell from the path used by NFmiSvgTools. Unclosed subpaths are
+ * closed implicitly.
+ */
+// ----------------------------------------------------------------------
+
+template <typename Function>
+void for_each_piece(const NFmiGrid& theGrid, const NFmiSvgPath& thePath, Function theFunction)
+{
+  auto subdivide = [&](const NFmiPoint& theStart, const NFmiPoint& theEnd)
+  {
+    const NFmiPoint g1 = theGrid.LatLonToGrid(theStart);
+    const NFmiPoint g2 = theGrid.LatLonToGrid(theEnd);
+
+    const double len = g1.Distance(g2);
+    if (!std::isfinite(len))
+      return;
+
+    const int n = std::max(1, static_cast<int>(std::ceil(len / max_edge_length)));
+
+    NFmiPoint a = g1;
+    for (int k = 1; k <= n; k++)
+    {
+      NFmiPoint b = g2;
+      if (k < n)
+      {
+        const double t = static_cast<double>(k) / n;
+        b = theGrid.LatLonToGrid(NFmiPoint(theStart.X() + t * (theEnd.X() - theStart.X()),
+                                           theStart.Y() + t * (theEnd.Y() - theStart.Y())));
+      }
+      theFunction(a, b);
+      a = b;
+    }
+  };
+
+  if (thePath.empty())
+    return;
+
+  NFmiPoint firstPoint(thePath.front().itsX, thePath.front().itsY);
+  NFmiPoint lastPoint = firstPoint;
+  bool open = false;
+
+  for (const auto& it : thePath)
+  {
+    switch (it.itsType)
+    {
+      case NFmiSvgPath::kElementMoveto:
+        if (open)
+          subdivide(lastPoint, firstPoint);
+        lastPoint = NFmiPoint(it.itsX, it.itsY);
+        firstPoint = lastPoint;
+        open = false;
+        break;
+      case NFmiSvgPath::kElementClosePath:
+        if (open)
+          subdivide(lastPoint, firstPoint);
+        lastPoint = firstPoint;
+        open = false;
+        break;
+      case NFmiSvgPath::kElementLineto:
+      {
+        NFmiPoint nextPoint(it.itsX, it.itsY);
+        subdivide(lastPoint, nextPoint);
+        lastPoint = nextPoint;
+        open = true;
+        break;
+      }
+      case NFmiSvgPath::kElementNotValid:
+        break;
+    }
+  }
+  if (open)
+    subdivide(lastPoint, firstPoint);
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief One dimensional squared distance transform
+ *
+ * \param f The input function, 0 at the path and infinity elsewhere
+ * \param n The number of elements
+ * \param theSpacing The distance between adjacent elements
+ * \param d The output squared distances
+ * \param v Work space for n parabola locations
+ * \param z Work space for n+1 parabola boundaries
+ */
+// ----------------------------------------------------------------------
+
+void distance_transform(
+    const double* f, long n, double theSpacing, double* d, long* v, double* z)
+{
+  long k = -1;
+  for (long q = 0; q < n; q++)
+  {
+    if (f[q] == infinity)
+      continue;
+
+    if (k < 0)
+    {
+      k = 0;
+      v[0] = q;
+      z[0] = -infinity;
+      z[1] = infinity;
+      continue;
+    }
+
+    const double xq = q * theSpacing;
+    double s = 0;
+    while (true)
+    {
+      const double xp = v[k] * theSpacing;
+      s = ((f[q] + xq * xq) - (f[v[k]] + xp * xp)) / (2 * (xq - xp));
+      if (s > z[k])
+        break;
+      --k;
+    }
+    ++k;
+    v[k] = q;
+    z[k] = s;
+    z[k + 1] = infinity;
+  }
+
+  if (k < 0)
+  {
+    std::fill(d, d + n, infinity);
+    return;
+  }
+
+  k = 0;
+  for (long q = 0; q < n; q++)
+  {
+    const double x = q * theSpacing;
+    while (z[k + 1] < x)
+      ++k;
+    const double dx = x - v[k] * theSpacing;
+    d[q] = dx * dx + f[v[k]];
+  }
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief The distances of the grid points from a path
+ *
+ * The distances are in the scaled grid coordinates. The true distance
+ * in kilometres of a grid point with distance d is within
+ * [minscale*(d-slack), maxscale*(d+slack)].
+ */
+// ----------------------------------------------------------------------
+
+struct DistanceField
+{
+  long nx = 0;
+  long ny = 0;
+  double minscale = 0;
+  double maxscale = 0;
+  double slack = 0;
+  std::vector<double> distances;
+
+  double distance(long i, long j) const { return distances[j * nx + i]; }
+};
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Calculate the distance field for distances up to the given limit
+ *
+ * Returns false if the grid is unsuitable for the calculation.
+ */
+// ----------------------------------------------------------------------
+
+bool distance_field(const NFmiGrid& theGrid,
+                    const NFmiSvgPath& thePath,
+                    double theDistance,
+                    DistanceField& theField)
+{
+  const long nx = theGrid.XNumber();
+  const long ny = theGrid.YNumber();
+  if (nx < 2 || ny < 2)
+    return false;
+
+  auto latlon = [&](long i, long j) { return theGrid.LatLon(j * nx + i); };
+
+  // Kilometres per grid step at the middle of the grid
+
+  const long ic = (nx - 1) / 2;
+  const long jc = (ny - 1) / 2;
+  const double ax = geodistance(latlon(ic, jc), latlon(ic + 1, jc));
+  const double ay = geodistance(latlon(ic, jc), latlon(ic, jc + 1));
+  if (!(ax > 0) || !(ay > 0))
+    return false;
+  const double diagonal = std::sqrt(ax * ax + ay * ay);
+
+  // Sample the scale variation in all directions over the grid
+
+  auto samples = [](long n)
+  {
+    std::vector<long> ret;
+    const long step = std::max(1L, (n - 1) / 16);
+    for (long k = 0; k < n - 1; k += step)
+      ret.push_back(k);
+    if (ret.back() != n - 2)
+      ret.push_back(n - 2);
+    return ret;
+  };
+
+  double minscale = infinity;
+  double maxscale = 0;
+  for (long j : samples(ny))
+    for (long i : samples(nx))
+    {
+      const NFmiPoint p00 = latlon(i, j);
+      const NFmiPoint p10 = latlon(i + 1, j);
+      const NFmiPoint p01 = latlon(i, j + 1);
+      const NFmiPoint p11 = latlon(i + 1, j + 1);
+      const double scales[] = {geodistance(p00, p10) / ax,
+                               geodistance(p00, p01) / ay,
+                               geodistance(p00, p11) / diagonal,
+                               geodistance(p10, p01) / diagonal};
+      for (double scale : scales)
+      {
+        minscale = std::min(minscale, scale);
+        maxscale = std::max(maxscale, scale);
+      }
+    }
+  if (!(minscale > 0) || !std::isfinite(maxscale))
+    return false;
+
+  minscale *= (1 - scale_margin);
+  maxscale *= (1 + scale_margin);
+
+  // The rasterized point is within half a grid cell of the path, and the
+  // subdivided path within a fraction of a cell from the original one.
+
+  const double slack = 2 * diagonal;
+
+  // Path points further than this from the grid cannot affect the mask
+
+  const double reach = theDistance / minscale + slack;
+  const long pad = static_cast<long>(std::ceil(reach / std::min(ax, ay))) + 1;
+  const long w = nx + 2 * pad;
+  const long h = ny + 2 * pad;
+  if (static_cast<double>(w) * h > max_padding_factor * nx * ny)
+    return false;
+
+  // Rasterize the path
+
+  std::vector<double> field(w * h, infinity);
+
+  for_each_piece(theGrid,
+                 thePath,
+                 [&](const NFmiPoint& a, const NFmiPoint& b)
+                 {
+                   for (const NFmiPoint& p : {a, b})
+                   {
+                     const double x = std::round(p.X()) + pad;
+                     const double y = std::round(p.Y()) + pad;
+                     if (x >= 0 && x < w && y >= 0 && y < h)
+                       field[static_cast<long>(y) * w + static_cast<long>(x)] = 0;
+                   }
+                 });
+
+  // Transform the columns and then the rows of the grid
+
+  const long n = std::max(w, h);
+  std::vector<double> f(n);
+  std::vector<double> d(n);
+  std::vector<long> v(n);
+  std::vector<double> z(n + 1);
+
+  for (long i = 0; i < w; i++)
+  {
+    for (long j = 0; j < h; j++)
+      f[j] = field[j * w + i];
+    distance_transform(f.data(), h, ay, d.data(), v.data(), z.data());
+    for (long j = 0; j < h; j++)
+      field[j * w + i] = d[j];
+  }
+
+  theField.nx = nx;
+  theField.ny = ny;
+  theField.minscale = minscale;
+  theField.maxscale = maxscale;
+  theField.slack = slack;
+  theField.distances.resize(nx * ny);
+
+  for (long j = 0; j < ny; j++)
+  {
+    distance_transform(&field[(j + pad) * w], w, ax, d.data(), v.data(), z.data());
+    for (long i = 0; i < nx; i++)
+      theField.distances[j * nx + i] = std::sqrt(d[i + pad]);
+  }
+
+  return true;
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Test whether a grid point is inside the projected path
+ */
+// ----------------------------------------------------------------------
+
+bool inside(const RowCrossings& theRows, long i, long j)
+{
+  auto row = theRows.find(j);
+  if (row == theRows.end())
+    return false;
+  const vector<double>& crossings = row->second;
+  const auto count = std::upper_bound(crossings.begin(), crossings.end(), static_cast<double>(i)) -
+                     crossings.begin();
+  return (count % 2 == 1);
+}
+
+}  // namespace
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Calculate the sorted edge crossings of a path for each grid row
+ *
+ * Each row crossing uses the half-open rule so that shared vertices are
+ * counted once. Unclosed subpaths are closed implicitly.
+ */
+// ----------------------------------------------------------------------
+
+RowCrossings CrossingsByRow(const NFmiGrid& theGrid, const NFmiSvgPath& thePath)
+{
+  try
+  {
+    RowCrossings rows;
+
+    const long ny = theGrid.YNumber();
+
+    for_each_piece(theGrid,
+                   thePath,
+                   [&](const NFmiPoint& a, const NFmiPoint& b)
+                   {
+                     const double ylo = std::min(a.Y(), b.Y());
+                     const double yhi = std::max(a.Y(), b.Y());
+
+                     const long j1 = std::max(0L, static_cast<long>(std::ceil(ylo)));
+                     const long j2 = std::min(ny - 1, static_cast<long>(std::ceil(yhi)) - 1);
+
+                     for (long j = j1; j <= j2; j++)
+                     {
+                       const double x = a.X() + (j - a.Y()) * (b.X() - a.X()) / (b.Y() - a.Y());
+                       rows[j].push_back(x);
+                     }
+                   });
+
+    for (auto& row : rows)
+      std::sort(row.second.begin(), row.second.end());
+
+    return rows;
+  }
+  catch (...)
+  {
+    throw Fmi::Exception::Trace(BCP, "Operation failed");
+  }
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief The grid points within the given distance from a path
+ *
+ * Equivalent to NFmiIndexMaskTools::MaskDistance.
+ *
+ * \param theGrid The grid
+ * \param thePath The path in lat/lon coordinates
+ * \param theDistance The distance in kilometres
+ */
+// ----------------------------------------------------------------------
+
+GridMask MaskDistance(const NFmiGrid& theGrid, const NFmiSvgPath& thePath, double theDistance)
+{
+  try
+  {
+    DistanceField field;
+    if (theDistance < 0 || !distance_field(theGrid, thePath, theDistance, field))
+      return GridMask(NFmiIndexMaskTools::MaskDistance(theGrid, thePath, theDistance), theGrid);
+
+    const std::shared_ptr<const GridCoordinates> coordinates = GridCoordinates::get(theGrid);
+
+    GridMask mask(theGrid);
+
+    for (long j = 0; j < field.ny; j++)
+      for (long i = 0; i < field.nx; i++)
+      {
+        const double d = field.distance(i, j);
+        const unsigned long idx = j * field.nx + i;
+
+        if (field.maxscale * (d + field.slack) <= theDistance)
+          mask.set(idx);
+        else if (field.minscale * (d - field.slack) > theDistance)
+          continue;
+        else if (NFmiSvgTools::GeoDistance(thePath, coordinates->latlon(idx)) <= theDistance)
+          mask.set(idx);
+      }
+
+    return mask;
+  }
+  catch (...)
+  {
+    throw Fmi::Exception::Trace(BCP, "Operation failed");
+  }
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief The grid points inside a path or within the given distance from it
+ *
+ * Equivalent to NFmiIndexMaskTools::MaskExpand. Negative distances
+ * (shrinking the area) are passed on to NFmiIndexMaskTools.
+ *
+ * \param theGrid The grid
+ * \param thePath The path in lat/lon coordinates
+ * \param theDistance The distance in kilometres
+ */
+// ----------------------------------------------------------------------
+
+GridMask MaskExpand(const NFmiGrid& theGrid, const NFmiSvgPath& thePath, double theDistance)
+{
+  try
+  {
+    DistanceField field;
+    if (theDistance < 0 || !distance_field(theGrid, thePath, theDistance, field))
+      return GridMask(NFmiIndexMaskTools::MaskExpand(theGrid, thePath, theDistance), theGrid);
+
+    const RowCrossings rows = CrossingsByRow(theGrid, thePath);
+
+    const std::shared_ptr<const GridCoordinates> coordinates = GridCoordinates::get(theGrid);
+
+    GridMask mask(theGrid);
+
+    for (long j = 0; j < field.ny; j++)
+      for (long i = 0; i < field.nx; i++)
+      {
+        const double d = field.distance(i, j);
+        const unsigned long idx = j * field.nx + i;
+
+        if (theDistance > 0 && field.maxscale * (d + field.slack) <= theDistance)
+          mask.set(idx);
+        else if (d <= field.slack ||
+                 (theDistance > 0 && field.minscale * (d - field.slack) <= theDistance))
+        {
+          const NFmiPoint p = coordinates->latlon(idx);
+          if (NFmiSvgTools::IsInside(thePath, p) ||
+              (theDistance > 0 && NFmiSvgTools::GeoDistance(thePath, p) <= theDistance))
+            mask.set(idx);
+        }
+        else if (inside(rows, i, j))
+          mask.set(idx);
+      }
+
+    return mask;
+  }
+  catch (...)
+  {
+    throw Fmi::Exception::Trace(BCP, "Operation failed");
+  }
+}
+
+}  // namespace RasterMaskTools
+}  // namespace TextGen
+
+// ======================================================================
@@ -0,0 +1,33 @@
+// ======================================================================
+/*!
+ * \file
+ * \brief Interface of namespace TextGen::RasterMaskTools
+ */
+// ======================================================================
+
+#pragma once
+
+#include "GridMask.h"
+
+#include <map>
+#include <vector>
+
+class NFmiGrid;
+class NFmiSvgPath;
+
+namespace TextGen
+{
+namespace RasterMaskTools
+{
+//! Edge crossing x-coordinates for each grid row crossed by a path
+using RowCrossings = std::map<long, std::vector<double> >;
+
+RowCrossings CrossingsByRow(const NFmiGrid& theGrid, const NFmiSvgPath& thePath);
+
+GridMask MaskDistance(const NFmiGrid& theGrid, const NFmiSvgPath& thePath, double theDistance);
+GridMask MaskExpand(const NFmiGrid& theGrid, const NFmiSvgPath& thePath, double theDistance);
+
+}  // namespace RasterMaskTools
+}  // namespace TextGen
+
+// ======================================================================
@@ -0,0 +1,597 @@
+// ======================================================================
+/*!
+ * \file
+ * \brief Implementation of namespace TextGen::ReductionTools
+ */
+// ======================================================================
+/*!
+ * \namespace TextGen::ReductionTools
+ *
+ * \brief Vectorized reductions of contiguous float arrays
+ *
+ * The functions here calculate the same results as the corresponding
+ * calculators with the default acceptor, that is, values equal to
+ * kFloatMissing are ignored and kFloatMissing is returned if there
+ * are no other values:
+ *
+ * <table>
+ * <tr><th>Function</th><th>Calculator</th></tr>
+ * <tr><td>sum</td><td>SumCalculator</td></tr>
+ * <tr><td>mean</td><td>MeanCalculator</td></tr>
+ * <tr><td>minimum</td><td>MinimumCalculator</td></tr>
+ * <tr><td>maximum</td><td>MaximumCalculator</td></tr>
+ * <tr><td>percentage</td><td>PercentageCalculator with a RangeAcceptor or a
+ *     ValueAcceptor as the condition</td></tr>
+ * </table>
+ *
+ * The minimum, maximum and percentages are exact. Sums are accumulated
+ * in double precision like the calculators do, but in a different
+ * order, hence the sum and the mean may differ in the last bits.
+ *
+ * The kernels are selected at runtime: AVX2 or SSE4.1 on x86 processors
+ * supporting them, plain C++ otherwise. The selection can be changed
+ * for testing and benchmarking with instructionSet().
+ *
+ * The arrays are typically rows of a MaskedCube.
+ */
+// ======================================================================
+
+#include "ReductionTools.h"
+#include <macgyver/Exception.h>
+
+#include <newbase/NFmiGlobals.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define TEXTGEN_X86_KERNELS
+#include <immintrin.h>
+#endif
+
+using namespace std;
+
+namespace TextGen
+{
+namespace ReductionTools
+{
+namespace
+{
+// ----------------------------------------------------------------------
+/*!
+ * \brief Partial results of a reduction
+ */
+// ----------------------------------------------------------------------
+
+struct Summary
+{
+  size_t count = 0;
+  double sum = 0;
+  float min = std::numeric_limits<float>::infinity();
+  float max = -std::numeric_limits<float>::infinity();
+};
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Scalar kernels, also used for the tails of the vector kernels
+ */
+// ----------------------------------------------------------------------
+
+void summarize_scalar(const float* theValues, size_t theSize, Summary& theSummary)
+{
+  for (size_t i = 0; i < theSize; i++)
+  {
+    const float value = theValues[i];
+    if (value == kFloatMissing)
+      continue;
+    ++theSummary.count;
+    theSummary.sum += value;
+    theSummary.min = std::min(theSummary.min, value);
+    theSummary.max = std::max(theSummary.max, value);
+  }
+}
+
+void count_scalar(const float* theValues,
+                  size_t theSize,
+                  float theLowerLimit,
+                  float theUpperLimit,
+                  size_t& theCount,
+                  size_t& theHits)
+{
+  for (size_t i = 0; i < theSize; i++)
+  {
+    const float value = theValues[i];
+    if (value == kFloatMissing)
+      continue;
+    ++theCount;
+    if (value >= theLowerLimit && value <= theUpperLimit)
+      ++theHits;
+  }
+}
+
+#ifdef TEXTGEN_X86_KERNELS
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief SSE4.1 kernels
+ */
+// ----------------------------------------------------------------------
+
+__attribute__((target("sse4.1"))) void summarize_sse4(const float* theValues,
+                                                      size_t theSize,
+                                                      Summary& theSummary)
+{
+  const __m128 missing = _mm_set1_ps(kFloatMissing);
+  const __m128 inf = _mm_set1_ps(std::numeric_limits<float>::infinity());
+  const __m128 neginf = _mm_set1_ps(-std::numeric_limits<float>::infinity());
+
+  __m128d sumlo = _mm_setzero_pd();
+  __m128d sumhi = _mm_setzero_pd();
+  __m128 vmin = inf;
+  __m128 vmax = neginf;
+  __m128i count = _mm_setzero_si128();
+
+  size_t i = 0;
+  for (; i + 4 <= theSize; i += 4)
+  {
+    const __m128 v = _mm_loadu_ps(theValues + i);
+    const __m128 valid = _mm_cmpneq_ps(v, missing);
+    const __m128 vz = _mm_and_ps(v, valid);
+    sumlo = _mm_add_pd(sumlo, _mm_cvtps_pd(vz));
+    sumhi = _mm_add_pd(sumhi, _mm_cvtps_pd(_mm_movehl_ps(vz, vz)));
+    vmin = _mm_min_ps(vmin, _mm_blendv_ps(inf, v, valid));
+    vmax = _mm_max_ps(vmax, _mm_blendv_ps(neginf, v, valid));
+    count = _mm_sub_epi32(count, _mm_castps_si128(valid));
+  }
+
+  alignas(16) double sums[4];
+  alignas(16) float mins[4];
+  alignas(16) float maxs[4];
+  alignas(16) int32_t counts[4];
+  _mm_store_pd(sums, sumlo);
+  _mm_store_pd(sums + 2, sumhi);
+  _mm_store_ps(mins, vmin);
+  _mm_store_ps(maxs, vmax);
+  _mm_store_si128(reinterpret_cast<__m128i*>(counts), count);
+
+  for (int j = 0; j < 4; j++)
+  {
+    theSummary.count += counts[j];
+    theSummary.sum += sums[j];
+    theSummary.min = std::min(theSummary.min, mins[j]);
+    theSummary.max = std::max(theSummary.max, maxs[j]);
+  }
+
+  summarize_scalar(theValues + i, theSize - i, theSummary);
+}
+
+__attribute__((target("sse4.1"))) void count_sse4(const float* theValues,
+                                                  size_t theSize,
+                                                  float theLowerLimit,
+                                                  float theUpperLimit,
+                                                  size_t& theCount,
+                                                  size_t& theHits)
+{
+  const __m128 missing = _mm_set1_ps(kFloatMissing);
+  const __m128 lo = _mm_set1_ps(theLowerLimit);
+  const __m128 hi = _mm_set1_ps(theUpperLimit);
+
+  __m128i count = _mm_setzero_si128();
+  __m128i hits = _mm_setzero_si128();
+
+  size_t i = 0;
+  for (; i + 4 <= theSize; i += 4)
+  {
+    const __m128 v = _mm_loadu_ps(theValues + i);
+    const __m128 valid = _mm_cmpneq_ps(v, missing);
+    const __m128 hit = _mm_and_ps(valid, _mm_and_ps(_mm_cmpge_ps(v, lo), _mm_cmple_ps(v, hi)));
+    count = _mm_sub_epi32(count, _mm_castps_si128(valid));
+    hits = _mm_sub_epi32(hits, _mm_castps_si128(hit));
+  }
+
+  alignas(16) int32_t counts[4];
+  alignas(16) int32_t hitcounts[4];
+  _mm_store_si128(reinterpret_cast<__m128i*>(counts), count);
+  _mm_store_si128(reinterpret_cast<__m128i*>(hitcounts), hits);
+  for (int j = 0; j < 4; j++)
+  {
+    theCount += counts[j];
+    theHits += hitcounts[j];
+  }
+
+  count_scalar(theValues + i, theSize - i, theLowerLimit, theUpperLimit, theCount, theHits);
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief AVX2 kernels
+ */
+// ----------------------------------------------------------------------
+
+__attribute__((target("avx2"))) void summarize_avx2(const float* theValues,
+                                                    size_t theSize,
+                                                    Summary& theSummary)
+{
+  const __m256 missing = _mm256_set1_ps(kFloatMissing);
+  const __m256 inf = _mm256_set1_ps(std::numeric_limits<float>::infinity());
+  const __m256 neginf = _mm256_set1_ps(-std::numeric_limits<float>::infinity());
+
+  __m256d sumlo = _mm256_setzero_pd();
+  __m256d sumhi = _mm256_setzero_pd();
+  __m256 vmin = inf;
+  __m256 vmax = neginf;
+  __m256i count = _mm256_setzero_si256();
+
+  size_t i = 0;
+  for (; i + 8 <= theSize; i += 8)
+  {
+    const __m256 v = _mm256_loadu_ps(theValues + i);
+    const __m256 valid = _mm256_cmp_ps(v, missing, _CMP_NEQ_UQ);
+    const __m256 vz = _mm256_and_ps(v, valid);
+    sumlo = _mm256_add_pd(sumlo, _mm256_cvtps_pd(_mm256_castps256_ps128(vz)));
+    sumhi = _mm256_add_pd(sumhi, _mm256_cvtps_pd(_mm256_extractf128_ps(vz, 1)));
+    vmin = _mm256_min_ps(vmin, _mm256_blendv_ps(inf, v, valid));
+    vmax = _mm256_max_ps(vmax, _mm256_blendv_ps(neginf, v, valid));
+    count = _mm256_sub_epi32(count, _mm256_castps_si256(valid));
+  }
+
+  alignas(32) double sums[8];
+  alignas(32) float mins[8];
+  alignas(32) float maxs[8];
+  alignas(32) int32_t counts[8];
+  _mm256_store_pd(sums, sumlo);
+  _mm256_store_pd(sums + 4, sumhi);
+  _mm256_store_ps(mins, vmin);
+  _mm256_store_ps(maxs, vmax);
+  _mm256_store_si256(reinterpret_cast<__m256i*>(counts), count);
+
+  for (int j = 0; j < 8; j++)
+  {
+    theSummary.count += counts[j];
+    theSummary.sum += sums[j];
+    theSummary.min = std::min(theSummary.min, mins[j]);
+    theSummary.max = std::max(theSummary.max, maxs[j]);
+  }
+
+  summarize_scalar(theValues + i, theSize - i, theSummary);
+}
+
+__attribute__((target("avx2"))) void count_avx2(const float* theValues,
+                                                size_t theSize,
+                                                float theLowerLimit,
+                                                float theUpperLimit,
+                                                size_t& theCount,
+                                                size_t& theHits)
+{
+  const __m256 missing = _mm256_set1_ps(kFloatMissing);
+  const __m256 lo = _mm256_set1_ps(theLowerLimit);
+  const __m256 hi = _mm256_set1_ps(theUpperLimit);
+
+  __m256i count = _mm256_setzero_si256();
+  __m256i hits = _mm256_setzero_si256();
+
+  size_t i = 0;
+  for (; i + 8 <= theSize; i += 8)
+  {
+    const __m256 v = _mm256_loadu_ps(theValues + i);
+    const __m256 valid = _mm256_cmp_ps(v, missing, _CMP_NEQ_UQ);
+    const __m256 inside =
+        _mm256_and_ps(_mm256_cmp_ps(v, lo, _CMP_GE_OQ), _mm256_cmp_ps(v, hi, _CMP_LE_OQ));
+    const __m256 hit = _mm256_and_ps(valid, inside);
+    count = _mm256_sub_epi32(count, _mm256_castps_si256(valid));
+    hits = _mm256_sub_epi32(hits, _mm256_castps_si256(hit));
+  }
+
+  alignas(32) int32_t counts[8];
+  alignas(32) int32_t hitcounts[8];
+  _mm256_store_si256(reinterpret_cast<__m256i*>(counts), count);
+  _mm256_store_si256(reinterpret_cast<__m256i*>(hitcounts), hits);
+  for (int j = 0; j < 8; j++)
+  {
+    theCount += counts[j];
+    theHits += hitcounts[j];
+  }
+
+  count_scalar(theValues + i, theSize - i, theLowerLimit, theUpperLimit, theCount, theHits);
+}
+
+#endif
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief The best instruction set supported by the processor
+ */
+// ----------------------------------------------------------------------
+
+InstructionSet best_instruction_set()
+{
+#ifdef TEXTGEN_X86_KERNELS
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2"))
+    return InstructionSet::AVX2;
+  if (__builtin_cpu_supports("sse4.1"))
+    return InstructionSet::SSE4;
+#endif
+  return InstructionSet::Scalar;
+}
+
+std::atomic<InstructionSet> active_set{best_instruction_set()};
+
+// The vector kernels use 32-bit lane counters
+const size_t max_block = 1UL << 30;
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Dispatch to the active kernels
+ */
+// ----------------------------------------------------------------------
+
+Summary summarize(const float* theValues, size_t theSize)
+{
+  Summary summary;
+  const InstructionSet set = active_set.load(std::memory_order_relaxed);
+
+  for (size_t pos = 0; pos < theSize; pos += max_block)
+  {
+    const size_t n = std::min(max_block, theSize - pos);
+    switch (set)
+    {
+#ifdef TEXTGEN_X86_KERNELS
+      case InstructionSet::AVX2:
+        summarize_avx2(theValues + pos, n, summary);
+        break;
+      case InstructionSet::SSE4:
+        summarize_sse4(theValues + pos, n, summary);
+        break;
+#endif
+      default:
+        summarize_scalar(theValues + pos, n, summary);
+        break;
+    }
+  }
+  return summary;
+}
+
+float count_percentage(const float* theValues,
+                       size_t theSize,
+                       float theLowerLimit,
+                       float theUpperLimit)
+{
+  size_t count = 0;
+  size_t hits = 0;
+  const InstructionSet set = active_set.load(std::memory_order_relaxed);
+
+  for (size_t pos = 0; pos < theSize; pos += max_block)
+  {
+    const size_t n = std::min(max_block, theSize - pos);
+    switch (set)
+    {
+#ifdef TEXTGEN_X86_KERNELS
+      case InstructionSet::AVX2:
+        count_avx2(theValues + pos, n, theLowerLimit, theUpperLimit, count, hits);
+        break;
+      case InstructionSet::SSE4:
+        count_sse4(theValues + pos, n, theLowerLimit, theUpperLimit, count, hits);
+        break;
+#endif
+      default:
+        count_scalar(theValues + pos, n, theLowerLimit, theUpperLimit, count, hits);
+        break;
+    }
+  }
+
+  if (count == 0)
+    return kFloatMissing;
+  return static_cast<float>(100.0 * hits / count);
+}
+
+}  // namespace
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Return the instruction set of the active kernels
+ */
+// ----------------------------------------------------------------------
+
+InstructionSet instructionSet()
+{
+  return active_set.load();
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Select the kernels to use
+ *
+ * This is intended for tests and benchmarks. By default the best
+ * kernels supported by the processor are used.
+ *
+ * \param theSet The instruction set
+ */
+// ----------------------------------------------------------------------
+
+void instructionSet(InstructionSet theSet)
+{
+  try
+  {
+    if (!supported(theSet))
+      throw Fmi::Exception(BCP, "The instruction set is not supported by the processor");
+    active_set.store(theSet);
+  }
+  catch (...)
+  {
+    throw Fmi::Exception::Trace(BCP, "Operation failed");
+  }
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Test whether the processor supports the given instruction set
+ */
+// ----------------------------------------------------------------------
+
+bool supported(InstructionSet theSet)
+{
+  return static_cast<int>(theSet) <= static_cast<int>(best_instruction_set());
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Sum of the values
+ *
+ * \param theValues The values
+ * \param theSize The number of values
+ * \return The sum, or kFloatMissing if all values are missing
+ */
+// ----------------------------------------------------------------------
+
+float sum(const float* theValues, std::size_t theSize)
+{
+  try
+  {
+    const Summary summary = summarize(theValues, theSize);
+    if (summary.count == 0)
+      return kFloatMissing;
+    return static_cast<float>(summary.sum);
+  }
+  catch (...)
+  {
+    throw Fmi::Exception::Trace(BCP, "Operation failed");
+  }
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Mean of the values
+ *
+ * \param theValues The values
+ * \param theSize The number of values
+ * \return The mean, or kFloatMissing if all values are missing
+ */
+// ----------------------------------------------------------------------
+
+float mean(const float* theValues, std::size_t theSize)
+{
+  try
+  {
+    const Summary summary = summarize(theValues, theSize);
+    if (summary.count == 0)
+      return kFloatMissing;
+    return static_cast<float>(summary.sum / summary.count);
+  }
+  catch (...)
+  {
+    throw Fmi::Exception::Trace(BCP, "Operation failed");
+  }
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Minimum of the values
+ *
+ * \param theValues The values
+ * \param theSize The number of values
+ * \return The minimum, or kFloatMissing if all values are missing
+ */
+// ----------------------------------------------------------------------
+
+float minimum(const float* theValues, std::size_t theSize)
+{
+  try
+  {
+    const Summary summary = summarize(theValues, theSize);
+    if (summary.count == 0)
+      return kFloatMissing;
+    return summary.min;
+  }
+  catch (...)
+  {
+    throw Fmi::Exception::Trace(BCP, "Operation failed");
+  }
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Maximum of the values
+ *
+ * \param theValues The values
+ * \param theSize The number of values
+ * \return The maximum, or kFloatMissing if all values are missing
+ */
+// ----------------------------------------------------------------------
+
+float maximum(const float* theValues, std::size_t theSize)
+{
+  try
+  {
+    const Summary summary = summarize(theValues, theSize);
+    if (summary.count == 0)
+      return kFloatMissing;
+    return summary.max;
+  }
+  catch (...)
+  {
+    throw Fmi::Exception::Trace(BCP, "Operation failed");
+  }
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Percentage of the values in the given range
+ *
+ * Equivalent to a RangeAcceptor with the given limits. Use the
+ * extreme float values for a range open at one end.
+ *
+ * \param theValues The values
+ * \param theSize The number of values
+ * \param theLowerLimit The smallest accepted value
+ * \param theUpperLimit The largest accepted value
+ * \return The percentage, or kFloatMissing if all values are missing
+ */
+// ----------------------------------------------------------------------
+
+float percentage(const float* theValues,
+                 std::size_t theSize,
+                 float theLowerLimit,
+                 float theUpperLimit)
+{
+  try
+  {
+    return count_percentage(theValues, theSize, theLowerLimit, theUpperLimit);
+  }
+  catch (...)
+  {
+    throw Fmi::Exception::Trace(BCP, "Operation failed");
+  }
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Percentage of the values equal to the given value
+ *
+ * Equivalent to a ValueAcceptor with the given value.
+ *
+ * \param theValues The values
+ * \param theSize The number of values
+ * \param theValue The accepted value
+ * \return The percentage, or kFloatMissing if all values are missing
+ */
+// ----------------------------------------------------------------------
+
+float percentage(const float* theValues, std::size_t theSize, float theValue)
+{
+  try
+  {
+    return count_percentage(theValues, theSize, theValue, theValue);
+  }
+  catch (...)
+  {
+    throw Fmi::Exception::Trace(BCP, "Operation failed");
+  }
+}
+
+}  // namespace ReductionTools
+}  // namespace TextGen
+
+// ======================================================================
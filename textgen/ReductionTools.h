@@ -0,0 +1,41 @@
+// ======================================================================
+/*!
+ * \file
+ * \brief Interface of namespace TextGen::ReductionTools
+ */
+// ======================================================================
+
+#pragma once
+
+#include <cstddef>
+
+namespace TextGen
+{
+namespace ReductionTools
+{
+enum class InstructionSet
+{
+  Scalar,
+  SSE4,
+  AVX2
+};
+
+InstructionSet instructionSet();
+void instructionSet(InstructionSet theSet);
+bool supported(InstructionSet theSet);
+
+float sum(const float* theValues, std::size_t theSize);
+float mean(const float* theValues, std::size_t theSize);
+float minimum(const float* theValues, std::size_t theSize);
+float maximum(const float* theValues, std::size_t theSize);
+
+float percentage(const float* theValues,
+                 std::size_t theSize,
+                 float theLowerLimit,
+                 float theUpperLimit);
+float percentage(const float* theValues, std::size_t theSize, float theValue);
+
+}  // namespace ReductionTools
+}  // namespace TextGen
+
+// ======================================================================
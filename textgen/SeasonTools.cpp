@@ -14,8 +14,8 @@
 // ======================================================================
 
 #include "SeasonTools.h"
+#include "CachedGridForecaster.h"
 #include "PositiveValueAcceptor.h"
-#include <calculator/GridForecaster.h>
 #include <calculator/RangeAcceptor.h>
 #include <calculator/Settings.h>
 #include <calculator/TextGenPosixTime.h>
@@ -109,7 +109,7 @@ float get_GrowthPeriodOnOff_percentage(const WeatherArea& theArea,
   {
     if (Settings::isset("textgen::effectivetemperaturesum_forecast"))
     {
-      GridForecaster forecaster;
+      CachedGridForecaster forecaster;
       PositiveValueAcceptor acceptor;
       WeatherResult growingSeasonPercentage = forecaster.analyze(theVariable,
                                                                  theSources,
@@ -148,7 +148,7 @@ float get_OverFiveDegrees_percentage(const WeatherArea& theArea,
     if (Settings::isset(fake_var))
       return Settings::optional_double(fake_var, 0.0);
 
-    GridForecaster forecaster;
+    CachedGridForecaster forecaster;
     // 5 days average temperature
     const TextGenPosixTime& startTime = thePeriod.localStartTime();
     TextGenPosixTime endTime = thePeriod.localStartTime();
@@ -0,0 +1,423 @@
+// ======================================================================
+/*!
+ * \file
+ * \brief Implementation of namespace TextGen::ShareTools
+ */
+// ======================================================================
+/*!
+ * \namespace TextGen::ShareTools
+ *
+ * \brief Single pass calculation of areal shares of value classes
+ *
+ * Calculating the distribution of a parameter over N value classes
+ * with GridForecaster requires N analyses, each of which scans the
+ * whole area mask and time period. The functions here scan the data
+ * once and accumulate all the classes simultaneously.
+ *
+ * The results are identical to those of the analysis
+ * Mean(area) of Percentage(time) with a RangeAcceptor tester
+ * for each class, or a ValueAcceptor tester for each category
+ * of a categorical parameter.
+ */
+// ======================================================================
+
+#include "ShareTools.h"
+#include "CachedGridForecaster.h"
+#include "SubMaskExtractor.h"
+#include "ValueAcceptor.h"
+#include <calculator/DefaultAcceptor.h>
+#include <calculator/ParameterAnalyzer.h>
+#include <calculator/QueryDataTools.h>
+#include <calculator/RangeAcceptor.h>
+#include <calculator/Settings.h>
+#include <calculator/WeatherSource.h>
+#include <macgyver/Exception.h>
+
+#include <newbase/NFmiEnumConverter.h>
+#include <newbase/NFmiFastQueryInfo.h>
+#include <newbase/NFmiGlobals.h>
+#include <newbase/NFmiQueryData.h>
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <numeric>
+
+using namespace std;
+
+namespace TextGen
+{
+namespace ShareTools
+{
+namespace
+{
+NFmiEnumConverter converter;
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Calculate the distributions with one analysis per class
+ *
+ * This is used for point areas and when the result has been faked.
+ */
+// ----------------------------------------------------------------------
+
+void analyze_separately(const string& theFakeVar,
+                        const AnalysisSources& theSources,
+                        const vector<WeatherParameter>& theParameters,
+                        const WeatherArea& theArea,
+                        const WeatherPeriod& thePeriod,
+                        const value_class_vector& theClasses,
+                        vector<share_distribution>& theDistributions)
+{
+  CachedGridForecaster forecaster;
+
+  for (unsigned int i = 0; i < theParameters.size(); i++)
+  {
+    for (const auto& valueClass : theClasses)
+    {
+      RangeAcceptor acceptor;
+      acceptor.lowerLimit(valueClass.first);
+      acceptor.upperLimit(valueClass.second);
+
+      WeatherResult share = forecaster.analyze(theFakeVar,
+                                               theSources,
+                                               theParameters[i],
+                                               Mean,
+                                               Percentage,
+                                               theArea,
+                                               thePeriod,
+                                               DefaultAcceptor(),
+                                               DefaultAcceptor(),
+                                               acceptor);
+
+      theDistributions[i].push_back(make_pair(valueClass.first, share));
+    }
+  }
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Calculate the category shares with one analysis per category
+ *
+ * This is used for point areas and when any result has been faked.
+ */
+// ----------------------------------------------------------------------
+
+void analyze_categories_separately(const vector<string>& theFakeVars,
+                                   const AnalysisSources& theSources,
+                                   const WeatherParameter& theParameter,
+                                   const WeatherArea& theArea,
+                                   const WeatherPeriod& thePeriod,
+                                   const vector<float>& theCategories,
+                                   vector<WeatherResult>& theShares)
+{
+  CachedGridForecaster forecaster;
+
+  for (unsigned int i = 0; i < theCategories.size(); i++)
+  {
+    ValueAcceptor acceptor;
+    acceptor.value(theCategories[i]);
+
+    theShares.push_back(forecaster.analyze(theFakeVars[i],
+                                           theSources,
+                                           theParameter,
+                                           Mean,
+                                           Percentage,
+                                           theArea,
+                                           thePeriod,
+                                           DefaultAcceptor(),
+                                           DefaultAcceptor(),
+                                           acceptor));
+  }
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Calculate the distributions of parameters stored in the same data
+ *
+ * Parameters missing from the data get missing shares.
+ */
+// ----------------------------------------------------------------------
+
+void analyze_data(const AnalysisSources& theSources,
+                  const string& theData,
+                  const vector<unsigned int>& theIndexes,
+                  const vector<WeatherParameter>& theParameters,
+                  const WeatherArea& theArea,
+                  const WeatherPeriod& thePeriod,
+                  const value_class_vector& theClasses,
+                  vector<share_distribution>& theDistributions)
+{
+  std::shared_ptr<WeatherSource> wsource = theSources.getWeatherSource();
+  std::shared_ptr<NFmiQueryData> qd = wsource->data(theData);
+  NFmiFastQueryInfo qi = NFmiFastQueryInfo(qd.get());
+
+  // Establish which of the parameters are available
+
+  vector<unsigned int> available;
+  vector<unsigned long> paramindexes;
+
+  for (unsigned int i : theIndexes)
+  {
+    std::string parameterName;
+    std::string dataName;
+    ParameterAnalyzer::getParameterStrings(theParameters[i], parameterName, dataName);
+
+    auto param = FmiParameterName(converter.ToEnum(parameterName));
+    if (param == kFmiBadParameter)
+      throw Fmi::Exception(BCP, "Parameter " + parameterName + " is not defined in newbase");
+
+    if (qi.Param(param))
+    {
+      available.push_back(i);
+      paramindexes.push_back(qi.ParamIndex());
+    }
+  }
+
+  // Sums of the time percentages and the number of points with valid data
+
+  const unsigned int nclasses = theClasses.size();
+  vector<vector<double> > sums(available.size(), vector<double>(nclasses, 0));
+  vector<unsigned long> npoints(available.size(), 0);
+
+  unsigned long startindex;
+  unsigned long endindex;
+
+  if (!available.empty() &&
+      QueryDataTools::findIndices(
+          qi, thePeriod.utcStartTime(), thePeriod.utcEndTime(), startindex, endindex))
+  {
+    MaskSource::mask_type mask = GetIndexMask(theSources, theArea, theData);
+
+    // The first time step is always included, as in the normal time integration
+    endindex = std::max(endindex, startindex + 1);
+
+    vector<unsigned long> counts(nclasses);
+
+    for (unsigned long it : *mask)
+    {
+      for (unsigned int p = 0; p < available.size(); p++)
+      {
+        std::fill(counts.begin(), counts.end(), 0);
+        unsigned long valid = 0;
+
+        for (unsigned long t = startindex; t < endindex; t++)
+        {
+          const float value =
+              qi.GetFloatValue(qi.Index(paramindexes[p], it, qi.LevelIndex(), t));
+          if (value == kFloatMissing)
+            continue;
+          ++valid;
+          const int c = classIndex(theClasses, value);
+          if (c >= 0)
+            ++counts[c];
+        }
+
+        if (valid > 0)
+        {
+          ++npoints[p];
+          for (unsigned int c = 0; c < nclasses; c++)
+            sums[p][c] += 100.0 * counts[c] / valid;
+        }
+      }
+    }
+  }
+
+  // Store the areal means
+
+  for (unsigned int i : theIndexes)
+  {
+    auto pos = std::find(available.begin(), available.end(), i);
+    const unsigned int p = pos - available.begin();
+
+    for (unsigned int c = 0; c < nclasses; c++)
+    {
+      float share = kFloatMissing;
+      if (pos != available.end() && npoints[p] > 0)
+        share = sums[p][c] / npoints[p];
+      theDistributions[i].push_back(make_pair(theClasses[c].first, WeatherResult(share, 0)));
+    }
+  }
+}
+
+}  // namespace
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Calculate areal shares of value classes for several parameters
+ *
+ * For each parameter the result contains one element per value class,
+ * the share being the areal mean of the time percentages of the class.
+ * Parameters stored in the same data are analyzed in a single pass over
+ * the area mask and the period. Missing parameters give missing shares.
+ *
+ * \param theFakeVar The fake variable used for every class
+ * \param theSources The analysis sources
+ * \param theParameters The parameters to analyze
+ * \param theArea The area
+ * \param thePeriod The period
+ * \param theClasses The value classes
+ * \param theDistributions The distributions in the order of the parameters
+ */
+// ----------------------------------------------------------------------
+
+void distributions(const string& theFakeVar,
+                   const AnalysisSources& theSources,
+                   const vector<WeatherParameter>& theParameters,
+                   const WeatherArea& theArea,
+                   const WeatherPeriod& thePeriod,
+                   const value_class_vector& theClasses,
+                   vector<share_distribution>& theDistributions)
+{
+  try
+  {
+    theDistributions.clear();
+    theDistributions.resize(theParameters.size());
+
+    if (theArea.isPoint() || Settings::isset(theFakeVar))
+    {
+      analyze_separately(theFakeVar,
+                         theSources,
+                         theParameters,
+                         theArea,
+                         thePeriod,
+                         theClasses,
+                         theDistributions);
+      return;
+    }
+
+    map<string, vector<unsigned int> > groups;
+    for (unsigned int i = 0; i < theParameters.size(); i++)
+      groups[GetDataName(theParameters[i])].push_back(i);
+
+    for (const auto& group : groups)
+      analyze_data(theSources,
+                   group.first,
+                   group.second,
+                   theParameters,
+                   theArea,
+                   thePeriod,
+                   theClasses,
+                   theDistributions);
+  }
+  catch (...)
+  {
+    throw Fmi::Exception::Trace(BCP, "Operation failed").addParameter("theFakeVar", theFakeVar);
+  }
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Calculate areal shares of the categories of a categorical parameter
+ *
+ * The share of each category is the areal mean of the time percentages
+ * of the category, calculated for all categories in a single pass.
+ *
+ * \param theFakeVars The fake variables of the categories
+ * \param theSources The analysis sources
+ * \param theParameter The categorical parameter
+ * \param theArea The area
+ * \param thePeriod The period
+ * \param theCategories The distinct category values
+ * \param theShares The shares in the order of the categories
+ */
+// ----------------------------------------------------------------------
+
+void categories(const vector<string>& theFakeVars,
+                const AnalysisSources& theSources,
+                const WeatherParameter& theParameter,
+                const WeatherArea& theArea,
+                const WeatherPeriod& thePeriod,
+                const vector<float>& theCategories,
+                vector<WeatherResult>& theShares)
+{
+  try
+  {
+    if (theFakeVars.size() != theCategories.size())
+      throw Fmi::Exception(BCP, "Each category must have a fake variable");
+
+    theShares.clear();
+
+    bool faked = false;
+    for (const auto& fakevar : theFakeVars)
+      faked |= Settings::isset(fakevar);
+
+    if (theArea.isPoint() || faked)
+    {
+      analyze_categories_separately(theFakeVars,
+                                    theSources,
+                                    theParameter,
+                                    theArea,
+                                    thePeriod,
+                                    theCategories,
+                                    theShares);
+      return;
+    }
+
+    // Categories are single value classes in increasing order
+
+    vector<unsigned int> order(theCategories.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(),
+              order.end(),
+              [&theCategories](unsigned int i, unsigned int j)
+              { return theCategories[i] < theCategories[j]; });
+
+    value_class_vector classes;
+    for (unsigned int i : order)
+      classes.push_back(make_pair(theCategories[i], theCategories[i]));
+
+    vector<WeatherParameter> parameters{theParameter};
+    vector<share_distribution> distributions(1);
+
+    analyze_data(theSources,
+                 GetDataName(theParameter),
+                 vector<unsigned int>{0},
+                 parameters,
+                 theArea,
+                 thePeriod,
+                 classes,
+                 distributions);
+
+    theShares.resize(theCategories.size(), WeatherResult(kFloatMissing, 0));
+    for (unsigned int k = 0; k < order.size(); k++)
+      theShares[order[k]] = distributions[0][k].second;
+  }
+  catch (...)
+  {
+    throw Fmi::Exception::Trace(BCP, "Operation failed");
+  }
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Return the index of the value class containing the value
+ *
+ * \param theClasses The value classes
+ * \param theValue The value
+ * \return The index of the class, or -1 if no class contains the value
+ */
+// ----------------------------------------------------------------------
+
+int classIndex(const value_class_vector& theClasses, float theValue)
+{
+  auto it = std::upper_bound(theClasses.begin(),
+                             theClasses.end(),
+                             theValue,
+                             [](float value, const pair<float, float>& valueClass)
+                             { return value < valueClass.first; });
+
+  if (it == theClasses.begin())
+    return -1;
+
+  --it;
+  if (theValue > it->second)
+    return -1;
+
+  return it - theClasses.begin();
+}
+
+}  // namespace ShareTools
+}  // namespace TextGen
+
+// ======================================================================
@@ -0,0 +1,51 @@
+// ======================================================================
+/*!
+ * \file
+ * \brief Interface of namespace TextGen::ShareTools
+ */
+// ======================================================================
+
+#pragma once
+
+#include <calculator/AnalysisSources.h>
+#include <calculator/WeatherArea.h>
+#include <calculator/WeatherParameter.h>
+#include <calculator/WeatherPeriod.h>
+#include <calculator/WeatherResult.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace TextGen
+{
+namespace ShareTools
+{
+// Closed value classes [lower,upper] in increasing non-overlapping order
+using value_class_vector = std::vector<std::pair<float, float> >;
+
+// Shares of the value classes keyed by the lower limit of the class
+using share_distribution = std::vector<std::pair<float, WeatherResult> >;
+
+void distributions(const std::string& theFakeVar,
+                   const AnalysisSources& theSources,
+                   const std::vector<WeatherParameter>& theParameters,
+                   const WeatherArea& theArea,
+                   const WeatherPeriod& thePeriod,
+                   const value_class_vector& theClasses,
+                   std::vector<share_distribution>& theDistributions);
+
+void categories(const std::vector<std::string>& theFakeVars,
+                const AnalysisSources& theSources,
+                const WeatherParameter& theParameter,
+                const WeatherArea& theArea,
+                const WeatherPeriod& thePeriod,
+                const std::vector<float>& theCategories,
+                std::vector<WeatherResult>& theShares);
+
+int classIndex(const value_class_vector& theClasses, float theValue);
+
+}  // namespace ShareTools
+}  // namespace TextGen
+
+// ======================================================================
@@ -7,287 +7,27 @@
 /*!
  * \class TextGen::SouthernMaskSource
  *
- * \brief Provides mask services to clients (masked to inlandal areas)
+ * \brief Provides mask services to clients (masked to southern areas)
  *
- * The InlandMaskSource class provides access to masks calculated from
- * named SVG paths which represent geographic areas. This class is
- * differentiated from RegularMaskSource by the fact that any mask
- * is restricted to the southern part of the area.
+ * The SouthernMaskSource class is a DirectionalMaskSource which
+ * restricts any mask to the southern part of the area.
  *
  */
 // ======================================================================
 
 #include "SouthernMaskSource.h"
 
-#include "SubMaskExtractor.h"
-#include <calculator/WeatherArea.h>
-#include <calculator/WeatherSource.h>
-#include <macgyver/Exception.h>
-
-#include <newbase/NFmiFastQueryInfo.h>
-#include <newbase/NFmiGrid.h>
-#include <newbase/NFmiIndexMask.h>
-#include <newbase/NFmiIndexMaskSource.h>
-#include <newbase/NFmiIndexMaskTools.h>
-#include <newbase/NFmiQueryData.h>
-
-#include <map>
-
-using namespace std;
-
-using namespace NFmiIndexMaskTools;
-
 namespace TextGen
 {
-// ----------------------------------------------------------------------
-/*!
- * \brief Utility structure to each cache management
- */
-// ----------------------------------------------------------------------
-
-struct WeatherAreaAndID
-{
-  WeatherId itsID;
-  WeatherArea itsArea;
-
-  WeatherAreaAndID(const WeatherId& theID, const WeatherArea& theArea)
-      : itsID(theID), itsArea(theArea)
-  {
-  }
-
-  bool operator==(const WeatherAreaAndID& theOther) const
-  {
-    return (itsID == theOther.itsID && itsArea == theOther.itsArea);
-  }
-
-  bool operator<(const WeatherAreaAndID& theOther) const
-  {
-    return (itsID != theOther.itsID ? itsID < theOther.itsID : itsArea < theOther.itsArea);
-  }
-};
-
-// ----------------------------------------------------------------------
-/*!
- * \brief Implementation hiding detail for TextGen::SouthernMaskSource
- */
-// ----------------------------------------------------------------------
-
-class SouthernMaskSource::Pimple
-{
- public:
-  Pimple(const WeatherArea& theArea);
-
-  const WeatherArea itsArea;
-
-  using mask_storage = map<WeatherAreaAndID, mask_type>;
-  using masks_storage = map<WeatherAreaAndID, masks_type>;
-
-  mutable mask_storage itsMaskStorage;
-  mutable masks_storage itsMasksStorage;
-
-  mask_type find(const WeatherId& theID, const WeatherArea& theArea) const;
-
-  void insert(const WeatherId& theID, const WeatherArea& theArea, const mask_type& theMask) const;
-
-  static mask_type create_mask(const WeatherArea& theArea,
-                               const std::string& theData,
-                               const WeatherSource& theWeatherSource);
-
-};  // class SouthernMaskSource::Pimple
-
-// ----------------------------------------------------------------------
-/*!
- * \brief Pimple constructor
- */
-// ----------------------------------------------------------------------
-
-SouthernMaskSource::Pimple::Pimple(const WeatherArea& theArea) : itsArea(theArea) {}
-
-// ----------------------------------------------------------------------
-/*!
- * \brief Find mask from cache
- *
- * Returns a 0-shared pointer if mask is not found
- *
- * \param theID The weather ID
- * \param theArea The weather area
- * \return shared_ptr to mask or 0
- */
-// ----------------------------------------------------------------------
-
-SouthernMaskSource::mask_type SouthernMaskSource::Pimple::find(const WeatherId& theID,
-                                                               const WeatherArea& theArea) const
-{
-  try
-  {
-    static std::shared_ptr<NFmiIndexMask> dummy;
-
-    mask_storage::const_iterator it;
-
-    for (it = itsMaskStorage.begin(); it != itsMaskStorage.end(); ++it)
-    {
-      // identicalArea-function compares more than operator ==
-      if (it->first.itsArea.identicalArea(theArea))
-        return it->second;
-    }
-
-    mask_storage::iterator iter;
-
-    WeatherAreaAndID key(theID, theArea);
-    iter = itsMaskStorage.find(key);
-    if (iter != itsMaskStorage.end())
-      itsMaskStorage.erase(iter);
-
-    return dummy;
-  }
-  catch (...)
-  {
-    throw Fmi::Exception::Trace(BCP, "Operation failed");
-  }
-}
-
-// ----------------------------------------------------------------------
-/*!
- * \brief Insert a new mask into the cache
- *
- * \param theID The data ID
- * \param theArea The weather area
- * \param theMask The mask itself
- */
-// ----------------------------------------------------------------------
-
-void SouthernMaskSource::Pimple::insert(const WeatherId& theID,
-                                        const WeatherArea& theArea,
-                                        const mask_type& theMask) const
-{
-  try
-  {
-    using value_type = mask_storage::value_type;
-
-    WeatherAreaAndID key(theID, theArea);
-
-    itsMaskStorage.insert(value_type(key, theMask));
-
-    if (itsMaskStorage.insert(value_type(key, theMask)).second)
-      throw Fmi::Exception(BCP, "Could not cache mask for " + theArea.name());
-  }
-  catch (...)
-  {
-    throw Fmi::Exception::Trace(BCP, "Operation failed");
-  }
-}
-
-// ----------------------------------------------------------------------
-/*!
- * \brief Create a new weather area
- *
- * \param theArea The area
- * \param theData The data name
- * \param theWeatherSource The weather source
- * \return The mask
- */
-// ----------------------------------------------------------------------
-
-SouthernMaskSource::mask_type SouthernMaskSource::Pimple::create_mask(
-    const WeatherArea& theArea, const std::string& theData, const WeatherSource& theWeatherSource)
-{
-  try
-  {
-    // Establish the grid which to mask
-
-    std::shared_ptr<NFmiQueryData> qdata = theWeatherSource.data(theData);
-    NFmiFastQueryInfo qi = NFmiFastQueryInfo(qdata.get());
-    if (!qi.IsGrid())
-      throw Fmi::Exception(
-          BCP, "The data in " + theData + " is not gridded - cannot generate mask for it");
-
-    // First build the area mask
-
-    mask_type return_mask(
-        new NFmiIndexMask(MaskDirection(*(qi.Grid()), theArea, AreaTools::SOUTH)));
-    return return_mask;
-  }
-  catch (...)
-  {
-    throw Fmi::Exception::Trace(BCP, "Operation failed").addParameter("theData", theData);
-  }
-}
-
 // ----------------------------------------------------------------------
 /*!
  * \brief Constructor
  */
 // ----------------------------------------------------------------------
 
-SouthernMaskSource::SouthernMaskSource(const WeatherArea& theArea) : itsPimple(new Pimple(theArea))
-{
-}
-
-// ----------------------------------------------------------------------
-/*!
- * \brief Return the mask for the given area
- *
- * \param theArea The weather area
- * \param theData The data name
- * \param theWeatherSource The source for weather data
- */
-// ----------------------------------------------------------------------
-
-SouthernMaskSource::mask_type SouthernMaskSource::mask(const WeatherArea& theArea,
-                                                       const std::string& theData,
-                                                       const WeatherSource& theWeatherSource) const
-{
-  try
-  {
-    if (theArea.isPoint())
-      throw Fmi::Exception(BCP, "Trying to generate mask for point");
-
-    // Establish the ID for the data
-
-    WeatherId id = theWeatherSource.id(theData);
-
-    // Try to find cached mask first
-
-    mask_type areamask = itsPimple->find(id, theArea);
-
-    if (areamask.get() != nullptr)
-      return areamask;
-
-    // Calculate new mask and cache it
-    areamask = Pimple::create_mask(theArea, theData, theWeatherSource);
-    itsPimple->insert(id, theArea, areamask);
-
-    return areamask;
-  }
-  catch (...)
-  {
-    throw Fmi::Exception::Trace(BCP, "Operation failed").addParameter("theData", theData);
-  }
-}
-
-// ----------------------------------------------------------------------
-/*!
- * \brief Return the mask source for the given area
- *
- * \param theArea The weather area
- * \param theData The data name
- * \param theWeatherSource The source for weather data
- */
-// ----------------------------------------------------------------------
-
-SouthernMaskSource::masks_type SouthernMaskSource::masks(
-    const WeatherArea& /*theArea*/,
-    const std::string& /*theData*/,
-    const WeatherSource& /*theWeatherSource*/) const
+SouthernMaskSource::SouthernMaskSource(const WeatherArea& theArea)
+    : DirectionalMaskSource(theArea, AreaTools::SOUTH, "southern")
 {
-  try
-  {
-    throw Fmi::Exception(BCP, "SouthernMaskSource::masks not implemented");
-  }
-  catch (...)
-  {
-    throw Fmi::Exception::Trace(BCP, "Operation failed");
-  }
 }
 
 }  // namespace TextGen
@@ -7,31 +7,16 @@
 
 #pragma once
 
-#include <calculator/MaskSource.h>
+#include "DirectionalMaskSource.h"
 
 namespace TextGen
 {
-class SouthernMaskSource : public MaskSource
+class SouthernMaskSource : public DirectionalMaskSource
 {
  public:
-  using mask_type = MaskSource::mask_type;
-  using masks_type = MaskSource::masks_type;
-
   SouthernMaskSource() = delete;
   SouthernMaskSource(const WeatherArea& theArea);
 
-  mask_type mask(const WeatherArea& theArea,
-                 const std::string& theData,
-                 const WeatherSource& theWeatherSource) const override;
-
-  masks_type masks(const WeatherArea& theArea,
-                   const std::string& theData,
-                   const WeatherSource& theWeatherSource) const override;
-
- private:
-  class Pimple;
-  std::shared_ptr<Pimple> itsPimple;
-
 };  // class SouthernMaskSource
 
 }  // namespace TextGen
@@ -195,7 +195,7 @@ string SpeechTextFormatter::visit(const Sentence& theSentence) const
   {
     const string sep = TextFormatterTools::wordSeparator(itsDictionary.get());
     string ret = TextFormatterTools::realize(theSentence.begin(), theSentence.end(), *this, sep, "");
-    ret = TextFormatterTools::capitalize(ret);
+    ret = TextFormatterTools::capitalize(ret, itsDictionary.get());
     if (!ret.empty())
       ret += TextFormatterTools::sentenceEnd(itsDictionary.get());
 
@@ -242,7 +242,7 @@ string SpeechTextFormatter::visit(const Header& theHeader) const
 
     const string sep = TextFormatterTools::wordSeparator(itsDictionary.get());
     string ret = TextFormatterTools::realize(theHeader.begin(), theHeader.end(), *this, sep, "");
-    ret = TextFormatterTools::capitalize(ret);
+    ret = TextFormatterTools::capitalize(ret, itsDictionary.get());
     if (!ret.empty())
     {
       if (colon)
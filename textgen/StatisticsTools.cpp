@@ -0,0 +1,496 @@
+// ======================================================================
+/*!
+ * \file
+ * \brief Implementation of namespace TextGen::StatisticsTools
+ */
+// ======================================================================
+/*!
+ * \namespace TextGen::StatisticsTools
+ *
+ * \brief Single pass calculation of several area functions
+ *
+ * Stories often need the minimum, maximum, mean and median of the same
+ * parameter over the same area and period. With GridForecaster each
+ * of them requires a separate analysis scanning the whole area mask
+ * and period. The function here integrates the data over time once
+ * for each grid point and feeds the time integrals to all the area
+ * functions simultaneously.
+ *
+ * The same applies to series of periods, for which the data and the
+ * area mask are resolved only once, and to several types of the same
+ * area, for which each grid point of the union of the masks is
+ * integrated over time only once, see LabelMask.
+ *
+ * The calculators are created by CalculatorFactory exactly as in
+ * the normal analysis, so the results are identical to those of
+ * separate GridForecaster analyses of the area functions with the
+ * same time function.
+ *
+ * The minimum, maximum and value percentage of a single area type
+ * with the default area acceptor are calculated from the row of time
+ * integrals with ReductionTools, which gives the same results. Sums
+ * and means are left to the calculators, since ReductionTools adds
+ * the values up in a different order.
+ */
+// ======================================================================
+
+#include "StatisticsTools.h"
+#include "CachedGridForecaster.h"
+#include "LabelMask.h"
+#include "MaskedCube.h"
+#include "ReductionTools.h"
+#include "SubMaskExtractor.h"
+#include "ValueAcceptor.h"
+#include <calculator/Calculator.h>
+#include <calculator/CalculatorFactory.h>
+#include <calculator/DefaultAcceptor.h>
+#include <calculator/ParameterAnalyzer.h>
+#include <calculator/QueryDataTools.h>
+#include <calculator/Settings.h>
+#include <calculator/WeatherSource.h>
+#include <macgyver/Exception.h>
+
+#include <newbase/NFmiEnumConverter.h>
+#include <newbase/NFmiFastQueryInfo.h>
+#include <newbase/NFmiGlobals.h>
+#include <newbase/NFmiQueryData.h>
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <typeinfo>
+
+using namespace std;
+
+namespace TextGen
+{
+namespace StatisticsTools
+{
+namespace
+{
+NFmiEnumConverter converter;
+
+using reduction_type = std::function<float(const float*, std::size_t)>;
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Return the exact ReductionTools equivalent of an area function
+ *
+ * \return The reduction, or an empty function if there is none
+ */
+// ----------------------------------------------------------------------
+
+reduction_type reduction(const WeatherFunction& theFunction,
+                         const Acceptor& theAreaAcceptor,
+                         const Acceptor& theTester)
+{
+  if (typeid(theAreaAcceptor) != typeid(DefaultAcceptor))
+    return {};
+
+  switch (theFunction)
+  {
+    case Minimum:
+      return ReductionTools::minimum;
+    case Maximum:
+      return ReductionTools::maximum;
+    case Percentage:
+      if (typeid(theTester) == typeid(ValueAcceptor))
+      {
+        const float value = static_cast<const ValueAcceptor&>(theTester).value();
+        return [value](const float* theValues, std::size_t theSize)
+        { return ReductionTools::percentage(theValues, theSize, value); };
+      }
+      return {};
+    default:
+      return {};
+  }
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Calculate the results of one period with one analysis per area function
+ *
+ * This is used whenever the single pass calculation does not apply.
+ */
+// ----------------------------------------------------------------------
+
+void analyze_separately(const vector<string>& theFakeVars,
+                        const AnalysisSources& theSources,
+                        const WeatherParameter& theParameter,
+                        const vector<WeatherFunction>& theAreaFunctions,
+                        const WeatherFunction& theTimeFunction,
+                        const WeatherArea& theArea,
+                        const WeatherPeriod& thePeriod,
+                        vector<vector<WeatherResult> >& theResults,
+                        const Acceptor& theAreaAcceptor,
+                        const Acceptor& theTimeAcceptor,
+                        const Acceptor& theTester)
+{
+  CachedGridForecaster forecaster;
+
+  for (unsigned int i = 0; i < theAreaFunctions.size(); i++)
+    theResults[i].push_back(forecaster.analyze(theFakeVars[i],
+                                               theSources,
+                                               theParameter,
+                                               theAreaFunctions[i],
+                                               theTimeFunction,
+                                               theArea,
+                                               thePeriod,
+                                               theAreaAcceptor,
+                                               theTimeAcceptor,
+                                               theTester));
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Calculate all the area functions of all area types in a single pass per period
+ *
+ * The data and the masks are resolved only once for all the periods,
+ * and each grid point is integrated over time only once even if it
+ * belongs to several of the area types. Periods not covered by the
+ * data are analyzed separately.
+ *
+ * \return False if the parameter is not available in the data,
+ *         in which case nothing is calculated
+ */
+// ----------------------------------------------------------------------
+
+bool analyze_data(const vector<string>& theFakeVars,
+                  const AnalysisSources& theSources,
+                  const WeatherParameter& theParameter,
+                  const vector<WeatherFunction>& theAreaFunctions,
+                  const WeatherFunction& theTimeFunction,
+                  const WeatherArea& theArea,
+                  const vector<WeatherArea::Type>& theTypes,
+                  const vector<WeatherPeriod>& thePeriods,
+                  vector<vector<vector<WeatherResult> > >& theResults,
+                  const Acceptor& theAreaAcceptor,
+                  const Acceptor& theTimeAcceptor,
+                  const Acceptor& theTester)
+{
+  std::string parameterName;
+  std::string dataName;
+  ParameterAnalyzer::getParameterStrings(theParameter, parameterName, dataName);
+
+  const string dataname = GetDataName(theParameter);
+
+  std::shared_ptr<WeatherSource> wsource = theSources.getWeatherSource();
+  std::shared_ptr<NFmiQueryData> qd = wsource->data(dataname);
+  NFmiFastQueryInfo qi = NFmiFastQueryInfo(qd.get());
+
+  auto param = FmiParameterName(converter.ToEnum(parameterName));
+  if (param == kFmiBadParameter || !qi.Param(param))
+    return false;
+
+  std::shared_ptr<Calculator> timemod(CalculatorFactory::create(theTimeFunction, theTester));
+  timemod->acceptor(theTimeAcceptor);
+
+  // spacemods[label][function]
+
+  vector<vector<std::shared_ptr<Calculator> > > spacemods(theTypes.size());
+  for (auto& labelmods : spacemods)
+  {
+    for (const auto& function : theAreaFunctions)
+    {
+      std::shared_ptr<Calculator> spacemod(CalculatorFactory::create(function, theTester));
+      spacemod->acceptor(theAreaAcceptor);
+      labelmods.push_back(spacemod);
+    }
+  }
+
+  // Reductions apply only when all the points belong to the one area type
+
+  vector<reduction_type> reductions(theAreaFunctions.size());
+  if (theTypes.size() == 1)
+    for (unsigned int f = 0; f < theAreaFunctions.size(); f++)
+      reductions[f] = reduction(theAreaFunctions[f], theAreaAcceptor, theTester);
+
+  const LabelMask mask(theSources, theArea, theTypes, dataname);
+  vector<float> values;
+  for (const auto& period : thePeriods)
+  {
+    unsigned long startindex;
+    unsigned long endindex;
+    if (!QueryDataTools::findIndices(
+            qi, period.utcStartTime(), period.utcEndTime(), startindex, endindex))
+    {
+      for (unsigned int label = 0; label < theTypes.size(); label++)
+      {
+        WeatherArea area(theArea);
+        area.type(theTypes[label]);
+        analyze_separately(theFakeVars,
+                           theSources,
+                           theParameter,
+                           theAreaFunctions,
+                           theTimeFunction,
+                           area,
+                           period,
+                           theResults[label],
+                           theAreaAcceptor,
+                           theTimeAcceptor,
+                           theTester);
+      }
+      continue;
+    }
+
+    // The first time step is always included, as in the normal time integration
+    endindex = std::max(endindex, startindex + 1);
+
+    for (auto& labelmods : spacemods)
+      for (auto& spacemod : labelmods)
+        spacemod->reset();
+
+    const MaskedCube cube(qi, mask.indexes(), startindex, endindex);
+    const auto& memberships = mask.memberships();
+
+    values.resize(cube.points());
+    for (std::size_t i = 0; i < cube.points(); i++)
+    {
+      timemod->reset();
+      for (std::size_t t = 0; t < cube.times(); t++)
+        (*timemod)(cube.value(t, i));
+
+      const float value = (*timemod)();
+      values[i] = value;
+      for (unsigned int label = 0; label < spacemods.size(); label++)
+        if (memberships[i].test(label))
+          for (unsigned int f = 0; f < spacemods[label].size(); f++)
+            if (!reductions[f])
+              (*spacemods[label][f])(value);
+    }
+
+    for (unsigned int label = 0; label < spacemods.size(); label++)
+      for (unsigned int f = 0; f < theAreaFunctions.size(); f++)
+      {
+        const float result = (reductions[f] ? reductions[f](values.data(), values.size())
+                                            : (*spacemods[label][f])());
+        theResults[label][f].emplace_back(result, 0);
+      }
+  }
+
+  return true;
+}
+
+}  // namespace
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Analyze several area functions of the same parameter at once
+ *
+ * The result of each area function equals that of the analysis
+ *
+ * \code
+ * GridForecaster().analyze(theFakeVars[i], theSources, theParameter,
+ *                          theAreaFunctions[i], theTimeFunction,
+ *                          theArea, thePeriod, theAreaAcceptor,
+ *                          theTimeAcceptor, theTester);
+ * \endcode
+ *
+ * but all of them are calculated from one scan of the area mask and
+ * the period. Point areas, faked results and modular parameters
+ * are analyzed separately.
+ *
+ * \param theFakeVars The fake variables of the area functions
+ * \param theSources The analysis sources
+ * \param theParameter The parameter to analyze
+ * \param theAreaFunctions The area functions
+ * \param theTimeFunction The common time function
+ * \param theArea The area
+ * \param thePeriod The period
+ * \param theResults The results in the order of the area functions
+ * \param theAreaAcceptor The acceptor in area integration
+ * \param theTimeAcceptor The acceptor in time integration
+ * \param theTester The acceptor for Percentage and Count calculations
+ */
+// ----------------------------------------------------------------------
+
+void analyze(const vector<string>& theFakeVars,
+             const AnalysisSources& theSources,
+             const WeatherParameter& theParameter,
+             const vector<WeatherFunction>& theAreaFunctions,
+             const WeatherFunction& theTimeFunction,
+             const WeatherArea& theArea,
+             const WeatherPeriod& thePeriod,
+             vector<WeatherResult>& theResults,
+             const Acceptor& theAreaAcceptor,
+             const Acceptor& theTimeAcceptor,
+             const Acceptor& theTester)
+{
+  try
+  {
+    vector<vector<WeatherResult> > series;
+    timeSeries(theFakeVars,
+               theSources,
+               theParameter,
+               theAreaFunctions,
+               theTimeFunction,
+               theArea,
+               vector<WeatherPeriod>{thePeriod},
+               series,
+               theAreaAcceptor,
+               theTimeAcceptor,
+               theTester);
+
+    theResults.clear();
+    for (const auto& results : series)
+      theResults.push_back(results.front());
+  }
+  catch (...)
+  {
+    throw Fmi::Exception::Trace(BCP, "Operation failed");
+  }
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Analyze several area functions for a series of periods
+ *
+ * This is analyze() for each period, except that the data, the
+ * parameter and the area mask are resolved only once for the whole
+ * series. Typically the periods are the hours of a HourPeriodGenerator.
+ *
+ * \param theFakeVars The fake variables of the area functions
+ * \param theSources The analysis sources
+ * \param theParameter The parameter to analyze
+ * \param theAreaFunctions The area functions
+ * \param theTimeFunction The common time function
+ * \param theArea The area
+ * \param thePeriods The periods
+ * \param theResults For each area function the results of the periods
+ * \param theAreaAcceptor The acceptor in area integration
+ * \param theTimeAcceptor The acceptor in time integration
+ * \param theTester The acceptor for Percentage and Count calculations
+ */
+// ----------------------------------------------------------------------
+
+void timeSeries(const vector<string>& theFakeVars,
+                const AnalysisSources& theSources,
+                const WeatherParameter& theParameter,
+                const vector<WeatherFunction>& theAreaFunctions,
+                const WeatherFunction& theTimeFunction,
+                const WeatherArea& theArea,
+                const vector<WeatherPeriod>& thePeriods,
+                vector<vector<WeatherResult> >& theResults,
+                const Acceptor& theAreaAcceptor,
+                const Acceptor& theTimeAcceptor,
+                const Acceptor& theTester)
+{
+  try
+  {
+    // One area type is the special case of a single label
+
+    vector<vector<vector<WeatherResult> > > results;
+    timeSeries(theFakeVars,
+               theSources,
+               theParameter,
+               theAreaFunctions,
+               theTimeFunction,
+               theArea,
+               vector<WeatherArea::Type>{theArea.type()},
+               thePeriods,
+               results,
+               theAreaAcceptor,
+               theTimeAcceptor,
+               theTester);
+
+    theResults = std::move(results.front());
+  }
+  catch (...)
+  {
+    throw Fmi::Exception::Trace(BCP, "Operation failed");
+  }
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Analyze several area functions of several area types for a series of periods
+ *
+ * This is timeSeries() for the area with each of the given types, for
+ * example Full, Inland and Coast, except that all the types are
+ * calculated from one scan of the union of their masks. The fake
+ * variables are the same for all the area types.
+ *
+ * \param theFakeVars The fake variables of the area functions
+ * \param theSources The analysis sources
+ * \param theParameter The parameter to analyze
+ * \param theAreaFunctions The area functions
+ * \param theTimeFunction The common time function
+ * \param theArea The area
+ * \param theTypes The area types, at most LabelMask::max_labels
+ * \param thePeriods The periods
+ * \param theResults For each area type and area function the results of the periods
+ * \param theAreaAcceptor The acceptor in area integration
+ * \param theTimeAcceptor The acceptor in time integration
+ * \param theTester The acceptor for Percentage and Count calculations
+ */
+// ----------------------------------------------------------------------
+
+void timeSeries(const vector<string>& theFakeVars,
+                const AnalysisSources& theSources,
+                const WeatherParameter& theParameter,
+                const vector<WeatherFunction>& theAreaFunctions,
+                const WeatherFunction& theTimeFunction,
+                const WeatherArea& theArea,
+                const vector<WeatherArea::Type>& theTypes,
+                const vector<WeatherPeriod>& thePeriods,
+                vector<vector<vector<WeatherResult> > >& theResults,
+                const Acceptor& theAreaAcceptor,
+                const Acceptor& theTimeAcceptor,
+                const Acceptor& theTester)
+{
+  try
+  {
+    if (theFakeVars.size() != theAreaFunctions.size())
+      throw Fmi::Exception(BCP, "Each area function must have a fake variable");
+
+    theResults.assign(theTypes.size(), vector<vector<WeatherResult> >(theAreaFunctions.size()));
+
+    bool faked = false;
+    for (const auto& fakevar : theFakeVars)
+      faked |= Settings::isset(fakevar);
+
+    // Wind direction is analyzed with modular calculators
+
+    if (!theArea.isPoint() && !faked && theParameter != WindDirection &&
+        analyze_data(theFakeVars,
+                     theSources,
+                     theParameter,
+                     theAreaFunctions,
+                     theTimeFunction,
+                     theArea,
+                     theTypes,
+                     thePeriods,
+                     theResults,
+                     theAreaAcceptor,
+                     theTimeAcceptor,
+                     theTester))
+      return;
+
+    for (unsigned int label = 0; label < theTypes.size(); label++)
+    {
+      WeatherArea area(theArea);
+      area.type(theTypes[label]);
+      for (const auto& period : thePeriods)
+        analyze_separately(theFakeVars,
+                           theSources,
+                           theParameter,
+                           theAreaFunctions,
+                           theTimeFunction,
+                           area,
+                           period,
+                           theResults[label],
+                           theAreaAcceptor,
+                           theTimeAcceptor,
+                           theTester);
+    }
+  }
+  catch (...)
+  {
+    throw Fmi::Exception::Trace(BCP, "Operation failed");
+  }
+}
+
+}  // namespace StatisticsTools
+}  // namespace TextGen
+
+// ======================================================================
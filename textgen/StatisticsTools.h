@@ -0,0 +1,67 @@
+// ======================================================================
+/*!
+ * \file
+ * \brief Interface of namespace TextGen::StatisticsTools
+ */
+// ======================================================================
+
+#pragma once
+
+#include <calculator/Acceptor.h>
+#include <calculator/AnalysisSources.h>
+#include <calculator/DefaultAcceptor.h>
+#include <calculator/NullAcceptor.h>
+#include <calculator/WeatherArea.h>
+#include <calculator/WeatherFunction.h>
+#include <calculator/WeatherParameter.h>
+#include <calculator/WeatherPeriod.h>
+#include <calculator/WeatherResult.h>
+
+#include <string>
+#include <vector>
+
+namespace TextGen
+{
+namespace StatisticsTools
+{
+void analyze(const std::vector<std::string>& theFakeVars,
+             const AnalysisSources& theSources,
+             const WeatherParameter& theParameter,
+             const std::vector<WeatherFunction>& theAreaFunctions,
+             const WeatherFunction& theTimeFunction,
+             const WeatherArea& theArea,
+             const WeatherPeriod& thePeriod,
+             std::vector<WeatherResult>& theResults,
+             const Acceptor& theAreaAcceptor = DefaultAcceptor(),
+             const Acceptor& theTimeAcceptor = DefaultAcceptor(),
+             const Acceptor& theTester = NullAcceptor());
+
+void timeSeries(const std::vector<std::string>& theFakeVars,
+                const AnalysisSources& theSources,
+                const WeatherParameter& theParameter,
+                const std::vector<WeatherFunction>& theAreaFunctions,
+                const WeatherFunction& theTimeFunction,
+                const WeatherArea& theArea,
+                const std::vector<WeatherPeriod>& thePeriods,
+                std::vector<std::vector<WeatherResult> >& theResults,
+                const Acceptor& theAreaAcceptor = DefaultAcceptor(),
+                const Acceptor& theTimeAcceptor = DefaultAcceptor(),
+                const Acceptor& theTester = NullAcceptor());
+
+void timeSeries(const std::vector<std::string>& theFakeVars,
+                const AnalysisSources& theSources,
+                const WeatherParameter& theParameter,
+                const std::vector<WeatherFunction>& theAreaFunctions,
+                const WeatherFunction& theTimeFunction,
+                const WeatherArea& theArea,
+                const std::vector<WeatherArea::Type>& theTypes,
+                const std::vector<WeatherPeriod>& thePeriods,
+                std::vector<std::vector<std::vector<WeatherResult> > >& theResults,
+                const Acceptor& theAreaAcceptor = DefaultAcceptor(),
+                const Acceptor& theTimeAcceptor = DefaultAcceptor(),
+                const Acceptor& theTester = NullAcceptor());
+
+}  // namespace StatisticsTools
+}  // namespace TextGen
+
+// ======================================================================
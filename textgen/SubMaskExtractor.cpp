@@ -1,6 +1,10 @@
 #include <calculator/RegularFunctionAnalyzer.h>
 
 #include "SubMaskExtractor.h"
+#include "GridCoordinates.h"
+#include "GridMask.h"
+#include "MaskedCube.h"
+#include "RasterMaskTools.h"
 #include <calculator/CalculatorFactory.h>
 #include <calculator/MaskSource.h>
 #include <calculator/ParameterAnalyzer.h>
@@ -14,15 +18,18 @@
 #include <calculator/TextGenPosixTime.h>
 #include <newbase/NFmiEnumConverter.h>
 #include <newbase/NFmiFastQueryInfo.h>
+#include <newbase/NFmiGrid.h>
 #include <newbase/NFmiIndexMaskSource.h>
-#include <newbase/NFmiMetMath.h>
-#include <newbase/NFmiNearTree.h>
 #include <newbase/NFmiQueryData.h>
 #include <newbase/NFmiSvgTools.h>
+#include <algorithm>
 #include <cassert>
+#include <cmath>
 
 #include <boost/lexical_cast.hpp>
+#include <map>
 #include <memory>
+#include <optional>
 #include <sstream>
 #include <string>
 
@@ -51,52 +58,26 @@ NFmiEnumConverter converter;
 
 namespace TextGen
 {
-namespace
-{
 // ----------------------------------------------------------------------
 /*!
- * \brief Insert a line into the given NFmiNearTree
- *
- * This is used when inserting a NFmiSvgPath into the NFmiNearTree
- * with some fixed resolution.
+ * \brief Return the name of the data the given parameter is read from
  *
- * \param theTree The tree to insert the data into
- * \param theStart The starting X-coordinate
- * \param theEnd The end X-coordinate
- * \param theResolution The maximum allowed edge distance
+ * \param theParameter The parameter
+ * \return The data name, textgen::default_forecast unless overridden
  */
 // ----------------------------------------------------------------------
 
-void Insert(NFmiNearTree<NFmiPoint>& theTree,
-            const NFmiPoint& theStart,
-            const NFmiPoint& theEnd,
-            double theResolution)
+std::string GetDataName(const WeatherParameter& theParameter)
 {
   try
   {
-    // Safety against infinite recursion
-    if (theResolution <= 0)
-    {
-      theTree.Insert(theStart);
-      theTree.Insert(theEnd);
-    }
-    else
-    {
-      // if edge length is small enough, stop recursion
-      const double dist = theStart.Distance(theEnd);
-      if (dist <= theResolution)
-      {
-        theTree.Insert(theStart);
-        theTree.Insert(theEnd);
-      }
-      else
-      {
-        // subdivide and recurse
-        NFmiPoint mid((theStart.X() + theEnd.X()) / 2, (theStart.Y() + theEnd.Y()) / 2);
-        Insert(theTree, theStart, mid, theResolution);
-        Insert(theTree, theEnd, mid, theResolution);
-      }
-    }
+    std::string parameterName;
+    std::string dataName;
+
+    ParameterAnalyzer::getParameterStrings(theParameter, parameterName, dataName);
+    const string default_forecast = Settings::optional_string("textgen::default_forecast", "");
+    const string datavar = dataName + '_' + data_type_name(Forecast);
+    return Settings::optional_string(datavar, default_forecast);
   }
   catch (...)
   {
@@ -106,62 +87,51 @@ void Insert(NFmiNearTree<NFmiPoint>& theTree,
 
 // ----------------------------------------------------------------------
 /*!
- * \brief Insert the SVG path into the given NFmiNearTree
+ * \brief Return the index mask of the area for the given data
  *
- * The purpose here is to provide means for calculating
- * the distance of some point from the NFmiSvgPath. The user
- * is expected to provide some suitable resolution for
- * subdividing too long edges into more vertices.
+ * The mask source is selected based on the type of the area.
  *
- * \param theTree The tree to insert the data into
- * \param thePath The path to insert
- * \param theResolution The maximum allowed edge distance
+ * \param theSources The analysis sources
+ * \param theArea The area, which must not be a point
+ * \param theData The name of the data
+ * \return The mask
  */
 // ----------------------------------------------------------------------
 
-void Insert(NFmiNearTree<NFmiPoint>& theTree, const NFmiSvgPath& thePath, double theResolution)
+MaskSource::mask_type GetIndexMask(const AnalysisSources& theSources,
+                                   const WeatherArea& theArea,
+                                   const std::string& theData)
 {
   try
   {
-    if (thePath.empty())
-      return;
-
-    NFmiPoint firstPoint(thePath.front().itsX, thePath.front().itsY);
-
-    NFmiPoint lastPoint(0, 0);
+    std::shared_ptr<WeatherSource> wsource = theSources.getWeatherSource();
 
-    for (const auto& it : thePath)
+    switch (theArea.type())
     {
-      switch (it.itsType)
-      {
-        case NFmiSvgPath::kElementMoveto:
-          lastPoint = NFmiPoint(it.itsX, it.itsY);
-          firstPoint = lastPoint;
-          break;
-        case NFmiSvgPath::kElementClosePath:
-        {
-          Insert(theTree, lastPoint, firstPoint, theResolution);
-          lastPoint = firstPoint;
-          break;
-        }
-        case NFmiSvgPath::kElementLineto:
-        {
-          NFmiPoint nextPoint(it.itsX, it.itsY);
-          Insert(theTree, lastPoint, nextPoint, theResolution);
-          lastPoint = nextPoint;
-          break;
-        }
-        case NFmiSvgPath::kElementNotValid:
-          return;
-      }
+      case WeatherArea::Full:
+        return theSources.getMaskSource()->mask(theArea, theData, *wsource);
+      case WeatherArea::Land:
+        return theSources.getLandMaskSource()->mask(theArea, theData, *wsource);
+      case WeatherArea::Coast:
+        return theSources.getCoastMaskSource()->mask(theArea, theData, *wsource);
+      case WeatherArea::Inland:
+        return theSources.getInlandMaskSource()->mask(theArea, theData, *wsource);
+      case WeatherArea::Northern:
+        return theSources.getNorthernMaskSource()->mask(theArea, theData, *wsource);
+      case WeatherArea::Southern:
+        return theSources.getSouthernMaskSource()->mask(theArea, theData, *wsource);
+      case WeatherArea::Eastern:
+        return theSources.getEasternMaskSource()->mask(theArea, theData, *wsource);
+      case WeatherArea::Western:
+        return theSources.getWesternMaskSource()->mask(theArea, theData, *wsource);
     }
+    throw Fmi::Exception(BCP, "Unknown area type");
   }
   catch (...)
   {
     throw Fmi::Exception::Trace(BCP, "Operation failed");
   }
 }
-}  // namespace
 
 double GetLocationCoordinates(const AnalysisSources& theSources,
                               const WeatherParameter& theParameter,
@@ -178,9 +148,7 @@ double GetLocationCoordinates(const AnalysisSources& theSources,
     std::string dataName;
 
     ParameterAnalyzer::getParameterStrings(theParameter, parameterName, dataName);
-    const string default_forecast = Settings::optional_string("textgen::default_forecast", "");
-    const string datavar = dataName + '_' + data_type_name(Forecast);
-    const string dataname = Settings::optional_string(datavar, default_forecast);
+    const string dataname = GetDataName(theParameter);
 
     // Get the data into use
 
@@ -197,35 +165,7 @@ double GetLocationCoordinates(const AnalysisSources& theSources,
 
     if (!theArea.isPoint())
     {
-      MaskSource::mask_type theIndexMask;
-
-      switch (theArea.type())
-      {
-        case WeatherArea::Full:
-          theIndexMask = theSources.getMaskSource()->mask(theArea, dataname, *wsource);
-          break;
-        case WeatherArea::Land:
-          theIndexMask = theSources.getLandMaskSource()->mask(theArea, dataname, *wsource);
-          break;
-        case WeatherArea::Coast:
-          theIndexMask = theSources.getCoastMaskSource()->mask(theArea, dataname, *wsource);
-          break;
-        case WeatherArea::Inland:
-          theIndexMask = theSources.getInlandMaskSource()->mask(theArea, dataname, *wsource);
-          break;
-        case WeatherArea::Northern:
-          theIndexMask = theSources.getNorthernMaskSource()->mask(theArea, dataname, *wsource);
-          break;
-        case WeatherArea::Southern:
-          theIndexMask = theSources.getSouthernMaskSource()->mask(theArea, dataname, *wsource);
-          break;
-        case WeatherArea::Eastern:
-          theIndexMask = theSources.getEasternMaskSource()->mask(theArea, dataname, *wsource);
-          break;
-        case WeatherArea::Western:
-          theIndexMask = theSources.getWesternMaskSource()->mask(theArea, dataname, *wsource);
-          break;
-      }
+      MaskSource::mask_type theIndexMask = GetIndexMask(theSources, theArea, dataname);
 
       if (theIndexMask->empty())
         return 0;
@@ -239,23 +179,30 @@ double GetLocationCoordinates(const AnalysisSources& theSources,
         return 0;
       }
 
-      for (unsigned long it : *theIndexMask)
-      {
-        theQI.TimeIndex(startindex);
+      // The first time step is always included
+      const MaskedCube cube(
+          theQI, *theIndexMask, startindex, std::max(endindex, startindex + 1));
 
-        do
+      // Point data has no grid, its coordinates are read from the data
+
+      std::shared_ptr<const GridCoordinates> coordinates;
+      if (theQI.IsGrid())
+        coordinates = GridCoordinates::get(*theQI.Grid());
+
+      for (size_t i = 0; i < cube.points(); i++)
+      {
+        for (size_t t = 0; t < cube.times(); t++)
         {
-          // possible -1 is handled by IndexFloatValue
-          const unsigned long idx =
-              theQI.Index(theQI.ParamIndex(), it, theQI.LevelIndex(), theQI.TimeIndex());
-          const float tmp = theQI.GetFloatValue(idx);
+          const float tmp = cube.value(t, i);
 
           if (theAcceptor.accept(tmp))
           {
-            theResultData.push_back(new NFmiPoint(theQI.LatLon(it)));
+            const unsigned long idx = cube.indexes()[i];
+            theResultData.push_back(new NFmiPoint(coordinates ? coordinates->latlon(idx)
+                                                              : theQI.LatLon(idx)));
             retval += tmp;
           }
-        } while (theQI.NextTime() && theQI.TimeIndex() < endindex);
+        }
       }
     }
 
@@ -282,9 +229,7 @@ double ExtractMask(const AnalysisSources& theSources,
     std::string dataName;
 
     ParameterAnalyzer::getParameterStrings(theParameter, parameterName, dataName);
-    const string default_forecast = Settings::optional_string("textgen::default_forecast", "");
-    const string datavar = dataName + '_' + data_type_name(Forecast);
-    const string dataname = Settings::optional_string(datavar, default_forecast);
+    const string dataname = GetDataName(theParameter);
 
     // Get the data into use
 
@@ -301,35 +246,7 @@ double ExtractMask(const AnalysisSources& theSources,
 
     if (!theArea.isPoint())
     {
-      MaskSource::mask_type theIndexMask;
-
-      switch (theArea.type())
-      {
-        case WeatherArea::Full:
-          theIndexMask = theSources.getMaskSource()->mask(theArea, dataname, *wsource);
-          break;
-        case WeatherArea::Land:
-          theIndexMask = theSources.getLandMaskSource()->mask(theArea, dataname, *wsource);
-          break;
-        case WeatherArea::Coast:
-          theIndexMask = theSources.getCoastMaskSource()->mask(theArea, dataname, *wsource);
-          break;
-        case WeatherArea::Inland:
-          theIndexMask = theSources.getInlandMaskSource()->mask(theArea, dataname, *wsource);
-          break;
-        case WeatherArea::Northern:
-          theIndexMask = theSources.getNorthernMaskSource()->mask(theArea, dataname, *wsource);
-          break;
-        case WeatherArea::Southern:
-          theIndexMask = theSources.getSouthernMaskSource()->mask(theArea, dataname, *wsource);
-          break;
-        case WeatherArea::Eastern:
-          theIndexMask = theSources.getEasternMaskSource()->mask(theArea, dataname, *wsource);
-          break;
-        case WeatherArea::Western:
-          theIndexMask = theSources.getWesternMaskSource()->mask(theArea, dataname, *wsource);
-          break;
-      }
+      MaskSource::mask_type theIndexMask = GetIndexMask(theSources, theArea, dataname);
 
       if (theIndexMask->empty())
         return 0;
@@ -341,24 +258,38 @@ double ExtractMask(const AnalysisSources& theSources,
               theQI, thePeriod.utcStartTime(), thePeriod.utcEndTime(), startindex, endindex))
         return 0;
 
-      for (unsigned long it : *theIndexMask)
-      {
-        theQI.TimeIndex(startindex);
+      // The first time step is always included
+      const MaskedCube cube(
+          theQI, *theIndexMask, startindex, std::max(endindex, startindex + 1));
+
+      // Collect the accepted points of gridded data into a bitmask to insert
+      // each one only once. Point data is inserted location by location.
 
-        do
+      std::optional<GridMask> accepted;
+      if (theQI.IsGrid())
+        accepted.emplace(*theQI.Grid());
+
+      for (size_t i = 0; i < cube.points(); i++)
+      {
+        for (size_t t = 0; t < cube.times(); t++)
         {
-          // possible -1 is handled by IndexFloatValue
-          const unsigned long idx =
-              theQI.Index(theQI.ParamIndex(), it, theQI.LevelIndex(), theQI.TimeIndex());
-          const float tmp = theQI.GetFloatValue(idx);
+          const float tmp = cube.value(t, i);
 
           if (theAcceptor.accept(tmp))
           {
-            theResultIndexMask.insert(it);
+            if (accepted)
+              accepted->set(cube.indexes()[i]);
+            else
+              theResultIndexMask.insert(cube.indexes()[i]);
             retval += tmp;
           }
-        } while (theQI.NextTime() && theQI.TimeIndex() < endindex);
+        }
       }
+
+      if (accepted)
+        for (const auto& span : accepted->spans())
+          for (unsigned long idx = span.begin; idx < span.end; idx++)
+            theResultIndexMask.insert(idx);
     }
 
     return retval;
@@ -406,70 +337,83 @@ bool point_in_direction(const NFmiPoint& p,
     throw Fmi::Exception::Trace(BCP, "Operation failed");
   }
 }
+
+// Grid points closer than this to a crossing are tested exactly
+const double edge_margin = 1.0;
 }  // namespace
 
 NFmiIndexMask MaskDirection(const NFmiGrid& theGrid,
                             const WeatherArea& theArea,
                             const AreaTools::direction_id& theDirectionId)
 {
-  NFmiIndexMask mask;
-
-  const NFmiSvgPath& svgPath = theArea.path();
-
-  const double resolution_factor = 1.0 / 4;
+  try
+  {
+    NFmiIndexMask mask;
 
-  // Establish grid resolution
+    const NFmiSvgPath& svgPath = theArea.path();
 
-  const double dx = theGrid.Area()->WorldXYWidth() / (theGrid.XNumber() - 1);
-  const double dy = theGrid.Area()->WorldXYHeight() / (theGrid.YNumber() - 1);
+    if (svgPath.empty())
+      return mask;
 
-  // Fast lookup tree for distance calculations
+    double theXmin;
+    double theYmin;
+    double theXmax;
+    double theYmax;
 
-  NFmiSvgPath projectedPath(svgPath);
-  NFmiSvgTools::LatLonToWorldXY(projectedPath, *theGrid.Area());
-  NFmiNearTree<NFmiPoint> tree;
-  Insert(tree, projectedPath, FmiMin(dx, dy) * resolution_factor);
+    NFmiSvgTools::BoundingBox(svgPath, theXmin, theYmin, theXmax, theYmax);
 
-  //
-  double theXmin;
-  double theYmin;
-  double theXmax;
-  double theYmax;
+    double latitudeDivisionLine =
+        (theArea.latitudeDivisionLineSet() ? theArea.getLatitudeDivisionLine()
+                                           : theYmin + ((theYmax - theYmin) / 2.0));
 
-  NFmiSvgTools::BoundingBox(svgPath, theXmin, theYmin, theXmax, theYmax);
+    double longitudeDivisionLine =
+        (theArea.longitudeDivisionLineSet() ? theArea.getLongitudeDivisionLine()
+                                            : theXmin + ((theXmax - theXmin) / 2.0));
 
-  double latitudeDivisionLine =
-      (theArea.latitudeDivisionLineSet() ? theArea.getLatitudeDivisionLine()
-                                         : theYmin + ((theYmax - theYmin) / 2.0));
+    const long nx = theGrid.XNumber();
 
-  double longitudeDivisionLine =
-      (theArea.longitudeDivisionLineSet() ? theArea.getLongitudeDivisionLine()
-                                          : theXmin + ((theXmax - theXmin) / 2.0));
+    // Rasterize the path one grid row at a time. Only rows crossed by the
+    // path are visited, and only grid points near the edges need the exact
+    // point-in-polygon test.
 
-  // Non-optimal solution loops through the entire grid
+    const RasterMaskTools::RowCrossings rows = RasterMaskTools::CrossingsByRow(theGrid, svgPath);
+    const std::shared_ptr<const GridCoordinates> coordinates = GridCoordinates::get(theGrid);
 
-  const unsigned long nx = theGrid.XNumber();
-  const unsigned long ny = theGrid.YNumber();
+    for (const auto& row : rows)
+    {
+      const long j = row.first;
+      const vector<double>& crossings = row.second;
 
-  if (!svgPath.empty())
-  {
-    for (unsigned long j = 0; j < ny; j++)
-      for (unsigned long i = 0; i < nx; i++)
+      for (unsigned int k = 0; k + 1 < crossings.size(); k += 2)
       {
-        const unsigned long idx = j * nx + i;
-        const NFmiPoint p = theGrid.LatLon(idx);
+        const double x1 = crossings[k];
+        const double x2 = crossings[k + 1];
 
-        // const NFmiPoint xy = theGrid.GridToWorldXY(i,j);
+        const long i1 = std::max(0L, static_cast<long>(std::floor(x1)) - 1);
+        const long i2 = std::min(nx - 1, static_cast<long>(std::ceil(x2)) + 1);
 
-        if (NFmiSvgTools::IsInside(svgPath, p))
+        for (long i = i1; i <= i2; i++)
         {
-          if (point_in_direction(p, theDirectionId, latitudeDivisionLine, longitudeDivisionLine))
-            mask.insert(idx);
+          const unsigned long idx = j * nx + i;
+          const NFmiPoint p = coordinates->latlon(idx);
+
+          const bool interior = (i >= x1 + edge_margin && i <= x2 - edge_margin);
+
+          if (interior || NFmiSvgTools::IsInside(svgPath, p))
+          {
+            if (point_in_direction(p, theDirectionId, latitudeDivisionLine, longitudeDivisionLine))
+              mask.insert(idx);
+          }
         }
       }
-  }
+    }
 
-  return mask;
+    return mask;
+  }
+  catch (...)
+  {
+    throw Fmi::Exception::Trace(BCP, "Operation failed");
+  }
 }
 
 void PrintLatLon(const AnalysisSources& theSources,
@@ -3,10 +3,12 @@
 #include "AreaTools.h"
 #include <calculator/Acceptor.h>
 #include <calculator/AnalysisSources.h>
+#include <calculator/MaskSource.h>
 #include <calculator/WeatherArea.h>
 #include <calculator/WeatherParameter.h>
 #include <calculator/WeatherPeriod.h>
 
+#include <string>
 #include <vector>
 
 #include <newbase/NFmiGrid.h>
@@ -16,6 +18,12 @@
 
 namespace TextGen
 {
+std::string GetDataName(const WeatherParameter& theParameter);
+
+MaskSource::mask_type GetIndexMask(const AnalysisSources& theSources,
+                                   const WeatherArea& theArea,
+                                   const std::string& theData);
+
 double GetLocationCoordinates(const AnalysisSources& theSources,
                               const WeatherParameter& theParameter,
                               const WeatherArea& theArea,
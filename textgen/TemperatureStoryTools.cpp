@@ -13,6 +13,7 @@
 // ======================================================================
 
 #include "TemperatureStoryTools.h"
+#include "CachedGridForecaster.h"
 #include "ClimatologyTools.h"
 #include "GridClimatology.h"
 #include "Integer.h"
@@ -25,8 +26,8 @@
 #include <calculator/WeatherPeriodGenerator.h>
 
 #include "SeasonTools.h"
+#include "StatisticsTools.h"
 #include "TextFormatter.h"
-#include <calculator/GridForecaster.h>
 #include <calculator/WeatherArea.h>
 #include <calculator/WeatherPeriod.h>
 #include <calculator/WeatherResult.h>
@@ -92,31 +93,19 @@ void min_max_mean_temperature(const string& theVar,
 {
   try
   {
-    GridForecaster theForecaster;
-
-    theMin = theForecaster.analyze(theVar + "::min",
-                                   theSources,
-                                   Temperature,
-                                   Minimum,
-                                   theIsWinterHalf ? Mean : Maximum,
-                                   theArea,
-                                   thePeriod);
-
-    theMax = theForecaster.analyze(theVar + "::max",
-                                   theSources,
-                                   Temperature,
-                                   Maximum,
-                                   theIsWinterHalf ? Mean : Maximum,
-                                   theArea,
-                                   thePeriod);
+    vector<WeatherResult> results;
+    StatisticsTools::analyze({theVar + "::min", theVar + "::max", theVar + "::mean"},
+                             theSources,
+                             Temperature,
+                             {Minimum, Maximum, Mean},
+                             theIsWinterHalf ? Mean : Maximum,
+                             theArea,
+                             thePeriod,
+                             results);
 
-    theMean = theForecaster.analyze(theVar + "::mean",
-                                    theSources,
-                                    Temperature,
-                                    Mean,
-                                    theIsWinterHalf ? Mean : Maximum,
-                                    theArea,
-                                    thePeriod);
+    theMin = results[0];
+    theMax = results[1];
+    theMean = results[2];
   }
   catch (...)
   {
@@ -443,7 +432,7 @@ void min_max_mean_temperature(const string& theVar,
 {
   try
   {
-    GridForecaster theForecaster;
+    CachedGridForecaster theForecaster;
 
     theMin = theForecaster.analyze(theVar + "::min",
                                    theSources,
@@ -768,42 +757,16 @@ fractile_id classify_fake_fractile(const float& theTemperature,
   }
 }
 
-// Helper: analyze a single fractile level and check if temperature falls in it
-fractile_id check_grid_fractile(GridClimatology& gc,
-                                const std::string& theVar,
-                                const AnalysisSources& theSources,
-                                const WeatherArea& theArea,
-                                const WeatherPeriod& climatePeriod,
-                                const fractile_type_id& theFractileType,
-                                WeatherParameter minParam,
-                                WeatherParameter meanParam,
-                                WeatherParameter maxParam,
-                                const float& theTemperature,
-                                fractile_id resultId)
-{
-  try
-  {
-    WeatherParameter param =
-        fractile_weather_parameter(theFractileType, minParam, meanParam, maxParam);
-    WeatherResult result =
-        gc.analyze(theVar, theSources, param, Mean, Mean, theArea, climatePeriod);
-    if (result.value() != kFloatMissing && theTemperature <= result.value())
-      return resultId;
-    return FRACTILE_UNDEFINED;
-  }
-  catch (...)
-  {
-    throw Fmi::Exception::Trace(BCP, "Operation failed")
-        .addParameter("theVar", theVar)
-        .addParameter("theTemperature", Fmi::to_string(theTemperature));
-  }
-}
 }  // namespace
 
 // ----------------------------------------------------------------------
 /*!
  * \brief determines the fractile of the given temperature
  *
+ * Only the fractiles up to the first one exceeding the temperature are
+ * analyzed. Fractiles analyzed earlier for the same area and day are
+ * served from the active AnalysisCache.
+ *
  * \param theVar The control variable prefix
  * \param theSources The analysis sources
  * \param theArea The waether area
@@ -961,6 +924,117 @@ WeatherResult get_fractile_temperature(const std::string& theVar,
   }
 }
 
+// ----------------------------------------------------------------------
+/*!
+ * \brief determines the temperatures of the given fractiles
+ *
+ * The climatology period is determined once for all the fractiles,
+ * and the analyses are memoized by the active AnalysisCache, hence
+ * later requests for the same area and day during the same generate
+ * call are served from memory.
+ *
+ * \param theVar The control variable prefix
+ * \param theFractileIds The fractiles to analyze, FRACTILE_02...FRACTILE_98
+ * \param theSources The analysis sources
+ * \param theArea The waether area
+ * \param thePeriod The main period
+ * \return The temperatures of the given fractiles
+ *
+ */
+// ----------------------------------------------------------------------
+
+std::map<fractile_id, WeatherResult> get_fractile_temperatures(
+    const std::string& theVar,
+    const std::vector<fractile_id>& theFractileIds,
+    const AnalysisSources& theSources,
+    const WeatherArea& theArea,
+    const WeatherPeriod& thePeriod,
+    const fractile_type_id& theFractileType)
+{
+  try
+  {
+    std::map<fractile_id, WeatherResult> result;
+
+    string seasonStr =
+        SeasonTools::isSummerHalf(thePeriod.localStartTime(), theVar) ? "summer" : "winter";
+
+    // fake variables are just for rough testing purposes
+    if (Settings::isset(theVar + "::fake::fractile::" + seasonStr + "::F02"))
+    {
+      const auto& suffixMap = fractile_fake_suffix_map();
+      for (const auto id : theFractileIds)
+      {
+        auto it = suffixMap.find(id);
+        if (it != suffixMap.end())
+          result.insert(std::make_pair(
+              id, WeatherResult(fake_fractile_value(theVar, seasonStr, it->second), 0)));
+      }
+      return result;
+    }
+
+    std::string dataName("textgen::fractiles");
+    WeatherPeriod climatePeriod =
+        ClimatologyTools::getClimatologyPeriod(thePeriod, dataName, theSources);
+    GridClimatology gc;
+
+    const auto& paramMap = fractile_param_map();
+    for (const auto id : theFractileIds)
+    {
+      auto it = paramMap.find(id);
+      if (it == paramMap.end())
+        continue;
+      WeatherParameter param = fractile_weather_parameter(theFractileType,
+                                                          std::get<0>(it->second),
+                                                          std::get<1>(it->second),
+                                                          std::get<2>(it->second));
+      result.insert(std::make_pair(
+          id, gc.analyze(theVar, theSources, param, Mean, Mean, theArea, climatePeriod)));
+    }
+
+    return result;
+  }
+  catch (...)
+  {
+    throw Fmi::Exception::Trace(BCP, "Operation failed").addParameter("theVar", theVar);
+  }
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief determines the temperatures of all fractiles F02...F98
+ *
+ * \param theVar The control variable prefix
+ * \param theSources The analysis sources
+ * \param theArea The waether area
+ * \param thePeriod The main period
+ * \return The temperatures of the fractiles FRACTILE_02...FRACTILE_98
+ *
+ */
+// ----------------------------------------------------------------------
+
+std::map<fractile_id, WeatherResult> get_fractile_temperatures(
+    const std::string& theVar,
+    const AnalysisSources& theSources,
+    const WeatherArea& theArea,
+    const WeatherPeriod& thePeriod,
+    const fractile_type_id& theFractileType)
+{
+  try
+  {
+    return get_fractile_temperatures(
+        theVar,
+        {FRACTILE_02, FRACTILE_12, FRACTILE_37, FRACTILE_50, FRACTILE_63, FRACTILE_88, FRACTILE_98},
+        theSources,
+        theArea,
+        thePeriod,
+        theFractileType);
+  }
+  catch (...)
+  {
+    throw Fmi::Exception::Trace(BCP, "Operation failed").addParameter("theVar", theVar);
+  }
+}
+
 // ----------------------------------------------------------------------
 /*!
  * \brief returns fractile as a readable string
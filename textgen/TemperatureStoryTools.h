@@ -9,7 +9,9 @@
 
 #include <calculator/AnalysisSources.h>
 #include <calculator/TextGenPosixTime.h>
+#include <map>
 #include <string>
+#include <vector>
 
 namespace TextGen
 {
@@ -174,6 +176,33 @@ WeatherResult get_fractile_temperature(const std::string& theVar,
                                        const WeatherPeriod& thePeriod,
                                        const fractile_type_id& theFractileType);
 
+// ----------------------------------------------------------------------
+/*!
+ * \brief determines the temperatures of the given fractiles
+ */
+// ----------------------------------------------------------------------
+
+std::map<fractile_id, WeatherResult> get_fractile_temperatures(
+    const std::string& theVar,
+    const std::vector<fractile_id>& theFractileIds,
+    const AnalysisSources& theSources,
+    const WeatherArea& theArea,
+    const WeatherPeriod& thePeriod,
+    const fractile_type_id& theFractileType);
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief determines the temperatures of all fractiles F02...F98
+ */
+// ----------------------------------------------------------------------
+
+std::map<fractile_id, WeatherResult> get_fractile_temperatures(
+    const std::string& theVar,
+    const AnalysisSources& theSources,
+    const WeatherArea& theArea,
+    const WeatherPeriod& thePeriod,
+    const fractile_type_id& theFractileType);
+
 // ----------------------------------------------------------------------
 /*!
  * \brief returns fractile as a readable string
@@ -1,9 +1,9 @@
 #include "TemperatureTools.h"
+#include "CachedGridForecaster.h"
 
 #include "Story.h"
 
 #include "SeasonTools.h"
-#include <calculator/GridForecaster.h>
 #include <calculator/Settings.h>
 #include <calculator/WeatherResult.h>
 #include <macgyver/Exception.h>
@@ -24,7 +24,7 @@ void min_max_mean_temperature(const std::string& theVar,
 {
   try
   {
-    GridForecaster theForecaster;
+    CachedGridForecaster theForecaster;
 
     theMin = theForecaster.analyze(
         theVar + "::min", theSources, Temperature, Minimum, Maximum, theArea, thePeriod);
@@ -20,6 +20,7 @@ class TemplateAcceptor : public Acceptor
   TemplateAcceptor(const T& theFunctor) : itsFunctor(theFunctor) {}
   bool accept(float theValue) const override { return itsFunctor(theValue); }
   Acceptor* clone() const override { return new TemplateAcceptor(*this); }
+  const T& functor() const { return itsFunctor; }
 
  private:
   T itsFunctor;
@@ -21,6 +21,9 @@
 #include <calculator/WeatherPeriod.h>
 #include <macgyver/Exception.h>
 #include <newbase/NFmiStringTools.h>
+#include <cctype>
+#include <map>
+#include <mutex>
 
 using namespace std;
 
@@ -64,28 +67,173 @@ std::string sentenceEnd(const Dictionary* theDict)
   return ".";
 }
 
+// ----------------------------------------------------------------------
+/*!
+ * \brief Return the locale name for the language of the given dictionary
+ *
+ * The languages of the dictionaries are mapped to UTF-8 locales by
+ * an explicit table, since the country of a language cannot be
+ * derived from its code. Other languages get a locale without a
+ * country, and full locale names are used as is. Finnish is used if
+ * the dictionary or its language is not set.
+ */
+// ----------------------------------------------------------------------
+
+std::string localeName(const Dictionary* theDict)
+{
+  static const std::map<std::string, std::string> locales{{"ar", "ar_SA"},
+                                                          {"da", "da_DK"},
+                                                          {"de", "de_DE"},
+                                                          {"en", "en_GB"},
+                                                          {"en-marine", "en_GB"},
+                                                          {"es", "es_ES"},
+                                                          {"et", "et_EE"},
+                                                          {"fi", "fi_FI"},
+                                                          {"fr", "fr_FR"},
+                                                          {"id", "id_ID"},
+                                                          {"it", "it_IT"},
+                                                          {"ja", "ja_JP"},
+                                                          {"ko", "ko_KR"},
+                                                          {"lv", "lv_LV"},
+                                                          {"nl", "nl_NL"},
+                                                          {"no", "nb_NO"},
+                                                          {"pl", "pl_PL"},
+                                                          {"ru", "ru_RU"},
+                                                          {"sonera", "fi_FI"},
+                                                          {"sv", "sv_FI"},
+                                                          {"sw", "sw_TZ"},
+                                                          {"th", "th_TH"},
+                                                          {"vi", "vi_VN"},
+                                                          {"zh", "zh_CN"}};
+
+  if (!theDict || theDict->language().empty())
+    return "fi_FI.UTF-8";
+
+  const std::string& language = theDict->language();
+
+  if (language.find_first_of("_.") != std::string::npos)
+    return language;
+
+  auto it = locales.find(language);
+  if (it != locales.end())
+    return it->second + ".UTF-8";
+
+  return language + ".UTF-8";
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Return the locale of the given name
+ *
+ * Generating a boost::locale instance initializes ICU and is expensive,
+ * hence the locales are created only once and shared by all threads.
+ *
+ * \param theName The locale name, for example fi_FI.UTF-8
+ * \return The locale
+ */
+// ----------------------------------------------------------------------
+
+const std::locale& getLocale(const std::string& theName)
+{
+  try
+  {
+    static std::mutex mutex;
+    static std::map<std::string, std::locale> locales;
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    auto it = locales.find(theName);
+    if (it != locales.end())
+      return it->second;
+
+    boost::locale::generator gen;
+    return locales.insert(std::make_pair(theName, gen(theName))).first->second;
+  }
+  catch (...)
+  {
+    throw Fmi::Exception::Trace(BCP, "Operation failed").addParameter("theName", theName);
+  }
+}
+
+namespace
+{
+// ----------------------------------------------------------------------
+/*!
+ * \brief Capitalize a string beginning with a plain ASCII word
+ *
+ * The first word is title cased the same way ICU does it, without
+ * building a word boundary index. Returns false if the string does not
+ * begin with ASCII letters followed by the end, a space, a comma or
+ * a hyphen, since only then is the word boundary unambiguous.
+ */
+// ----------------------------------------------------------------------
+
+bool capitalize_ascii(const std::string& theString, std::string& theResult)
+{
+  std::size_t n = 0;
+  while (n < theString.size() && std::isalpha(static_cast<unsigned char>(theString[n])) &&
+         static_cast<unsigned char>(theString[n]) < 0x80)
+    ++n;
+
+  if (n == 0)
+    return false;
+
+  if (n < theString.size() && theString[n] != ' ' && theString[n] != ',' && theString[n] != '-')
+    return false;
+
+  theResult = theString;
+  theResult[0] = static_cast<char>(std::toupper(static_cast<unsigned char>(theResult[0])));
+  for (std::size_t i = 1; i < n; i++)
+    theResult[i] = static_cast<char>(std::tolower(static_cast<unsigned char>(theResult[i])));
+
+  return true;
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Test whether ASCII title casing depends on the locale
+ *
+ * Turkish and Azerbaijani have a dotted capital I, Dutch capitalizes
+ * the digraph IJ.
+ */
+// ----------------------------------------------------------------------
+
+bool special_title_case(const std::string& theLocaleName)
+{
+  const std::string language = theLocaleName.substr(0, 2);
+  return (language == "tr" || language == "az" || language == "nl");
+}
+
+}  // namespace
+
 // ----------------------------------------------------------------------
 /*!
  * \brief Capitalize the given string (UTF-8!!!)
  *
- * TODO: Note that we use fi_FI.UTF-8 by default, this should be improved.
+ * The locale is selected based on the language of the dictionary,
+ * Finnish being the default.
  *
  * \param theString The string to capitalize
+ * \param theDict The dictionary of the language, or null
  */
 // ----------------------------------------------------------------------
 
-std::string capitalize(std::string& theString)
+std::string capitalize(std::string& theString, const Dictionary* theDict)
 {
   try
   {
     using namespace boost::locale;
     using namespace boost::locale::boundary;
 
-    generator gen;
-    std::locale loc(gen("fi_FI.UTF-8"));
-    ssegment_index wordmap(word, theString.begin(), theString.end(), loc);
+    const std::string name = localeName(theDict);
 
     std::string ret;
+    if (!special_title_case(name) && capitalize_ascii(theString, ret))
+      return ret;
+
+    const std::locale& loc = getLocale(name);
+    ssegment_index wordmap(word, theString.begin(), theString.end(), loc);
+
     for (ssegment_index::iterator it = wordmap.begin(), e = wordmap.end(); it != e; ++it)
     {
       if (it == wordmap.begin())
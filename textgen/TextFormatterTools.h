@@ -12,6 +12,7 @@
 #include <boost/algorithm/string/replace.hpp>
 #include <boost/lexical_cast.hpp>
 #include <iostream>
+#include <locale>
 #include <string>
 
 class TextGenPosixTime;
@@ -25,7 +26,9 @@ namespace TextFormatterTools
 {
 std::string wordSeparator(const Dictionary* theDict);
 std::string sentenceEnd(const Dictionary* theDict);
-std::string capitalize(std::string& theString);
+std::string localeName(const Dictionary* theDict);
+const std::locale& getLocale(const std::string& theName);
+std::string capitalize(std::string& theString, const Dictionary* theDict = nullptr);
 void punctuate(std::string& theString);
 std::string make_needle(int n);
 int count_patterns(const std::string& theString);
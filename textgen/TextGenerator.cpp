@@ -13,6 +13,7 @@
 // ======================================================================
 
 #include "TextGenerator.h"
+#include "AnalysisCache.h"
 #include "CoastMaskSource.h"
 #include "Document.h"
 #include "EasternMaskSource.h"
@@ -24,6 +25,7 @@
 #include "NorthernMaskSource.h"
 #include "NullMaskSource.h"
 #include "Paragraph.h"
+#include "ParallelTools.h"
 #include "SectionTag.h"
 #include "SouthernMaskSource.h"
 #include "StoryFactory.h"
@@ -43,6 +45,9 @@
 #include <calculator/TextGenPosixTime.h>
 #include <newbase/NFmiStringTools.h>
 
+#include <chrono>
+#include <mutex>
+
 #define VERSION_STRING "17.11.21-1"
 
 using namespace TextGen;
@@ -54,47 +59,289 @@ namespace
 {
 // ----------------------------------------------------------------------
 /*!
- * \brief Generate contents from given contents list
+ * \brief A story to be generated
+ */
+// ----------------------------------------------------------------------
+
+struct StoryPlan
+{
+  std::string itsName;
+  std::string itsVar;
+};
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief The stories of one paragraph and the period they describe
+ */
+// ----------------------------------------------------------------------
+
+struct ContentsPlan
+{
+  std::string itsContents;
+  WeatherPeriod itsPeriod;
+  std::vector<StoryPlan> itsStories;
+};
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief A section of the document
+ */
+// ----------------------------------------------------------------------
+
+struct SectionPlan
+{
+  std::string itsName;
+  WeatherPeriod itsPeriod;
+  std::string itsHeaderVar;
+  bool itsSubperiods;
+  std::vector<ContentsPlan> itsContents;
+};
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Establish the stories from given contents list
  *
  * \param theContents The string with content variables
  * \param theVar The control variable prefix
+ * \param thePeriod The weather period
+ * \return The contents to be generated
+ */
+// ----------------------------------------------------------------------
+
+ContentsPlan plan_contents(const string& theContents,
+                           const string& theVar,
+                           const WeatherPeriod& thePeriod)
+{
+  try
+  {
+    ContentsPlan plan{theContents, thePeriod, {}};
+
+    for (const auto& content : NFmiStringTools::Split(theContents))
+      plan.itsStories.push_back(StoryPlan{content, theVar + "::story::" + content});
+
+    return plan;
+  }
+  catch (...)
+  {
+    throw Fmi::Exception::Trace(BCP, "Operation failed").addParameter("contents", theContents);
+  }
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Establish the periods and stories of all sections
+ *
+ * The plan does not depend on the area, and can be shared by
+ * all the documents generated for the same forecast time. Nothing
+ * is logged here, the plan is logged by make_document section by
+ * section as the document is assembled.
+ *
+ * \param theForecastTime The forecast time
+ * \return The sections
+ */
+// ----------------------------------------------------------------------
+
+vector<SectionPlan> plan_sections(const TextGenPosixTime& theForecastTime)
+{
+  try
+  {
+    const vector<string> paragraphs =
+        NFmiStringTools::Split(Settings::require_string("textgen::sections"));
+
+    vector<SectionPlan> sections;
+    for (const auto& paragraph : paragraphs)
+    {
+      const string periodvar = "textgen::" + paragraph + "::period";
+      const WeatherPeriod period = WeatherPeriodFactory::create(theForecastTime, periodvar);
+
+      const string headervar = "textgen::" + paragraph + "::header";
+
+      const bool subs = Settings::optional_bool("textgen::" + paragraph + "::subperiods", false);
+
+      SectionPlan section{paragraph, period, headervar, subs, {}};
+
+      if (!subs)
+      {
+        const string contents = Settings::require("textgen::" + paragraph + "::content");
+        section.itsContents.push_back(plan_contents(contents, "textgen::" + paragraph, period));
+      }
+      else
+      {
+        // Generate subparagraphs for each day
+        HourPeriodGenerator generator(period, "textgen::" + paragraph + "::subperiod::day");
+
+        const string defaultvar = "textgen::" + paragraph;
+
+        for (HourPeriodGenerator::size_type day = 1; day <= generator.size(); day++)
+        {
+          const WeatherPeriod subperiod = generator.period(day);
+
+          const string dayvar = defaultvar + "::day" + NFmiStringTools::Convert(day);
+
+          const bool hasday = Settings::isset(dayvar + "::content");
+
+          section.itsContents.push_back(
+              plan_contents(hasday ? Settings::require_string(dayvar + "::content")
+                                   : Settings::require_string(defaultvar + "::content"),
+                            hasday ? dayvar : defaultvar,
+                            subperiod));
+        }
+      }
+      sections.push_back(section);
+    }
+    return sections;
+  }
+  catch (...)
+  {
+    throw Fmi::Exception::Trace(BCP, "Operation failed");
+  }
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Generate the document for one area
+ *
+ * The headers are created and the plan is logged on the calling
+ * thread, the messages of each section and subperiod being captured
+ * separately. The stories are independent of each other, and are
+ * generated with the given number of threads. The captured messages
+ * are relayed as tasks of their own in between the stories, hence
+ * the document and the message log are both in the original order.
+ *
+ * \param theSections The sections to generate
  * \param theForecastTime The forecast time
  * \param theSources The analysis sources
  * \param theArea The weather area
- * \param thePeriod The weather period
- * \return A paragraph
+ * \param theThreads The number of threads
+ * \param theLog The log of the calling thread
+ * \return The document
  */
 // ----------------------------------------------------------------------
 
-Paragraph make_contents(const string& theContents,
-                        const string& theVar,
-                        const TextGenPosixTime& theForecastTime,
-                        const AnalysisSources& theSources,
-                        const WeatherArea& theArea,
-                        const WeatherPeriod& thePeriod)
+Document make_document(const vector<SectionPlan>& theSections,
+                       const TextGenPosixTime& theForecastTime,
+                       const AnalysisSources& theSources,
+                       const WeatherArea& theArea,
+                       unsigned int theThreads,
+                       MessageLogger& theLog)
 {
   try
   {
-    const vector<string> contents = NFmiStringTools::Split(theContents);
+    const MessageLogger::Context context = MessageLogger::context();
+
+    // The headers of the sections, the paragraphs of the stories in the
+    // order of the plan, and the messages to be relayed
+
+    vector<Header> headers;
+    vector<Paragraph> paragraphs;
+    vector<string> messages;
+    vector<ParallelTools::task_type> tasks;
+
+    // Reserved in advance so that the tasks may refer to the messages
+
+    std::size_t nmessages = 0;
+    for (const auto& section : theSections)
+      nmessages += 1 + (section.itsSubperiods ? section.itsContents.size() : 0);
+    messages.reserve(nmessages);
+
+    auto relay = [&messages, &tasks]()
+    {
+      const string& text = messages.back();
+      tasks.push_back([&text]() { MessageLogger::append(text); });
+    };
+
+    for (const auto& section : theSections)
+    {
+      {
+        MessageLogger::Capture capture(context);
 
-    Paragraph paragraph;
+        theLog << "TextGenerator::generate periodvar textgen::" << section.itsName << "::period\n"
+               << "TextGenerator::generate headervar " << section.itsHeaderVar << '\n'
+               << "TextGenerator::generate period : " << section.itsPeriod.localStartTime()
+               << '\n'
+               << " -  " << section.itsPeriod.localEndTime() << '\n';
 
-    for (const auto& content : contents)
+        headers.push_back(HeaderFactory::create(
+            theForecastTime, theArea, section.itsPeriod, section.itsHeaderVar));
+
+        if (!section.itsSubperiods)
+          theLog << "TextGenerator::generate contents " << section.itsContents.front().itsContents
+                 << '\n';
+
+        messages.push_back(capture.str());
+      }
+      relay();
+
+      for (const auto& contents : section.itsContents)
+      {
+        if (section.itsSubperiods)
+        {
+          {
+            MessageLogger::Capture capture(context);
+            theLog << "TextGenerator::generate subperiod: " << contents.itsPeriod.localStartTime()
+                   << " - " << contents.itsPeriod.localEndTime() << '\n';
+            messages.push_back(capture.str());
+          }
+          relay();
+        }
+
+        for (const auto& story : contents.itsStories)
+        {
+          const WeatherPeriod& period = contents.itsPeriod;
+          const std::size_t i = paragraphs.size();
+          paragraphs.emplace_back();
+          tasks.push_back(
+              [&theForecastTime, &theSources, &theArea, &period, &story, &paragraphs, i]()
+              {
+                try
+                {
+                  paragraphs[i] = StoryFactory::create(
+                      theForecastTime, theSources, theArea, period, story.itsName, story.itsVar);
+                }
+                catch (...)
+                {
+                  throw Fmi::Exception::Trace(BCP, "Operation failed")
+                      .addParameter("story", story.itsVar);
+                }
+              });
+        }
+      }
+    }
+
+    ParallelTools::run(tasks, theThreads);
+
+    std::size_t i = 0;
+
+    Document doc;
+    for (std::size_t s = 0; s < theSections.size(); s++)
     {
-      const string storyvar = theVar + "::story::" + content;
+      const SectionPlan& section = theSections[s];
+
+      doc << SectionTag("textgen::" + section.itsName, true);
+
+      if (!headers[s].empty())
+        doc << headers[s];
+
+      for (const auto& contents : section.itsContents)
+      {
+        Paragraph paragraph;
+        for (const auto& story : contents.itsStories)
+        {
+          paragraph << StoryTag(story.itsVar, true);
+          paragraph << paragraphs[i++];
+          paragraph << StoryTag(story.itsVar, false);
+        }
+        doc << paragraph;
+      }
 
-      paragraph << StoryTag(storyvar, true);
-      Paragraph p =
-          StoryFactory::create(theForecastTime, theSources, theArea, thePeriod, content, storyvar);
-      paragraph << p;
-      paragraph << StoryTag(storyvar, false);
+      doc << SectionTag("textgen::" + section.itsName, false);
     }
 
-    return paragraph;
+    return doc;
   }
   catch (...)
   {
-    throw Fmi::Exception::Trace(BCP, "Operation failed").addParameter("contents", theContents);
+    throw Fmi::Exception::Trace(BCP, "Operation failed").addParameter("area", theArea.name());
   }
 }
 
@@ -115,6 +362,10 @@ class TextGenerator::Pimple
   AnalysisSources itsSources;
   TextGenPosixTime itsForecastTime;
 
+  // Timings of the latest generateBatch call, updated by the const method
+  mutable std::mutex itsMutex;
+  mutable std::vector<double> itsBatchTimings;
+
 };  // class Pimple
 
 // ----------------------------------------------------------------------
@@ -329,6 +580,13 @@ void TextGenerator::time(const TextGenPosixTime& theForecastTime)
  *           -# Append the story to the output paragraph
  * -# Return the document
  *
+ * The stories are independent of each other, and are generated
+ * concurrently if textgen::parallel::threads is greater than one.
+ * The document is assembled in the original order afterwards.
+ *
+ * The analysis results are memoized in a cache local to the call,
+ * hence the same generator may be used by several threads at once.
+ *
  * \param theArea The weather area
  *
  */
@@ -340,72 +598,140 @@ Document TextGenerator::generate(const WeatherArea& theArea) const
   {
     MessageLogger log("TextGenerator::generate");
 
-    const vector<string> paragraphs =
-        NFmiStringTools::Split(Settings::require_string("textgen::sections"));
+    const Pimple& pimple = *itsPimple;
 
-    Document doc;
-    for (const auto& paragraph : paragraphs)
-    {
-      doc << SectionTag("textgen::" + paragraph, true);
+    // Results are memoized only for the duration of this call
 
-      const string periodvar = "textgen::" + paragraph + "::period";
-      const WeatherPeriod period =
-          WeatherPeriodFactory::create(itsPimple->itsForecastTime, periodvar);
+    AnalysisCache cache;
+    const bool use_cache = Settings::optional_bool("textgen::cache::analysis", true);
+    AnalysisCache::Scope cache_scope(use_cache ? &cache : nullptr);
 
-      const string headervar = "textgen::" + paragraph + "::header";
+    const vector<SectionPlan> sections = plan_sections(pimple.itsForecastTime);
 
-      log << "TextGenerator::generate periodvar " << periodvar << '\n'
-          << "TextGenerator::generate headervar " << headervar << '\n'
-          << "TextGenerator::generate period : " << period.localStartTime() << '\n'
-          << " -  " << period.localEndTime() << '\n';
+    Document doc = make_document(sections,
+                                 pimple.itsForecastTime,
+                                 pimple.itsSources,
+                                 theArea,
+                                 ParallelTools::threads(),
+                                 log);
 
-      Header header = HeaderFactory::create(itsPimple->itsForecastTime, theArea, period, headervar);
-      if (!header.empty())
-        doc << header;
+    if (use_cache)
+      log << "TextGenerator::generate analysis cache hits " << cache.hits() << ", misses "
+          << cache.misses() << '\n';
 
-      const bool subs = Settings::optional_bool("textgen::" + paragraph + "::subperiods", false);
+    return doc;
+  }
+  catch (...)
+  {
+    throw Fmi::Exception::Trace(BCP, "Operation failed");
+  }
+}
 
-      if (!subs)
-      {
-        const string contents = Settings::require("textgen::" + paragraph + "::content");
-        log << "TextGenerator::generate contents " << contents << '\n';
-        doc << make_contents(contents,
-                             "textgen::" + paragraph,
-                             itsPimple->itsForecastTime,
-                             itsPimple->itsSources,
-                             theArea,
-                             period);
-      }
-      else
-      {
-        // Generate subparagraphs for each day
-        HourPeriodGenerator generator(period, "textgen::" + paragraph + "::subperiod::day");
+// ----------------------------------------------------------------------
+/*!
+ * \brief Generate the text for several areas
+ *
+ * The result is the same as calling generate for each area, but the
+ * periods and story lists are established only once, the mask caches
+ * are shared by all the areas, and the areas are generated
+ * concurrently if textgen::parallel::threads is greater than one.
+ *
+ * The analysis results depend on the area, hence each area memoizes
+ * them in a cache of its own, which is released as soon as the area
+ * is done. The time spent on each area and its cache statistics are
+ * written to the message log, and the times are available from
+ * batchTimings().
+ *
+ * \param theAreas The weather areas
+ * \return The documents in the order of the areas
+ */
+// ----------------------------------------------------------------------
 
-        const string defaultvar = "textgen::" + paragraph;
+std::vector<Document> TextGenerator::generateBatch(const std::vector<WeatherArea>& theAreas) const
+{
+  try
+  {
+    MessageLogger log("TextGenerator::generateBatch");
 
-        for (HourPeriodGenerator::size_type day = 1; day <= generator.size(); day++)
-        {
-          const WeatherPeriod subperiod = generator.period(day);
+    const Pimple& pimple = *itsPimple;
 
-          log << "TextGenerator::generate subperiod: " << subperiod.localStartTime() << " - "
-              << subperiod.localEndTime() << '\n';
+    const bool use_cache = Settings::optional_bool("textgen::cache::analysis", true);
 
-          const string dayvar = defaultvar + "::day" + NFmiStringTools::Convert(day);
+    const vector<SectionPlan> sections = plan_sections(pimple.itsForecastTime);
 
-          const bool hasday = Settings::isset(dayvar + "::content");
+    vector<Document> documents(theAreas.size());
+    vector<double> timings(theAreas.size(), 0);
+    vector<unsigned long> hits(theAreas.size(), 0);
+    vector<unsigned long> misses(theAreas.size(), 0);
 
-          doc << make_contents(hasday ? Settings::require_string(dayvar + "::content")
-                                      : Settings::require_string(defaultvar + "::content"),
-                               hasday ? dayvar : defaultvar,
-                               itsPimple->itsForecastTime,
-                               itsPimple->itsSources,
-                               theArea,
-                               subperiod);
-        }
-      }
-      doc << SectionTag("textgen::" + paragraph, false);
+    vector<ParallelTools::task_type> tasks;
+    for (std::size_t i = 0; i < theAreas.size(); i++)
+      tasks.push_back(
+          [&pimple, &sections, &theAreas, &documents, &timings, &hits, &misses, use_cache, i]()
+          {
+            try
+            {
+              const auto start = std::chrono::steady_clock::now();
+
+              // Each area is logged like a generate call of its own
+
+              MessageLogger area_log("TextGenerator::generate");
+
+              AnalysisCache cache;
+              AnalysisCache::Scope cache_scope(use_cache ? &cache : nullptr);
+
+              documents[i] = make_document(
+                  sections, pimple.itsForecastTime, pimple.itsSources, theAreas[i], 1, area_log);
+
+              const std::chrono::duration<double> elapsed =
+                  std::chrono::steady_clock::now() - start;
+              timings[i] = elapsed.count();
+              hits[i] = cache.hits();
+              misses[i] = cache.misses();
+            }
+            catch (...)
+            {
+              throw Fmi::Exception::Trace(BCP, "Operation failed")
+                  .addParameter("area", theAreas[i].name());
+            }
+          });
+
+    ParallelTools::run(tasks, ParallelTools::threads());
+
+    for (std::size_t i = 0; i < theAreas.size(); i++)
+    {
+      log << "TextGenerator::generateBatch area " << theAreas[i].name() << " took "
+          << 1000 * timings[i] << " ms";
+      if (use_cache)
+        log << ", analysis cache hits " << hits[i] << ", misses " << misses[i];
+      log << '\n';
     }
-    return doc;
+
+    std::lock_guard<std::mutex> lock(pimple.itsMutex);
+    pimple.itsBatchTimings = timings;
+
+    return documents;
+  }
+  catch (...)
+  {
+    throw Fmi::Exception::Trace(BCP, "Operation failed");
+  }
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Return the generation times of the areas of the latest batch
+ *
+ * \return The times in seconds in the order of the areas
+ */
+// ----------------------------------------------------------------------
+
+std::vector<double> TextGenerator::batchTimings() const
+{
+  try
+  {
+    std::lock_guard<std::mutex> lock(itsPimple->itsMutex);
+    return itsPimple->itsBatchTimings;
   }
   catch (...)
   {
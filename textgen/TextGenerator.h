@@ -9,6 +9,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 class TextGenPosixTime;
 
@@ -39,6 +40,9 @@ class TextGenerator
   void sources(const TextGen::AnalysisSources& theSources);
 
   Document generate(const TextGen::WeatherArea& theArea) const;
+  std::vector<Document> generateBatch(const std::vector<TextGen::WeatherArea>& theAreas) const;
+
+  std::vector<double> batchTimings() const;
 
   static std::string version();
 
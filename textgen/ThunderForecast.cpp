@@ -102,14 +102,14 @@ float ThunderForecast::getMaxValue(const WeatherPeriod& theWeatherPeriod,
   try
   {
     float maxValue(0.0);
+    const std::time_t startTime = theWeatherPeriod.localStartTime().EpochTime();
+    const std::time_t endTime = theWeatherPeriod.localEndTime().EpochTime();
     for (const auto& i : theDataVector)
     {
-      if (i->thePeriod.localStartTime() >= theWeatherPeriod.localStartTime() &&
-          i->thePeriod.localStartTime() <= theWeatherPeriod.localEndTime() &&
-          i->thePeriod.localEndTime() >= theWeatherPeriod.localStartTime() &&
-          i->thePeriod.localEndTime() <= theWeatherPeriod.localEndTime())
+      if (i.startTime() >= startTime && i.startTime() <= endTime && i.endTime() >= startTime &&
+          i.endTime() <= endTime)
       {
-        maxValue = std::max(i->theResult.value(), maxValue);
+        maxValue = std::max(i.value(), maxValue);
       }
     }
     return maxValue;
@@ -20,6 +20,7 @@ class ValueAcceptor : public Acceptor
 
   ValueAcceptor();
   void value(float theValue);
+  float value() const { return itsValue; }
 
  private:
   float itsValue;
@@ -1641,16 +1641,74 @@ precipitation_form_id get_complete_precipitation_form(const string& /*theVariabl
   }
 }
 
+// ----------------------------------------------------------------------
+/*!
+ * \brief Append an hour to the time axis
+ *
+ * The start and end times are also stored as epoch seconds of the
+ * local times, so that scans over the hours compare integers instead
+ * of TextGenPosixTime objects.
+ */
+// ----------------------------------------------------------------------
+
+void HourlyTimeAxis::push_back(const WeatherPeriod& thePeriod, part_of_the_day_id thePartOfTheDay)
+{
+  try
+  {
+    itsPeriods.push_back(thePeriod);
+    itsStartTimes.push_back(thePeriod.localStartTime().EpochTime());
+    itsEndTimes.push_back(thePeriod.localEndTime().EpochTime());
+    itsPartsOfTheDay.push_back(thePartOfTheDay);
+  }
+  catch (...)
+  {
+    throw Fmi::Exception::Trace(BCP, "Operation failed");
+  }
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Construct a column of missing values for the hours of the axis
+ *
+ * The values of all the quantities and areas of a story share the
+ * same axis. Each column holds its values and errors in two
+ * contiguous arrays instead of one heap allocated item per hour.
+ * The items of the hours refer to the arrays, so that the data item
+ * handles can return real references.
+ */
+// ----------------------------------------------------------------------
+
+HourlyColumn::HourlyColumn(const HourlyTimeAxis& theAxis)
+    : itsAxis(&theAxis),
+      itsValues(theAxis.size(), kFloatMissing),
+      itsErrors(theAxis.size(), kFloatMissing)
+{
+  try
+  {
+    itsItems.reserve(itsValues.size());
+    for (std::size_t i = 0; i < itsValues.size(); i++)
+      itsItems.push_back(WeatherResultDataItem{theAxis.period(i),
+                                               WeatherResultRef(itsValues[i], itsErrors[i]),
+                                               theAxis.partOfTheDay(i)});
+  }
+  catch (...)
+  {
+    throw Fmi::Exception::Trace(BCP, "Operation failed");
+  }
+}
+
 void get_sub_time_series(const WeatherPeriod& thePeriod,
                          const weather_result_data_item_vector& theSourceVector,
                          weather_result_data_item_vector& theDestinationVector)
 {
   try
   {
+  const std::time_t startTime = thePeriod.localStartTime().EpochTime();
+  const std::time_t endTime = thePeriod.localEndTime().EpochTime();
+
   for (const auto& item : theSourceVector)
   {
-    if (item->thePeriod.localStartTime() >= thePeriod.localStartTime() &&
-        item->thePeriod.localEndTime() <= thePeriod.localEndTime())
+    if (item.startTime() >= startTime && item.endTime() <= endTime)
       theDestinationVector.push_back(item);
   }
   }
@@ -3,8 +3,12 @@
 #include "AreaTools.h"
 #include "MessageLogger.h"
 #include <calculator/WeatherPeriod.h>
+#include <calculator/WeatherResult.h>
+#include <ctime>
+#include <deque>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace TextGen
 {
@@ -485,14 +489,152 @@ enum time_phrase_format
   AT_FORMAT
 };
 
-struct WeatherResultDataItem;
 struct PrecipitationDataItemData;
 struct FogIntensityDataItem;
 struct PrecipitationDataItem;
 struct CloudinessDataItem;
 struct ThunderDataItem;
 
-using weather_result_data_item_vector = std::vector<std::shared_ptr<WeatherResultDataItem> >;
+// Chooses the "in some places" / "in many places" phrase of a story and
+// avoids repeating it in the coastal part of a split sentence
+
+class InPlacesPhrase
+{
+ public:
+  enum PhraseType
+  {
+    NONEXISTENT_PHRASE,
+    IN_SOME_PLACES_PHRASE,
+    IN_MANY_PLACES_PHRASE
+  };
+
+  InPlacesPhrase();
+  void preventTautology(bool preventTautologyFlag)
+  {
+    thePreventTautologyFlag = preventTautologyFlag;
+  }
+  Sentence getInPlacesPhrase(PhraseType thePhraseType, bool useOllaVerbFlag);
+
+ private:
+  PhraseType thePreviousPhrase{NONEXISTENT_PHRASE};
+  bool thePreventTautologyFlag{false};
+};
+
+// The hourly time axis shared by all the hourly data of a story
+
+class HourlyTimeAxis
+{
+ public:
+  void push_back(const WeatherPeriod& thePeriod, part_of_the_day_id thePartOfTheDay);
+
+  std::size_t size() const { return itsPeriods.size(); }
+  const WeatherPeriod& period(std::size_t theIndex) const { return itsPeriods[theIndex]; }
+  std::time_t startTime(std::size_t theIndex) const { return itsStartTimes[theIndex]; }
+  std::time_t endTime(std::size_t theIndex) const { return itsEndTimes[theIndex]; }
+  part_of_the_day_id partOfTheDay(std::size_t theIndex) const
+  {
+    return itsPartsOfTheDay[theIndex];
+  }
+
+ private:
+  std::vector<WeatherPeriod> itsPeriods;
+  std::vector<std::time_t> itsStartTimes;
+  std::vector<std::time_t> itsEndTimes;
+  std::vector<part_of_the_day_id> itsPartsOfTheDay;
+};
+
+// A WeatherResult stored in a HourlyColumn
+
+class WeatherResultRef
+{
+ public:
+  WeatherResultRef(float& theValue, float& theError) : itsValue(theValue), itsError(theError) {}
+  WeatherResultRef(const WeatherResultRef& theOther) = default;
+
+  float value() const { return itsValue; }
+  float error() const { return itsError; }
+  operator WeatherResult() const { return WeatherResult(itsValue, itsError); }
+
+  WeatherResultRef& operator=(const WeatherResult& theResult)
+  {
+    itsValue = theResult.value();
+    itsError = theResult.error();
+    return *this;
+  }
+  WeatherResultRef& operator=(const WeatherResultRef& theOther)
+  {
+    return *this = static_cast<WeatherResult>(theOther);
+  }
+
+ private:
+  float& itsValue;
+  float& itsError;
+};
+
+// One hour of a HourlyColumn
+
+struct WeatherResultDataItem
+{
+  const WeatherPeriod& thePeriod;
+  WeatherResultRef theResult;
+  part_of_the_day_id thePartOfTheDay;
+};
+
+// The hourly values and errors of one quantity in one area. The items
+// refer to the values and the axis, hence the column cannot be copied.
+
+class HourlyColumn
+{
+ public:
+  explicit HourlyColumn(const HourlyTimeAxis& theAxis);
+  HourlyColumn(const HourlyColumn& theOther) = delete;
+  HourlyColumn& operator=(const HourlyColumn& theOther) = delete;
+
+  const HourlyTimeAxis& axis() const { return *itsAxis; }
+  std::size_t size() const { return itsValues.size(); }
+  float& value(std::size_t theIndex) { return itsValues[theIndex]; }
+  float& error(std::size_t theIndex) { return itsErrors[theIndex]; }
+  WeatherResultDataItem& item(std::size_t theIndex) { return itsItems[theIndex]; }
+  const std::vector<float>& values() const { return itsValues; }
+  const std::vector<float>& errors() const { return itsErrors; }
+
+ private:
+  const HourlyTimeAxis* itsAxis;
+  std::vector<float> itsValues;
+  std::vector<float> itsErrors;
+  std::vector<WeatherResultDataItem> itsItems;
+};
+
+// A pointer-like handle to one hour of a HourlyColumn owned by wf_story_params
+
+class WeatherResultDataItemPtr
+{
+ public:
+  WeatherResultDataItemPtr(HourlyColumn& theColumn, std::size_t theIndex)
+      : itsColumn(&theColumn), itsIndex(theIndex)
+  {
+  }
+
+  WeatherResultDataItem& operator*() const { return itsColumn->item(itsIndex); }
+  WeatherResultDataItem* operator->() const { return &itsColumn->item(itsIndex); }
+
+  bool operator==(const WeatherResultDataItemPtr& theOther) const
+  {
+    return itsColumn == theOther.itsColumn && itsIndex == theOther.itsIndex;
+  }
+  bool operator!=(const WeatherResultDataItemPtr& theOther) const { return !(*this == theOther); }
+
+  std::size_t index() const { return itsIndex; }
+  float value() const { return itsColumn->value(itsIndex); }
+  std::time_t startTime() const { return itsColumn->axis().startTime(itsIndex); }
+  std::time_t endTime() const { return itsColumn->axis().endTime(itsIndex); }
+
+ private:
+  HourlyColumn* itsColumn;
+  std::size_t itsIndex;
+};
+
+using weather_result_data_item_vector = std::vector<WeatherResultDataItemPtr>;
 using timestamp_weather_event_id_pair = std::pair<TextGenPosixTime, weather_event_id>;
 using weather_event_id_vector = std::vector<timestamp_weather_event_id_pair>;
 using precipitation_data_vector = std::vector<std::shared_ptr<PrecipitationDataItemData> >;
@@ -528,6 +670,10 @@ struct wf_story_params
   {
   }
 
+  // the hourly columns refer to the time axis of these parameters
+  wf_story_params(const wf_story_params& theOther) = delete;
+  wf_story_params& operator=(const wf_story_params& theOther) = delete;
+
   const std::string& theVariable;
   const WeatherArea& theArea;
   const WeatherPeriod theDataPeriod;
@@ -569,6 +715,9 @@ struct wf_story_params
   float theThuderNormalExtentMax = 0;
   float theThunderProbabilityMin = 0;
   float theThunderProbabilityThreshold = 0;
+  InPlacesPhrase theInPlacesPhrase;
+  HourlyTimeAxis theHourlyTimeAxis;
+  std::deque<HourlyColumn> theHourlyColumns;
   weather_forecast_data_container theCompleteData;
   cloudiness_data_container theCloudinessData;
   fog_data_container theFogData;
@@ -664,6 +813,7 @@ double get_pearson_coefficient(const weather_result_data_item_vector& theTimeSer
                                unsigned int theStartIndex,
                                unsigned int theEndIndex,
                                bool theUseErrorValueFlag = false);
+bool populate_weather_forecast_data(wf_story_params& theParameters);
 void print_out_weather_event_vector(std::ostream& theOutput,
                                     const weather_event_id_vector& theWeatherEventVector);
 Sentence area_specific_sentence(float north,
@@ -729,20 +879,6 @@ std::string as_string(const WeatherPeriod& period);
 std::string as_string(const GlyphContainer& gc);
 std::string as_string(const WeatherResult& wr);
 
-struct WeatherResultDataItem
-{
-  WeatherResultDataItem(WeatherPeriod period,
-                        const WeatherResult& result,
-                        part_of_the_day_id partOfTheDay)
-      : thePeriod(std::move(period)), theResult(result), thePartOfTheDay(partOfTheDay)
-  {
-  }
-
-  WeatherPeriod thePeriod;
-  WeatherResult theResult;
-  part_of_the_day_id thePartOfTheDay;
-};
-
 struct CloudinessDataItemData
 {
   CloudinessDataItemData(cloudiness_id id,
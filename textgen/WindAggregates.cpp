@@ -0,0 +1,418 @@
+// ======================================================================
+/*!
+ * \file
+ * \brief Implementation of class TextGen::WindAggregates
+ */
+// ======================================================================
+/*!
+ * \class TextGen::WindAggregates
+ *
+ * \brief Period aggregates over the hourly wind data of one area
+ *
+ * The wind story asks for the mean median wind, the maximum top wind,
+ * the mean wind direction error and the peak wind of many overlapping
+ * periods, and each question used to scan the whole wind data vector.
+ * WindAggregates scans the equalized data once into prefix sums and
+ * sparse range maximum tables. A query then finds the hours of the
+ * period by a binary search and reads the result in constant time.
+ *
+ * The index is valid for the data vector and area it was built for, and
+ * only if the data items are hourly points in ascending order. Otherwise
+ * the queries return an empty value and the caller scans the data as
+ * before. The index must be rebuilt if the data items are modified,
+ * since covers() cannot detect it. The top wind is not indexed if it contains missing values,
+ * since a missing value restarts the maximum search of the scan.
+ *
+ * The sums are accumulated in double precision, whereas the scans sum
+ * in float, hence the means may differ in the last bits.
+ */
+// ======================================================================
+
+#include "WindAggregates.h"
+#include "WindForecastStructs.h"
+
+#include <macgyver/Exception.h>
+
+#include <newbase/NFmiGlobals.h>
+
+#include <algorithm>
+#include <numeric>
+
+namespace TextGen
+{
+// ----------------------------------------------------------------------
+/*!
+ * \brief Build the index from the data of the given area
+ *
+ * The index is left empty if the data items are not hourly points in
+ * ascending order.
+ */
+// ----------------------------------------------------------------------
+
+void WindAggregates::build(const std::vector<WindDataItemsByArea*>& theWindDataVector,
+                           WeatherArea::Type theAreaType,
+                           double theWindSpeedTopCoverage)
+{
+  try
+  {
+    clear();
+
+    const std::size_t n = theWindDataVector.size();
+    std::vector<float> topWind;
+    std::vector<float> equalizedTopWind;
+    std::vector<float> peakIndex;
+
+    itsTimes.reserve(n);
+    itsMedianWindSums.reserve(n + 1);
+    itsDirectionErrorSums.reserve(n + 1);
+    topWind.reserve(n);
+    equalizedTopWind.reserve(n);
+    peakIndex.reserve(n);
+
+    itsMedianWindSums.push_back(0.0);
+    itsDirectionErrorSums.push_back(0.0);
+
+    for (const WindDataItemsByArea* item : theWindDataVector)
+    {
+      const WindDataItemUnit& dataItem = (*item)(theAreaType);
+
+      const std::time_t t = dataItem.thePeriod.localStartTime().EpochTime();
+      if (dataItem.thePeriod.localEndTime().EpochTime() != t ||
+          (!itsTimes.empty() && t <= itsTimes.back()))
+      {
+        clear();
+        return;
+      }
+      itsTimes.push_back(t);
+
+      itsMedianWindSums.push_back(itsMedianWindSums.back() +
+                                  dataItem.theEqualizedMedianWind.value());
+      itsDirectionErrorSums.push_back(itsDirectionErrorSums.back() +
+                                      dataItem.theEqualizedWindDirection.error());
+
+      topWind.push_back(dataItem.theWindSpeedTop.value());
+      if (topWind.back() == kFloatMissing)
+        itsTopWindMissing = true;
+
+      equalizedTopWind.push_back(dataItem.theEqualizedTopWind.value());
+
+      // the first wind speed at which the cumulative share reaches the coverage
+      int peak = -1;
+      double totalShare = 0.0;
+      const value_distribution_data_vector& distribution = dataItem.theWindSpeedDistributionTop;
+      for (unsigned int k = 0; k < distribution.size(); k++)
+      {
+        totalShare += distribution[k].second.value();
+        if (totalShare >= theWindSpeedTopCoverage)
+        {
+          peak = static_cast<int>(k);
+          break;
+        }
+      }
+      peakIndex.push_back(static_cast<float>(peak));
+    }
+
+    itsTopWind.build(std::move(topWind));
+    itsEqualizedTopWind.build(std::move(equalizedTopWind));
+    itsPeakIndex.build(std::move(peakIndex));
+
+    itsData = theWindDataVector.data();
+    itsSize = n;
+    itsAreaType = theAreaType;
+    itsBuilt = true;
+  }
+  catch (...)
+  {
+    throw Fmi::Exception::Trace(BCP, "Operation failed");
+  }
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Empty the index
+ */
+// ----------------------------------------------------------------------
+
+void WindAggregates::clear()
+{
+  try
+  {
+    itsBuilt = false;
+    itsData = nullptr;
+    itsSize = 0;
+    itsTopWindMissing = false;
+    itsTimes.clear();
+    itsMedianWindSums.clear();
+    itsDirectionErrorSums.clear();
+    itsTopWind.build({});
+    itsEqualizedTopWind.build({});
+    itsPeakIndex.build({});
+  }
+  catch (...)
+  {
+    throw Fmi::Exception::Trace(BCP, "Operation failed");
+  }
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Test whether the index was built from the given data
+ *
+ * The data is identified by the address and size of the vector only,
+ * hence changes to the data items after build() go unnoticed.
+ */
+// ----------------------------------------------------------------------
+
+bool WindAggregates::covers(const std::vector<WindDataItemsByArea*>& theWindDataVector,
+                            WeatherArea::Type theAreaType) const
+{
+  try
+  {
+    return (itsBuilt && itsData == theWindDataVector.data() &&
+            itsSize == theWindDataVector.size() && itsAreaType == theAreaType);
+  }
+  catch (...)
+  {
+    throw Fmi::Exception::Trace(BCP, "Operation failed");
+  }
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief The mean equalized median wind of the period
+ */
+// ----------------------------------------------------------------------
+
+std::optional<float> WindAggregates::medianWind(
+    const std::vector<WindDataItemsByArea*>& theWindDataVector,
+    WeatherArea::Type theAreaType,
+    const WeatherPeriod& thePeriod) const
+{
+  try
+  {
+    if (!covers(theWindDataVector, theAreaType))
+      return {};
+
+    const auto r = range(thePeriod);
+    if (r.first == r.second)
+      return 0.0;
+
+    return static_cast<float>((itsMedianWindSums[r.second] - itsMedianWindSums[r.first]) /
+                              (r.second - r.first));
+  }
+  catch (...)
+  {
+    throw Fmi::Exception::Trace(BCP, "Operation failed");
+  }
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief The maximum top wind of the period
+ */
+// ----------------------------------------------------------------------
+
+std::optional<float> WindAggregates::topWind(
+    const std::vector<WindDataItemsByArea*>& theWindDataVector,
+    WeatherArea::Type theAreaType,
+    const WeatherPeriod& thePeriod) const
+{
+  try
+  {
+    if (!covers(theWindDataVector, theAreaType) || itsTopWindMissing)
+      return {};
+
+    const auto r = range(thePeriod);
+    if (r.first == r.second)
+      return kFloatMissing;
+
+    return itsTopWind.value(itsTopWind.argmax(r.first, r.second));
+  }
+  catch (...)
+  {
+    throw Fmi::Exception::Trace(BCP, "Operation failed");
+  }
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief The mean equalized wind direction error of the period
+ */
+// ----------------------------------------------------------------------
+
+std::optional<float> WindAggregates::directionError(
+    const std::vector<WindDataItemsByArea*>& theWindDataVector,
+    WeatherArea::Type theAreaType,
+    const WeatherPeriod& thePeriod) const
+{
+  try
+  {
+    if (!covers(theWindDataVector, theAreaType))
+      return {};
+
+    const auto r = range(thePeriod);
+    if (r.first == r.second)
+      return 0.0;
+
+    return static_cast<float>((itsDirectionErrorSums[r.second] - itsDirectionErrorSums[r.first]) /
+                              (r.second - r.first));
+  }
+  catch (...)
+  {
+    throw Fmi::Exception::Trace(BCP, "Operation failed");
+  }
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Test whether the equalized top wind stays at or below the limit
+ */
+// ----------------------------------------------------------------------
+
+std::optional<bool> WindAggregates::isWeak(
+    const std::vector<WindDataItemsByArea*>& theWindDataVector,
+    WeatherArea::Type theAreaType,
+    const WeatherPeriod& thePeriod,
+    float theLimit) const
+{
+  try
+  {
+    if (!covers(theWindDataVector, theAreaType))
+      return {};
+
+    const auto r = range(thePeriod);
+    if (r.first == r.second)
+      return true;
+
+    return !(itsEqualizedTopWind.value(itsEqualizedTopWind.argmax(r.first, r.second)) > theLimit);
+  }
+  catch (...)
+  {
+    throw Fmi::Exception::Trace(BCP, "Operation failed");
+  }
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief The peak wind index of the period and the hour it first occurs
+ */
+// ----------------------------------------------------------------------
+
+std::optional<std::pair<int, std::size_t> > WindAggregates::peakWind(
+    const std::vector<WindDataItemsByArea*>& theWindDataVector,
+    WeatherArea::Type theAreaType,
+    const WeatherPeriod& thePeriod) const
+{
+  try
+  {
+    if (!covers(theWindDataVector, theAreaType))
+      return {};
+
+    const auto r = range(thePeriod);
+    if (r.first == r.second)
+      return std::make_pair(-1, r.first);
+
+    const std::size_t idx = itsPeakIndex.argmax(r.first, r.second);
+    return std::make_pair(static_cast<int>(itsPeakIndex.value(idx)), idx);
+  }
+  catch (...)
+  {
+    throw Fmi::Exception::Trace(BCP, "Operation failed");
+  }
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief The index range [first, second) of the hours inside the period
+ */
+// ----------------------------------------------------------------------
+
+std::pair<std::size_t, std::size_t> WindAggregates::range(const WeatherPeriod& thePeriod) const
+{
+  try
+  {
+    const auto first = std::lower_bound(
+        itsTimes.begin(), itsTimes.end(), thePeriod.localStartTime().EpochTime());
+    const auto last =
+        std::upper_bound(first, itsTimes.end(), thePeriod.localEndTime().EpochTime());
+
+    return std::make_pair(first - itsTimes.begin(), std::max(first, last) - itsTimes.begin());
+  }
+  catch (...)
+  {
+    throw Fmi::Exception::Trace(BCP, "Operation failed");
+  }
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Build the sparse table
+ *
+ * Level j holds the index of the first maximum of each range of 2^j
+ * values.
+ */
+// ----------------------------------------------------------------------
+
+void WindAggregates::RangeMaximum::build(std::vector<float> theValues)
+{
+  try
+  {
+    itsValues = std::move(theValues);
+    itsTable.clear();
+    itsLevels.clear();
+
+    const std::size_t n = itsValues.size();
+    if (n == 0)
+      return;
+
+    itsLevels.resize(n + 1, 0);
+    for (std::size_t width = 2; width <= n; width++)
+      itsLevels[width] = itsLevels[width / 2] + 1;
+
+    itsTable.emplace_back(n);
+    std::iota(itsTable.back().begin(), itsTable.back().end(), 0);
+
+    for (std::size_t width = 2; width <= n; width *= 2)
+    {
+      const std::vector<std::size_t>& previous = itsTable.back();
+      std::vector<std::size_t> level(n - width + 1);
+      for (std::size_t i = 0; i < level.size(); i++)
+      {
+        const std::size_t a = previous[i];
+        const std::size_t b = previous[i + width / 2];
+        level[i] = (itsValues[b] > itsValues[a] ? b : a);
+      }
+      itsTable.push_back(std::move(level));
+    }
+  }
+  catch (...)
+  {
+    throw Fmi::Exception::Trace(BCP, "Operation failed");
+  }
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief The index of the first maximum in the nonempty range [begin, end)
+ */
+// ----------------------------------------------------------------------
+
+std::size_t WindAggregates::RangeMaximum::argmax(std::size_t theBegin, std::size_t theEnd) const
+{
+  try
+  {
+    const std::size_t level = itsLevels[theEnd - theBegin];
+
+    const std::size_t a = itsTable[level][theBegin];
+    const std::size_t b = itsTable[level][theEnd - (std::size_t(1) << level)];
+    return (itsValues[b] > itsValues[a] ? b : a);
+  }
+  catch (...)
+  {
+    throw Fmi::Exception::Trace(BCP, "Operation failed");
+  }
+}
+
+}  // namespace TextGen
+
+// ======================================================================
@@ -0,0 +1,92 @@
+// ======================================================================
+/*!
+ * \file
+ * \brief Interface of class TextGen::WindAggregates
+ */
+// ======================================================================
+
+#pragma once
+
+#include <calculator/WeatherArea.h>
+#include <calculator/WeatherPeriod.h>
+
+#include <cstddef>
+#include <ctime>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace TextGen
+{
+struct WindDataItemsByArea;
+
+class WindAggregates
+{
+ public:
+  void build(const std::vector<WindDataItemsByArea*>& theWindDataVector,
+             WeatherArea::Type theAreaType,
+             double theWindSpeedTopCoverage);
+  void clear();
+
+  bool covers(const std::vector<WindDataItemsByArea*>& theWindDataVector,
+              WeatherArea::Type theAreaType) const;
+
+  // mean of the equalized median wind, 0 if the period has no data
+  std::optional<float> medianWind(const std::vector<WindDataItemsByArea*>& theWindDataVector,
+                                  WeatherArea::Type theAreaType,
+                                  const WeatherPeriod& thePeriod) const;
+  // maximum of the top wind, kFloatMissing if the period has no data
+  std::optional<float> topWind(const std::vector<WindDataItemsByArea*>& theWindDataVector,
+                               WeatherArea::Type theAreaType,
+                               const WeatherPeriod& thePeriod) const;
+  // mean error of the equalized wind direction, 0 if the period has no data
+  std::optional<float> directionError(const std::vector<WindDataItemsByArea*>& theWindDataVector,
+                                      WeatherArea::Type theAreaType,
+                                      const WeatherPeriod& thePeriod) const;
+  // true if the equalized top wind does not exceed the limit during the period
+  std::optional<bool> isWeak(const std::vector<WindDataItemsByArea*>& theWindDataVector,
+                             WeatherArea::Type theAreaType,
+                             const WeatherPeriod& thePeriod,
+                             float theLimit) const;
+  // highest top wind distribution index reaching the coverage and the index of
+  // the first hour it occurs at, index -1 if the coverage is never reached
+  std::optional<std::pair<int, std::size_t> > peakWind(
+      const std::vector<WindDataItemsByArea*>& theWindDataVector,
+      WeatherArea::Type theAreaType,
+      const WeatherPeriod& thePeriod) const;
+
+ private:
+  // sparse table returning the index of the first maximum of a range
+  class RangeMaximum
+  {
+   public:
+    void build(std::vector<float> theValues);
+    std::size_t argmax(std::size_t theBegin, std::size_t theEnd) const;
+    float value(std::size_t theIndex) const { return itsValues[theIndex]; }
+
+   private:
+    std::vector<float> itsValues;
+    std::vector<std::vector<std::size_t> > itsTable;
+    std::vector<std::size_t> itsLevels;  // floor(log2(width)) by range width
+  };
+
+  std::pair<std::size_t, std::size_t> range(const WeatherPeriod& thePeriod) const;
+
+  bool itsBuilt = false;
+  const WindDataItemsByArea* const* itsData = nullptr;
+  std::size_t itsSize = 0;
+  WeatherArea::Type itsAreaType = WeatherArea::Full;
+  bool itsTopWindMissing = false;
+
+  std::vector<std::time_t> itsTimes;
+  std::vector<double> itsMedianWindSums;
+  std::vector<double> itsDirectionErrorSums;
+  RangeMaximum itsTopWind;
+  RangeMaximum itsEqualizedTopWind;
+  RangeMaximum itsPeakIndex;
+
+};  // class WindAggregates
+
+}  // namespace TextGen
+
+// ======================================================================
@@ -322,11 +322,15 @@ Paragraph operator<<(Paragraph& p, const ParagraphInfoVector& piv)
 }
 
 float wind_direction_error(const wind_data_item_vector& theWindDataVector,
+                           const WindAggregates& theAggregates,
                            const WeatherArea& theArea,
                            const WeatherPeriod& thePeriod)
 {
   try
   {
+    if (auto error = theAggregates.directionError(theWindDataVector, theArea.type(), thePeriod))
+      return *error;
+
     unsigned int counter(0);
     float cumulativeWindDirectionError(0.0);
 
@@ -353,6 +357,12 @@ bool is_weak_period(const wo_story_params& theParameters, const WeatherPeriod& t
 {
   try
   {
+    if (auto weak = theParameters.theWindAggregates.isWeak(theParameters.theWindDataVector,
+                                                           theParameters.theArea.type(),
+                                                           thePeriod,
+                                                           WEAK_WIND_SPEED_UPPER_LIMIT))
+      return *weak;
+
     for (const WindDataItemsByArea* item : theParameters.theWindDataVector)
     {
       WindDataItemUnit& dataitem = item->getDataItem(theParameters.theArea.type());
@@ -377,6 +387,17 @@ unsigned int get_peak_wind(const WeatherPeriod& thePeriod,
 {
   try
   {
+    if (auto peak = theParameters.theWindAggregates.peakWind(
+            theParameters.theWindDataVector, theParameters.theArea.type(), thePeriod))
+    {
+      if (peak->first < 0)
+        return 0;
+      const WindDataItemUnit& windDataItem =
+          (*theParameters.theWindDataVector[peak->second])(theParameters.theArea.type());
+      thePeakWindTime = windDataItem.thePeriod.localStartTime();
+      return peak->first;
+    }
+
     unsigned int upper_index = 0;
 
     bool upper_index_updated(false);
@@ -610,7 +631,10 @@ WindDirectionInfo get_wind_direction(const wo_story_params& theParameters,
                                                                         theParameters.theVar);
 
     float directionError =
-        wind_direction_error(theParameters.theWindDataVector, theParameters.theArea, period);
+        wind_direction_error(theParameters.theWindDataVector,
+                             theParameters.theWindAggregates,
+                             theParameters.theArea,
+                             period);
 
     if (directionError < resultDirection.error())
       resultDirection = WeatherResult(resultDirection.value(), directionError);
@@ -905,6 +929,10 @@ float get_median_wind(const WeatherPeriod& thePeriod, const wo_story_params& the
 {
   try
   {
+    if (auto median = theParameters.theWindAggregates.medianWind(
+            theParameters.theWindDataVector, theParameters.theArea.type(), thePeriod))
+      return *median;
+
     float retval(0.0);
     unsigned int counter(0);
 
@@ -932,6 +960,10 @@ float get_top_wind(const WeatherPeriod& thePeriod, const wo_story_params& thePar
 {
   try
   {
+    if (auto top = theParameters.theWindAggregates.topWind(
+            theParameters.theWindDataVector, theParameters.theArea.type(), thePeriod))
+      return *top;
+
     float top_wind(kFloatMissing);
 
     for (unsigned int i = 0; i < theParameters.theWindDataVector.size(); i++)
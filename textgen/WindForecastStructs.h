@@ -2,6 +2,7 @@
 
 #include "Sentence.h"
 #include "WeatherForecast.h"
+#include "WindAggregates.h"
 #include "WindStoryTools.h"
 
 namespace TextGen
@@ -121,32 +122,34 @@ struct wo_story_params
   wind_direction_period_data_item_vector theWindDirectionVector;
   wind_event_period_data_item_vector theWindSpeedEventPeriodVector;
   std::vector<WeatherPeriod> theWindDirectionPeriods;
+  // period aggregates of the equalized data
+  WindAggregates theWindAggregates;
 
   std::map<WeatherArea::Type, index_vectors*> indexes;
 
   std::vector<unsigned int>& originalWindDataIndexes(WeatherArea::Type type)
   {
-    return indexes[type]->theOriginalWindDataIndexes;
+    return indexes.at(type)->theOriginalWindDataIndexes;
   }
   std::vector<unsigned int>& equalizedWSIndexesMaxWind(WeatherArea::Type type)
   {
-    return indexes[type]->theEqualizedWindSpeedIndexesForMaxWind;
+    return indexes.at(type)->theEqualizedWindSpeedIndexesForMaxWind;
   }
   std::vector<unsigned int>& equalizedWSIndexesMedian(WeatherArea::Type type)
   {
-    return indexes[type]->theEqualizedWindSpeedIndexesForMedianWind;
+    return indexes.at(type)->theEqualizedWindSpeedIndexesForMedianWind;
   }
   std::vector<unsigned int>& equalizedWSIndexesTopWind(WeatherArea::Type type)
   {
-    return indexes[type]->theEqualizedWindSpeedIndexesForTopWind;
+    return indexes.at(type)->theEqualizedWindSpeedIndexesForTopWind;
   }
   std::vector<unsigned int>& equalizedWSIndexesCalcWind(WeatherArea::Type type)
   {
-    return indexes[type]->theEqualizedWindSpeedIndexesForCalcWind;
+    return indexes.at(type)->theEqualizedWindSpeedIndexesForCalcWind;
   }
   std::vector<unsigned int>& equalizedWDIndexes(WeatherArea::Type type)
   {
-    return indexes[type]->theEqualizedWindDirectionIndexes;
+    return indexes.at(type)->theEqualizedWindDirectionIndexes;
   }
 
   // If the area is split this contains e.g. inland coast, full, eastern, western areas
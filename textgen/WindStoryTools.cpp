@@ -13,11 +13,11 @@
 // ======================================================================
 
 #include "WindStoryTools.h"
+#include "CachedGridForecaster.h"
 #include "Integer.h"
 #include "PositiveRange.h"
 #include "Sentence.h"
 #include "UnitFactory.h"
-#include <calculator/GridForecaster.h>
 #include <calculator/RangeAcceptor.h>
 #include <calculator/Settings.h>
 #include <macgyver/Exception.h>
@@ -846,7 +846,7 @@ pair<float, WeatherResult> get_share_item(
     const WindDirectionId& theWindDirection,
     WindStoryTools::CompassType compass_type = sixteen_directions)
 {
-  GridForecaster forecaster;
+  CachedGridForecaster forecaster;
   RangeAcceptor acceptor;
   float ws_lower_limit(0.0);
   float ws_upper_limit(360.0);
@@ -1179,7 +1179,7 @@ WeatherResult mode_wind_direction(const AnalysisSources& theSources,
                                   const WeatherResult& theTopWind,
                                   const string& theVar)
 {
-  GridForecaster forecaster;
+  CachedGridForecaster forecaster;
 
   WeatherResult meanDirection = forecaster.analyze(
       theVar + "::fake::wind:direction", theSources, WindDirection, Mean, Mean, theArea, thePeriod);
@@ -5,6 +5,7 @@
  */
 // ======================================================================
 
+#include "CachedGridForecaster.h"
 #include "CloudinessStory.h"
 #include "CloudinessStoryTools.h"
 #include "Delimiter.h"
@@ -12,7 +13,6 @@
 #include "Paragraph.h"
 #include "PeriodPhraseFactory.h"
 #include "Sentence.h"
-#include <calculator/GridForecaster.h>
 #include <calculator/HourPeriodGenerator.h>
 #include <calculator/RangeAcceptor.h>
 #include <calculator/Settings.h>
@@ -59,7 +59,7 @@ Paragraph CloudinessStory::overview() const
     // We do not allow forecasts longer than 3 days in order
     // to limit the complexity of the algorithm.
 
-    GridForecaster forecaster;
+    CachedGridForecaster forecaster;
     Paragraph paragraph;
 
     const HourPeriodGenerator periodgenerator(itsPeriod, itsVar + "::day");
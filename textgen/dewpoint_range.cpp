@@ -5,13 +5,13 @@
  */
 // ======================================================================
 
+#include "CachedGridForecaster.h"
 #include "DewPointStory.h"
 #include "Integer.h"
 #include "MessageLogger.h"
 #include "Paragraph.h"
 #include "Sentence.h"
 #include "TemperatureStoryTools.h"
-#include <calculator/GridForecaster.h>
 #include <calculator/Settings.h>
 #include <calculator/WeatherResult.h>
 #include <calculator/WeatherResultTools.h>
@@ -46,7 +46,7 @@ Paragraph DewPointStory::range() const
     Paragraph paragraph;
     Sentence sentence;
 
-    GridForecaster forecaster;
+    CachedGridForecaster forecaster;
 
     WeatherResult minresult = forecaster.analyze(
         itsVar + "::fake::minimum", itsSources, DewPoint, Mean, Minimum, itsArea, itsPeriod);
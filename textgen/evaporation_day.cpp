@@ -5,6 +5,7 @@
  */
 // ======================================================================
 
+#include "CachedGridForecaster.h"
 #include "Delimiter.h"
 #include "ForestStory.h"
 #include "MessageLogger.h"
@@ -12,7 +13,6 @@
 #include "Real.h"
 #include "Sentence.h"
 #include "UnitFactory.h"
-#include <calculator/GridForecaster.h>
 #include <calculator/HourPeriodGenerator.h>
 #include <calculator/WeatherResult.h>
 #include <macgyver/Exception.h>
@@ -56,7 +56,7 @@ Paragraph ForestStory::evaporation_day() const
 
     // Calculate mean evaporation for the area
 
-    GridForecaster forecaster;
+    CachedGridForecaster forecaster;
 
     WeatherResult evaporation = forecaster.analyze(
         itsVar + "::fake::area::mean", itsSources, Evaporation, Mean, Sum, itsArea, period);
@@ -5,6 +5,7 @@
  */
 // ======================================================================
 
+#include "CachedGridForecaster.h"
 #include "Delimiter.h"
 #include "FrostStory.h"
 #include "FrostStoryTools.h"
@@ -14,7 +15,6 @@
 #include "PeriodPhraseFactory.h"
 #include "Sentence.h"
 #include "UnitFactory.h"
-#include <calculator/GridForecaster.h>
 #include <calculator/HourPeriodGenerator.h>
 #include <calculator/MathTools.h>
 #include <calculator/Settings.h>
@@ -109,7 +109,7 @@ Paragraph FrostStory::day() const
 
     // Calculate frost probability for the area
 
-    GridForecaster forecaster;
+    CachedGridForecaster forecaster;
 
     WeatherResult areafrost = forecaster.analyze(
         itsVar + "::fake::area::frost", itsSources, Frost, Mean, Maximum, itsArea, period);
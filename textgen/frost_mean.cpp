@@ -5,6 +5,7 @@
  */
 // ======================================================================
 
+#include "CachedGridForecaster.h"
 #include "FrostStory.h"
 #include "FrostStoryTools.h"
 #include "Integer.h"
@@ -12,7 +13,6 @@
 #include "Paragraph.h"
 #include "Sentence.h"
 #include "UnitFactory.h"
-#include <calculator/GridForecaster.h>
 #include <calculator/MathTools.h>
 #include <calculator/Settings.h>
 #include <calculator/WeatherResult.h>
@@ -58,7 +58,7 @@ Paragraph FrostStory::mean() const
     const int severelimit = Settings::require_percentage(var2);
     const int normallimit = Settings::require_percentage(var3);
 
-    GridForecaster forecaster;
+    CachedGridForecaster forecaster;
 
     WeatherResult frost = forecaster.analyze(
         itsVar + "::fake::mean", itsSources, Frost, Mean, Maximum, itsArea, itsPeriod);
@@ -6,6 +6,7 @@
 // ======================================================================
 
 #include "AreaTools.h"
+#include "CachedGridForecaster.h"
 #include "ComparativeAcceptor.h"
 #include "Delimiter.h"
 #include "FrostStory.h"
@@ -19,7 +20,6 @@
 #include "Sentence.h"
 #include "UnitFactory.h"
 #include "WeatherForecast.h"
-#include <calculator/GridForecaster.h>
 #include <calculator/HourPeriodGenerator.h>
 #include <calculator/MathTools.h>
 #include <calculator/RangeAcceptor.h>
@@ -698,7 +698,7 @@ Paragraph FrostStory::onenight() const
     return paragraph;
   }
 
-  GridForecaster forecaster;
+  CachedGridForecaster forecaster;
 
   const int starthour = Settings::require_hour(itsVar + "::night::starthour");
   const int endhour = Settings::require_hour(itsVar + "::night::endhour");
@@ -5,6 +5,7 @@
  */
 // ======================================================================
 
+#include "CachedGridForecaster.h"
 #include "FrostStory.h"
 #include "FrostStoryTools.h"
 #include "MessageLogger.h"
@@ -12,7 +13,6 @@
 #include "PositiveRange.h"
 #include "Sentence.h"
 #include "UnitFactory.h"
-#include <calculator/GridForecaster.h>
 #include <calculator/MathTools.h>
 #include <calculator/Settings.h>
 #include <calculator/WeatherResult.h>
@@ -60,7 +60,7 @@ Paragraph FrostStory::range() const
 
     const string rangeseparator = Settings::optional_string(itsVar + "::rangeseparator", "-");
 
-    GridForecaster forecaster;
+    CachedGridForecaster forecaster;
 
     WeatherResult maxfrost = forecaster.analyze(
         itsVar + "::fake::maximum", itsSources, Frost, Maximum, Maximum, itsArea, itsPeriod);
@@ -5,6 +5,7 @@
  */
 // ======================================================================
 
+#include "CachedGridForecaster.h"
 #include "Delimiter.h"
 #include "FrostStory.h"
 #include "FrostStoryTools.h"
@@ -13,7 +14,6 @@
 #include "Paragraph.h"
 #include "Sentence.h"
 #include "UnitFactory.h"
-#include <calculator/GridForecaster.h>
 #include <calculator/MathTools.h>
 #include <calculator/Settings.h>
 #include <calculator/WeatherPeriodTools.h>
@@ -141,7 +141,7 @@ Paragraph FrostStory::twonights() const
 
     // Calculate frost probability
 
-    GridForecaster forecaster;
+    CachedGridForecaster forecaster;
 
     WeatherPeriod night1 =
         WeatherPeriodTools::getPeriod(itsPeriod, 1, starthour, endhour, maxstarthour, minendhour);
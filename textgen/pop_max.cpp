@@ -5,6 +5,7 @@
  */
 // ======================================================================
 
+#include "CachedGridForecaster.h"
 #include "Delimiter.h"
 #include "Integer.h"
 #include "MessageLogger.h"
@@ -13,7 +14,6 @@
 #include "Sentence.h"
 #include "UnitFactory.h"
 #include <calculator/DefaultAcceptor.h>
-#include <calculator/GridForecaster.h>
 #include <calculator/MathTools.h>
 #include <calculator/Settings.h>
 #include <calculator/WeatherResult.h>
@@ -50,7 +50,7 @@ Paragraph PrecipitationStory::pop_max() const
     const int maximum = Settings::optional_percentage(itsVar + "::maximum", 100);
     const int precision = Settings::optional_percentage(itsVar + "::precision", 10);
 
-    GridForecaster forecaster;
+    CachedGridForecaster forecaster;
 
     WeatherResult maxresult = forecaster.analyze(itsVar + "::fake::max",
                                                  itsSources,
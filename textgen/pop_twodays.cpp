@@ -5,6 +5,7 @@
  */
 // ======================================================================
 
+#include "CachedGridForecaster.h"
 #include "Delimiter.h"
 #include "Integer.h"
 #include "MessageLogger.h"
@@ -14,7 +15,6 @@
 #include "Sentence.h"
 #include "UnitFactory.h"
 #include <calculator/DefaultAcceptor.h>
-#include <calculator/GridForecaster.h>
 #include <calculator/HourPeriodGenerator.h>
 #include <calculator/MathTools.h>
 #include <calculator/NullPeriodGenerator.h>
@@ -75,7 +75,7 @@ Paragraph PrecipitationStory::pop_twodays() const
 
     WeatherPeriod firstperiod = generator.period(1);
 
-    GridForecaster forecaster;
+    CachedGridForecaster forecaster;
 
     WeatherResult result = forecaster.analyze(itsVar + "::fake::day1::maximum",
                                               itsSources,
@@ -5,6 +5,7 @@
  */
 // ======================================================================
 
+#include "CachedGridForecaster.h"
 #include "Delimiter.h"
 #include "MessageLogger.h"
 #include "Paragraph.h"
@@ -12,7 +13,6 @@
 #include "PrecipitationStory.h"
 #include "Sentence.h"
 #include "UnitFactory.h"
-#include <calculator/GridForecaster.h>
 #include <calculator/RangeAcceptor.h>
 #include <calculator/Settings.h>
 #include <calculator/WeatherResult.h>
@@ -156,7 +156,7 @@ Paragraph PrecipitationStory::classification() const
     Paragraph paragraph;
     Sentence sentence;
 
-    GridForecaster forecaster;
+    CachedGridForecaster forecaster;
 
     RangeAcceptor rainlimits;
     rainlimits.lowerLimit(Settings::optional_double(itsVar + "::minrain", 0));
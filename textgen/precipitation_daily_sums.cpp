@@ -5,6 +5,7 @@
  */
 // ======================================================================
 
+#include "CachedGridForecaster.h"
 #include "Delimiter.h"
 #include "Integer.h"
 #include "MessageLogger.h"
@@ -14,7 +15,6 @@
 #include "PrecipitationStoryTools.h"
 #include "Sentence.h"
 #include "UnitFactory.h"
-#include <calculator/GridForecaster.h>
 #include <calculator/HourPeriodGenerator.h>
 #include <calculator/RangeAcceptor.h>
 #include <calculator/Settings.h>
@@ -53,7 +53,7 @@ Paragraph PrecipitationStory::daily_sums() const
 
     Paragraph paragraph;
 
-    GridForecaster forecaster;
+    CachedGridForecaster forecaster;
 
     // All the days
 
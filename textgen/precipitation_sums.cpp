@@ -5,6 +5,7 @@
  */
 // ======================================================================
 
+#include "CachedGridForecaster.h"
 #include "Delimiter.h"
 #include "MessageLogger.h"
 #include "Paragraph.h"
@@ -12,7 +13,6 @@
 #include "PrecipitationStoryTools.h"
 #include "Sentence.h"
 #include "UnitFactory.h"
-#include <calculator/GridForecaster.h>
 #include <calculator/RangeAcceptor.h>
 #include <calculator/Settings.h>
 #include <calculator/TimeTools.h>
@@ -49,7 +49,7 @@ Paragraph PrecipitationStory::sums() const
 
     Paragraph paragraph;
 
-    GridForecaster forecaster;
+    CachedGridForecaster forecaster;
 
     const TextGenPosixTime time1 = itsPeriod.localStartTime();
     const TextGenPosixTime time2 = TimeTools::addHours(time1, 12);
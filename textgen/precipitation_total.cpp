@@ -5,13 +5,13 @@
  */
 // ======================================================================
 
+#include "CachedGridForecaster.h"
 #include "Integer.h"
 #include "MessageLogger.h"
 #include "Paragraph.h"
 #include "PrecipitationStory.h"
 #include "Sentence.h"
 #include "UnitFactory.h"
-#include <calculator/GridForecaster.h>
 #include <calculator/RangeAcceptor.h>
 #include <calculator/Settings.h>
 #include <calculator/WeatherResult.h>
@@ -42,7 +42,7 @@ Paragraph PrecipitationStory::total() const
     Paragraph paragraph;
     Sentence sentence;
 
-    GridForecaster forecaster;
+    CachedGridForecaster forecaster;
 
     RangeAcceptor rainlimits;
     rainlimits.lowerLimit(Settings::optional_double(itsVar + "::minrain", 0));
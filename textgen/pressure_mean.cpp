@@ -5,13 +5,13 @@
  */
 // ======================================================================
 
+#include "CachedGridForecaster.h"
 #include "Integer.h"
 #include "MessageLogger.h"
 #include "Paragraph.h"
 #include "PressureStory.h"
 #include "Sentence.h"
 #include "UnitFactory.h"
-#include <calculator/GridForecaster.h>
 #include <calculator/Settings.h>
 #include <calculator/WeatherResult.h>
 #include <calculator/WeatherResultTools.h>
@@ -43,7 +43,7 @@ Paragraph PressureStory::mean() const
     Paragraph paragraph;
     Sentence sentence;
 
-    GridForecaster forecaster;
+    CachedGridForecaster forecaster;
 
     WeatherResult meanresult = forecaster.analyze(
         itsVar + "::fake::mean", itsSources, Pressure, Mean, Mean, itsArea, itsPeriod);
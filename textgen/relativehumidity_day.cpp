@@ -5,6 +5,7 @@
  */
 // ======================================================================
 
+#include "CachedGridForecaster.h"
 #include "RelativeHumidityStory.h"
 
 #include "Delimiter.h"
@@ -15,7 +16,6 @@
 #include "Sentence.h"
 #include "UnitFactory.h"
 #include <calculator/DefaultAcceptor.h>
-#include <calculator/GridForecaster.h>
 #include <calculator/HourPeriodGenerator.h>
 #include <calculator/MathTools.h>
 #include <calculator/Settings.h>
@@ -71,7 +71,7 @@ Paragraph RelativeHumidityStory::day() const
     const int precision = Settings::optional_percentage(itsVar + "::precision", 10);
     const int coastlimit = Settings::optional_percentage(itsVar + "::coast_limit", 30);
 
-    GridForecaster forecaster;
+    CachedGridForecaster forecaster;
 
     // Result for the area
 
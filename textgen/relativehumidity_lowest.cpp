@@ -5,6 +5,7 @@
  */
 // ======================================================================
 
+#include "CachedGridForecaster.h"
 #include "Delimiter.h"
 #include "Integer.h"
 #include "MessageLogger.h"
@@ -14,7 +15,6 @@
 #include "Sentence.h"
 #include "UnitFactory.h"
 #include <calculator/DefaultAcceptor.h>
-#include <calculator/GridForecaster.h>
 #include <calculator/MathTools.h>
 #include <calculator/NullPeriodGenerator.h>
 #include <calculator/Settings.h>
@@ -74,7 +74,7 @@ Paragraph RelativeHumidityStory::lowest() const
     WeatherPeriod firstperiod =
         WeatherPeriodTools::getPeriod(itsPeriod, 1, starthour, endhour, maxstarthour, minendhour);
 
-    GridForecaster forecaster;
+    CachedGridForecaster forecaster;
 
     WeatherResult result = forecaster.analyze(itsVar + "::fake::day1::minimum",
                                               itsSources,
@@ -5,6 +5,7 @@
  */
 // ======================================================================
 
+#include "CachedGridForecaster.h"
 #include "Integer.h"
 #include "MessageLogger.h"
 #include "Paragraph.h"
@@ -12,7 +13,6 @@
 #include "RelativeHumidityStory.h"
 #include "Sentence.h"
 #include "UnitFactory.h"
-#include <calculator/GridForecaster.h>
 #include <calculator/MathTools.h>
 #include <calculator/Settings.h>
 #include <calculator/WeatherResult.h>
@@ -48,7 +48,7 @@ Paragraph RelativeHumidityStory::range() const
     Paragraph paragraph;
     Sentence sentence;
 
-    GridForecaster forecaster;
+    CachedGridForecaster forecaster;
 
     WeatherResult minresult = forecaster.analyze(
         itsVar + "::fake::minimum", itsSources, RelativeHumidity, Mean, Minimum, itsArea, itsPeriod);
@@ -13,8 +13,7 @@
 #include "PeriodPhraseFactory.h"
 #include "RoadStory.h"
 #include "Sentence.h"
-#include "ValueAcceptor.h"
-#include <calculator/GridForecaster.h>
+#include "ShareTools.h"
 #include <calculator/Settings.h>
 #include <calculator/TimeTools.h>
 #include <calculator/WeatherResult.h>
@@ -151,9 +150,8 @@ class ConditionPercentages
 /*!
  * \brief Calculate road condition percentages for given period
  *
- * \todo Optimize the integration loop so that you first calculate
- *       the minimum and maximum road condition, or possibly just
- *       the maximum, and then loop over those values only.
+ * The percentages of all conditions are calculated in a single pass
+ * over the area and the period.
  */
 // ----------------------------------------------------------------------
 
@@ -165,32 +163,23 @@ ConditionPercentages calculate_percentages(const WeatherPeriod& thePeriod,
 {
   try
   {
-    GridForecaster forecaster;
-
-    ConditionPercentages percentages;
+    vector<string> fakes;
+    vector<float> categories;
     for (int i = min_condition; i <= max_condition; i++)
     {
       const auto c = RoadConditionType(i);
+      fakes.push_back(theVar + "::fake::period" + std::to_string(thePeriodIndex) +
+                      "::" + condition_name(c) + "::percentage");
+      categories.push_back(c);
+    }
 
-      const string fake = (theVar + "::fake::period" + std::to_string(thePeriodIndex) +
-                           "::" + condition_name(c) + "::percentage");
-
-      ValueAcceptor condfilter;
-      condfilter.value(c);
-
-      WeatherResult result = forecaster.analyze(fake,
-                                                theSources,
-                                                RoadCondition,
-                                                Mean,
-                                                Percentage,
-                                                theArea,
-                                                thePeriod,
-                                                DefaultAcceptor(),
-                                                DefaultAcceptor(),
-                                                condfilter);
+    vector<WeatherResult> results;
+    ShareTools::categories(
+        fakes, theSources, RoadCondition, theArea, thePeriod, categories, results);
 
-      percentages[c] = result.value();
-    }
+    ConditionPercentages percentages;
+    for (int i = min_condition; i <= max_condition; i++)
+      percentages[i] = results[i - min_condition].value();
 
     return percentages;
   }
@@ -5,6 +5,7 @@
  */
 // ======================================================================
 
+#include "CachedGridForecaster.h"
 #include "DebugTextFormatter.h"
 #include "Delimiter.h"
 #include "MessageLogger.h"
@@ -13,7 +14,6 @@
 #include "RoadStory.h"
 #include "Sentence.h"
 #include "ValueAcceptor.h"
-#include <calculator/GridForecaster.h>
 #include <calculator/HourPeriodGenerator.h>
 #include <calculator/Settings.h>
 #include <calculator/TimeTools.h>
@@ -165,7 +165,7 @@ ConditionPercentages calculate_percentages(const WeatherPeriod& thePeriod,
 {
   try
   {
-    GridForecaster forecaster;
+    CachedGridForecaster forecaster;
 
     ConditionPercentages percentages;
     for (int i = min_condition; i <= max_condition; i++)
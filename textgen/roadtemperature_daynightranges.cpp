@@ -5,6 +5,7 @@
  */
 // ======================================================================
 
+#include "CachedGridForecaster.h"
 #include "Delimiter.h"
 #include "MessageLogger.h"
 #include "NightAndDayPeriodGenerator.h"
@@ -13,7 +14,6 @@
 #include "RoadStory.h"
 #include "Sentence.h"
 #include "TemperatureStoryTools.h"
-#include <calculator/GridForecaster.h>
 #include <calculator/Settings.h>
 #include <calculator/WeatherResult.h>
 #include <macgyver/Exception.h>
@@ -52,7 +52,7 @@ Paragraph RoadStory::daynightranges() const
 
     NightAndDayPeriodGenerator generator(itsPeriod, itsVar);
 
-    GridForecaster forecaster;
+    CachedGridForecaster forecaster;
 
     Sentence sentence;
 
@@ -5,6 +5,7 @@
  */
 // ======================================================================
 
+#include "CachedGridForecaster.h"
 #include "Delimiter.h"
 #include "MessageLogger.h"
 #include "Paragraph.h"
@@ -12,7 +13,6 @@
 #include "RoadStory.h"
 #include "Sentence.h"
 #include "TemperatureStoryTools.h"
-#include <calculator/GridForecaster.h>
 #include <calculator/HourPeriodGenerator.h>
 #include <calculator/Settings.h>
 #include <calculator/WeatherResult.h>
@@ -52,7 +52,7 @@ Paragraph RoadStory::shortrange() const
 
     HourPeriodGenerator generator(itsPeriod, itsVar);
 
-    GridForecaster forecaster;
+    CachedGridForecaster forecaster;
 
     Sentence sentence;
 
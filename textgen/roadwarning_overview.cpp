@@ -13,8 +13,7 @@
 #include "PeriodPhraseFactory.h"
 #include "RoadStory.h"
 #include "Sentence.h"
-#include "ValueAcceptor.h"
-#include <calculator/GridForecaster.h>
+#include "ShareTools.h"
 #include <calculator/Settings.h>
 #include <calculator/TimeTools.h>
 #include <calculator/WeatherResult.h>
@@ -171,9 +170,8 @@ class WarningPercentages
 /*!
  * \brief Calculate road warning percentages for given period
  *
- * \todo Optimize the integration loop so that you first calculate
- *       the minimum and maximum road warning, or possibly just
- *       the maximum, and then loop over those values only.
+ * The percentages of all warnings are calculated in a single pass
+ * over the area and the period.
  */
 // ----------------------------------------------------------------------
 
@@ -185,32 +183,22 @@ WarningPercentages calculate_percentages(const WeatherPeriod& thePeriod,
 {
   try
   {
-    GridForecaster forecaster;
-
-    WarningPercentages percentages;
+    vector<string> fakes;
+    vector<float> categories;
     for (int i = min_warning; i <= max_warning; i++)
     {
       const auto c = RoadWarningType(i);
+      fakes.push_back(theVar + "::fake::period" + std::to_string(thePeriodIndex) +
+                      "::" + warning_name(c) + "::percentage");
+      categories.push_back(c);
+    }
 
-      const string fake = (theVar + "::fake::period" + std::to_string(thePeriodIndex) +
-                           "::" + warning_name(c) + "::percentage");
-
-      ValueAcceptor warnfilter;
-      warnfilter.value(c);
-
-      WeatherResult result = forecaster.analyze(fake,
-                                                theSources,
-                                                RoadWarning,
-                                                Mean,
-                                                Percentage,
-                                                theArea,
-                                                thePeriod,
-                                                DefaultAcceptor(),
-                                                DefaultAcceptor(),
-                                                warnfilter);
+    vector<WeatherResult> results;
+    ShareTools::categories(fakes, theSources, RoadWarning, theArea, thePeriod, categories, results);
 
-      percentages[c] = result.value();
-    }
+    WarningPercentages percentages;
+    for (int i = min_warning; i <= max_warning; i++)
+      percentages[i] = results[i - min_warning].value();
 
     return percentages;
   }
@@ -5,6 +5,7 @@
  */
 // ======================================================================
 
+#include "CachedGridForecaster.h"
 #include "DebugTextFormatter.h"
 #include "Delimiter.h"
 #include "MessageLogger.h"
@@ -13,7 +14,6 @@
 #include "RoadStory.h"
 #include "Sentence.h"
 #include "ValueAcceptor.h"
-#include <calculator/GridForecaster.h>
 #include <calculator/HourPeriodGenerator.h>
 #include <calculator/Settings.h>
 #include <calculator/TimeTools.h>
@@ -186,7 +186,7 @@ WarningPercentages calculate_percentages(const WeatherPeriod& thePeriod,
 {
   try
   {
-    GridForecaster forecaster;
+    CachedGridForecaster forecaster;
 
     WarningPercentages percentages;
     for (int i = min_warning; i <= max_warning; i++)
@@ -5,6 +5,7 @@
  */
 // ======================================================================
 
+#include "CachedGridForecaster.h"
 #include "TemperatureStory.h"
 
 #include "ClimatologyTools.h"
@@ -21,7 +22,6 @@
 #include "TemperatureStoryTools.h"
 #include "UnitFactory.h"
 #include <calculator/DefaultAcceptor.h>
-#include <calculator/GridForecaster.h>
 #include <calculator/HourPeriodGenerator.h>
 #include <calculator/MathTools.h>
 #include <calculator/RangeAcceptor.h>
@@ -377,29 +377,17 @@ void log_daily_factiles_for_period(MessageLogger& theLog,
   {
     WeatherPeriod fractilePeriod(startTime, endTime);
 
-    WeatherResult fractile02Temperature = get_fractile_temperature(
-        theVariable, FRACTILE_02, theSources, theArea, fractilePeriod, theFractileType);
-    WeatherResult fractile12Temperature = get_fractile_temperature(
-        theVariable, FRACTILE_12, theSources, theArea, fractilePeriod, theFractileType);
-    WeatherResult fractile37Temperature = get_fractile_temperature(
-        theVariable, FRACTILE_37, theSources, theArea, fractilePeriod, theFractileType);
-    WeatherResult fractile50Temperature = get_fractile_temperature(
-        theVariable, FRACTILE_50, theSources, theArea, fractilePeriod, theFractileType);
-    WeatherResult fractile63Temperature = get_fractile_temperature(
-        theVariable, FRACTILE_63, theSources, theArea, fractilePeriod, theFractileType);
-    WeatherResult fractile88Temperature = get_fractile_temperature(
-        theVariable, FRACTILE_88, theSources, theArea, fractilePeriod, theFractileType);
-    WeatherResult fractile98Temperature = get_fractile_temperature(
-        theVariable, FRACTILE_98, theSources, theArea, fractilePeriod, theFractileType);
+    const std::map<fractile_id, WeatherResult> fractiles = get_fractile_temperatures(
+        theVariable, theSources, theArea, fractilePeriod, theFractileType);
 
     theLog << "date = " << startTime << "..." << endTime << '\n';
-    theLog << "F02 = " << fractile02Temperature << '\n';
-    theLog << "F12 = " << fractile12Temperature << '\n';
-    theLog << "F37 = " << fractile37Temperature << '\n';
-    theLog << "F50 = " << fractile50Temperature << '\n';
-    theLog << "F63 = " << fractile63Temperature << '\n';
-    theLog << "F88 = " << fractile88Temperature << '\n';
-    theLog << "F98 = " << fractile98Temperature << '\n';
+    theLog << "F02 = " << fractiles.at(FRACTILE_02) << '\n';
+    theLog << "F12 = " << fractiles.at(FRACTILE_12) << '\n';
+    theLog << "F37 = " << fractiles.at(FRACTILE_37) << '\n';
+    theLog << "F50 = " << fractiles.at(FRACTILE_50) << '\n';
+    theLog << "F63 = " << fractiles.at(FRACTILE_63) << '\n';
+    theLog << "F88 = " << fractiles.at(FRACTILE_88) << '\n';
+    theLog << "F98 = " << fractiles.at(FRACTILE_98) << '\n';
 
     startTime.ChangeByDays(1);
     endTime.ChangeByDays(1);
@@ -1483,19 +1471,20 @@ Paragraph anomaly(const TextGen::WeatherArea& itsArea,
     return paragraph;
   }
 
-  WeatherResult fractile02Temperature = get_fractile_temperature(
-      itsVar, FRACTILE_02, itsSources, itsArea, fractileTemperaturePeriod, fractileType);
+  const std::map<fractile_id, WeatherResult> fractiles =
+      get_fractile_temperatures(itsVar,
+                                {FRACTILE_02, FRACTILE_12, FRACTILE_88, FRACTILE_98},
+                                itsSources,
+                                itsArea,
+                                fractileTemperaturePeriod,
+                                fractileType);
 
-  WeatherResult fractile12Temperature = get_fractile_temperature(
-      itsVar, FRACTILE_12, itsSources, itsArea, fractileTemperaturePeriod, fractileType);
+  const WeatherResult& fractile02Temperature = fractiles.at(FRACTILE_02);
+  const WeatherResult& fractile12Temperature = fractiles.at(FRACTILE_12);
+  const WeatherResult& fractile88Temperature = fractiles.at(FRACTILE_88);
+  const WeatherResult& fractile98Temperature = fractiles.at(FRACTILE_98);
 
-  WeatherResult fractile88Temperature = get_fractile_temperature(
-      itsVar, FRACTILE_88, itsSources, itsArea, fractileTemperaturePeriod, fractileType);
-
-  WeatherResult fractile98Temperature = get_fractile_temperature(
-      itsVar, FRACTILE_98, itsSources, itsArea, fractileTemperaturePeriod, fractileType);
-
-  GridForecaster theForecaster;
+  CachedGridForecaster theForecaster;
   RangeAcceptor upperLimitF02Acceptor;
   upperLimitF02Acceptor.upperLimit(fractile02Temperature.value());
   RangeAcceptor upperLimitF12Acceptor;
@@ -5,6 +5,7 @@
  */
 // ======================================================================
 
+#include "CachedGridForecaster.h"
 #include "TemperatureStory.h"
 
 #include "Delimiter.h"
@@ -17,7 +18,6 @@
 #include "TemperatureStoryTools.h"
 #include "UnitFactory.h"
 #include <calculator/DefaultAcceptor.h>
-#include <calculator/GridForecaster.h>
 #include <calculator/MathTools.h>
 #include <calculator/Settings.h>
 #include <calculator/WeatherPeriodTools.h>
@@ -304,7 +304,7 @@ Paragraph TemperatureStory::day() const
 
     // Calculate the results
 
-    GridForecaster forecaster;
+    CachedGridForecaster forecaster;
 
     unsigned int periodnum = 1;
     unsigned int part = 0;
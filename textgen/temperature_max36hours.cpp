@@ -20,6 +20,7 @@
 #include "SeasonTools.h"
 #include "Sentence.h"
 #include "SouthernMaskSource.h"
+#include "StatisticsTools.h"
 #include "TemperatureStory.h"
 #include "TemperatureStoryTools.h"
 #include "UnitFactory.h"
@@ -27,7 +28,6 @@
 #include "WeekdayTools.h"
 #include <boost/lexical_cast.hpp>
 #include <calculator/DefaultAcceptor.h>
-#include <calculator/GridForecaster.h>
 #include <calculator/HourPeriodGenerator.h>
 #include <calculator/MathTools.h>
 #include <calculator/Settings.h>
@@ -1004,26 +1004,6 @@ proximity_id get_proximity_id(float theMinimum,
   }
 }
 
-WeatherResult do_calculation(const string& theVar,
-                             const AnalysisSources& theSources,
-                             const WeatherFunction& theAreaFunction,
-                             const WeatherFunction& theTimeFunction,
-                             const WeatherArea& theArea,
-                             const WeatherPeriod& thePeriod)
-{
-  try
-  {
-    GridForecaster theForecaster;
-
-    return theForecaster.analyze(
-        theVar, theSources, Temperature, theAreaFunction, theTimeFunction, theArea, thePeriod);
-  }
-  catch (...)
-  {
-    throw Fmi::Exception::Trace(BCP, "Operation failed");
-  }
-}
-
 // Lookup tables for weather result IDs per (period, area) combination
 struct period_area_ids
 {
@@ -1123,24 +1103,21 @@ void calculate_night_period(const string& theVar,
 {
   try
   {
-    minResultFull = do_calculation(theVar + fakeVarFull + "::min",
-                                   theSources,
-                                   Minimum,
-                                   timeFunction,
-                                   theActualArea,
-                                   thePeriod);
-    maxResultFull = do_calculation(theVar + fakeVarFull + "::max",
-                                   theSources,
-                                   Maximum,
-                                   timeFunction,
-                                   theActualArea,
-                                   thePeriod);
-    meanResultFull = do_calculation(theVar + fakeVarFull + "::mean",
-                                    theSources,
-                                    Mean,
-                                    timeFunction,
-                                    theActualArea,
-                                    thePeriod);
+    vector<WeatherResult> results;
+    StatisticsTools::analyze({theVar + fakeVarFull + "::min",
+                              theVar + fakeVarFull + "::max",
+                              theVar + fakeVarFull + "::mean"},
+                             theSources,
+                             Temperature,
+                             {Minimum, Maximum, Mean},
+                             timeFunction,
+                             theActualArea,
+                             thePeriod,
+                             results);
+
+    minResultFull = results[0];
+    maxResultFull = results[1];
+    meanResultFull = results[2];
 
     if (theActualArea.type() == WeatherArea::Full)
       WeatherResultTools::checkMissingValue(
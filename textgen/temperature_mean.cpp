@@ -5,13 +5,13 @@
  */
 // ======================================================================
 
+#include "CachedGridForecaster.h"
 #include "Integer.h"
 #include "MessageLogger.h"
 #include "Paragraph.h"
 #include "Sentence.h"
 #include "TemperatureStory.h"
 #include "UnitFactory.h"
-#include <calculator/GridForecaster.h>
 #include <calculator/WeatherResult.h>
 #include <calculator/WeatherResultTools.h>
 #include <macgyver/Exception.h>
@@ -42,7 +42,7 @@ Paragraph TemperatureStory::mean() const
     Paragraph paragraph;
     Sentence sentence;
 
-    GridForecaster forecaster;
+    CachedGridForecaster forecaster;
 
     WeatherResult result = forecaster.analyze(
         itsVar + "::fake::mean", itsSources, Temperature, Mean, Mean, itsArea, itsPeriod);
@@ -5,6 +5,7 @@
  */
 // ======================================================================
 
+#include "CachedGridForecaster.h"
 #include "Delimiter.h"
 #include "MessageLogger.h"
 #include "Paragraph.h"
@@ -13,7 +14,6 @@
 #include "TemperatureStory.h"
 #include "TemperatureStoryTools.h"
 #include "WeekdayTools.h"
-#include <calculator/GridForecaster.h>
 #include <calculator/Settings.h>
 #include <calculator/WeatherPeriodTools.h>
 #include <calculator/WeatherResult.h>
@@ -69,7 +69,7 @@ Paragraph TemperatureStory::nightlymin() const
 
     WeatherPeriod period = getPeriod(itsPeriod, 1, starthour, endhour, maxstarthour, minendhour);
 
-    GridForecaster forecaster;
+    CachedGridForecaster forecaster;
 
     WeatherResult minresult = forecaster.analyze(itsVar + "::fake::night1::minimum",
                                                  itsSources,
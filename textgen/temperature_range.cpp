@@ -5,13 +5,13 @@
  */
 // ======================================================================
 
+#include "CachedGridForecaster.h"
 #include "Integer.h"
 #include "MessageLogger.h"
 #include "Paragraph.h"
 #include "Sentence.h"
 #include "TemperatureStory.h"
 #include "TemperatureStoryTools.h"
-#include <calculator/GridForecaster.h>
 #include <calculator/Settings.h>
 #include <calculator/WeatherResult.h>
 #include <calculator/WeatherResultTools.h>
@@ -47,7 +47,7 @@ Paragraph TemperatureStory::range() const
     Paragraph paragraph;
     Sentence sentence;
 
-    GridForecaster forecaster;
+    CachedGridForecaster forecaster;
 
     WeatherResult minresult = forecaster.analyze(
         itsVar + "::fake::minimum", itsSources, Temperature, Mean, Minimum, itsArea, itsPeriod);
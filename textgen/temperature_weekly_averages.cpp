@@ -5,13 +5,13 @@
  */
 // ======================================================================
 
+#include "CachedGridForecaster.h"
 #include "Delimiter.h"
 #include "MessageLogger.h"
 #include "Paragraph.h"
 #include "Sentence.h"
 #include "TemperatureStory.h"
 #include "TemperatureStoryTools.h"
-#include <calculator/GridForecaster.h>
 #include <calculator/HourPeriodGenerator.h>
 #include <calculator/Settings.h>
 #include <calculator/WeatherResult.h>
@@ -55,7 +55,7 @@ Paragraph TemperatureStory::weekly_averages() const
     const HourPeriodGenerator days(itsPeriod, itsVar + "::day");
     const HourPeriodGenerator nights(itsPeriod, itsVar + "::night");
 
-    GridForecaster forecaster;
+    CachedGridForecaster forecaster;
 
     const WeatherResult dayminresult = forecaster.analyze(itsVar + "::fake::day::minimum",
                                                           itsSources,
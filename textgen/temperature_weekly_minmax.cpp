@@ -5,6 +5,7 @@
  */
 // ======================================================================
 
+#include "CachedGridForecaster.h"
 #include "Delimiter.h"
 #include "Integer.h"
 #include "MessageLogger.h"
@@ -13,7 +14,6 @@
 #include "TemperatureStory.h"
 #include "TemperatureStoryTools.h"
 #include "UnitFactory.h"
-#include <calculator/GridForecaster.h>
 #include <calculator/HourPeriodGenerator.h>
 #include <calculator/Settings.h>
 #include <calculator/WeatherResult.h>
@@ -57,7 +57,7 @@ Paragraph TemperatureStory::weekly_minmax() const
     const HourPeriodGenerator days(itsPeriod, itsVar + "::day");
     const HourPeriodGenerator nights(itsPeriod, itsVar + "::night");
 
-    GridForecaster forecaster;
+    CachedGridForecaster forecaster;
 
     const WeatherResult dayminresult = forecaster.analyze(itsVar + "::fake::day::minimum",
                                                           itsSources,
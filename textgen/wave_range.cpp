@@ -5,6 +5,7 @@
  */
 // ======================================================================
 
+#include "CachedGridForecaster.h"
 #include "Delimiter.h"
 #include "MessageLogger.h"
 #include "Paragraph.h"
@@ -13,7 +14,6 @@
 #include "Sentence.h"
 #include "UnitFactory.h"
 #include "WaveStory.h"
-#include <calculator/GridForecaster.h>
 #include <calculator/MathTools.h>
 #include <calculator/Settings.h>
 #include <calculator/WeatherResult.h>
@@ -52,7 +52,7 @@ Paragraph WaveStory::range() const
 
     Paragraph paragraph;
 
-    GridForecaster forecaster;
+    CachedGridForecaster forecaster;
 
     // Calculate wave speeds
 
@@ -6,6 +6,7 @@
 // ======================================================================
 
 #include "AreaTools.h"
+#include "CachedGridForecaster.h"
 #include "CloudinessForecast.h"
 #include "CloudinessStory.h"
 #include "CloudinessStoryTools.h"
@@ -17,6 +18,7 @@
 #include "MessageLogger.h"
 #include "NightAndDayPeriodGenerator.h"
 #include "Paragraph.h"
+#include "ParallelTools.h"
 #include "PeriodPhraseFactory.h"
 #include "Phrase.h"
 #include "PlainTextFormatter.h"
@@ -25,6 +27,8 @@
 #include "PrecipitationStoryTools.h"
 #include "SeasonTools.h"
 #include "Sentence.h"
+#include "ShareTools.h"
+#include "StatisticsTools.h"
 #include "SubMaskExtractor.h"
 #include "ThunderForecast.h"
 #include "ValueAcceptor.h"
@@ -32,7 +36,6 @@
 #include "WeatherForecastStory.h"
 #include "WeatherStory.h"
 #include "WeekdayTools.h"
-#include <calculator/GridForecaster.h>
 #include <calculator/HourPeriodGenerator.h>
 #include <calculator/MathTools.h>
 #include <calculator/NullPeriodGenerator.h>
@@ -51,6 +54,7 @@
 
 #include <boost/lexical_cast.hpp>
 #include <map>
+#include <memory>
 #include <typeinfo>
 #include <vector>
 
@@ -280,88 +284,134 @@ void log_subperiods(wf_story_params& theParameters)
 }
 #endif
 
+// ----------------------------------------------------------------------
+/*!
+ * \brief Return the periods of an hourly time series
+ */
+// ----------------------------------------------------------------------
+
+vector<WeatherPeriod> hourly_periods(const weather_result_data_item_vector& theHourlyData)
+{
+  vector<WeatherPeriod> periods;
+  periods.reserve(theHourlyData.size());
+  for (const auto& item : theHourlyData)
+    periods.push_back(item->thePeriod);
+  return periods;
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Return the forecast areas of the story
+ *
+ * The areas are in the order inland, coastal and full area.
+ */
+// ----------------------------------------------------------------------
+
+vector<forecast_area_id> forecast_areas(const wf_story_params& theParameters)
+{
+  vector<forecast_area_id> areas;
+  for (auto id : {INLAND_AREA, COASTAL_AREA, FULL_AREA})
+    if (theParameters.theForecastArea & id)
+      areas.push_back(id);
+  return areas;
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Return the area types of the given forecast areas
+ */
+// ----------------------------------------------------------------------
+
+vector<WeatherArea::Type> forecast_area_types(const wf_story_params& theParameters,
+                                              const vector<forecast_area_id>& theAreas)
+{
+  vector<WeatherArea::Type> types;
+  for (auto id : theAreas)
+  {
+    if (id == INLAND_AREA)
+      types.push_back(WeatherArea::Inland);
+    else if (id == COASTAL_AREA)
+      types.push_back(WeatherArea::Coast);
+    else
+      types.push_back(theParameters.theArea.type());
+  }
+  return types;
+}
+
+// ----------------------------------------------------------------------
+/*!
+ * \brief Return the area of the story with the given type
+ */
+// ----------------------------------------------------------------------
+
+WeatherArea forecast_area(const wf_story_params& theParameters, WeatherArea::Type theType)
+{
+  WeatherArea area = theParameters.theArea;
+  area.type(theType);
+  return area;
+}
+
+//! Time series of the forecast areas, shared by the area tasks
+using area_series_type = vector<vector<vector<WeatherResult> > >;
+
 void populate_precipitation_time_series(const string& theVariable,
                                         const AnalysisSources& theSources,
                                         const WeatherArea& theArea,
-                                        weather_forecast_result_container& theHourlyDataContainer)
+                                        weather_forecast_result_container& theHourlyDataContainer,
+                                        const vector<vector<WeatherResult> >& theAmounts,
+                                        const vector<vector<WeatherResult> >& theExtents,
+                                        const vector<vector<WeatherResult> >& theTypes)
 {
   try
   {
-  GridForecaster theForecaster;
-
   std::shared_ptr<weather_result_data_item_vector> precipitationMaxHourly =
-      theHourlyDataContainer[PRECIPITATION_MAX_DATA];
+      theHourlyDataContainer.at(PRECIPITATION_MAX_DATA);
   std::shared_ptr<weather_result_data_item_vector> precipitationMeanHourly =
-      theHourlyDataContainer[PRECIPITATION_MEAN_DATA];
+      theHourlyDataContainer.at(PRECIPITATION_MEAN_DATA);
   std::shared_ptr<weather_result_data_item_vector> precipitationExtentHourly =
-      theHourlyDataContainer[PRECIPITATION_EXTENT_DATA];
+      theHourlyDataContainer.at(PRECIPITATION_EXTENT_DATA);
   std::shared_ptr<weather_result_data_item_vector> precipitationFormWaterHourly =
-      theHourlyDataContainer[PRECIPITATION_FORM_WATER_DATA];
+      theHourlyDataContainer.at(PRECIPITATION_FORM_WATER_DATA);
   std::shared_ptr<weather_result_data_item_vector> precipitationFormDrizzleHourly =
-      theHourlyDataContainer[PRECIPITATION_FORM_DRIZZLE_DATA];
+      theHourlyDataContainer.at(PRECIPITATION_FORM_DRIZZLE_DATA);
   std::shared_ptr<weather_result_data_item_vector> precipitationFormSleetHourly =
-      theHourlyDataContainer[PRECIPITATION_FORM_SLEET_DATA];
+      theHourlyDataContainer.at(PRECIPITATION_FORM_SLEET_DATA);
   std::shared_ptr<weather_result_data_item_vector> precipitationFormSnowHourly =
-      theHourlyDataContainer[PRECIPITATION_FORM_SNOW_DATA];
+      theHourlyDataContainer.at(PRECIPITATION_FORM_SNOW_DATA);
   std::shared_ptr<weather_result_data_item_vector> precipitationFormFreezingDrizzleHourly =
-      theHourlyDataContainer[PRECIPITATION_FORM_FREEZING_DRIZZLE_DATA];
+      theHourlyDataContainer.at(PRECIPITATION_FORM_FREEZING_DRIZZLE_DATA);
   std::shared_ptr<weather_result_data_item_vector> precipitationFormFreezingRainHourly =
-      theHourlyDataContainer[PRECIPITATION_FORM_FREEZING_RAIN_DATA];
+      theHourlyDataContainer.at(PRECIPITATION_FORM_FREEZING_RAIN_DATA);
   std::shared_ptr<weather_result_data_item_vector> precipitationTypeHourly =
-      theHourlyDataContainer[PRECIPITATION_TYPE_DATA];
+      theHourlyDataContainer.at(PRECIPITATION_TYPE_DATA);
   std::shared_ptr<weather_result_data_item_vector> precipitationShareNorthEastHourly =
-      theHourlyDataContainer[PRECIPITATION_NORTHEAST_SHARE_DATA];
+      theHourlyDataContainer.at(PRECIPITATION_NORTHEAST_SHARE_DATA);
   std::shared_ptr<weather_result_data_item_vector> precipitationShareSouthEastHourly =
-      theHourlyDataContainer[PRECIPITATION_SOUTHEAST_SHARE_DATA];
+      theHourlyDataContainer.at(PRECIPITATION_SOUTHEAST_SHARE_DATA);
   std::shared_ptr<weather_result_data_item_vector> precipitationShareSouthWestHourly =
-      theHourlyDataContainer[PRECIPITATION_SOUTHWEST_SHARE_DATA];
+      theHourlyDataContainer.at(PRECIPITATION_SOUTHWEST_SHARE_DATA);
   std::shared_ptr<weather_result_data_item_vector> precipitationShareNorthWestHourly =
-      theHourlyDataContainer[PRECIPITATION_NORTHWEST_SHARE_DATA];
+      theHourlyDataContainer.at(PRECIPITATION_NORTHWEST_SHARE_DATA);
   std::shared_ptr<weather_result_data_item_vector> precipitationPointHourly =
-      theHourlyDataContainer[PRECIPITATION_POINT_DATA];
+      theHourlyDataContainer.at(PRECIPITATION_POINT_DATA);
 
   RangeAcceptor precipitationlimits;
   precipitationlimits.lowerLimit(DRY_WEATHER_LIMIT_DRIZZLE);
-  ValueAcceptor waterfilter;
-  waterfilter.value(kTRain);  // 1 = water
   // RangeAcceptor percentagelimits;
   // percentagelimits.lowerLimit(maxprecipitationlimit);
-  ValueAcceptor drizzlefilter;
-  drizzlefilter.value(kTDrizzle);  // 0 = drizzle
-  ValueAcceptor sleetfilter;
-  sleetfilter.value(kTSleet);  // 2 = sleet
-  ValueAcceptor snowfilter;
-  snowfilter.value(kTSnow);  // 3 = snow
-  ValueAcceptor freezingdrizzlefilter;
-  freezingdrizzlefilter.value(kTFreezingDrizzle);  // 4 = freezing drizzle
-  ValueAcceptor freezingrainfilter;
-  freezingrainfilter.value(kTFreezingRain);  // 5 = freezing rain
-  ValueAcceptor showerfilter;
-  showerfilter.value(kTConvectivePrecipitation);  // 1=large scale, 2=showers
-
+  const vector<float> formCategories{
+      kTRain,             // 1 = water
+      kTDrizzle,          // 0 = drizzle
+      kTSleet,            // 2 = sleet
+      kTSnow,             // 3 = snow
+      kTFreezingDrizzle,  // 4 = freezing drizzle
+      kTFreezingRain      // 5 = freezing rain
+  };
+  const vector<string> formFakes(formCategories.size(), theVariable);
   for (unsigned int i = 0; i < precipitationMaxHourly->size(); i++)
   {
-    (*precipitationMaxHourly)[i]->theResult =
-        theForecaster.analyze(theVariable,
-                              theSources,
-                              Precipitation,
-                              Maximum,
-                              Sum,
-                              theArea,
-                              (*precipitationMaxHourly)[i]->thePeriod,
-                              DefaultAcceptor(),
-                              precipitationlimits);
-
-    (*precipitationMeanHourly)[i]->theResult =
-        theForecaster.analyze(theVariable,
-                              theSources,
-                              Precipitation,
-                              Mean,
-                              Sum,
-                              theArea,
-                              (*precipitationMeanHourly)[i]->thePeriod,
-                              DefaultAcceptor(),
-                              precipitationlimits);
+    (*precipitationMaxHourly)[i]->theResult = theAmounts[0][i];
+    (*precipitationMeanHourly)[i]->theResult = theAmounts[1][i];
 
     if (theArea.type() == WeatherArea::Full)
       WeatherResultTools::checkMissingValue(
@@ -369,112 +419,46 @@ void populate_precipitation_time_series(const string& theVariable,
           Precipitation,
           {(*precipitationMaxHourly)[i]->theResult, (*precipitationMeanHourly)[i]->theResult});
 
-    (*precipitationExtentHourly)[i]->theResult =
-        theForecaster.analyze(theVariable,
-                              theSources,
-                              Precipitation,
-                              Percentage,
-                              Sum,
-                              theArea,
-                              (*precipitationExtentHourly)[i]->thePeriod,
-                              DefaultAcceptor(),
-                              DefaultAcceptor(),
-                              precipitationlimits);
-
-    (*precipitationFormWaterHourly)[i]->theResult =
-        theForecaster.analyze(theVariable,
-                              theSources,
-                              PrecipitationForm,
-                              Mean,
-                              Percentage,
-                              theArea,
-                              (*precipitationMaxHourly)[i]->thePeriod,
-                              DefaultAcceptor(),
-                              DefaultAcceptor(),
-                              waterfilter);
-
-    (*precipitationFormDrizzleHourly)[i]->theResult =
-        theForecaster.analyze(theVariable,
-                              theSources,
-                              PrecipitationForm,
-                              Mean,
-                              Percentage,
-                              theArea,
-                              (*precipitationMaxHourly)[i]->thePeriod,
-                              DefaultAcceptor(),
-                              DefaultAcceptor(),
-                              drizzlefilter);
-
-    (*precipitationFormSleetHourly)[i]->theResult =
-        theForecaster.analyze(theVariable,
-                              theSources,
-                              PrecipitationForm,
-                              Mean,
-                              Percentage,
-                              theArea,
-                              (*precipitationMaxHourly)[i]->thePeriod,
-                              DefaultAcceptor(),
-                              DefaultAcceptor(),
-                              sleetfilter);
+    (*precipitationExtentHourly)[i]->theResult = theExtents[0][i];
 
-    (*precipitationFormSnowHourly)[i]->theResult =
-        theForecaster.analyze(theVariable,
-                              theSources,
-                              PrecipitationForm,
-                              Mean,
-                              Percentage,
-                              theArea,
-                              (*precipitationMaxHourly)[i]->thePeriod,
-                              DefaultAcceptor(),
-                              DefaultAcceptor(),
-                              snowfilter);
+    // All precipitation forms are calculated in a single pass
 
-    (*precipitationFormFreezingDrizzleHourly)[i]->theResult =
-        theForecaster.analyze(theVariable,
-                              theSources,
-                              PrecipitationForm,
-                              Mean,
-                              Percentage,
-                              theArea,
-                              (*precipitationMaxHourly)[i]->thePeriod,
-                              DefaultAcceptor(),
-                              DefaultAcceptor(),
-                              freezingdrizzlefilter);
+    vector<WeatherResult> formShares;
+    ShareTools::categories(formFakes,
+                           theSources,
+                           PrecipitationForm,
+                           theArea,
+                           (*precipitationMaxHourly)[i]->thePeriod,
+                           formCategories,
+                           formShares);
 
-    (*precipitationFormFreezingRainHourly)[i]->theResult =
-        theForecaster.analyze(theVariable,
-                              theSources,
-                              PrecipitationForm,
-                              Mean,
-                              Percentage,
-                              theArea,
-                              (*precipitationMaxHourly)[i]->thePeriod,
-                              DefaultAcceptor(),
-                              DefaultAcceptor(),
-                              freezingrainfilter);
+    (*precipitationFormWaterHourly)[i]->theResult = formShares[0];
+    (*precipitationFormDrizzleHourly)[i]->theResult = formShares[1];
+    (*precipitationFormSleetHourly)[i]->theResult = formShares[2];
+    (*precipitationFormSnowHourly)[i]->theResult = formShares[3];
+    (*precipitationFormFreezingDrizzleHourly)[i]->theResult = formShares[4];
+    (*precipitationFormFreezingRainHourly)[i]->theResult = formShares[5];
 
-    (*precipitationTypeHourly)[i]->theResult =
-        theForecaster.analyze(theVariable,
-                              theSources,
-                              PrecipitationType,
-                              Mean,
-                              Percentage,
-                              theArea,
-                              (*precipitationMaxHourly)[i]->thePeriod,
-                              DefaultAcceptor(),
-                              DefaultAcceptor(),
-                              showerfilter);
+    (*precipitationTypeHourly)[i]->theResult = theTypes[0][i];
 
+    WeatherResult northEast = (*precipitationShareNorthEastHourly)[i]->theResult;
+    WeatherResult southEast = (*precipitationShareSouthEastHourly)[i]->theResult;
+    WeatherResult southWest = (*precipitationShareSouthWestHourly)[i]->theResult;
+    WeatherResult northWest = (*precipitationShareNorthWestHourly)[i]->theResult;
     NFmiPoint precipitationPoint =
         AreaTools::getArealDistribution(theSources,
                                         Precipitation,
                                         theArea,
                                         (*precipitationShareNorthEastHourly)[i]->thePeriod,
                                         precipitationlimits,
-                                        (*precipitationShareNorthEastHourly)[i]->theResult,
-                                        (*precipitationShareSouthEastHourly)[i]->theResult,
-                                        (*precipitationShareSouthWestHourly)[i]->theResult,
-                                        (*precipitationShareNorthWestHourly)[i]->theResult);
+                                        northEast,
+                                        southEast,
+                                        southWest,
+                                        northWest);
+    (*precipitationShareNorthEastHourly)[i]->theResult = northEast;
+    (*precipitationShareSouthEastHourly)[i]->theResult = southEast;
+    (*precipitationShareSouthWestHourly)[i]->theResult = southWest;
+    (*precipitationShareNorthWestHourly)[i]->theResult = northWest;
 
     // lets store lat/lon pair into
     WeatherResult precipitationPointResult(precipitationPoint.X(), precipitationPoint.Y());
@@ -487,34 +471,83 @@ void populate_precipitation_time_series(const string& theVariable,
   }
 }
 
-void populate_precipitation_time_series(wf_story_params& theParameters)
+void populate_precipitation_time_series(wf_story_params& theParameters,
+                                        vector<ParallelTools::task_type>& theAreaTasks)
 {
   try
   {
-  if (theParameters.theForecastArea & INLAND_AREA)
-  {
-    WeatherArea inlandArea = theParameters.theArea;
-    inlandArea.type(WeatherArea::Inland);
-    populate_precipitation_time_series(theParameters.theVariable,
-                                       theParameters.theSources,
-                                       inlandArea,
-                                       *theParameters.theCompleteData[INLAND_AREA]);
-  }
-  if (theParameters.theForecastArea & COASTAL_AREA)
-  {
-    WeatherArea coastalArea = theParameters.theArea;
-    coastalArea.type(WeatherArea::Coast);
-    populate_precipitation_time_series(theParameters.theVariable,
-                                       theParameters.theSources,
-                                       coastalArea,
-                                       *theParameters.theCompleteData[COASTAL_AREA]);
-  }
-  if (theParameters.theForecastArea & FULL_AREA)
+  // All the forecast areas are analyzed for the whole series at once
+
+  const vector<forecast_area_id> areas = forecast_areas(theParameters);
+  if (areas.empty())
+    return;
+
+  const vector<WeatherArea::Type> types = forecast_area_types(theParameters, areas);
+  const vector<WeatherPeriod> periods =
+      hourly_periods(*theParameters.theCompleteData.at(areas.front())->at(PRECIPITATION_MAX_DATA));
+  const string& var = theParameters.theVariable;
+
+  RangeAcceptor precipitationlimits;
+  precipitationlimits.lowerLimit(DRY_WEATHER_LIMIT_DRIZZLE);
+  ValueAcceptor showerfilter;
+  showerfilter.value(kTConvectivePrecipitation);  // 1=large scale, 2=showers
+
+  auto amounts = std::make_shared<area_series_type>();
+  StatisticsTools::timeSeries({var, var},
+                              theParameters.theSources,
+                              Precipitation,
+                              {Maximum, Mean},
+                              Sum,
+                              theParameters.theArea,
+                              types,
+                              periods,
+                              *amounts,
+                              DefaultAcceptor(),
+                              precipitationlimits);
+
+  auto extents = std::make_shared<area_series_type>();
+  StatisticsTools::timeSeries({var},
+                              theParameters.theSources,
+                              Precipitation,
+                              {Percentage},
+                              Sum,
+                              theParameters.theArea,
+                              types,
+                              periods,
+                              *extents,
+                              DefaultAcceptor(),
+                              DefaultAcceptor(),
+                              precipitationlimits);
+
+  auto precipitationTypes = std::make_shared<area_series_type>();
+  StatisticsTools::timeSeries({var},
+                              theParameters.theSources,
+                              PrecipitationType,
+                              {Mean},
+                              Percentage,
+                              theParameters.theArea,
+                              types,
+                              periods,
+                              *precipitationTypes,
+                              DefaultAcceptor(),
+                              DefaultAcceptor(),
+                              showerfilter);
+
+  for (unsigned int k = 0; k < areas.size(); k++)
   {
-    populate_precipitation_time_series(theParameters.theVariable,
-                                       theParameters.theSources,
-                                       theParameters.theArea,
-                                       *theParameters.theCompleteData[FULL_AREA]);
+    const WeatherArea area = forecast_area(theParameters, types[k]);
+    const auto data = theParameters.theCompleteData.at(areas[k]);
+    theAreaTasks.push_back(
+        [&theParameters, area, data, amounts, extents, precipitationTypes, k]()
+        {
+          populate_precipitation_time_series(theParameters.theVariable,
+                                             theParameters.theSources,
+                                             area,
+                                             *data,
+                                             (*amounts)[k],
+                                             (*extents)[k],
+                                             (*precipitationTypes)[k]);
+        });
   }
   }
   catch (...)
@@ -524,65 +557,51 @@ void populate_precipitation_time_series(wf_story_params& theParameters)
 }
 
 void populate_thunderprobability_time_series(
-    const string& theVariable,
     const AnalysisSources& theSources,
     const WeatherArea& theArea,
-    weather_forecast_result_container& theHourlyDataContainer)
+    weather_forecast_result_container& theHourlyDataContainer,
+    const vector<vector<WeatherResult> >& theProbabilities,
+    const vector<vector<WeatherResult> >& theExtents)
 {
   try
   {
   weather_result_data_item_vector& thunderProbabilityHourly =
-      *(theHourlyDataContainer[THUNDER_PROBABILITY_DATA]);
+      *(theHourlyDataContainer.at(THUNDER_PROBABILITY_DATA));
   std::shared_ptr<weather_result_data_item_vector> thunderExtentHourly =
-      theHourlyDataContainer[THUNDER_EXTENT_DATA];
+      theHourlyDataContainer.at(THUNDER_EXTENT_DATA);
   std::shared_ptr<weather_result_data_item_vector> thunderNorthEastHourly =
-      theHourlyDataContainer[THUNDER_NORTHEAST_SHARE_DATA];
+      theHourlyDataContainer.at(THUNDER_NORTHEAST_SHARE_DATA);
   std::shared_ptr<weather_result_data_item_vector> thunderSouthEastHourly =
-      theHourlyDataContainer[THUNDER_SOUTHEAST_SHARE_DATA];
+      theHourlyDataContainer.at(THUNDER_SOUTHEAST_SHARE_DATA);
   std::shared_ptr<weather_result_data_item_vector> thunderSouthWestHourly =
-      theHourlyDataContainer[THUNDER_SOUTHWEST_SHARE_DATA];
+      theHourlyDataContainer.at(THUNDER_SOUTHWEST_SHARE_DATA);
   std::shared_ptr<weather_result_data_item_vector> thunderNorthWestHourly =
-      theHourlyDataContainer[THUNDER_NORTHWEST_SHARE_DATA];
-
-  RangeAcceptor thunderlimits;
-  thunderlimits.lowerLimit(5.0);  // 5 % propability is the minimum
-
-  GridForecaster theForecaster;
+      theHourlyDataContainer.at(THUNDER_NORTHWEST_SHARE_DATA);
 
   for (unsigned int i = 0; i < thunderProbabilityHourly.size(); i++)
   {
-    thunderProbabilityHourly[i]->theResult =
-        theForecaster.analyze(theVariable,
-                              theSources,
-                              Thunder,
-                              Maximum,
-                              Maximum,
-                              theArea,
-                              thunderProbabilityHourly[i]->thePeriod);
-
-    (*thunderExtentHourly)[i]->theResult =
-        theForecaster.analyze(theVariable,
-                              theSources,
-                              Thunder,
-                              Percentage,
-                              Maximum,
-                              theArea,
-                              (*thunderExtentHourly)[i]->thePeriod,
-                              DefaultAcceptor(),
-                              DefaultAcceptor(),
-                              thunderlimits);
+    thunderProbabilityHourly[i]->theResult = theProbabilities[0][i];
+    (*thunderExtentHourly)[i]->theResult = theExtents[0][i];
 
     RangeAcceptor thunderlimits;
     thunderlimits.lowerLimit(SMALL_PROBABILITY_FOR_THUNDER_LOWER_LIMIT);
+    WeatherResult northEast = (*thunderNorthEastHourly)[i]->theResult;
+    WeatherResult southEast = (*thunderSouthEastHourly)[i]->theResult;
+    WeatherResult southWest = (*thunderSouthWestHourly)[i]->theResult;
+    WeatherResult northWest = (*thunderNorthWestHourly)[i]->theResult;
     AreaTools::getArealDistribution(theSources,
                                     Thunder,
                                     theArea,
                                     (*thunderNorthEastHourly)[i]->thePeriod,
                                     thunderlimits,
-                                    (*thunderNorthEastHourly)[i]->theResult,
-                                    (*thunderSouthEastHourly)[i]->theResult,
-                                    (*thunderSouthWestHourly)[i]->theResult,
-                                    (*thunderNorthWestHourly)[i]->theResult);
+                                    northEast,
+                                    southEast,
+                                    southWest,
+                                    northWest);
+    (*thunderNorthEastHourly)[i]->theResult = northEast;
+    (*thunderSouthEastHourly)[i]->theResult = southEast;
+    (*thunderSouthWestHourly)[i]->theResult = southWest;
+    (*thunderNorthWestHourly)[i]->theResult = northWest;
   }
   }
   catch (...)
@@ -591,36 +610,58 @@ void populate_thunderprobability_time_series(
   }
 }
 
-void populate_thunderprobability_time_series(wf_story_params& theParameters)
+void populate_thunderprobability_time_series(wf_story_params& theParameters,
+                                             vector<ParallelTools::task_type>& theAreaTasks)
 {
   try
   {
-  if (theParameters.theForecastArea & INLAND_AREA)
-  {
-    WeatherArea inlandArea = theParameters.theArea;
-    inlandArea.type(WeatherArea::Inland);
-    populate_thunderprobability_time_series(theParameters.theVariable,
-                                            theParameters.theSources,
-                                            inlandArea,
-                                            *theParameters.theCompleteData[INLAND_AREA]);
-  }
+  const vector<forecast_area_id> areas = forecast_areas(theParameters);
+  if (areas.empty())
+    return;
 
-  if (theParameters.theForecastArea & COASTAL_AREA)
-  {
-    WeatherArea coastalArea = theParameters.theArea;
-    coastalArea.type(WeatherArea::Coast);
-    populate_thunderprobability_time_series(theParameters.theVariable,
-                                            theParameters.theSources,
-                                            coastalArea,
-                                            *theParameters.theCompleteData[COASTAL_AREA]);
-  }
+  const vector<WeatherArea::Type> types = forecast_area_types(theParameters, areas);
+  const vector<WeatherPeriod> periods =
+      hourly_periods(
+          *theParameters.theCompleteData.at(areas.front())->at(THUNDER_PROBABILITY_DATA));
 
-  if (theParameters.theForecastArea & FULL_AREA)
+  RangeAcceptor thunderlimits;
+  thunderlimits.lowerLimit(5.0);  // 5 % propability is the minimum
+
+  auto probabilities = std::make_shared<area_series_type>();
+  StatisticsTools::timeSeries({theParameters.theVariable},
+                              theParameters.theSources,
+                              Thunder,
+                              {Maximum},
+                              Maximum,
+                              theParameters.theArea,
+                              types,
+                              periods,
+                              *probabilities);
+
+  auto extents = std::make_shared<area_series_type>();
+  StatisticsTools::timeSeries({theParameters.theVariable},
+                              theParameters.theSources,
+                              Thunder,
+                              {Percentage},
+                              Maximum,
+                              theParameters.theArea,
+                              types,
+                              periods,
+                              *extents,
+                              DefaultAcceptor(),
+                              DefaultAcceptor(),
+                              thunderlimits);
+
+  for (unsigned int k = 0; k < areas.size(); k++)
   {
-    populate_thunderprobability_time_series(theParameters.theVariable,
-                                            theParameters.theSources,
-                                            theParameters.theArea,
-                                            *theParameters.theCompleteData[FULL_AREA]);
+    const WeatherArea area = forecast_area(theParameters, types[k]);
+    const auto data = theParameters.theCompleteData.at(areas[k]);
+    theAreaTasks.push_back(
+        [&theParameters, area, data, probabilities, extents, k]()
+        {
+          populate_thunderprobability_time_series(
+              theParameters.theSources, area, *data, (*probabilities)[k], (*extents)[k]);
+        });
   }
   }
   catch (...)
@@ -632,66 +673,49 @@ void populate_thunderprobability_time_series(wf_story_params& theParameters)
 void populate_fogintensity_time_series(const string& theVariable,
                                        const AnalysisSources& theSources,
                                        const WeatherArea& theArea,
-                                       weather_forecast_result_container& theHourlyDataContainer)
+                                       weather_forecast_result_container& theHourlyDataContainer,
+                                       const vector<vector<WeatherResult> >& theModerateFogs,
+                                       const vector<vector<WeatherResult> >& theDenseFogs)
 {
   try
   {
   weather_result_data_item_vector& fogIntensityModerateHourly =
-      *(theHourlyDataContainer[FOG_INTENSITY_MODERATE_DATA]);
+      *(theHourlyDataContainer.at(FOG_INTENSITY_MODERATE_DATA));
   weather_result_data_item_vector& fogIntensityDenseHourly =
-      *(theHourlyDataContainer[FOG_INTENSITY_DENSE_DATA]);
+      *(theHourlyDataContainer.at(FOG_INTENSITY_DENSE_DATA));
   std::shared_ptr<weather_result_data_item_vector> fogNorthEastHourly =
-      theHourlyDataContainer[FOG_NORTHEAST_SHARE_DATA];
+      theHourlyDataContainer.at(FOG_NORTHEAST_SHARE_DATA);
   std::shared_ptr<weather_result_data_item_vector> fogSouthEastHourly =
-      theHourlyDataContainer[FOG_SOUTHEAST_SHARE_DATA];
+      theHourlyDataContainer.at(FOG_SOUTHEAST_SHARE_DATA);
   std::shared_ptr<weather_result_data_item_vector> fogSouthWestHourly =
-      theHourlyDataContainer[FOG_SOUTHWEST_SHARE_DATA];
+      theHourlyDataContainer.at(FOG_SOUTHWEST_SHARE_DATA);
   std::shared_ptr<weather_result_data_item_vector> fogNorthWestHourly =
-      theHourlyDataContainer[FOG_NORTHWEST_SHARE_DATA];
-
-  GridForecaster theForecaster;
-  ValueAcceptor moderateFogFilter;
-  moderateFogFilter.value(kTModerateFog);
-  ValueAcceptor denseFogFilter;
-  denseFogFilter.value(kTDenseFog);
+      theHourlyDataContainer.at(FOG_NORTHWEST_SHARE_DATA);
 
   for (unsigned int i = 0; i < fogIntensityModerateHourly.size(); i++)
   {
-    fogIntensityModerateHourly[i]->theResult =
-        theForecaster.analyze(theVariable,
-                              theSources,
-                              Fog,
-                              Mean,
-                              Percentage,
-                              theArea,
-                              fogIntensityModerateHourly[i]->thePeriod,
-                              DefaultAcceptor(),
-                              DefaultAcceptor(),
-                              moderateFogFilter);
-
-    fogIntensityDenseHourly[i]->theResult =
-        theForecaster.analyze(theVariable,
-                              theSources,
-                              Fog,
-                              Mean,
-                              Percentage,
-                              theArea,
-                              fogIntensityDenseHourly[i]->thePeriod,
-                              DefaultAcceptor(),
-                              DefaultAcceptor(),
-                              denseFogFilter);
+    fogIntensityModerateHourly[i]->theResult = theModerateFogs[0][i];
+    fogIntensityDenseHourly[i]->theResult = theDenseFogs[0][i];
 
     RangeAcceptor foglimits;
     foglimits.lowerLimit(kTModerateFog);
+    WeatherResult northEast = (*fogNorthEastHourly)[i]->theResult;
+    WeatherResult southEast = (*fogSouthEastHourly)[i]->theResult;
+    WeatherResult southWest = (*fogSouthWestHourly)[i]->theResult;
+    WeatherResult northWest = (*fogNorthWestHourly)[i]->theResult;
     AreaTools::getArealDistribution(theSources,
                                     Fog,
                                     theArea,
                                     (*fogNorthEastHourly)[i]->thePeriod,
                                     foglimits,
-                                    (*fogNorthEastHourly)[i]->theResult,
-                                    (*fogSouthEastHourly)[i]->theResult,
-                                    (*fogSouthWestHourly)[i]->theResult,
-                                    (*fogNorthWestHourly)[i]->theResult);
+                                    northEast,
+                                    southEast,
+                                    southWest,
+                                    northWest);
+    (*fogNorthEastHourly)[i]->theResult = northEast;
+    (*fogSouthEastHourly)[i]->theResult = southEast;
+    (*fogSouthWestHourly)[i]->theResult = southWest;
+    (*fogNorthWestHourly)[i]->theResult = northWest;
   }
   }
   catch (...)
@@ -700,36 +724,67 @@ void populate_fogintensity_time_series(const string& theVariable,
   }
 }
 
-void populate_fogintensity_time_series(wf_story_params& theParameters)
+void populate_fogintensity_time_series(wf_story_params& theParameters,
+                                       vector<ParallelTools::task_type>& theAreaTasks)
 {
   try
   {
-  if (theParameters.theForecastArea & INLAND_AREA)
-  {
-    WeatherArea inlandArea = theParameters.theArea;
-    inlandArea.type(WeatherArea::Inland);
-    populate_fogintensity_time_series(theParameters.theVariable,
-                                      theParameters.theSources,
-                                      inlandArea,
-                                      *theParameters.theCompleteData[INLAND_AREA]);
-  }
+  const vector<forecast_area_id> areas = forecast_areas(theParameters);
+  if (areas.empty())
+    return;
 
-  if (theParameters.theForecastArea & COASTAL_AREA)
-  {
-    WeatherArea coastalArea = theParameters.theArea;
-    coastalArea.type(WeatherArea::Coast);
-    populate_fogintensity_time_series(theParameters.theVariable,
-                                      theParameters.theSources,
-                                      coastalArea,
-                                      *theParameters.theCompleteData[COASTAL_AREA]);
-  }
+  const vector<WeatherArea::Type> types = forecast_area_types(theParameters, areas);
+  const vector<WeatherPeriod> periods =
+      hourly_periods(
+          *theParameters.theCompleteData.at(areas.front())->at(FOG_INTENSITY_MODERATE_DATA));
 
-  if (theParameters.theForecastArea & FULL_AREA)
+  ValueAcceptor moderateFogFilter;
+  moderateFogFilter.value(kTModerateFog);
+  ValueAcceptor denseFogFilter;
+  denseFogFilter.value(kTDenseFog);
+
+  auto moderateFogs = std::make_shared<area_series_type>();
+  StatisticsTools::timeSeries({theParameters.theVariable},
+                              theParameters.theSources,
+                              Fog,
+                              {Mean},
+                              Percentage,
+                              theParameters.theArea,
+                              types,
+                              periods,
+                              *moderateFogs,
+                              DefaultAcceptor(),
+                              DefaultAcceptor(),
+                              moderateFogFilter);
+
+  auto denseFogs = std::make_shared<area_series_type>();
+  StatisticsTools::timeSeries({theParameters.theVariable},
+                              theParameters.theSources,
+                              Fog,
+                              {Mean},
+                              Percentage,
+                              theParameters.theArea,
+                              types,
+                              periods,
+                              *denseFogs,
+                              DefaultAcceptor(),
+                              DefaultAcceptor(),
+                              denseFogFilter);
+
+  for (unsigned int k = 0; k < areas.size(); k++)
   {
-    populate_fogintensity_time_series(theParameters.theVariable,
-                                      theParameters.theSources,
-                                      theParameters.theArea,
-                                      *theParameters.theCompleteData[FULL_AREA]);
+    const WeatherArea area = forecast_area(theParameters, types[k]);
+    const auto data = theParameters.theCompleteData.at(areas[k]);
+    theAreaTasks.push_back(
+        [&theParameters, area, data, moderateFogs, denseFogs, k]()
+        {
+          populate_fogintensity_time_series(theParameters.theVariable,
+                                            theParameters.theSources,
+                                            area,
+                                            *data,
+                                            (*moderateFogs)[k],
+                                            (*denseFogs)[k]);
+        });
   }
   }
   catch (...)
@@ -741,26 +796,24 @@ void populate_fogintensity_time_series(wf_story_params& theParameters)
 void populate_cloudiness_time_series(const string& theVariable,
                                      const AnalysisSources& theSources,
                                      const WeatherArea& theArea,
-                                     weather_forecast_result_container& theHourlyDataContainer)
+                                     weather_forecast_result_container& theHourlyDataContainer,
+                                     const vector<vector<WeatherResult> >& theCloudiness)
 {
   try
   {
-  weather_result_data_item_vector& cloudinessHourly = *(theHourlyDataContainer[CLOUDINESS_DATA]);
+  weather_result_data_item_vector& cloudinessHourly = *(theHourlyDataContainer.at(CLOUDINESS_DATA));
   std::shared_ptr<weather_result_data_item_vector> cloudinessNorthEastHourly =
-      theHourlyDataContainer[CLOUDINESS_NORTHEAST_SHARE_DATA];
+      theHourlyDataContainer.at(CLOUDINESS_NORTHEAST_SHARE_DATA);
   std::shared_ptr<weather_result_data_item_vector> cloudinessSouthEastHourly =
-      theHourlyDataContainer[CLOUDINESS_SOUTHEAST_SHARE_DATA];
+      theHourlyDataContainer.at(CLOUDINESS_SOUTHEAST_SHARE_DATA);
   std::shared_ptr<weather_result_data_item_vector> cloudinessSouthWestHourly =
-      theHourlyDataContainer[CLOUDINESS_SOUTHWEST_SHARE_DATA];
+      theHourlyDataContainer.at(CLOUDINESS_SOUTHWEST_SHARE_DATA);
   std::shared_ptr<weather_result_data_item_vector> cloudinessNorthWestHourly =
-      theHourlyDataContainer[CLOUDINESS_NORTHWEST_SHARE_DATA];
+      theHourlyDataContainer.at(CLOUDINESS_NORTHWEST_SHARE_DATA);
 
-  GridForecaster theForecaster;
   for (unsigned int i = 0; i < cloudinessHourly.size(); i++)
   {
-    // areal function Maximum changed to Mean (after consulting with Kaisa 25.11.2010)
-    cloudinessHourly[i]->theResult = theForecaster.analyze(
-        theVariable, theSources, Cloudiness, Mean, Mean, theArea, cloudinessHourly[i]->thePeriod);
+    cloudinessHourly[i]->theResult = theCloudiness[0][i];
 
     if (theArea.type() == WeatherArea::Full)
       WeatherResultTools::checkMissingValue(
@@ -768,15 +821,23 @@ void populate_cloudiness_time_series(const string& theVariable,
 
     RangeAcceptor cloudinesslimits;
     cloudinesslimits.lowerLimit(VERRATTAIN_PILVISTA_LOWER_LIMIT);
+    WeatherResult northEast = (*cloudinessNorthEastHourly)[i]->theResult;
+    WeatherResult southEast = (*cloudinessSouthEastHourly)[i]->theResult;
+    WeatherResult southWest = (*cloudinessSouthWestHourly)[i]->theResult;
+    WeatherResult northWest = (*cloudinessNorthWestHourly)[i]->theResult;
     AreaTools::getArealDistribution(theSources,
                                     Cloudiness,
                                     theArea,
                                     (*cloudinessNorthEastHourly)[i]->thePeriod,
                                     cloudinesslimits,
-                                    (*cloudinessNorthEastHourly)[i]->theResult,
-                                    (*cloudinessSouthEastHourly)[i]->theResult,
-                                    (*cloudinessSouthWestHourly)[i]->theResult,
-                                    (*cloudinessNorthWestHourly)[i]->theResult);
+                                    northEast,
+                                    southEast,
+                                    southWest,
+                                    northWest);
+    (*cloudinessNorthEastHourly)[i]->theResult = northEast;
+    (*cloudinessSouthEastHourly)[i]->theResult = southEast;
+    (*cloudinessSouthWestHourly)[i]->theResult = southWest;
+    (*cloudinessNorthWestHourly)[i]->theResult = northWest;
   }
   }
   catch (...)
@@ -785,38 +846,88 @@ void populate_cloudiness_time_series(const string& theVariable,
   }
 }
 
-void populate_cloudiness_time_series(wf_story_params& theParameters)
+void populate_cloudiness_time_series(wf_story_params& theParameters,
+                                     vector<ParallelTools::task_type>& theAreaTasks)
 {
   try
   {
   // theParameters.theVariable+"::fake::"+hourstr+"::cloudiness",
-  if (theParameters.theForecastArea & INLAND_AREA)
-  {
-    WeatherArea inlandArea = theParameters.theArea;
-    inlandArea.type(WeatherArea::Inland);
-    populate_cloudiness_time_series(theParameters.theVariable,
-                                    theParameters.theSources,
-                                    inlandArea,
-                                    *theParameters.theCompleteData[INLAND_AREA]);
-  }
+  const vector<forecast_area_id> areas = forecast_areas(theParameters);
+  if (areas.empty())
+    return;
 
-  if (theParameters.theForecastArea & COASTAL_AREA)
+  const vector<WeatherArea::Type> types = forecast_area_types(theParameters, areas);
+
+  // areal function Maximum changed to Mean (after consulting with Kaisa 25.11.2010)
+  auto cloudiness = std::make_shared<area_series_type>();
+  StatisticsTools::timeSeries(
+      {theParameters.theVariable},
+      theParameters.theSources,
+      Cloudiness,
+      {Mean},
+      Mean,
+      theParameters.theArea,
+      types,
+      hourly_periods(*theParameters.theCompleteData.at(areas.front())->at(CLOUDINESS_DATA)),
+      *cloudiness);
+
+  for (unsigned int k = 0; k < areas.size(); k++)
+  {
+    const WeatherArea area = forecast_area(theParameters, types[k]);
+    const auto data = theParameters.theCompleteData.at(areas[k]);
+    theAreaTasks.push_back(
+        [&theParameters, area, data, cloudiness, k]()
+        {
+          populate_cloudiness_time_series(theParameters.theVariable,
+                                          theParameters.theSources,
+                                          area,
+                                          *data,
+                                          (*cloudiness)[k]);
+        });
+  }
+  }
+  catch (...)
   {
-    WeatherArea coastalArea = theParameters.theArea;
-    coastalArea.type(WeatherArea::Coast);
-    populate_cloudiness_time_series(theParameters.theVariable,
-                                    theParameters.theSources,
-                                    coastalArea,
-                                    *theParameters.theCompleteData[COASTAL_AREA]);
+    throw Fmi::Exception::Trace(BCP, "Operation failed");
   }
+}
 
-  if (theParameters.theForecastArea & FULL_AREA)
+// ----------------------------------------------------------------------
+/*!
+ * \brief Populate the hourly data of all parameter groups and areas
+ *
+ * The area analyses of the four parameter groups run as parallel tasks.
+ * Each of them queues one task per forecast area, which fills in the
+ * hourly results and areal distributions of that area's container. The
+ * area tasks of all the groups then run in parallel. The containers are
+ * allocated beforehand, so each task writes only to its own results.
+ */
+// ----------------------------------------------------------------------
+
+void populate_time_series(wf_story_params& theParameters)
+{
+  try
   {
-    populate_cloudiness_time_series(theParameters.theVariable,
-                                    theParameters.theSources,
-                                    theParameters.theArea,
-                                    *theParameters.theCompleteData[FULL_AREA]);
-  }
+    const unsigned int nthreads = ParallelTools::threads();
+
+    vector<vector<ParallelTools::task_type> > areaTasks(4);
+    const vector<ParallelTools::task_type> groupTasks{
+        [&theParameters, &areaTasks]()
+        { populate_precipitation_time_series(theParameters, areaTasks[0]); },
+        [&theParameters, &areaTasks]()
+        { populate_cloudiness_time_series(theParameters, areaTasks[1]); },
+        [&theParameters, &areaTasks]()
+        { populate_fogintensity_time_series(theParameters, areaTasks[2]); },
+        [&theParameters, &areaTasks]()
+        { populate_thunderprobability_time_series(theParameters, areaTasks[3]); }};
+
+    ParallelTools::run(groupTasks, nthreads);
+
+    vector<ParallelTools::task_type> tasks;
+    for (const auto& group : areaTasks)
+      tasks.insert(tasks.end(), group.begin(), group.end());
+
+    ParallelTools::run(tasks, nthreads);
   }
   catch (...)
   {
@@ -828,129 +939,76 @@ void allocate_data_structures(wf_story_params& theParameters, const forecast_are
 {
   try
   {
-  auto hourlyMaxPrecipitation = std::make_shared<weather_result_data_item_vector>();
-  auto hourlyMeanPrecipitation = std::make_shared<weather_result_data_item_vector>();
-  auto hourlyPrecipitationExtent = std::make_shared<weather_result_data_item_vector>();
-
-  auto hourlyPrecipitationType = std::make_shared<weather_result_data_item_vector>();
-  auto hourlyPrecipitationFormWater = std::make_shared<weather_result_data_item_vector>();
-  auto hourlyPrecipitationFormDrizzle = std::make_shared<weather_result_data_item_vector>();
-  auto hourlyPrecipitationFormSleet = std::make_shared<weather_result_data_item_vector>();
-  auto hourlyPrecipitationFormSnow = std::make_shared<weather_result_data_item_vector>();
-  auto hourlyPrecipitationFormFreezingDrizzle = std::make_shared<weather_result_data_item_vector>();
-  auto hourlyPrecipitationFormFreezingRain = std::make_shared<weather_result_data_item_vector>();
-  auto hourlyCloudiness = std::make_shared<weather_result_data_item_vector>();
-  auto hourlyThunderProbability = std::make_shared<weather_result_data_item_vector>();
-  auto hourlyThunderExtent = std::make_shared<weather_result_data_item_vector>();
-  auto hourlyFogIntensityModerate = std::make_shared<weather_result_data_item_vector>();
-  auto hourlyFogIntensityDense = std::make_shared<weather_result_data_item_vector>();
-
-  auto hourlyPrecipitationShareNortEast = std::make_shared<weather_result_data_item_vector>();
-  auto hourlyPrecipitationShareSouthEast = std::make_shared<weather_result_data_item_vector>();
-  auto hourlyPrecipitationShareSouthWest = std::make_shared<weather_result_data_item_vector>();
-  auto hourlyPrecipitationShareNorthWest = std::make_shared<weather_result_data_item_vector>();
-  auto hourlyPrecipitationPoint = std::make_shared<weather_result_data_item_vector>();
-
-  auto hourlyCloudinessShareNortEast = std::make_shared<weather_result_data_item_vector>();
-  auto hourlyCloudinessShareSouthEast = std::make_shared<weather_result_data_item_vector>();
-  auto hourlyCloudinessShareSouthWest = std::make_shared<weather_result_data_item_vector>();
-  auto hourlyCloudinessShareNorthWest = std::make_shared<weather_result_data_item_vector>();
-
-  auto hourlyThunderProbabilityShareNortEast = std::make_shared<weather_result_data_item_vector>();
-  auto hourlyThunderProbabilityShareSouthEast = std::make_shared<weather_result_data_item_vector>();
-  auto hourlyThunderProbabilityShareSouthWest = std::make_shared<weather_result_data_item_vector>();
-  auto hourlyThunderProbabilityShareNorthWest = std::make_shared<weather_result_data_item_vector>();
-
-  auto hourlyFogShareNortEast = std::make_shared<weather_result_data_item_vector>();
-  auto hourlyFogShareSouthEast = std::make_shared<weather_result_data_item_vector>();
-  auto hourlyFogShareSouthWest = std::make_shared<weather_result_data_item_vector>();
-  auto hourlyFogShareNorthWest = std::make_shared<weather_result_data_item_vector>();
-
-  // first split the whole period to one-hour subperiods
-  TextGenPosixTime periodStartTime = theParameters.theDataPeriod.localStartTime();
-
-  theParameters.theHourPeriodCount = 0;
-  while (periodStartTime.IsLessThan(theParameters.theDataPeriod.localEndTime()))
-  {
-    TextGenPosixTime periodEndTime = periodStartTime;
-    periodEndTime.ChangeByHours(1);
-    WeatherPeriod theWeatherPeriod(periodEndTime, periodEndTime);
-    WeatherResult theWeatherResult(kFloatMissing, kFloatMissing);
-
-    part_of_the_day_id partOfTheDayId = get_part_of_the_day_id_large(theWeatherPeriod);
-
-    hourlyMaxPrecipitation->push_back(std::make_shared<WeatherResultDataItem>(
-        theWeatherPeriod, theWeatherResult, partOfTheDayId));
-    hourlyMeanPrecipitation->push_back(std::make_shared<WeatherResultDataItem>(
-        theWeatherPeriod, theWeatherResult, partOfTheDayId));
-    hourlyPrecipitationExtent->push_back(std::make_shared<WeatherResultDataItem>(
-        theWeatherPeriod, theWeatherResult, partOfTheDayId));
-    hourlyPrecipitationType->push_back(std::make_shared<WeatherResultDataItem>(
-        theWeatherPeriod, theWeatherResult, partOfTheDayId));
-    hourlyPrecipitationFormWater->push_back(std::make_shared<WeatherResultDataItem>(
-        theWeatherPeriod, theWeatherResult, partOfTheDayId));
-    hourlyPrecipitationFormDrizzle->push_back(std::make_shared<WeatherResultDataItem>(
-        theWeatherPeriod, theWeatherResult, partOfTheDayId));
-    hourlyPrecipitationFormSleet->push_back(std::make_shared<WeatherResultDataItem>(
-        theWeatherPeriod, theWeatherResult, partOfTheDayId));
-    hourlyPrecipitationFormSnow->push_back(std::make_shared<WeatherResultDataItem>(
-        theWeatherPeriod, theWeatherResult, partOfTheDayId));
-    hourlyPrecipitationFormFreezingDrizzle->push_back(std::make_shared<WeatherResultDataItem>(
-        theWeatherPeriod, theWeatherResult, partOfTheDayId));
-    hourlyPrecipitationFormFreezingRain->push_back(std::make_shared<WeatherResultDataItem>(
-        theWeatherPeriod, theWeatherResult, partOfTheDayId));
-    hourlyPrecipitationPoint->push_back(std::make_shared<WeatherResultDataItem>(
-        theWeatherPeriod, theWeatherResult, partOfTheDayId));
-    hourlyCloudiness->push_back(std::make_shared<WeatherResultDataItem>(
-        theWeatherPeriod, theWeatherResult, partOfTheDayId));
-    hourlyThunderProbability->push_back(std::make_shared<WeatherResultDataItem>(
-        theWeatherPeriod, theWeatherResult, partOfTheDayId));
-    hourlyThunderExtent->push_back(std::make_shared<WeatherResultDataItem>(
-        theWeatherPeriod, theWeatherResult, partOfTheDayId));
-    hourlyFogIntensityModerate->push_back(std::make_shared<WeatherResultDataItem>(
-        theWeatherPeriod, theWeatherResult, partOfTheDayId));
-    hourlyFogIntensityDense->push_back(std::make_shared<WeatherResultDataItem>(
-        theWeatherPeriod, theWeatherResult, partOfTheDayId));
-
-    hourlyPrecipitationShareNortEast->push_back(std::make_shared<WeatherResultDataItem>(
-        theWeatherPeriod, theWeatherResult, partOfTheDayId));
-    hourlyPrecipitationShareSouthEast->push_back(std::make_shared<WeatherResultDataItem>(
-        theWeatherPeriod, theWeatherResult, partOfTheDayId));
-    hourlyPrecipitationShareSouthWest->push_back(std::make_shared<WeatherResultDataItem>(
-        theWeatherPeriod, theWeatherResult, partOfTheDayId));
-    hourlyPrecipitationShareNorthWest->push_back(std::make_shared<WeatherResultDataItem>(
-        theWeatherPeriod, theWeatherResult, partOfTheDayId));
-
-    hourlyCloudinessShareNortEast->push_back(std::make_shared<WeatherResultDataItem>(
-        theWeatherPeriod, theWeatherResult, partOfTheDayId));
-    hourlyCloudinessShareSouthEast->push_back(std::make_shared<WeatherResultDataItem>(
-        theWeatherPeriod, theWeatherResult, partOfTheDayId));
-    hourlyCloudinessShareSouthWest->push_back(std::make_shared<WeatherResultDataItem>(
-        theWeatherPeriod, theWeatherResult, partOfTheDayId));
-    hourlyCloudinessShareNorthWest->push_back(std::make_shared<WeatherResultDataItem>(
-        theWeatherPeriod, theWeatherResult, partOfTheDayId));
-
-    hourlyThunderProbabilityShareNortEast->push_back(std::make_shared<WeatherResultDataItem>(
-        theWeatherPeriod, theWeatherResult, partOfTheDayId));
-    hourlyThunderProbabilityShareSouthEast->push_back(std::make_shared<WeatherResultDataItem>(
-        theWeatherPeriod, theWeatherResult, partOfTheDayId));
-    hourlyThunderProbabilityShareSouthWest->push_back(std::make_shared<WeatherResultDataItem>(
-        theWeatherPeriod, theWeatherResult, partOfTheDayId));
-    hourlyThunderProbabilityShareNorthWest->push_back(std::make_shared<WeatherResultDataItem>(
-        theWeatherPeriod, theWeatherResult, partOfTheDayId));
-
-    hourlyFogShareNortEast->push_back(std::make_shared<WeatherResultDataItem>(
-        theWeatherPeriod, theWeatherResult, partOfTheDayId));
-    hourlyFogShareSouthEast->push_back(std::make_shared<WeatherResultDataItem>(
-        theWeatherPeriod, theWeatherResult, partOfTheDayId));
-    hourlyFogShareSouthWest->push_back(std::make_shared<WeatherResultDataItem>(
-        theWeatherPeriod, theWeatherResult, partOfTheDayId));
-    hourlyFogShareNorthWest->push_back(std::make_shared<WeatherResultDataItem>(
-        theWeatherPeriod, theWeatherResult, partOfTheDayId));
-
-    periodStartTime.ChangeByHours(1);
-    theParameters.theHourPeriodCount++;
+  // first split the whole period to one-hour subperiods, shared by all the areas
+
+  HourlyTimeAxis& axis = theParameters.theHourlyTimeAxis;
+  if (axis.size() == 0)
+  {
+    TextGenPosixTime periodStartTime = theParameters.theDataPeriod.localStartTime();
+
+    while (periodStartTime.IsLessThan(theParameters.theDataPeriod.localEndTime()))
+    {
+      TextGenPosixTime periodEndTime = periodStartTime;
+      periodEndTime.ChangeByHours(1);
+      WeatherPeriod theWeatherPeriod(periodEndTime, periodEndTime);
+
+      axis.push_back(theWeatherPeriod, get_part_of_the_day_id_large(theWeatherPeriod));
+
+      periodStartTime.ChangeByHours(1);
+    }
   }
+  theParameters.theHourPeriodCount = axis.size();
+
+  // each quantity gets a column of its own, the data vectors refer to its hours
+
+  auto hourly_data = [&theParameters, &axis]()
+  {
+    theParameters.theHourlyColumns.emplace_back(axis);
+    HourlyColumn& column = theParameters.theHourlyColumns.back();
+    auto data = std::make_shared<weather_result_data_item_vector>();
+    data->reserve(column.size());
+    for (std::size_t i = 0; i < column.size(); i++)
+      data->emplace_back(column, i);
+    return data;
+  };
+
+  auto hourlyMaxPrecipitation = hourly_data();
+  auto hourlyMeanPrecipitation = hourly_data();
+  auto hourlyPrecipitationExtent = hourly_data();
+
+  auto hourlyPrecipitationType = hourly_data();
+  auto hourlyPrecipitationFormWater = hourly_data();
+  auto hourlyPrecipitationFormDrizzle = hourly_data();
+  auto hourlyPrecipitationFormSleet = hourly_data();
+  auto hourlyPrecipitationFormSnow = hourly_data();
+  auto hourlyPrecipitationFormFreezingDrizzle = hourly_data();
+  auto hourlyPrecipitationFormFreezingRain = hourly_data();
+  auto hourlyCloudiness = hourly_data();
+  auto hourlyThunderProbability = hourly_data();
+  auto hourlyThunderExtent = hourly_data();
+  auto hourlyFogIntensityModerate = hourly_data();
+  auto hourlyFogIntensityDense = hourly_data();
+
+  auto hourlyPrecipitationShareNortEast = hourly_data();
+  auto hourlyPrecipitationShareSouthEast = hourly_data();
+  auto hourlyPrecipitationShareSouthWest = hourly_data();
+  auto hourlyPrecipitationShareNorthWest = hourly_data();
+  auto hourlyPrecipitationPoint = hourly_data();
+
+  auto hourlyCloudinessShareNortEast = hourly_data();
+  auto hourlyCloudinessShareSouthEast = hourly_data();
+  auto hourlyCloudinessShareSouthWest = hourly_data();
+  auto hourlyCloudinessShareNorthWest = hourly_data();
+
+  auto hourlyThunderProbabilityShareNortEast = hourly_data();
+  auto hourlyThunderProbabilityShareSouthEast = hourly_data();
+  auto hourlyThunderProbabilityShareSouthWest = hourly_data();
+  auto hourlyThunderProbabilityShareNorthWest = hourly_data();
+
+  auto hourlyFogShareNortEast = hourly_data();
+  auto hourlyFogShareSouthEast = hourly_data();
+  auto hourlyFogShareSouthWest = hourly_data();
+  auto hourlyFogShareNorthWest = hourly_data();
 
   auto resultContainer = std::make_shared<weather_forecast_result_container>();
 
@@ -1022,7 +1080,7 @@ void create_data_structures(wf_story_params& theParameters)
   coastalArea.type(WeatherArea::Coast);
   bool inlandExists = false;
   bool coastExists = false;
-  GridForecaster theForecaster;
+  CachedGridForecaster theForecaster;
   WeatherResult result = theForecaster.analyze(theParameters.theVariable,
                                                theParameters.theSources,
                                                Temperature,
@@ -1263,16 +1321,9 @@ Paragraph weather_forecast(const TextGen::WeatherArea& itsArea,
   wf_story_params theParameters(
       itsVar, itsArea, theDataGatheringPeriod, itsPeriod, itsForecastTime, itsSources, theLog);
 
-  init_parameters(theParameters);
-
-  if (theParameters.theForecastArea == NO_AREA)
+  if (!populate_weather_forecast_data(theParameters))
     return paragraph;
 
-  populate_precipitation_time_series(theParameters);
-  populate_cloudiness_time_series(theParameters);
-  populate_fogintensity_time_series(theParameters);
-  populate_thunderprobability_time_series(theParameters);
-
   CloudinessForecast cloudinessForecast(theParameters);
   PrecipitationForecast precipitationForecast(theParameters);
   FogForecast fogForecast(theParameters);
@@ -1364,16 +1415,9 @@ Paragraph weather_forecast_at_sea(const TextGen::WeatherArea& itsArea,
   wf_story_params theParameters(
       itsVar, itsArea, theDataGatheringPeriod, itsPeriod, itsForecastTime, itsSources, theLog);
 
-  init_parameters(theParameters);
-
-  if (theParameters.theForecastArea == NO_AREA)
+  if (!populate_weather_forecast_data(theParameters))
     return paragraph;
 
-  populate_precipitation_time_series(theParameters);
-  populate_cloudiness_time_series(theParameters);
-  populate_fogintensity_time_series(theParameters);
-  populate_thunderprobability_time_series(theParameters);
-
   CloudinessForecast cloudinessForecast(theParameters);
   PrecipitationForecast precipitationForecast(theParameters);
   FogForecast fogForecast(theParameters, true);
@@ -1527,6 +1571,33 @@ void analyze_sentences(Paragraph& paragraph)
 
 }  // namespace
 
+// ----------------------------------------------------------------------
+/*!
+ * \brief Initialize the story parameters and fill in the hourly data
+ *
+ * \return False if there is no area to forecast for
+ */
+// ----------------------------------------------------------------------
+
+bool populate_weather_forecast_data(wf_story_params& theParameters)
+{
+  try
+  {
+    init_parameters(theParameters);
+
+    if (theParameters.theForecastArea == NO_AREA)
+      return false;
+
+    populate_time_series(theParameters);
+
+    return true;
+  }
+  catch (...)
+  {
+    throw Fmi::Exception::Trace(BCP, "Operation failed");
+  }
+}
+
 void print_out_weather_event_vector(std::ostream& theOutput,
                                     const weather_event_id_vector& theWeatherEventVector)
 {
@@ -1592,15 +1663,30 @@ Paragraph WeatherStory::forecast() const
     paragraphAreaOne << onAreaOneSentence;
     paragraphAreaTwo << onAreaTwoSentence;
 
-    log << areaName + (splitMethod == HORIZONTAL ? " - southern part" : " - western part") << '\n';
-
-    paragraphAreaOne << weather_forecast(
-        areaOne, itsPeriod, itsSources, itsForecastTime, itsVar, log);
-
-    log << areaName + (splitMethod == HORIZONTAL ? " - northern part" : " - eastern part") << '\n';
-
-    paragraphAreaTwo << weather_forecast(
-        areaTwo, itsPeriod, itsSources, itsForecastTime, itsVar, log);
+    // The parts are independent, hence they are generated in parallel. Each task
+    // logs into its own logger at the depth of this one, the messages are relayed
+    // to this one in order.
+
+    const std::string partOne(splitMethod == HORIZONTAL ? " - southern part" : " - western part");
+    const std::string partTwo(splitMethod == HORIZONTAL ? " - northern part" : " - eastern part");
+
+    const vector<ParallelTools::task_type> tasks{
+        [this, &areaName, &partOne, &areaOne, &paragraphAreaOne]()
+        {
+          MessageLogger partlog{MessageLogger::Continue()};
+          partlog << areaName + partOne << '\n';
+          paragraphAreaOne << weather_forecast(
+              areaOne, itsPeriod, itsSources, itsForecastTime, itsVar, partlog);
+        },
+        [this, &areaName, &partTwo, &areaTwo, &paragraphAreaTwo]()
+        {
+          MessageLogger partlog{MessageLogger::Continue()};
+          partlog << areaName + partTwo << '\n';
+          paragraphAreaTwo << weather_forecast(
+              areaTwo, itsPeriod, itsSources, itsForecastTime, itsVar, partlog);
+        }};
+
+    ParallelTools::run(tasks, ParallelTools::threads());
 
     paragraph << paragraphAreaOne << paragraphAreaTwo;
   }
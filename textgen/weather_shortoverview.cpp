@@ -5,6 +5,7 @@
  */
 // ======================================================================
 
+#include "CachedGridForecaster.h"
 #include "Delimiter.h"
 #include "Integer.h"
 #include "MessageLogger.h"
@@ -13,7 +14,6 @@
 #include "UnitFactory.h"
 #include "WeatherStory.h"
 #include "WeekdayTools.h"
-#include <calculator/GridForecaster.h>
 #include <calculator/HourPeriodGenerator.h>
 #include <calculator/MathTools.h>
 #include <calculator/NullPeriodGenerator.h>
@@ -146,7 +146,7 @@ Paragraph WeatherStory::shortoverview() const
     const double r_partly_rainy = optional_double(itsVar + "::precipitation::partly_rainy", 0.1);
     const int r_unstable = optional_percentage(itsVar + "::precipitation::unstable", 50);
 
-    GridForecaster forecaster;
+    CachedGridForecaster forecaster;
 
     // Generate cloudiness story first
 
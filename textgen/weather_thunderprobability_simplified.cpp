@@ -5,13 +5,13 @@
  */
 // ======================================================================
 
+#include "CachedGridForecaster.h"
 #include "Integer.h"
 #include "MessageLogger.h"
 #include "Paragraph.h"
 #include "Sentence.h"
 #include "UnitFactory.h"
 #include "WeatherStory.h"
-#include <calculator/GridForecaster.h>
 #include <calculator/MathTools.h>
 #include <calculator/Settings.h>
 #include <calculator/WeatherPeriodTools.h>
@@ -48,7 +48,7 @@ Paragraph WeatherStory::thunderprobability_simplified() const
     const int precision = optional_percentage(itsVar + "::precision", 10);
     const int limit = optional_percentage(itsVar + "::limit", 10);
 
-    GridForecaster forecaster;
+    CachedGridForecaster forecaster;
 
     WeatherResult result = forecaster.analyze(
         itsVar + "::fake::probability", itsSources, Thunder, Maximum, Maximum, itsArea, itsPeriod);
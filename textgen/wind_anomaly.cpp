@@ -5,6 +5,7 @@
  */
 // ======================================================================
 
+#include "CachedGridForecaster.h"
 #include "WindStory.h"
 
 #include "AreaTools.h"
@@ -18,7 +19,6 @@
 #include "UnitFactory.h"
 #include "WeatherForecast.h"
 #include "WindStoryTools.h"
-#include <calculator/GridForecaster.h>
 #include <calculator/HourPeriodGenerator.h>
 #include <calculator/Settings.h>
 #include <calculator/WeatherPeriodTools.h>
@@ -541,7 +541,7 @@ void analyze_wind_result(WeatherResult* result,
   {
   if (result == nullptr)
     return;
-  *result = GridForecaster().analyze(fakeVar + statSuffix,
+  *result = CachedGridForecaster().analyze(fakeVar + statSuffix,
                                      theParameters.theSources,
                                      theWindspeed ? WindSpeed : WindChill,
                                      stat,
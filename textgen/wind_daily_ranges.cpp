@@ -5,6 +5,7 @@
  */
 // ======================================================================
 
+#include "CachedGridForecaster.h"
 #include "Delimiter.h"
 #include "MessageLogger.h"
 #include "Paragraph.h"
@@ -13,7 +14,6 @@
 #include "WeekdayTools.h"
 #include "WindStory.h"
 #include "WindStoryTools.h"
-#include <calculator/GridForecaster.h>
 #include <calculator/HourPeriodGenerator.h>
 #include <calculator/Settings.h>
 #include <calculator/WeatherResult.h>
@@ -464,7 +464,7 @@ Paragraph WindStory::daily_ranges() const
 
     Paragraph paragraph;
 
-    GridForecaster forecaster;
+    CachedGridForecaster forecaster;
 
     // All day periods
 
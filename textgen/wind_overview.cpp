@@ -1,15 +1,18 @@
+#include "CachedGridForecaster.h"
 #include "Delimiter.h"
 #include "MessageLogger.h"
 #include "Paragraph.h"
+#include "ParallelTools.h"
 #include "PositiveValueAcceptor.h"
 #include "Sentence.h"
+#include "ShareTools.h"
+#include "StatisticsTools.h"
 #include "SubMaskExtractor.h"
 #include "UnitFactory.h"
 #include "WeatherForecast.h"
 #include "WindForecast.h"
 #include "WindStory.h"
 #include "WindStoryTools.h"
-#include <calculator/GridForecaster.h>
 #include <calculator/ParameterAnalyzer.h>
 #include <calculator/RangeAcceptor.h>
 #include <calculator/Settings.h>
@@ -1781,6 +1784,7 @@ void deallocate_data_structures(wo_story_params& storyParams)
       delete i;
     }
     storyParams.theWindDataVector.clear();
+    storyParams.theWindAggregates.clear();
 
     for (auto& i : storyParams.theWindSpeedVector)
     {
@@ -1823,68 +1827,44 @@ void populate_windspeed_distribution_time_series(
 {
   try
   {
-    GridForecaster forecaster;
+    // Gust distribution (HourlyMaximumGust). Used for convective cell detection — the
+    // base wind / MaximumWind path does not resolve transient gustiness in high-resolution
+    // NWP, so we have to look at the proper gust diagnostic. If the data lacks the gust
+    // parameter, the gust shares are missing and the bucket share is just zero,
+    // which makes the cell detector a safe no-op on legacy datasets.
+
+    ShareTools::value_class_vector buckets;
 
     float ws_lower_limit(0.0);
     float ws_upper_limit(0.5);
 
     while (ws_lower_limit < HIRMUMYRSKY_LOWER_LIMIT)
     {
-      RangeAcceptor acceptor;
-      acceptor.lowerLimit(ws_lower_limit);
-      if (ws_lower_limit < HIRMUMYRSKY_LOWER_LIMIT + 1)
-        acceptor.upperLimit(ws_upper_limit - 0.0001);
-
-      WeatherResult share = forecaster.analyze(theVar + "::fake::tyyni::share",
-                                               theSources,
-                                               WindSpeed,
-                                               Mean,
-                                               Percentage,
-                                               theArea,
-                                               thePeriod,
-                                               DefaultAcceptor(),
-                                               DefaultAcceptor(),
-                                               acceptor);
-
-      pair<float, WeatherResult> shareItem(ws_lower_limit, share);
-      theWindSpeedDistribution.push_back(shareItem);
-
-      share = forecaster.analyze(theVar + "::fake::tyyni::share",
-                                 theSources,
-                                 MaximumWind,
-                                 Mean,
-                                 Percentage,
-                                 theArea,
-                                 thePeriod,
-                                 DefaultAcceptor(),
-                                 DefaultAcceptor(),
-                                 acceptor);
-
-      pair<float, WeatherResult> shareItemTop(ws_lower_limit, share);
-      theWindSpeedDistributionTop.push_back(shareItemTop);
-
-      // Gust distribution (HourlyMaximumGust). Used for convective cell detection — the
-      // base wind / MaximumWind path does not resolve transient gustiness in high-resolution
-      // NWP, so we have to look at the proper gust diagnostic. If the data lacks the gust
-      // parameter, GustSpeed analyze returns missing and the bucket share is just zero,
-      // which makes the cell detector a safe no-op on legacy datasets.
-      share = forecaster.analyze(theVar + "::fake::tyyni::share",
-                                 theSources,
-                                 GustSpeed,
-                                 Mean,
-                                 Percentage,
-                                 theArea,
-                                 thePeriod,
-                                 DefaultAcceptor(),
-                                 DefaultAcceptor(),
-                                 acceptor);
-
-      pair<float, WeatherResult> shareItemGust(ws_lower_limit, share);
-      theGustSpeedDistribution.push_back(shareItemGust);
+      buckets.push_back(make_pair(ws_lower_limit, static_cast<float>(ws_upper_limit - 0.0001)));
 
       ws_lower_limit += (ws_lower_limit == 0.0 ? 0.5 : 1.0);
       ws_upper_limit += 1.0;
     }
+
+    // All the buckets of all three parameters are calculated in a single pass
+
+    vector<WeatherParameter> parameters{WindSpeed, MaximumWind, GustSpeed};
+    vector<ShareTools::share_distribution> distributions;
+
+    ShareTools::distributions(theVar + "::fake::tyyni::share",
+                              theSources,
+                              parameters,
+                              theArea,
+                              thePeriod,
+                              buckets,
+                              distributions);
+
+    theWindSpeedDistribution.insert(
+        theWindSpeedDistribution.end(), distributions[0].begin(), distributions[0].end());
+    theWindSpeedDistributionTop.insert(
+        theWindSpeedDistributionTop.end(), distributions[1].begin(), distributions[1].end());
+    theGustSpeedDistribution.insert(
+        theGustSpeedDistribution.end(), distributions[2].begin(), distributions[2].end());
   }
   catch (...)
   {
@@ -1892,75 +1872,109 @@ void populate_windspeed_distribution_time_series(
   }
 }
 
+// ----------------------------------------------------------------------
+/*!
+ * \brief Analyze the wind speeds of all the wind data items of all the areas
+ *
+ * For each area the results are in the order minimum, maximum, mean
+ * and median wind speed, top wind and gust speed, each with one result
+ * per data item. All the areas are analyzed from one scan of the data.
+ */
+// ----------------------------------------------------------------------
+
+void analyze_wind_speed_series(const wo_story_params& storyParams,
+                               vector<vector<vector<WeatherResult> > >& theSpeeds)
+{
+  try
+  {
+    vector<WeatherArea::Type> types;
+    for (const auto& weatherArea : storyParams.theWeatherAreas)
+      types.push_back(weatherArea.type());
+
+    // The periods are the same for all the areas
+
+    vector<WeatherPeriod> periods;
+    periods.reserve(storyParams.theWindDataVector.size());
+    for (const auto& windData : storyParams.theWindDataVector)
+      periods.push_back(windData->getDataItem(types.front()).thePeriod);
+
+    // Minimum, maximum, mean and median wind speed from one scan of the data
+
+    StatisticsTools::timeSeries({storyParams.theVar + "::fake::wind::speed::minimum",
+                                 storyParams.theVar + "::fake::wind::speed::maximum",
+                                 storyParams.theVar + "::fake::wind::speed::mean",
+                                 storyParams.theVar + "::fake::wind::medianwind"},
+                                storyParams.theSources,
+                                WindSpeed,
+                                {Minimum, Peak, Mean, Median},
+                                Mean,
+                                storyParams.theArea,
+                                types,
+                                periods,
+                                theSpeeds);
+
+    vector<vector<vector<WeatherResult> > > top;
+    StatisticsTools::timeSeries({storyParams.theVar + "::fake::wind::maximumwind"},
+                                storyParams.theSources,
+                                MaximumWind,
+                                {Peak},
+                                Mean,
+                                storyParams.theArea,
+                                types,
+                                periods,
+                                top);
+
+    vector<vector<vector<WeatherResult> > > gust;
+    StatisticsTools::timeSeries({storyParams.theVar + "::fake::gust::speed"},
+                                storyParams.theSources,
+                                GustSpeed,
+                                {Maximum},
+                                Mean,
+                                storyParams.theArea,
+                                types,
+                                periods,
+                                gust);
+
+    for (unsigned int k = 0; k < types.size(); k++)
+    {
+      theSpeeds[k].push_back(top[k].front());
+      theSpeeds[k].push_back(gust[k].front());
+    }
+  }
+  catch (...)
+  {
+    throw Fmi::Exception::Trace(BCP, "Operation failed");
+  }
+}
+
 void populate_data_item_for_area(wo_story_params& storyParams,
                                  GridForecaster& forecaster,
                                  unsigned int i,
-                                 const WeatherArea& weatherArea)
+                                 const WeatherArea& weatherArea,
+                                 const vector<vector<WeatherResult> >& theSpeeds)
 {
   try
   {
     WeatherArea::Type areaType(weatherArea.type());
     WindDataItemUnit& dataItem = (storyParams.theWindDataVector[i])->getDataItem(areaType);
 
-    dataItem.theWindSpeedMin =
-        forecaster.analyze(storyParams.theVar + "::fake::wind::speed::minimum",
-                           storyParams.theSources,
-                           WindSpeed,
-                           Minimum,
-                           Mean,
-                           weatherArea,
-                           dataItem.thePeriod);
+    dataItem.theWindSpeedMin = theSpeeds[0][i];
+    dataItem.theWindSpeedMax = theSpeeds[1][i];
+    dataItem.theWindSpeedMean = theSpeeds[2][i];
+    dataItem.theWindSpeedMedian = theSpeeds[3][i];
 
     if (areaType == WeatherArea::Full)
-      WeatherResultTools::checkMissingValue("wind_overview", WindSpeed, dataItem.theWindSpeedMin);
-
-    dataItem.theWindSpeedMax =
-        forecaster.analyze(storyParams.theVar + "::fake::wind::speed::maximum",
-                           storyParams.theSources,
-                           WindSpeed,
-                           Peak,
-                           Mean,
-                           weatherArea,
-                           dataItem.thePeriod);
-
-    if (areaType == WeatherArea::Full)
-      WeatherResultTools::checkMissingValue("wind_overview", WindSpeed, dataItem.theWindSpeedMax);
+      WeatherResultTools::checkMissingValue("wind_overview",
+                                            WindSpeed,
+                                            {dataItem.theWindSpeedMin,
+                                             dataItem.theWindSpeedMax,
+                                             dataItem.theWindSpeedMean,
+                                             dataItem.theWindSpeedMedian});
 
     dataItem.theEqualizedMaxWind = dataItem.theWindSpeedMax;
-
-    dataItem.theWindSpeedMean = forecaster.analyze(storyParams.theVar + "::fake::wind::speed::mean",
-                                                   storyParams.theSources,
-                                                   WindSpeed,
-                                                   Mean,
-                                                   Mean,
-                                                   weatherArea,
-                                                   dataItem.thePeriod);
-
-    if (areaType == WeatherArea::Full)
-      WeatherResultTools::checkMissingValue("wind_overview", WindSpeed, dataItem.theWindSpeedMean);
-
-    dataItem.theWindSpeedMedian =
-        forecaster.analyze(storyParams.theVar + "::fake::wind::medianwind",
-                           storyParams.theSources,
-                           WindSpeed,
-                           Median,
-                           Mean,
-                           weatherArea,
-                           dataItem.thePeriod);
-
-    if (areaType == WeatherArea::Full)
-      WeatherResultTools::checkMissingValue(
-          "wind_overview", WindSpeed, dataItem.theWindSpeedMedian);
-
     dataItem.theEqualizedMedianWind = dataItem.theWindSpeedMedian;
 
-    dataItem.theWindSpeedTop = forecaster.analyze(storyParams.theVar + "::fake::wind::maximumwind",
-                                                  storyParams.theSources,
-                                                  MaximumWind,
-                                                  Peak,
-                                                  Mean,
-                                                  weatherArea,
-                                                  dataItem.thePeriod);
+    dataItem.theWindSpeedTop = theSpeeds[4][i];
 
     // 1.07 from Kaisa Solin, 16.1.2025 Teams meeting
     if (dataItem.theWindSpeedTop.value() == kFloatMissing)
@@ -1986,13 +2000,7 @@ void populate_data_item_for_area(wo_story_params& storyParams,
     dataItem.theCorrectedWindDirection = dataItem.theWindDirection;
     dataItem.theEqualizedWindDirection = dataItem.theWindDirection;
 
-    dataItem.theGustSpeed = forecaster.analyze(storyParams.theVar + "::fake::gust::speed",
-                                               storyParams.theSources,
-                                               GustSpeed,
-                                               Maximum,
-                                               Mean,
-                                               weatherArea,
-                                               dataItem.thePeriod);
+    dataItem.theGustSpeed = theSpeeds[5][i];
 
     if (dataItem.theGustSpeed.value() == kFloatMissing)
       dataItem.theGustSpeed = dataItem.theWindSpeedMax;
@@ -2115,11 +2123,25 @@ bool populate_time_series(wo_story_params& storyParams)
 {
   try
   {
-    GridForecaster forecaster;
+    // The wind speeds of all the areas are analyzed for the whole series at once
 
-    for (unsigned int i = 0; i < storyParams.theWindDataVector.size(); i++)
-      for (unsigned int k = 0; k < storyParams.theWeatherAreas.size(); k++)
-        populate_data_item_for_area(storyParams, forecaster, i, storyParams.theWeatherAreas[k]);
+    vector<vector<vector<WeatherResult> > > speeds;
+    analyze_wind_speed_series(storyParams, speeds);
+
+    // The rest of the data items of each area are independent of the other areas
+
+    vector<ParallelTools::task_type> tasks;
+    for (unsigned int k = 0; k < storyParams.theWeatherAreas.size(); k++)
+      tasks.push_back(
+          [&storyParams, &speeds, k]()
+          {
+            CachedGridForecaster forecaster;
+            for (unsigned int i = 0; i < storyParams.theWindDataVector.size(); i++)
+              populate_data_item_for_area(
+                  storyParams, forecaster, i, storyParams.theWeatherAreas[k], speeds[k]);
+          });
+
+    ParallelTools::run(tasks, ParallelTools::threads());
 
     check_weak_top_wind(storyParams);
     populate_calculated_wind_speeds(storyParams);
@@ -4071,35 +4093,22 @@ void remove_cell_from_timestep_stats(wo_story_params& storyParams,
     RangeAcceptor belowCutoff;
     belowCutoff.upperLimit(cutoff - 0.0001F);
 
-    dataItem.theWindSpeedMax =
-        forecaster.analyze(storyParams.theVar + "::fake::wind::speed::maximum::no_cell",
-                           storyParams.theSources,
-                           WindSpeed,
-                           Peak,
-                           Mean,
-                           weatherArea,
-                           dataItem.thePeriod,
-                           belowCutoff);
-
-    dataItem.theWindSpeedMean =
-        forecaster.analyze(storyParams.theVar + "::fake::wind::speed::mean::no_cell",
-                           storyParams.theSources,
-                           WindSpeed,
-                           Mean,
-                           Mean,
-                           weatherArea,
-                           dataItem.thePeriod,
-                           belowCutoff);
-
-    dataItem.theWindSpeedMedian =
-        forecaster.analyze(storyParams.theVar + "::fake::wind::medianwind::no_cell",
-                           storyParams.theSources,
-                           WindSpeed,
-                           Median,
-                           Mean,
-                           weatherArea,
-                           dataItem.thePeriod,
-                           belowCutoff);
+    vector<WeatherResult> speeds;
+    StatisticsTools::analyze({storyParams.theVar + "::fake::wind::speed::maximum::no_cell",
+                              storyParams.theVar + "::fake::wind::speed::mean::no_cell",
+                              storyParams.theVar + "::fake::wind::medianwind::no_cell"},
+                             storyParams.theSources,
+                             WindSpeed,
+                             {Peak, Mean, Median},
+                             Mean,
+                             weatherArea,
+                             dataItem.thePeriod,
+                             speeds,
+                             belowCutoff);
+
+    dataItem.theWindSpeedMax = speeds[0];
+    dataItem.theWindSpeedMean = speeds[1];
+    dataItem.theWindSpeedMedian = speeds[2];
 
     dataItem.theWindSpeedTop =
         forecaster.analyze(storyParams.theVar + "::fake::wind::maximumwind::no_cell",
@@ -4152,7 +4161,7 @@ void remove_cells_from_area_stats(wo_story_params& storyParams,
     if (anomalies.empty())
       return;
 
-    GridForecaster forecaster;
+    CachedGridForecaster forecaster;
     const float cutoff = static_cast<float>(storyParams.theConvectiveCellCutoff);
 
     for (const auto& anomaly : anomalies)
@@ -4191,7 +4200,7 @@ void determine_anomaly_quadrants(wo_story_params& storyParams,
     if (storyParams.theArea.isPoint())
       return;
 
-    GridForecaster forecaster;
+    CachedGridForecaster forecaster;
     const std::array<WeatherArea::Type, 4> quadrants = {
         WeatherArea::Northern, WeatherArea::Southern, WeatherArea::Eastern, WeatherArea::Western};
 
@@ -4630,6 +4639,12 @@ Paragraph WindStory::overview() const
       log_wind_direction_periods(storyParams);
       log_raw_data(storyParams);
 #endif
+      // The aggregates recognize the data only by the address and size of the
+      // vector, so the data items must not be modified after this point
+      storyParams.theWindAggregates.build(storyParams.theWindDataVector,
+                                          storyParams.theArea.type(),
+                                          storyParams.theWindSpeedTopCoverage);
+
       WindForecast windForecast(storyParams);
 
       auto windParts = windForecast.getWindStoryParts(itsPeriod);
@@ -4668,10 +4683,12 @@ Paragraph WindStory::overview() const
           paragraph << cellParagraph;
       }
 
-      std::size_t js_id = generateUniqueID();
-
+      // The debug output is generated serially, see ParallelTools, hence the
+      // shared random generator is not used concurrently
       if (Settings::optional_bool("qdtext::append_graph", false))
       {
+        std::size_t js_id = generateUniqueID();
+
         std::string html_string(Settings::optional_string("html__append", ""));
         html_string += get_js_code(js_id,
                                    html_string.empty(),
@@ -4696,12 +4713,6 @@ Paragraph WindStory::overview() const
         html_string += Fmi::to_string(itsPeriod.localEndTime().GetMin());
         html_string += "</h5>";
 
-        Settings::set("html__append", html_string);
-      }
-
-      if (Settings::optional_bool("qdtext::append_graph", false))
-      {
-        std::string html_string(Settings::optional_string("html__append", ""));
         html_string += get_js_data(storyParams, "windspeed", js_id);
         js_id++;
         html_string += get_js_data(storyParams, "winddirection", js_id);
@@ -5,13 +5,13 @@
  */
 // ======================================================================
 
+#include "CachedGridForecaster.h"
 #include "Delimiter.h"
 #include "MessageLogger.h"
 #include "Paragraph.h"
 #include "Sentence.h"
 #include "WindStory.h"
 #include "WindStoryTools.h"
-#include <calculator/GridForecaster.h>
 #include <calculator/Settings.h>
 #include <calculator/WeatherResult.h>
 #include <calculator/WeatherResultTools.h>
@@ -49,7 +49,7 @@ Paragraph WindStory::range() const
 
     Paragraph paragraph;
 
-    GridForecaster forecaster;
+    CachedGridForecaster forecaster;
 
     // Calculate wind speeds
 
@@ -5,6 +5,7 @@
  */
 // ======================================================================
 
+#include "CachedGridForecaster.h"
 #include "Delimiter.h"
 #include "MessageLogger.h"
 #include "Paragraph.h"
@@ -12,7 +13,6 @@
 #include "Sentence.h"
 #include "WindStory.h"
 #include "WindStoryTools.h"
-#include <calculator/GridForecaster.h>
 #include <calculator/Settings.h>
 #include <calculator/WeatherPeriodTools.h>
 #include <calculator/WeatherResult.h>
@@ -54,7 +54,7 @@ Paragraph WindStory::simple_overview() const
 
     Paragraph paragraph;
 
-    GridForecaster forecaster;
+    CachedGridForecaster forecaster;
 
     // The period until next morning should always be possible
 
@@ -0,0 +1,188 @@
+#!/usr/bin/env python3
+"""Compile gettext .po dictionaries into memory mapped .dict images.
+
+Usage:
+    po_to_dict.py [file.po ...]
+
+Each po/<lang>.po is compiled into po/<lang>.dict, or each given .po file
+into a .dict file next to it. The images are read by MmapDictionary, and
+the format must match MmapDictionary::compile byte for byte:
+
+    magic "TGDICT01"
+    count, nbuckets, strings_size, 0              (little endian uint32)
+    displacements[nbuckets]                       (uint32)
+    slots[count]                                  (uint32 entry index)
+    entries[count] sorted by key                  (uint32 key offset, key size,
+                                                   value offset, value size)
+    string data
+
+The slot of a key is a minimal perfect hash built with the hash and
+displace algorithm, see MmapDictionary.cpp for the details.
+"""
+
+from __future__ import annotations
+
+import os
+import pathlib
+import struct
+import sys
+
+SCRIPT_DIR = pathlib.Path(__file__).resolve().parent
+PO_DIR = SCRIPT_DIR.parent / "po"
+
+MASK = (1 << 64) - 1
+MAGIC = b"TGDICT01"
+MAX_DISPLACEMENT = 1 << 24
+
+ESCAPES = {"n": "\n", "t": "\t", "r": "\r", "\\": "\\", '"': '"'}
+
+
+def po_unquote(text: str, where: str) -> str:
+    if len(text) < 2 or text[0] != '"' or text[-1] != '"':
+        raise ValueError(f"{where}: expected a quoted string")
+    result = []
+    i = 1
+    while i < len(text) - 1:
+        c = text[i]
+        if c == "\\":
+            if i + 2 >= len(text):
+                raise ValueError(f"{where}: dangling backslash in quoted string")
+            i += 1
+            result.append(ESCAPES.get(text[i], text[i]))
+        else:
+            result.append(c)
+        i += 1
+    return "".join(result)
+
+
+def read_po(path: pathlib.Path) -> dict[bytes, bytes]:
+    """Parse a .po file the same way PoDictionary::read does."""
+    data: dict[bytes, bytes] = {}
+    state = None
+    msgid = ""
+    msgstr = ""
+
+    def commit() -> None:
+        nonlocal state, msgid, msgstr
+        if state is not None and msgid:
+            data.setdefault(msgid.encode("utf-8"), msgstr.encode("utf-8"))
+        msgid = msgstr = ""
+        state = None
+
+    with open(path, encoding="utf-8", newline="\n") as f:
+        for lineno, line in enumerate(f, 1):
+            line = line.rstrip("\n").rstrip("\r")
+            where = f"{path}:{lineno}"
+            if not line:
+                commit()
+            elif line[0] == "#":
+                continue
+            elif line.startswith('msgid "'):
+                commit()
+                msgid = po_unquote(line[6:], where)
+                state = "msgid"
+            elif line.startswith('msgstr "'):
+                msgstr = po_unquote(line[7:], where)
+                state = "msgstr"
+            elif line[0] == '"':
+                piece = po_unquote(line, where)
+                if state == "msgid":
+                    msgid += piece
+                elif state == "msgstr":
+                    msgstr += piece
+                else:
+                    raise ValueError(f"{where}: continuation string outside msgid/msgstr")
+            else:
+                raise ValueError(f"{where}: unexpected line '{line}'")
+    commit()
+    return data
+
+
+def fnv1a(key: bytes) -> int:
+    h = 14695981039346656037
+    for b in key:
+        h = ((h ^ b) * 1099511628211) & MASK
+    return h
+
+
+def mix(h: int) -> int:
+    h ^= h >> 30
+    h = (h * 0xBF58476D1CE4E5B9) & MASK
+    h ^= h >> 27
+    h = (h * 0x94D049BB133111EB) & MASK
+    h ^= h >> 31
+    return h
+
+
+def slot_index(h: int, d: int, nslots: int) -> int:
+    return mix(h ^ ((d * 0x9E3779B97F4A7C15) & MASK)) % nslots
+
+
+def compile_dict(data: dict[bytes, bytes]) -> bytes:
+    keys = sorted(data)
+    count = len(keys)
+    nbuckets = max(1, count // 2)
+
+    entries = bytearray()
+    strings = bytearray()
+    hashes = []
+    for key in keys:
+        value = data[key]
+        hashes.append(fnv1a(key))
+        entries += struct.pack("<II", len(strings), len(key))
+        strings += key
+        entries += struct.pack("<II", len(strings), len(value))
+        strings += value
+
+    buckets: list[list[int]] = [[] for _ in range(nbuckets)]
+    for i, h in enumerate(hashes):
+        buckets[mix(h) % nbuckets].append(i)
+
+    # sorted() is stable like std::stable_sort
+    order = sorted(range(nbuckets), key=lambda b: -len(buckets[b]))
+
+    displacements = [0] * nbuckets
+    slots = [0] * count
+    used = [False] * count
+    for b in order:
+        if not buckets[b]:
+            break
+        for d in range(MAX_DISPLACEMENT):
+            candidate: list[int] = []
+            for i in buckets[b]:
+                s = slot_index(hashes[i], d, count)
+                if used[s] or s in candidate:
+                    break
+                candidate.append(s)
+            else:
+                break
+        else:
+            raise ValueError("failed to build a perfect hash for the dictionary")
+        displacements[b] = d
+        for s, i in zip(candidate, buckets[b]):
+            used[s] = True
+            slots[s] = i
+
+    image = bytearray(MAGIC)
+    image += struct.pack("<IIII", count, nbuckets, len(strings), 0)
+    image += struct.pack(f"<{nbuckets}I", *displacements)
+    image += struct.pack(f"<{count}I", *slots)
+    image += entries
+    image += strings
+    return bytes(image)
+
+
+def main(argv: list[str]) -> int:
+    sources = [pathlib.Path(p) for p in argv[1:]] or sorted(PO_DIR.glob("*.po"))
+    for po in sources:
+        target = po.with_suffix(".dict")
+        image = compile_dict(read_po(po))
+        tmp = target.with_name(target.name + ".tmp")
+        tmp.write_bytes(image)
+        os.replace(tmp, target)
+        print(f"{po} -> {target}")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))